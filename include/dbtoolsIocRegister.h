@@ -0,0 +1,24 @@
+/*************************************************************************\
+* Copyright (c) 2007 UChicago Argonne LLC, as Operator of Argonne
+*     National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#ifndef INC_dbtoolsIocRegister_H
+#define INC_dbtoolsIocRegister_H
+
+#include "shareLib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+epicsShareFunc void dbtoolsIocRegister(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_dbtoolsIocRegister_H */
@@ -0,0 +1,52 @@
+/*************************************************************************\
+* Copyright (c) 2002 The University of Chicago, as Operator of Argonne
+*     National Laboratory.
+* Copyright (c) 2002 The Regents of the University of California, as
+*     Operator of Los Alamos National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+/* iocInit.h    ioc initialization */
+
+#ifndef INCiocInith
+#define INCiocInith
+
+#include "shareLib.h"
+
+enum iocStateEnum {
+    iocVoid, iocBuilding, iocBuilt, iocRunning, iocPaused
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+epicsShareFunc enum iocStateEnum getIocState(void);
+epicsShareFunc int iocInit(void);
+epicsShareFunc int iocBuild(void);
+epicsShareFunc int iocBuildIsolated(void);
+epicsShareFunc int iocRun(void);
+epicsShareFunc int iocPause(void);
+epicsShareFunc int iocShutdown(void);
+
+/* Parallel record initialization, off unless iocInitThreads is set.
+ * Types whose support isn't reentrant must be named first with
+ * iocInitSerialRecordType().
+ */
+epicsShareExtern int iocInitThreads;
+epicsShareFunc void iocInitSerialRecordType(const char *recordTypeName);
+epicsShareFunc void iocInitReport(int level);
+
+/* Pack each lockset's records together at the start of iocInit, see
+ * dbLockPackRecords().  Off by default, since record pointers taken
+ * before iocInit are left dangling.
+ */
+epicsShareExtern int iocPackRecords;
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /*INCiocInith*/
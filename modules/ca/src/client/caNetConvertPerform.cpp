@@ -0,0 +1,165 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Compare the throughput of caNetConvert() on large arrays with the
+ * element at a time conversion it used before, for each DBR type
+ * with a numeric value.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "epicsTime.h"
+#include "epicsTypes.h"
+#include "osiWireFormat.h"
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+#include "net_convert.h"
+#include "caerr.h"
+
+static const arrayElementCount nElem = 1000000u;
+static const unsigned nIter = 10u;
+
+template < class T >
+static void elementLoop ( const void * s, void * d, int hton,
+    arrayElementCount num )
+{
+    const T * pSrc = static_cast < const T * > ( s );
+    T * pDest = static_cast < T * > ( d );
+
+    if ( hton ) {
+        for ( arrayElementCount i = 0; i < num; i++ ) {
+            AlignedWireRef < T > tmp ( pDest[i] );
+            tmp = pSrc[i];
+        }
+    }
+    else {
+        for ( arrayElementCount i = 0; i < num; i++ ) {
+            pDest[i] = AlignedWireRef < const T > ( pSrc[i] );
+        }
+    }
+}
+
+// The conversion as done before, metadata then one element at a time
+static void oldConvert ( unsigned type, const void * pSrc, void * pDest,
+    int hton, arrayElementCount num )
+{
+    const void * pSrcVal = static_cast < const char * > ( pSrc ) +
+        dbr_value_offset[type];
+    void * pDestVal = static_cast < char * > ( pDest ) +
+        dbr_value_offset[type];
+
+    caNetConvert ( type, pSrc, pDest, hton, 1 );
+    switch ( type % ( LAST_TYPE + 1 ) ) {
+    case DBR_SHORT:
+    case DBR_ENUM:
+        elementLoop < epicsUInt16 > ( pSrcVal, pDestVal, hton, num );
+        break;
+    case DBR_LONG:
+        elementLoop < epicsUInt32 > ( pSrcVal, pDestVal, hton, num );
+        break;
+    case DBR_FLOAT:
+        elementLoop < epicsFloat32 > ( pSrcVal, pDestVal, hton, num );
+        break;
+    case DBR_DOUBLE:
+        elementLoop < epicsFloat64 > ( pSrcVal, pDestVal, hton, num );
+        break;
+    default:
+        memcpy ( pDestVal, pSrcVal, num * dbr_value_size[type] );
+    }
+}
+
+static double rate ( unsigned type, bool old, const void * pSrc,
+    void * pDest, int hton )
+{
+    epicsTime begin = epicsTime::getCurrent ();
+    for ( unsigned i = 0u; i < nIter; i++ ) {
+        if ( old ) {
+            oldConvert ( type, pSrc, pDest, hton, nElem );
+        }
+        else {
+            caNetConvert ( type, pSrc, pDest, hton, nElem );
+        }
+    }
+    double elapsed = epicsTime::getCurrent () - begin;
+    return dbr_size_n ( type, nElem ) * nIter / elapsed / 1e9;
+}
+
+static void measure ( unsigned type )
+{
+    size_t size = dbr_size_n ( type, nElem );
+    char * pHost = new char [size];
+    char * pNet = new char [size];
+    char * pOld = new char [size];
+    char * pNew = new char [size];
+    char * pVal = pHost + dbr_value_offset[type];
+
+    // padding in the DBR structures is not copied
+    memset ( pHost, 0, size );
+    memset ( pOld, 0, size );
+    memset ( pNew, 0, size );
+    for ( arrayElementCount i = 0; i < nElem; i++ ) {
+        switch ( type % ( LAST_TYPE + 1 ) ) {
+        case DBR_SHORT:
+        case DBR_ENUM:
+            reinterpret_cast < epicsUInt16 * > ( pVal )[i] =
+                static_cast < epicsUInt16 > ( i * 7u );
+            break;
+        case DBR_LONG:
+            reinterpret_cast < epicsInt32 * > ( pVal )[i] =
+                static_cast < epicsInt32 > ( i * 40503u );
+            break;
+        case DBR_FLOAT:
+            reinterpret_cast < epicsFloat32 * > ( pVal )[i] = i * 0.25f;
+            break;
+        case DBR_DOUBLE:
+            reinterpret_cast < epicsFloat64 * > ( pVal )[i] = i * 0.125;
+            break;
+        default:
+            pVal[i] = static_cast < char > ( i );
+        }
+    }
+
+    double oldEnc = rate ( type, true, pHost, pOld, true );
+    double newEnc = rate ( type, false, pHost, pNew, true );
+    bool encOk = memcmp ( pOld, pNew, size ) == 0;
+    memcpy ( pNet, pNew, size );
+    double oldDec = rate ( type, true, pNet, pOld, false );
+    double newDec = rate ( type, false, pNet, pNew, false );
+    bool decOk = memcmp ( pOld, pNew, size ) == 0 &&
+        memcmp ( pNew, pHost, size ) == 0;
+
+    testOk ( encOk && decOk,
+        "%-16s encode %6.2f -> %6.2f GB/s, decode %6.2f -> %6.2f GB/s",
+        dbr_type_to_text ( static_cast < int > ( type ) ),
+        oldEnc, newEnc, oldDec, newDec );
+
+    delete [] pHost;
+    delete [] pNet;
+    delete [] pOld;
+    delete [] pNew;
+}
+
+MAIN ( caNetConvertPerform )
+{
+    static const unsigned types[] = {
+        DBR_SHORT, DBR_FLOAT, DBR_ENUM, DBR_CHAR, DBR_LONG, DBR_DOUBLE,
+        DBR_TIME_SHORT, DBR_TIME_FLOAT, DBR_TIME_ENUM, DBR_TIME_CHAR,
+        DBR_TIME_LONG, DBR_TIME_DOUBLE,
+        DBR_CTRL_SHORT, DBR_CTRL_LONG, DBR_CTRL_DOUBLE,
+    };
+    const unsigned nTypes = sizeof ( types ) / sizeof ( types[0] );
+
+    testPlan ( nTypes );
+    testDiag ( "%lu element arrays, old -> new rates", nElem );
+    for ( unsigned i = 0u; i < nTypes; i++ ) {
+        measure ( types[i] );
+    }
+    return testDone ();
+}
@@ -71,6 +71,124 @@ inline void dbr_ntohf (
     *pHost = AlignedWireRef < const epicsFloat32 > ( *pNet );
 }
 
+#if EPICS_BYTE_ORDER == EPICS_ENDIAN_LITTLE && \
+    EPICS_FLOAT_WORD_ORDER == EPICS_ENDIAN_LITTLE
+
+/*
+ * On little endian hosts with IEEE floating point, converting an array
+ * of N byte elements in either direction reverses the bytes of each
+ * element, so whole arrays are swapped with vector shuffles where the
+ * compiler target allows. The source and destination may be the same
+ * buffer.
+ */
+#define CA_BULK_SWAP
+
+#if defined ( __SSSE3__ ) || defined ( __AVX2__ )
+#   include <immintrin.h>
+#elif defined ( __SSE2__ )
+#   include <emmintrin.h>
+#endif
+
+template < unsigned N >
+inline void swapElement ( const epicsUInt8 * pSrc, epicsUInt8 * pDest )
+{
+    epicsUInt8 tmp[N];
+    for ( unsigned i = 0u; i < N; i++ ) {
+        tmp[i] = pSrc[N - 1u - i];
+    }
+    memcpy ( pDest, tmp, N );
+}
+
+#if defined ( __SSSE3__ ) || defined ( __AVX2__ )
+// byte shuffle control reversing each N byte element of a 16 byte lane
+template < unsigned N >
+inline epicsUInt8 swapIndex ( unsigned i )
+{
+    i %= 16u;
+    return static_cast < epicsUInt8 > ( i - i % N + N - 1u - i % N );
+}
+#elif defined ( __SSE2__ )
+template < unsigned N > __m128i swapVector ( __m128i v );
+
+template <>
+inline __m128i swapVector < 2u > ( __m128i v )
+{
+    return _mm_or_si128 ( _mm_slli_epi16 ( v, 8 ), _mm_srli_epi16 ( v, 8 ) );
+}
+
+template <>
+inline __m128i swapVector < 4u > ( __m128i v )
+{
+    // exchange the 16 bit halves of each word, then their bytes
+    v = _mm_shufflelo_epi16 ( v, 0xb1 );
+    v = _mm_shufflehi_epi16 ( v, 0xb1 );
+    return swapVector < 2u > ( v );
+}
+
+template <>
+inline __m128i swapVector < 8u > ( __m128i v )
+{
+    // reverse the 16 bit quarters of each double word, then their bytes
+    v = _mm_shufflelo_epi16 ( v, 0x1b );
+    v = _mm_shufflehi_epi16 ( v, 0x1b );
+    return swapVector < 2u > ( v );
+}
+#endif
+
+template < unsigned N >
+static void swapBytes ( const void * s, void * d, arrayElementCount num )
+{
+    const epicsUInt8 * pSrc = static_cast < const epicsUInt8 * > ( s );
+    epicsUInt8 * pDest = static_cast < epicsUInt8 * > ( d );
+    const arrayElementCount nBytes = num * N;
+    arrayElementCount i = 0u;
+
+#   if defined ( __AVX2__ )
+    {
+        epicsUInt8 ctrl[32];
+        for ( unsigned j = 0u; j < sizeof ( ctrl ); j++ ) {
+            ctrl[j] = swapIndex < N > ( j );
+        }
+        const __m256i mask = _mm256_loadu_si256 (
+            reinterpret_cast < const __m256i * > ( ctrl ) );
+        for ( ; i + 32u <= nBytes; i += 32u ) {
+            __m256i v = _mm256_loadu_si256 (
+                reinterpret_cast < const __m256i * > ( pSrc + i ) );
+            _mm256_storeu_si256 ( reinterpret_cast < __m256i * > ( pDest + i ),
+                _mm256_shuffle_epi8 ( v, mask ) );
+        }
+    }
+#   endif
+#   if defined ( __SSSE3__ ) || defined ( __AVX2__ )
+    {
+        epicsUInt8 ctrl[16];
+        for ( unsigned j = 0u; j < sizeof ( ctrl ); j++ ) {
+            ctrl[j] = swapIndex < N > ( j );
+        }
+        const __m128i mask = _mm_loadu_si128 (
+            reinterpret_cast < const __m128i * > ( ctrl ) );
+        for ( ; i + 16u <= nBytes; i += 16u ) {
+            __m128i v = _mm_loadu_si128 (
+                reinterpret_cast < const __m128i * > ( pSrc + i ) );
+            _mm_storeu_si128 ( reinterpret_cast < __m128i * > ( pDest + i ),
+                _mm_shuffle_epi8 ( v, mask ) );
+        }
+    }
+#   elif defined ( __SSE2__ )
+    for ( ; i + 16u <= nBytes; i += 16u ) {
+        __m128i v = _mm_loadu_si128 (
+            reinterpret_cast < const __m128i * > ( pSrc + i ) );
+        _mm_storeu_si128 ( reinterpret_cast < __m128i * > ( pDest + i ),
+            swapVector < N > ( v ) );
+    }
+#   endif
+    for ( ; i < nBytes; i += N ) {
+        swapElement < N > ( pSrc + i, pDest + i );
+    }
+}
+
+#endif /* little endian */
+
 inline epicsUInt16 dbr_ntohs( const epicsUInt16 & net )
 {
     return AlignedWireRef < const epicsUInt16 > ( net );
@@ -134,6 +252,9 @@ int                 encode,     /* cvrt HOST to NET if T    */
 arrayElementCount   num         /* number of values     */
 )
 {
+#ifdef CA_BULK_SWAP
+    swapBytes < 2u > ( s, d, num );
+#else
     dbr_short_t         *pSrc = (dbr_short_t *) s;
     dbr_short_t         *pDest = (dbr_short_t *) d;
 
@@ -147,6 +268,7 @@ arrayElementCount   num         /* number of values     */
             pDest[i] = dbr_ntohs( pSrc[i] );
         }
     }
+#endif
 }
 
 /*
@@ -184,6 +306,9 @@ int                 encode,     /* cvrt HOST to NET if T    */
 arrayElementCount   num         /* number of values     */
 )
 {
+#ifdef CA_BULK_SWAP
+    swapBytes < 4u > ( s, d, num );
+#else
     dbr_long_t          *pSrc = (dbr_long_t *) s;
     dbr_long_t          *pDest = (dbr_long_t *) d;
 
@@ -197,6 +322,7 @@ arrayElementCount   num         /* number of values     */
             pDest[i] = dbr_ntohl( pSrc[i] );
         }
     }
+#endif
 }
 
 /*
@@ -213,6 +339,9 @@ int                 encode,     /* cvrt HOST to NET if T    */
 arrayElementCount   num         /* number of values     */
 )
 {
+#ifdef CA_BULK_SWAP
+    swapBytes < 2u > ( s, d, num );
+#else
     dbr_enum_t          *pSrc = (dbr_enum_t *) s;
     dbr_enum_t          *pDest = (dbr_enum_t *) d;
 
@@ -226,6 +355,7 @@ arrayElementCount   num         /* number of values     */
             pDest[i] = dbr_ntohs ( pSrc[i] );
         }
     }
+#endif
 }
 
 /*
@@ -244,6 +374,9 @@ int                 encode,     /* cvrt HOST to NET if T    */
 arrayElementCount   num         /* number of values     */
 )
 {
+#ifdef CA_BULK_SWAP
+    swapBytes < 4u > ( s, d, num );
+#else
     const dbr_float_t   *pSrc = (const dbr_float_t *) s;
     dbr_float_t         *pDest = (dbr_float_t *) d;
 
@@ -257,6 +390,7 @@ arrayElementCount   num         /* number of values     */
             dbr_ntohf ( &pSrc[i], &pDest[i] );
         }
     }
+#endif
 }
 
 /*
@@ -269,6 +403,9 @@ int                 encode,     /* cvrt HOST to NET if T    */
 arrayElementCount   num         /* number of values     */
 )
 {
+#ifdef CA_BULK_SWAP
+    swapBytes < 8u > ( s, d, num );
+#else
     dbr_double_t        *pSrc = (dbr_double_t *) s;
     dbr_double_t        *pDest = (dbr_double_t *) d;
 
@@ -282,6 +419,7 @@ arrayElementCount   num         /* number of values     */
             dbr_ntohd( &pSrc[i], &pDest[i] );
         }
     }
+#endif
 }
 
 /****************************************************************************
@@ -1080,7 +1218,7 @@ arrayElementCount   num         /* number of values     */
         pDest->value = dbr_ntohl(pSrc->value);
     else        /* array chan-- multiple pts */
     {
-        cvrt_long(&pDest->value, &pSrc->value, encode, num);
+        cvrt_long(&pSrc->value, &pDest->value, encode, num);
     }
 }
 
@@ -1300,7 +1438,7 @@ arrayElementCount   num         /* number of values     */
         pDest->value = dbr_ntohl(pSrc->value);
     else        /* array chan-- multiple pts */
     {
-        cvrt_long(&pDest->value, &pSrc->value, encode, num);
+        cvrt_long(&pSrc->value, &pDest->value, encode, num);
     }
 }
 
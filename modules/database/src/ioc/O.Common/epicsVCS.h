@@ -0,0 +1,7 @@
+/* Generated file, do not edit! */
+
+/* Version determined from Git */
+
+#ifndef EPICS_VCS_VERSION
+  #define EPICS_VCS_VERSION "d76ca610f278619c153d-dirty"
+#endif
@@ -26,7 +26,6 @@
 #include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsInterrupt.h"
-#include "epicsRingPointer.h"
 #include "epicsString.h"
 #include "epicsThread.h"
 #include "epicsTimer.h"
@@ -51,14 +50,36 @@
 
 static int callbackQueueSize = 2000;
 
+/* Maximum number of callbacks a worker takes from its queue at once */
+#define CALLBACK_BATCH 16
+
+/* The callback queues are bounded lock-free multi-producer/multi-consumer
+ * queues after Dmitry Vyukov.  Each cell carries a sequence number which
+ * tells a producer or consumer at position pos whether the cell is ready
+ * for it: seq == pos means free for the producer, seq == pos+1 means
+ * filled for the consumer.
+ */
+typedef struct cbQueueCell {
+    size_t seq;
+    epicsCallback *pcallback;
+} cbQueueCell;
+
 typedef struct cbQueueSet {
     epicsEventId semWakeUp;
-    epicsRingPointerId queue;
+    cbQueueCell *cells;
+    size_t mask;    /* number of cells - 1 */
+    size_t head;    /* next position to push, use atomic */
+    size_t tail;    /* next position to pop, use atomic */
+    int maxUsed;
     int queueOverflow;
     int queueOverflows;
     int shutdown; // use atomic
     int threadsConfigured;
     int threadsRunning;
+    int threadsIdle; // use atomic
+    size_t wakeups; // use atomic
+    size_t batches; // use atomic
+    size_t callbacks; // use atomic
 } cbQueueSet;
 
 static cbQueueSet callbackQueue[NUM_CALLBACK_PRIORITIES];
@@ -98,6 +119,116 @@ static unsigned int threadPriority[NUM_CALLBACK_PRIORITIES] = {
 static int priorityValue[NUM_CALLBACK_PRIORITIES] = {0, 1, 2};
 
 
+static int cbQueueCreate(cbQueueSet *mySet, int size)
+{
+    size_t ncells = 1;
+    size_t i;
+
+    while (ncells < (size_t)size)
+        ncells <<= 1;
+    mySet->cells = calloc(ncells, sizeof(cbQueueCell));
+    if (!mySet->cells)
+        return -1;
+    for (i = 0; i < ncells; i++)
+        mySet->cells[i].seq = i;
+    mySet->mask = ncells - 1;
+    mySet->head = mySet->tail = 0;
+    mySet->maxUsed = 0;
+    return 0;
+}
+
+static int cbQueueUsed(cbQueueSet *mySet)
+{
+    size_t tail = epicsAtomicGetSizeT(&mySet->tail);
+    size_t head = epicsAtomicGetSizeT(&mySet->head);
+
+    return (int)(head - tail);
+}
+
+/* Is the cell at the head of the queue ready to pop? */
+static int cbQueueReady(cbQueueSet *mySet)
+{
+    size_t pos = epicsAtomicGetSizeT(&mySet->tail);
+    cbQueueCell *cell = &mySet->cells[pos & mySet->mask];
+
+    return epicsAtomicGetSizeT(&cell->seq) == pos + 1;
+}
+
+/* This routine can be called from interrupt context */
+static int cbQueuePush(cbQueueSet *mySet, epicsCallback *pcallback)
+{
+    size_t pos = epicsAtomicGetSizeT(&mySet->head);
+
+    for (;;) {
+        cbQueueCell *cell = &mySet->cells[pos & mySet->mask];
+        size_t seq = epicsAtomicGetSizeT(&cell->seq);
+        ptrdiff_t dif = (ptrdiff_t)(seq - pos);
+
+        if (dif == 0) {
+            size_t prev = epicsAtomicCmpAndSwapSizeT(&mySet->head,
+                pos, pos + 1);
+
+            if (prev == pos) {
+                int used;
+
+                cell->pcallback = pcallback;
+                /* epicsAtomicSet*() stores before its barrier, so
+                 * pcallback must be fenced before seq is published */
+                epicsAtomicWriteMemoryBarrier();
+                epicsAtomicSetSizeT(&cell->seq, pos + 1);
+
+                used = cbQueueUsed(mySet);
+                if (used > epicsAtomicGetIntT(&mySet->maxUsed))
+                    epicsAtomicSetIntT(&mySet->maxUsed, used);
+                return 1;
+            }
+            pos = prev;
+        }
+        else if (dif < 0) {
+            return 0;   /* full */
+        }
+        else {
+            pos = epicsAtomicGetSizeT(&mySet->head);
+        }
+    }
+}
+
+static epicsCallback* cbQueuePop(cbQueueSet *mySet)
+{
+    size_t pos = epicsAtomicGetSizeT(&mySet->tail);
+
+    for (;;) {
+        cbQueueCell *cell = &mySet->cells[pos & mySet->mask];
+        size_t seq = epicsAtomicGetSizeT(&cell->seq);
+        ptrdiff_t dif = (ptrdiff_t)(seq - (pos + 1));
+
+        /* Don't read pcallback before seq says it was published */
+        epicsAtomicReadMemoryBarrier();
+
+        if (dif == 0) {
+            size_t prev = epicsAtomicCmpAndSwapSizeT(&mySet->tail,
+                pos, pos + 1);
+
+            if (prev == pos) {
+                epicsCallback *pcallback = cell->pcallback;
+
+                /* Finish reading the cell before a producer may reuse it */
+                epicsAtomicReadMemoryBarrier();
+                epicsAtomicWriteMemoryBarrier();
+                epicsAtomicSetSizeT(&cell->seq, pos + mySet->mask + 1);
+                return pcallback;
+            }
+            pos = prev;
+        }
+        else if (dif < 0) {
+            return NULL;    /* empty */
+        }
+        else {
+            pos = epicsAtomicGetSizeT(&mySet->tail);
+        }
+    }
+}
+
 int callbackSetQueueSize(int size)
 {
     if (epicsAtomicGetIntT(&cbState)!=cbInit) {
@@ -114,12 +245,12 @@ int callbackQueueStatus(const int reset, callbackQueueStats *result)
     if (epicsAtomicGetIntT(&cbState)==cbInit) return -1;
     if (result) {
         int prio;
-        result->size = callbackQueueSize;
+        result->size = (int)callbackQueue[0].mask + 1;
         for(prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
-            epicsRingPointerId qId = callbackQueue[prio].queue;
-            result->numUsed[prio] = epicsRingPointerGetUsed(qId);
-            result->maxUsed[prio] = epicsRingPointerGetHighWaterMark(qId);
-            result->numOverflow[prio] = epicsAtomicGetIntT(&callbackQueue[prio].queueOverflows);
+            cbQueueSet *mySet = &callbackQueue[prio];
+            result->numUsed[prio] = cbQueueUsed(mySet);
+            result->maxUsed[prio] = epicsAtomicGetIntT(&mySet->maxUsed);
+            result->numOverflow[prio] = epicsAtomicGetIntT(&mySet->queueOverflows);
         }
         ret = 0;
     } else {
@@ -128,7 +259,37 @@ int callbackQueueStatus(const int reset, callbackQueueStats *result)
     if (reset) {
         int prio;
         for(prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
-            epicsRingPointerResetHighWaterMark(callbackQueue[prio].queue);
+            cbQueueSet *mySet = &callbackQueue[prio];
+            epicsAtomicSetIntT(&mySet->maxUsed, cbQueueUsed(mySet));
+        }
+    }
+    return ret;
+}
+
+int callbackThreadStatus(const int reset, callbackThreadStats *result)
+{
+    int ret;
+    if (epicsAtomicGetIntT(&cbState)==cbInit) return -1;
+    if (result) {
+        int prio;
+        for(prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
+            cbQueueSet *mySet = &callbackQueue[prio];
+            result->threadsIdle[prio] = epicsAtomicGetIntT(&mySet->threadsIdle);
+            result->numWakeups[prio] = epicsAtomicGetSizeT(&mySet->wakeups);
+            result->numBatches[prio] = epicsAtomicGetSizeT(&mySet->batches);
+            result->numCallbacks[prio] = epicsAtomicGetSizeT(&mySet->callbacks);
+        }
+        ret = 0;
+    } else {
+        ret = -2;
+    }
+    if (reset) {
+        int prio;
+        for(prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
+            cbQueueSet *mySet = &callbackQueue[prio];
+            epicsAtomicSetSizeT(&mySet->wakeups, 0);
+            epicsAtomicSetSizeT(&mySet->batches, 0);
+            epicsAtomicSetSizeT(&mySet->callbacks, 0);
         }
     }
     return ret;
@@ -137,7 +298,9 @@ int callbackQueueStatus(const int reset, callbackQueueStats *result)
 void callbackQueueShow(const int reset)
 {
     callbackQueueStats stats;
-    if (callbackQueueStatus(reset, &stats) == -1) {
+    callbackThreadStats tstats;
+    if (callbackQueueStatus(reset, &stats) == -1 ||
+        callbackThreadStatus(reset, &tstats) == -1) {
         fprintf(stderr, "Callback system not initialized, yet. Please run "
             "iocInit before using this command.\n");
     } else {
@@ -150,6 +313,16 @@ void callbackQueueShow(const int reset)
                    stats.numUsed[prio], stats.size, qusage,
                    stats.numOverflow[prio]);
         }
+        printf("PRIORITY  IDLE THREADS     WAKEUPS     BATCHES   CALLBACKS  AVG BATCH\n");
+        for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
+            double avg = tstats.numBatches[prio] ? (double)
+                tstats.numCallbacks[prio] / tstats.numBatches[prio] : 0.0;
+            printf("%8s  %12d  %10lu  %10lu  %10lu  %9.2f\n",
+                   threadNamePrefix[prio], tstats.threadsIdle[prio],
+                   (unsigned long)tstats.numWakeups[prio],
+                   (unsigned long)tstats.numBatches[prio],
+                   (unsigned long)tstats.numCallbacks[prio], avg);
+        }
     }
 }
 
@@ -212,17 +385,45 @@ static void callbackTask(void *arg)
     epicsEventSignal(startStopEvent);
 
     while(!epicsAtomicGetIntT(&mySet->shutdown)) {
-        void *ptr;
-        if (epicsRingPointerIsEmpty(mySet->queue))
-            epicsEventMustWait(mySet->semWakeUp);
-
-        while ((ptr = epicsRingPointerPop(mySet->queue))) {
-            epicsCallback *pcallback = (epicsCallback *)ptr;
-            if(!epicsRingPointerIsEmpty(mySet->queue))
-                epicsEventMustTrigger(mySet->semWakeUp);
-            mySet->queueOverflow = FALSE;
-            (*pcallback->callback)(pcallback);
+        epicsCallback *batch[CALLBACK_BATCH];
+        int used = cbQueueUsed(mySet);
+        int limit = used / mySet->threadsConfigured;
+        int i, n;
+
+        /* Take this worker's share of the waiting callbacks */
+        if (limit < 1)
+            limit = 1;
+        else if (limit > CALLBACK_BATCH)
+            limit = CALLBACK_BATCH;
+        for (n = 0; n < limit; n++) {
+            batch[n] = cbQueuePop(mySet);
+            if (!batch[n])
+                break;
+        }
+
+        if (n == 0) {
+            /* Announce that we are idle before looking at the queue
+             * again, so a callbackRequest() racing with us either sees
+             * threadsIdle set and wakes us, or we see its callback.
+             */
+            epicsAtomicIncrIntT(&mySet->threadsIdle);
+            if (!cbQueueReady(mySet) && !epicsAtomicGetIntT(&mySet->shutdown))
+                epicsEventMustWait(mySet->semWakeUp);
+            epicsAtomicDecrIntT(&mySet->threadsIdle);
+            continue;
+        }
+
+        /* Pass the wakeup on if there is more work than we took */
+        if (cbQueueUsed(mySet) && epicsAtomicGetIntT(&mySet->threadsIdle)) {
+            epicsAtomicIncrSizeT(&mySet->wakeups);
+            epicsEventMustTrigger(mySet->semWakeUp);
         }
+        mySet->queueOverflow = FALSE;
+        epicsAtomicIncrSizeT(&mySet->batches);
+        epicsAtomicAddSizeT(&mySet->callbacks, n);
+
+        for (i = 0; i < n; i++)
+            (*batch[i]->callback)(batch[i]);
     }
 
     if(!epicsAtomicDecrIntT(&mySet->threadsRunning))
@@ -264,7 +465,7 @@ void callbackCleanup(void)
 
         assert(epicsAtomicGetIntT(&mySet->threadsRunning)==0);
         epicsEventDestroy(mySet->semWakeUp);
-        epicsRingPointerDelete(mySet->queue);
+        free(mySet->cells);
     }
 
     epicsTimerQueueRelease(timerQueue);
@@ -291,9 +492,8 @@ void callbackInit(void)
         epicsThreadId tid;
 
         callbackQueue[i].semWakeUp = epicsEventMustCreate(epicsEventEmpty);
-        callbackQueue[i].queue = epicsRingPointerLockedCreate(callbackQueueSize);
-        if (callbackQueue[i].queue == 0)
-            cantProceed("epicsRingPointerLockedCreate failed for %s\n",
+        if (cbQueueCreate(&callbackQueue[i], callbackQueueSize))
+            cantProceed("cbQueueCreate failed for %s\n",
                 threadNamePrefix[i]);
         callbackQueue[i].queueOverflow = FALSE;
         if (callbackQueue[i].threadsConfigured == 0)
@@ -336,7 +536,7 @@ int callbackRequest(epicsCallback *pcallback)
     mySet = &callbackQueue[priority];
     if (mySet->queueOverflow) return S_db_bufFull;
 
-    pushOK = epicsRingPointerPush(mySet->queue, pcallback);
+    pushOK = cbQueuePush(mySet, pcallback);
 
     if (!pushOK) {
         epicsInterruptContextMessage(fullMessage[priority]);
@@ -344,7 +544,13 @@ int callbackRequest(epicsCallback *pcallback)
         epicsAtomicIncrIntT(&mySet->queueOverflows);
         return S_db_bufFull;
     }
-    epicsEventSignal(mySet->semWakeUp);
+    /* Only wake a worker if one is waiting.  The read-modify-write orders
+     * this read after the push above; see callbackTask().
+     */
+    if (epicsAtomicAddIntT(&mySet->threadsIdle, 0) > 0) {
+        epicsAtomicIncrSizeT(&mySet->wakeups);
+        epicsEventSignal(mySet->semWakeUp);
+    }
     return 0;
 }
 
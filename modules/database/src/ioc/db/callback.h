@@ -18,6 +18,8 @@
 #ifndef INCcallbackh
 #define INCcallbackh 1
 
+#include <stddef.h>
+
 #include "shareLib.h"
 
 #ifdef __cplusplus
@@ -58,6 +60,14 @@ typedef struct callbackQueueStats {
     int numOverflow[NUM_CALLBACK_PRIORITIES];
 } callbackQueueStats;
 
+/* Worker thread activity, from callbackThreadStatus() */
+typedef struct callbackThreadStats {
+    int threadsIdle[NUM_CALLBACK_PRIORITIES];
+    size_t numWakeups[NUM_CALLBACK_PRIORITIES];
+    size_t numBatches[NUM_CALLBACK_PRIORITIES];
+    size_t numCallbacks[NUM_CALLBACK_PRIORITIES];
+} callbackThreadStats;
+
 #define callbackSetCallback(PFUN, PCALLBACK) \
     ( (PCALLBACK)->callback = (PFUN) )
 #define callbackSetPriority(PRIORITY, PCALLBACK) \
@@ -82,8 +92,12 @@ epicsShareFunc void callbackRequestDelayed(
 epicsShareFunc void callbackCancelDelayed(epicsCallback *pcallback);
 epicsShareFunc void callbackRequestProcessCallbackDelayed(
     epicsCallback *pCallback, int Priority, void *pRec, double seconds);
+/* The size is rounded up to a power of two, callbackQueueStatus()
+ * reports the size actually used.
+ */
 epicsShareFunc int callbackSetQueueSize(int size);
 epicsShareFunc int callbackQueueStatus(const int reset, callbackQueueStats *result);
+epicsShareFunc int callbackThreadStatus(const int reset, callbackThreadStats *result);
 epicsShareFunc void callbackQueueShow(const int reset);
 epicsShareFunc int callbackParallelThreads(int count, const char *prio);
 
@@ -52,6 +52,7 @@
 #include "dbLink.h"
 #include "dbLockPvt.h"
 #include "dbNotify.h"
+#include "dbProcStats.h"
 #include "dbScan.h"
 #include "dbServer.h"
 #include "dbStaticLib.h"
@@ -470,6 +471,7 @@ long dbProcess(dbCommon *precord)
     int set_trace = FALSE;
     dbFldDes *pdbFldDes;
     int callNotifyCompletion = FALSE;
+    epicsUInt64 start = 0;
 
     ptrace = dbLockSetAddrTrace(precord);
     /*
@@ -514,6 +516,9 @@ long dbProcess(dbCommon *precord)
     if (precord->pact) {
         unsigned short monitor_mask;
 
+        if (dbRec2Pvt(precord)->procStats && dbProcStatsEnable)
+            dbRec2Pvt(precord)->procStats->active++;
+
         if (*ptrace)
             printf("%s: dbProcess of Active '%s' with RPRO=%d\n",
                 context, precord->name, precord->rpro);
@@ -586,8 +591,14 @@ long dbProcess(dbCommon *precord)
         printf("%s: dbProcess of '%s'\n", context, precord->name);
 
     /* process record */
+    if (dbRec2Pvt(precord)->procStats && dbProcStatsEnable)
+        start = epicsMonotonicGet();
+
     status = prset->process(precord);
 
+    if (start)
+        dbProcStatsAdd(precord, epicsMonotonicGet() - start);
+
     /* Print record's fields if PRINT_MASK set in breakpoint field */
     if (lset_stack_count != 0) {
         dbPrint(precord);
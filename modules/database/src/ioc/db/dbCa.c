@@ -52,6 +52,7 @@
 #include "link.h"
 #include "recGbl.h"
 #include "recSup.h"
+#include "epicsExport.h"
 
 /* from dbAccessDefs.h which can't be included here */
 #define S_db_badDbrtype (M_dbAccess| 3)
@@ -62,19 +63,18 @@
 extern void dbServiceIOInit();
 extern int dbServiceIsolate;
 
-static ELLLIST workList = ELLLIST_INIT;    /* Work list for dbCaTask */
-static epicsMutexId workListLock; /*Mutual exclusions semaphores for workList*/
-static epicsEventId workListEvent; /*wakeup event for dbCaTask*/
-static int removesOutstanding = 0;
+int dbCaLinkWorkers = 1;
+epicsExportAddress(int, dbCaLinkWorkers);
+
+static dbCaWorker **workers; /* nWorkers in use, nAllocated created */
+static unsigned nWorkers, nAllocated;
 #define removesOutstandingWarning 10000
 
 static volatile enum dbCaCtl_t {
     ctlInit, ctlRun, ctlPause, ctlExit
 } dbCaCtl;
-static epicsEventId startStopEvent;
-static epicsThreadId dbCaWorker;
 
-struct ca_client_context * dbCaClientContext;
+struct ca_client_context * dbCaClientContext; /* of the first worker only */
 
 /* Forward declarations */
 static void dbCaTask(void *);
@@ -85,15 +85,14 @@ static lset dbCa_lset;
     errlogPrintf("%s has DB CA link to %s\n",\
         pcaLink->plink->precord->name, pcaLink->pvname)
 
-static int dbca_chan_count;
-
 /* caLink locking
  *
  * Lock ordering:
  *  dbScanLock -> caLink.lock -> workListLock
  *
  * workListLock:
- *   Guards access to workList.
+ *   Guards access to the workList of one worker.  Each link is given to
+ *   the worker which its target record name hashes to when it is added.
  *
  * dbScanLock:
  *   All dbCa* functions operating on a single link may only be called when
@@ -111,12 +110,12 @@ static int dbca_chan_count;
  * caLink.lock:
  *   Guards the caLink structure (but not the struct DBLINK)
  *
- * The dbCaTask only locks caLink, and must not lock the record (a violation of lock order).
+ * The dbCaTask workers only lock caLink, and must not lock the record (a violation of lock order).
  *
  * During link modification or IOC shutdown the pca->plink pointer (guarded by caLink.lock)
  * is used as a flag to indicate that a link is no longer active.
  *
- * References to the struct caLink are owned by the dbCaTask, and any scanOnceCallback()
+ * References to the struct caLink are owned by its dbCaTask, and any scanOnceCallback()
  * which is in progress.
  *
  * The libca and scanOnceCallback callbacks take no action if pca->plink==NULL.
@@ -131,9 +130,10 @@ static int dbca_chan_count;
 
 static void addAction(caLink *pca, short link_action)
 {
+    dbCaWorker *pw = pca->pworker;
     int callAdd;
 
-    epicsMutexMustLock(workListLock);
+    epicsMutexMustLock(pw->workListLock);
     callAdd = (pca->link_action == 0);
     if (pca->link_action & CA_CLEAR_CHANNEL) {
         errlogPrintf("dbCa::addAction %d with CA_CLEAR_CHANNEL set\n",
@@ -142,22 +142,30 @@ static void addAction(caLink *pca, short link_action)
         link_action = 0;
     }
     if (link_action & CA_CLEAR_CHANNEL) {
-        if (++removesOutstanding >= removesOutstandingWarning) {
+        if (++pw->removesOutstanding >= removesOutstandingWarning) {
             errlogPrintf("dbCa::addAction pausing, %d channels to clear\n",
-                removesOutstanding);
+                pw->removesOutstanding);
         }
-        while (removesOutstanding >= removesOutstandingWarning) {
-            epicsMutexUnlock(workListLock);
+        while (pw->removesOutstanding >= removesOutstandingWarning) {
+            epicsMutexUnlock(pw->workListLock);
             epicsThreadSleep(1.0);
-            epicsMutexMustLock(workListLock);
+            epicsMutexMustLock(pw->workListLock);
         }
     }
     pca->link_action |= link_action;
     if (callAdd)
-        ellAdd(&workList, &pca->node);
-    epicsMutexUnlock(workListLock);
+        ellAdd(&pw->workList, &pca->node);
+    epicsMutexUnlock(pw->workListLock);
     if (callAdd)
-        epicsEventSignal(workListEvent);
+        epicsEventSignal(pw->workListEvent);
+}
+
+/* Links to fields of the same record are serviced by the same worker */
+static dbCaWorker * chooseWorker(const char *pvname)
+{
+    size_t len = strcspn(pvname, ".");
+
+    return workers[epicsMemHash(pvname, len, 0) % nWorkers];
 }
 
 static void caLinkInc(caLink *pca)
@@ -179,8 +187,10 @@ static void caLinkDec(caLink *pca)
 
     if (pca->chid) {
         ca_clear_channel(pca->chid);
-        --dbca_chan_count;
+        epicsAtomicDecrIntT(&pca->pworker->chanCount);
     }
+    /* Clearing the channel cancelled their completions */
+    ellFree(&pca->putTags);
     callback = pca->putCallback;
     if (callback) {
         userPvt = pca->putUserPvt;
@@ -197,13 +207,14 @@ static void caLinkDec(caLink *pca)
     if (callback) callback(userPvt);
 }
 
-/* Block until worker thread has processed all previously queued actions.
- * Does not prevent additional actions from being queued.
+/* Block until the worker threads have processed all previously queued
+ * actions.  Does not prevent additional actions from being queued.
  */
 void dbCaSync(void)
 {
     epicsEventId wake;
     caLink templink;
+    unsigned i;
 
     /* we only partially initialize templink.
      * It has no link field and no subscription
@@ -217,15 +228,20 @@ void dbCaSync(void)
 
     templink.userPvt = wake;
 
-    addAction(&templink, CA_SYNC);
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = workers[i];
 
-    epicsEventMustWait(wake);
-    /* Worker holds workListLock when calling epicsEventMustTrigger()
-     * we cycle through workListLock to ensure worker call to
-     * epicsEventMustTrigger() returns before we destroy the event.
-     */
-    epicsMutexMustLock(workListLock);
-    epicsMutexUnlock(workListLock);
+        templink.pworker = pw;
+        addAction(&templink, CA_SYNC);
+
+        epicsEventMustWait(wake);
+        /* Worker holds workListLock when calling epicsEventMustTrigger()
+         * we cycle through workListLock to ensure worker call to
+         * epicsEventMustTrigger() returns before we destroy the event.
+         */
+        epicsMutexMustLock(pw->workListLock);
+        epicsMutexUnlock(pw->workListLock);
+    }
 
     assert(templink.refcount==1);
 
@@ -249,6 +265,21 @@ epicsShareFunc unsigned long dbCaGetUpdateCount(struct link *plink)
     return ret;
 }
 
+struct ca_client_context * dbCaLinkContext(const struct link *plink)
+{
+    caLink *pca;
+
+    if (!plink || plink->type != CA_LINK)
+        return NULL;
+    pca = (caLink *)plink->value.pv_link.pvt;
+    return pca ? pca->pworker->context : NULL;
+}
+
+struct ca_client_context * dbCaWorkerContext(unsigned index)
+{
+    return index < nWorkers ? workers[index]->context : NULL;
+}
+
 void dbCaCallbackProcess(void *userPvt)
 {
     struct link *plink = (struct link *)userPvt;
@@ -256,20 +287,37 @@ void dbCaCallbackProcess(void *userPvt)
     dbLinkAsyncComplete(plink);
 }
 
+static void signalWorkers(void)
+{
+    unsigned i;
+
+    for (i = 0; i < nWorkers; i++)
+        epicsEventSignal(workers[i]->workListEvent);
+}
+
 void dbCaShutdown(void)
 {
     enum dbCaCtl_t cur = dbCaCtl;
+    unsigned i;
+
     assert(cur == ctlRun || cur == ctlPause);
     dbCaCtl = ctlExit;
-    epicsEventSignal(workListEvent);
-    epicsEventMustWait(startStopEvent);
-    if(dbCaWorker)
-        epicsThreadMustJoin(dbCaWorker);
+    signalWorkers();
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = workers[i];
+
+        epicsEventMustWait(pw->startStopEvent);
+        if (pw->thread)
+            epicsThreadMustJoin(pw->thread);
+        pw->thread = NULL;
+    }
 }
 
 static void dbCaLinkInitImpl(int isolate)
 {
     epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    unsigned n = dbCaLinkWorkers > 1 ? dbCaLinkWorkers : 1;
+    unsigned i;
 
     opts.stackSize = epicsThreadGetStackSize(epicsThreadStackBig);
     opts.priority = epicsThreadPriorityMedium;
@@ -278,18 +326,44 @@ static void dbCaLinkInitImpl(int isolate)
     dbServiceIsolate = isolate;
     dbServiceIOInit();
 
-    if (!workListLock)
-        workListLock = epicsMutexMustCreate();
-    if (!workListEvent)
-        workListEvent = epicsEventMustCreate(epicsEventEmpty);
-
-    if(!startStopEvent)
-        startStopEvent = epicsEventMustCreate(epicsEventEmpty);
+    /* Workers are kept after shutdown and links may still refer to
+     * them, so all of those are started again even if dbCaLinkWorkers
+     * has been lowered.
+     */
+    if (n > nAllocated) {
+        dbCaWorker **pnew = dbCalloc(n, sizeof(dbCaWorker *));
+
+        if (workers)
+            memcpy(pnew, workers, nAllocated * sizeof(dbCaWorker *));
+        free(workers);
+        workers = pnew;
+        for (i = nAllocated; i < n; i++) {
+            dbCaWorker *pw = dbCalloc(1, sizeof(dbCaWorker));
+
+            ellInit(&pw->workList);
+            pw->workListLock = epicsMutexMustCreate();
+            pw->workListEvent = epicsEventMustCreate(epicsEventEmpty);
+            pw->startStopEvent = epicsEventMustCreate(epicsEventEmpty);
+            pw->index = i;
+            workers[i] = pw;
+        }
+        nAllocated = n;
+    }
+    nWorkers = nAllocated;
     dbCaCtl = ctlPause;
 
-    dbCaWorker = epicsThreadCreateOpt("dbCaLink", dbCaTask, NULL, &opts);
-    /* wait for worker to startup and initialize dbCaClientContext */
-    epicsEventMustWait(startStopEvent);
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = workers[i];
+        char name[20];
+
+        if (i == 0)
+            strcpy(name, "dbCaLink");
+        else
+            sprintf(name, "dbCaLink%u", i);
+        pw->thread = epicsThreadCreateOpt(name, dbCaTask, pw, &opts);
+        /* wait for worker to startup and initialize its context */
+        epicsEventMustWait(pw->startStopEvent);
+    }
 }
 
 void dbCaLinkInitIsolated(void)
@@ -306,7 +380,7 @@ void dbCaRun(void)
 {
     if (dbCaCtl == ctlPause) {
         dbCaCtl = ctlRun;
-        epicsEventSignal(workListEvent);
+        signalWorkers();
     }
 }
 
@@ -314,7 +388,30 @@ void dbCaPause(void)
 {
     if (dbCaCtl == ctlRun) {
         dbCaCtl = ctlPause;
-        epicsEventSignal(workListEvent);
+        signalWorkers();
+    }
+}
+
+void dbCaWorkerReport(int level)
+{
+    unsigned i;
+
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = workers[i];
+        int queued;
+
+        epicsMutexMustLock(pw->workListLock);
+        queued = ellCount(&pw->workList);
+        epicsMutexUnlock(pw->workListLock);
+
+        printf("dbCa worker %u: %d channels, %lu actions, %lu puts, "
+            "%lu flushes, %d queued\n", i,
+            epicsAtomicGetIntT(&pw->chanCount),
+            (unsigned long)epicsAtomicGetSizeT(&pw->nActions),
+            (unsigned long)epicsAtomicGetSizeT(&pw->nPuts),
+            (unsigned long)epicsAtomicGetSizeT(&pw->nFlushes), queued);
+        if (level > 2 && pw->context)
+            ca_context_status(pw->context, level - 2);
     }
 }
 
@@ -330,6 +427,8 @@ void dbCaAddLinkCallback(struct link *plink,
     pca->lock = epicsMutexMustCreate();
     pca->plink = plink;
     pca->pvname = epicsStrDup(plink->value.pv_link.pvname);
+    pca->pworker = chooseWorker(pca->pvname);
+    pca->coalesce = !!(plink->value.pv_link.pvlMask & pvlOptLATEST);
     pca->connect = connect;
     pca->monitor = monitor;
     pca->userPvt = userPvt;
@@ -493,7 +592,10 @@ long dbCaPutLinkCallback(struct link *plink,short dbrType,
         status = fConvert(pbuffer, pca->pputString, 0);
         link_action |= CA_WRITE_STRING;
         pca->gotOutString = TRUE;
-        if (pca->newOutString) pca->nNoWrite++;
+        if (pca->newOutString) {
+            if (pca->coalesce) pca->nCoalesced++;
+            else pca->nNoWrite++;
+        }
         pca->newOutString = TRUE;
     } else {
         int newType = dbDBRoldToDBFnew[pca->dbrType];
@@ -527,7 +629,10 @@ long dbCaPutLinkCallback(struct link *plink,short dbrType,
         }
         link_action |= CA_WRITE_NATIVE;
         pca->gotOutNative = TRUE;
-        if (pca->newOutNative) pca->nNoWrite++;
+        if (pca->newOutNative) {
+            if (pca->coalesce) pca->nCoalesced++;
+            else pca->nNoWrite++;
+        }
         pca->newOutNative = TRUE;
     }
     if (callback) {
@@ -798,6 +903,9 @@ static void connectionCallback(struct connection_handler_args arg)
         dbCommon *precord = plink->precord;
 
         pca->nDisconnect++;
+        /* Puts in flight no longer hold back those on the next circuit */
+        pca->putGen++;
+        pca->putPending = 0;
         if (precord &&
             ((ppv_link->pvlMask & pvlOptCP) ||
              ((ppv_link->pvlMask & pvlOptCPP) && precord->scan == 0)))
@@ -980,6 +1088,79 @@ done:
     if (callback) callback(userPvt);
 }
 
+/* A LATEST link keeps one put in flight.  Values written while it is
+ * outstanding overwrite each other, the latest is sent on completion.
+ * Each put is tagged with the generation of the circuit it was sent on,
+ * so those lost with an earlier circuit are ignored.
+ */
+typedef struct caPutTag {
+    ELLNODE         node;
+    caLink          *pca;
+    unsigned        gen;
+} caPutTag;
+
+/* Call with pca->lock held */
+static caPutTag * putTagAdd(caLink *pca)
+{
+    caPutTag *ptag = dbCalloc(1, sizeof(caPutTag));
+
+    ptag->pca = pca;
+    ptag->gen = pca->putGen;
+    ellAdd(&pca->putTags, &ptag->node);
+    return ptag;
+}
+
+/* Call with pca->lock held */
+static int putTagsCurrent(caLink *pca)
+{
+    caPutTag *ptag;
+
+    for (ptag = (caPutTag *)ellFirst(&pca->putTags); ptag;
+         ptag = (caPutTag *)ellNext(&ptag->node)) {
+        if (ptag->gen == pca->putGen)
+            return 1;
+    }
+    return 0;
+}
+
+static void coalescedPutComplete(struct event_handler_args arg)
+{
+    caPutTag *ptag = (caPutTag *)arg.usr;
+    caLink *pca = ptag->pca;
+
+    epicsMutexMustLock(pca->lock);
+    ellDelete(&pca->putTags, &ptag->node);
+    if (ptag->gen == pca->putGen && pca->plink && pca->putPending &&
+        !putTagsCurrent(pca)) {
+        addAction(pca, pca->putPending);
+        pca->putPending = 0;
+    }
+    epicsMutexUnlock(pca->lock);
+    free(ptag);
+}
+
+static int coalescedPut(caLink *pca, caPutTag *ptag, short write,
+    chtype type, unsigned long count, const void *pvalue)
+{
+    int status = ca_array_put_callback(type, count, pca->chid, pvalue,
+        coalescedPutComplete, ptag);
+
+    if (status != ECA_NORMAL) {
+        epicsMutexMustLock(pca->lock);
+        ellDelete(&pca->putTags, &ptag->node);
+        /* Not sent, so the value is still new and goes out on reconnect */
+        if (write == CA_WRITE_NATIVE)
+            pca->newOutNative = TRUE;
+        else
+            pca->newOutString = TRUE;
+        if (!putTagsCurrent(pca))
+            pca->putPending = 0;
+        epicsMutexUnlock(pca->lock);
+        free(ptag);
+    }
+    return status;
+}
+
 static void accessRightsCallback(struct access_rights_handler_args arg)
 {
     caLink *pca = (caLink *)ca_puser(arg.chid);
@@ -1059,27 +1240,33 @@ static void getAttribEventCallback(struct event_handler_args arg)
 
 static void dbCaTask(void *arg)
 {
+    dbCaWorker *pw = (dbCaWorker *)arg;
+
     taskwdInsert(0, NULL, NULL);
     SEVCHK(ca_context_create(ca_enable_preemptive_callback),
         "dbCaTask calling ca_context_create");
-    dbCaClientContext = ca_current_context ();
+    pw->context = ca_current_context ();
+    if (pw->index == 0)
+        dbCaClientContext = pw->context;
     SEVCHK(ca_add_exception_event(exceptionCallback,NULL),
         "ca_add_exception_event");
-    epicsEventSignal(startStopEvent);
+    epicsEventSignal(pw->startStopEvent);
 
     /* channel access event loop */
     while (TRUE){
         do {
-            epicsEventMustWait(workListEvent);
+            epicsEventMustWait(pw->workListEvent);
         } while (dbCaCtl == ctlPause);
         while (TRUE) { /* process all requests in workList*/
             caLink *pca;
             short  link_action;
             int    status;
+            int    coalesced;
+            caPutTag *ptagNative = NULL, *ptagString = NULL;
 
-            epicsMutexMustLock(workListLock);
-            if (!(pca = (caLink *)ellGet(&workList))){  /* Take off list head */
-                epicsMutexUnlock(workListLock);
+            epicsMutexMustLock(pw->workListLock);
+            if (!(pca = (caLink *)ellGet(&pw->workList))){  /* Take off list head */
+                epicsMutexUnlock(pw->workListLock);
                 if (dbCaCtl == ctlExit) goto shutdown;
                 break; /* workList is empty */
             }
@@ -1087,10 +1274,11 @@ static void dbCaTask(void *arg)
             if (link_action&CA_SYNC)
                 epicsEventMustTrigger((epicsEventId)pca->userPvt); /* dbCaSync() requires workListLock to be held here */
             pca->link_action = 0;
-            if (link_action & CA_CLEAR_CHANNEL) --removesOutstanding;
-            epicsMutexUnlock(workListLock);         /* Give back immediately */
+            if (link_action & CA_CLEAR_CHANNEL) --pw->removesOutstanding;
+            epicsMutexUnlock(pw->workListLock);     /* Give back immediately */
             if (link_action&CA_SYNC)
                 continue;
+            epicsAtomicIncrSizeT(&pw->nActions);
             if (link_action & CA_CLEAR_CHANNEL) {   /* This must be first */
                 caLinkDec(pca);
                 /* No alarm is raised. Since link is changing so what? */
@@ -1106,7 +1294,7 @@ static void dbCaTask(void *arg)
                     printLinks(pca);
                     continue;
                 }
-                dbca_chan_count++;
+                epicsAtomicIncrIntT(&pw->chanCount);
                 status = ca_replace_access_rights_event(pca->chid,
                     accessRightsCallback);
                 if (status != ECA_NORMAL) {
@@ -1117,9 +1305,38 @@ static void dbCaTask(void *arg)
                 continue; /*Other options must wait until connect*/
             }
             if (ca_state(pca->chid) != cs_conn) continue;
+            coalesced = 0;
+            if (pca->coalesce && pca->putType == CA_PUT &&
+                (link_action & (CA_WRITE_NATIVE | CA_WRITE_STRING))) {
+                short writes = link_action &
+                    (CA_WRITE_NATIVE | CA_WRITE_STRING);
+
+                epicsMutexMustLock(pca->lock);
+                if (putTagsCurrent(pca)) {
+                    /* Send whatever is latest when the put completes */
+                    pca->putPending |= writes;
+                    link_action &= ~writes;
+                }
+                else {
+                    /* Later values must count as coalesced from now on */
+                    if (writes & CA_WRITE_NATIVE) {
+                        ptagNative = putTagAdd(pca);
+                        pca->newOutNative = FALSE;
+                    }
+                    if (writes & CA_WRITE_STRING) {
+                        ptagString = putTagAdd(pca);
+                        pca->newOutString = FALSE;
+                    }
+                    coalesced = 1;
+                }
+                epicsMutexUnlock(pca->lock);
+            }
             if (link_action & CA_WRITE_NATIVE) {
                 assert(pca->pputNative);
-                if (pca->putType == CA_PUT) {
+                if (coalesced) {
+                    status = coalescedPut(pca, ptagNative, CA_WRITE_NATIVE,
+                        pca->dbrType, pca->putnelements, pca->pputNative);
+                } else if (pca->putType == CA_PUT) {
                     status = ca_array_put(
                         pca->dbrType, pca->putnelements,
                         pca->chid, pca->pputNative);
@@ -1136,13 +1353,19 @@ static void dbCaTask(void *arg)
                         ca_message(status));
                     printLinks(pca);
                 }
+                else
+                    epicsAtomicIncrSizeT(&pw->nPuts);
                 epicsMutexMustLock(pca->lock);
-                if (status == ECA_NORMAL) pca->newOutNative = FALSE;
+                if (!coalesced && status == ECA_NORMAL)
+                    pca->newOutNative = FALSE;
                 epicsMutexUnlock(pca->lock);
             }
             if (link_action & CA_WRITE_STRING) {
                 assert(pca->pputString);
-                if (pca->putType == CA_PUT) {
+                if (coalesced) {
+                    status = coalescedPut(pca, ptagString, CA_WRITE_STRING,
+                        DBR_STRING, 1, pca->pputString);
+                } else if (pca->putType == CA_PUT) {
                     status = ca_array_put(
                         DBR_STRING, 1,
                         pca->chid, pca->pputString);
@@ -1159,8 +1382,11 @@ static void dbCaTask(void *arg)
                         ca_message(status));
                     printLinks(pca);
                 }
+                else
+                    epicsAtomicIncrSizeT(&pw->nPuts);
                 epicsMutexMustLock(pca->lock);
-                if (status == ECA_NORMAL) pca->newOutString = FALSE;
+                if (!coalesced && status == ECA_NORMAL)
+                    pca->newOutString = FALSE;
                 epicsMutexUnlock(pca->lock);
             }
             /*CA_GET_ATTRIBUTES before CA_MONITOR so that attributes available
@@ -1206,13 +1432,18 @@ static void dbCaTask(void *arg)
                 }
             }
         }
+        /* One flush sends everything queued for this worker's circuits */
         SEVCHK(ca_flush_io(), "dbCaTask");
+        epicsAtomicIncrSizeT(&pw->nFlushes);
     }
 shutdown:
     taskwdRemove(0);
-    if (dbca_chan_count == 0)
+    if (epicsAtomicGetIntT(&pw->chanCount) == 0) {
         ca_context_destroy();
+        pw->context = NULL;
+    }
     else
-        fprintf(stderr, "dbCa: chan_count = %d at shutdown\n", dbca_chan_count);
-    epicsEventSignal(startStopEvent);
+        fprintf(stderr, "dbCa: chan_count = %d at shutdown\n",
+            epicsAtomicGetIntT(&pw->chanCount));
+    epicsEventSignal(pw->startStopEvent);
 }
@@ -45,8 +45,21 @@ epicsShareFunc long dbCaPutLinkCallback(struct link *plink,
 epicsShareFunc long dbCaPutLink(struct link *plink,short dbrType,
     const void *pbuffer,long nRequest);
 
+/* The CA client context of the first link thread only. With more than
+ * one thread (dbCaLinkWorkers) the channels of other links are in other
+ * contexts, use dbCaLinkContext() or dbCaWorkerContext() to find them.
+ */
 extern struct ca_client_context * dbCaClientContext;
 
+/* Number of threads servicing CA links, set before iocInit */
+epicsShareExtern int dbCaLinkWorkers;
+
+/* The CA client context holding the channel of a CA link, or NULL */
+epicsShareFunc struct ca_client_context * dbCaLinkContext(
+    const struct link *plink);
+/* The CA client context of link thread index, or NULL if there is none */
+epicsShareFunc struct ca_client_context * dbCaWorkerContext(unsigned index);
+
 #ifdef EPICS_DBCA_PRIVATE_API
 epicsShareFunc void dbCaSync(void);
 epicsShareFunc unsigned long dbCaGetUpdateCount(struct link *plink);
@@ -18,7 +18,9 @@
 
 #include "dbCa.h"
 #include "ellLib.h"
+#include "epicsEvent.h"
 #include "epicsMutex.h"
+#include "epicsThread.h"
 #include "epicsTypes.h"
 #include "link.h"
 
@@ -35,11 +37,32 @@
 #define CA_PUT          0x1
 #define CA_PUT_CALLBACK 0x2
 
+/* One of the dbCaLinkWorkers threads, each with its own CA client
+ * context, servicing the links whose target PV hashes to it.
+ */
+typedef struct dbCaWorker
+{
+    ELLLIST         workList;
+    epicsMutexId    workListLock; /* guards workList, removesOutstanding */
+    epicsEventId    workListEvent; /* wakeup event for the worker */
+    epicsEventId    startStopEvent;
+    epicsThreadId   thread;
+    struct ca_client_context *context;
+    unsigned        index;
+    int             removesOutstanding;
+    /* The following are for dbcar */
+    int             chanCount;
+    size_t          nActions;
+    size_t          nPuts;
+    size_t          nFlushes;
+}dbCaWorker;
+
 typedef struct caLink
 {
     ELLNODE         node;
     int             refcount;
     epicsMutexId    lock;
+    dbCaWorker      *pworker;
     struct link     *plink;
     char            *pvname;
     chid            chid;
@@ -90,10 +113,18 @@ typedef struct caLink
     char            newOutNative;
     char            newOutString;
     unsigned char scanningOnce;
+    /* The following are for LATEST links, which coalesce puts */
+    char            coalesce;
+    unsigned        putGen;     /* counts disconnects */
+    ELLLIST         putTags;    /* puts in flight, see coalescedPut() */
+    short           putPending; /* link_action waiting for putTags */
     /* The following are for dbcar*/
     unsigned long   nDisconnect;
     unsigned long   nNoWrite; /*only modified by dbCaPutLink*/
+    unsigned long   nCoalesced; /*only modified by dbCaPutLink*/
     unsigned long   nUpdate;
 }caLink;
 
+epicsShareFunc void dbCaWorkerReport(int level);
+
 #endif /* INC_dbCaPvt_H */
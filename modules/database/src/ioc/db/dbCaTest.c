@@ -69,6 +69,7 @@ long dbcar(char *precordname, int level)
     int                 noWriteAccess=0;
     unsigned long       nDisconnect=0;
     unsigned long       nNoWrite=0;
+    unsigned long       nCoalesced=0;
     caLink              *pca;
     int                 j;
 
@@ -101,6 +102,7 @@ long dbcar(char *precordname, int level)
                             nconnected++;
                             nDisconnect += pca->nDisconnect;
                             nNoWrite += pca->nNoWrite;
+                            nCoalesced += pca->nCoalesced;
                             if (!ca_read_access(pca->chid)) noReadAccess++;
                             if (!ca_write_access(pca->chid)) noWriteAccess++;
                             if (level>1) {
@@ -117,13 +119,16 @@ long dbcar(char *precordname, int level)
                                     plink->value.pv_link.pvname,
                                     pca->nDisconnect,
                                     pca->nNoWrite);
-                                printf("%21s [%s%s%s%s] host %s, %s\n", "",
+                                printf("%21s [%s%s%s%s] host %s, %s", "",
                                     mask & pvlOptInpNative ? "IN" : "  ",
                                     mask & pvlOptInpString ? "IS" : "  ",
                                     mask & pvlOptOutNative ? "ON" : "  ",
                                     mask & pvlOptOutString ? "OS" : "  ",
                                     ca_host_name(pca->chid),
                                     rights[rw]);
+                                if (pca->coalesce)
+                                    printf(", %lu coalesced", pca->nCoalesced);
+                                printf("\n");
                             }
                         } else {
                             if (level>0) {
@@ -153,13 +158,11 @@ done:
            nconnected, (ncalinks - nconnected));
     printf("    %d can't read, %d can't write.",
            noReadAccess, noWriteAccess);
-    printf("  (%lu disconnects, %lu writes prohibited)\n\n",
-           nDisconnect, nNoWrite);
+    printf("  (%lu disconnects, %lu writes prohibited, %lu coalesced)\n\n",
+           nDisconnect, nNoWrite, nCoalesced);
     dbFinishEntry(pdbentry);
 
-    if ( level > 2  && dbCaClientContext != 0 ) {
-        ca_context_status ( dbCaClientContext, level - 2 );
-    }
+    dbCaWorkerReport(level);
 
     return(0);
 }
@@ -37,6 +37,7 @@
 #include "dbEvent.h"
 #include "dbLock.h"
 #include "dbStaticLib.h"
+#include "dbStaticPvt.h"
 #include "link.h"
 #include "recSup.h"
 #include "special.h"
@@ -346,6 +347,11 @@ long dbChannelTest(const char *name)
     return status;
 }
 
+int dbChannelMayExist(const char *name)
+{
+    return name && *name && pdbbase && dbPvdMayExist(pdbbase, name);
+}
+
 #define TRY(Func, Arg) \
 if (Func) { \
     result = Func Arg; \
@@ -35,15 +35,21 @@ extern "C" {
  */
 typedef struct evSubscrip {
     ELLNODE                 node;
+    ELLNODE                 qnode;  /* on ev_que ready list while npend>0 */
     struct dbChannel        *chan;
     EVENTFUNC               *user_sub;
     void                    *user_arg;
     struct event_que        *ev_que;
-    db_field_log            **pLastLog;
-    unsigned long           npend;  /* n times this event is on the queue */
-    unsigned long           nreplace;  /* n times replacing event on the queue */
+    db_field_log            **valque;  /* ring of queued updates */
+    unsigned long           npend;  /* n updates in valque */
+    unsigned long           nreplace;  /* n updates dropped by replacement */
+    unsigned long           ncoalesce; /* n updates merged with queued one */
+    unsigned short          depth;  /* capacity of valque */
+    unsigned short          maxdepth;  /* valque may grow to this */
+    unsigned short          getix;  /* oldest update in valque */
     unsigned char           select;
     char                    useValque;
+    char                    useSnapshot;
     char                    callBackInProgress;
     char                    enabled;
 } evSubscrip;
@@ -57,6 +63,7 @@ typedef struct dbChannel {
     long  final_no_elements;  /* final number of elements (arrays) */
     short final_field_size;   /* final size of element */
     short final_type;         /* final type of database field */
+    unsigned short queue_depth; /* monitor queue depth, 0 for default */
     ELLLIST filters;          /* list of filters as created from JSON */
     ELLLIST pre_chain;        /* list of filters to be called pre-event-queue */
     ELLLIST post_chain;       /* list of filters to be called post-event-queue */
@@ -152,6 +159,8 @@ struct dbFldDes;
 DBCORE_API void dbChannelInit (void);
 DBCORE_API void dbChannelExit(void);
 DBCORE_API long dbChannelTest(const char *name);
+/* Returns zero if there is certainly no record for name, without locking */
+DBCORE_API int dbChannelMayExist(const char *name);
 DBCORE_API dbChannel * dbChannelCreate(const char *name);
 DBCORE_API long dbChannelOpen(dbChannel *chan);
 
@@ -6,6 +6,7 @@
 #include "dbCommon.h"
 
 struct epicsThreadOSD;
+struct dbProcStats;
 
 /** Base internal additional information for every record
  */
@@ -15,6 +16,9 @@ typedef struct dbCommonPvt {
     /* Thread which is currently processing this record */
     struct epicsThreadOSD* procThread;
 
+    /* Processing time statistics, see dbProcStats.h */
+    struct dbProcStats* procStats;
+
     struct dbCommon common;
 } dbCommonPvt;
 
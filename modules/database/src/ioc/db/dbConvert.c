@@ -19,6 +19,12 @@
 #include <math.h>
 #include <float.h>
 
+#if defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
 #include "cvtFast.h"
 #include "dbDefs.h"
 #include "epicsConvert.h"
@@ -61,22 +67,115 @@ static void copyNoConvert(const void *pfrom,
 #define COPYNOCONVERT(N, FROM, TO, NREQ, NO_ELEM, OFFSET) \
     copyNoConvert(FROM, TO, (N)*(NREQ), (N)*(NO_ELEM), (N)*(OFFSET))
 
+/* Convert a contiguous run of n elements.  The loop body has no
+ * wrap test so the compiler can vectorize it.
+ */
+#define CONVERT(typea, typeb, pdst, psrc, n) \
+do { \
+    long i_; \
+    for (i_ = 0; i_ < (n); i_++) \
+        (pdst)[i_] = (typeb) (psrc)[i_]; \
+} while (0)
+
+/* A circular buffer read or written starting at offset is converted
+ * as at most two contiguous runs, the same split as copyNoConvert().
+ */
+#define WRAPS(NREQ, NO_ELEM, OFFSET) \
+    ((OFFSET) > 0 && (OFFSET) < (NO_ELEM) && (OFFSET) + (NREQ) > (NO_ELEM))
+
+/* Convert a contiguous run of doubles to floats, saturating the same
+ * way as epicsConvertDoubleToFloat().
+ */
+#if defined(__AVX__)
+static void convertDoubleFloat(epicsFloat32 *pdst, const epicsFloat64 *psrc,
+    long n)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d fltMax = _mm256_set1_pd(FLT_MAX);
+    const __m256d fltMin = _mm256_set1_pd(FLT_MIN);
+    const __m256d inf = _mm256_set1_pd(HUGE_VAL);
+    const __m256d zero = _mm256_setzero_pd();
+    long i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m256d val = _mm256_loadu_pd(psrc + i);
+        __m256d sgn = _mm256_and_pd(val, sign);
+        __m256d mag = _mm256_andnot_pd(sign, val);
+        __m256d big = _mm256_and_pd(_mm256_cmp_pd(mag, fltMax, _CMP_GE_OQ),
+            _mm256_cmp_pd(mag, inf, _CMP_LT_OQ));
+        __m256d tiny = _mm256_and_pd(_mm256_cmp_pd(mag, fltMin, _CMP_LE_OQ),
+            _mm256_cmp_pd(mag, zero, _CMP_GT_OQ));
+
+        val = _mm256_blendv_pd(val, _mm256_or_pd(sgn, fltMax), big);
+        val = _mm256_blendv_pd(val, _mm256_or_pd(sgn, fltMin), tiny);
+        _mm_storeu_ps(pdst + i, _mm256_cvtpd_ps(val));
+    }
+    for (; i < n; i++)
+        pdst[i] = epicsConvertDoubleToFloat(psrc[i]);
+}
+#elif defined(__SSE2__)
+static __m128 clampDoubleFloat(__m128d val)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d fltMax = _mm_set1_pd(FLT_MAX);
+    const __m128d fltMin = _mm_set1_pd(FLT_MIN);
+    __m128d sgn = _mm_and_pd(val, sign);
+    __m128d mag = _mm_andnot_pd(sign, val);
+    __m128d big = _mm_and_pd(_mm_cmpge_pd(mag, fltMax),
+        _mm_cmplt_pd(mag, _mm_set1_pd(HUGE_VAL)));
+    __m128d tiny = _mm_and_pd(_mm_cmple_pd(mag, fltMin),
+        _mm_cmpgt_pd(mag, _mm_setzero_pd()));
+
+    val = _mm_or_pd(_mm_andnot_pd(big, val),
+        _mm_and_pd(big, _mm_or_pd(sgn, fltMax)));
+    val = _mm_or_pd(_mm_andnot_pd(tiny, val),
+        _mm_and_pd(tiny, _mm_or_pd(sgn, fltMin)));
+    return _mm_cvtpd_ps(val);
+}
+
+static void convertDoubleFloat(epicsFloat32 *pdst, const epicsFloat64 *psrc,
+    long n)
+{
+    long i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128 lo = clampDoubleFloat(_mm_loadu_pd(psrc + i));
+        __m128 hi = clampDoubleFloat(_mm_loadu_pd(psrc + i + 2));
+
+        _mm_storeu_ps(pdst + i, _mm_movelh_ps(lo, hi));
+    }
+    for (; i < n; i++)
+        pdst[i] = epicsConvertDoubleToFloat(psrc[i]);
+}
+#else
+static void convertDoubleFloat(epicsFloat32 *pdst, const epicsFloat64 *psrc,
+    long n)
+{
+    long i;
+
+    for (i = 0; i < n; i++)
+        pdst[i] = epicsConvertDoubleToFloat(psrc[i]);
+}
+#endif
+
 #define GET(typea, typeb) (const dbAddr *paddr, \
     void *pto, long nRequest, long no_elements, long offset) \
 { \
-    typea *psrc = (typea *) paddr->pfield; \
+    const typea *psrc = (const typea *) paddr->pfield; \
     typeb *pdst = (typeb *) pto; \
     \
     if (nRequest==1 && offset==0) { \
         *pdst = (typeb) *psrc; \
         return 0; \
     } \
-    psrc += offset; \
-    while (nRequest--) { \
-        *pdst++ = (typeb) *psrc++; \
-        if (++offset == no_elements) \
-            psrc = (typea *) paddr->pfield; \
+    if (WRAPS(nRequest, no_elements, offset)) { \
+        const long N = no_elements - offset; \
+        \
+        CONVERT(typea, typeb, pdst, psrc + offset, N); \
+        CONVERT(typea, typeb, pdst + N, psrc, nRequest - N); \
     } \
+    else \
+        CONVERT(typea, typeb, pdst, psrc + offset, nRequest); \
     return 0; \
 }
 
@@ -104,12 +203,14 @@ static void copyNoConvert(const void *pfrom,
         *pdst = (typeb) *psrc; \
         return 0; \
     } \
-    pdst += offset; \
-    while (nRequest--) { \
-        *pdst++ = (typeb) *psrc++; \
-        if (++offset == no_elements) \
-            pdst = (typeb *) paddr->pfield; \
+    if (WRAPS(nRequest, no_elements, offset)) { \
+        const long N = no_elements - offset; \
+        \
+        CONVERT(typea, typeb, pdst + offset, psrc, N); \
+        CONVERT(typea, typeb, pdst, psrc + N, nRequest - N); \
     } \
+    else \
+        CONVERT(typea, typeb, pdst + offset, psrc, nRequest); \
     return 0; \
 }
 
@@ -818,13 +919,14 @@ static long getDoubleFloat(const dbAddr *paddr,
         *pdst = epicsConvertDoubleToFloat(*psrc);
         return 0;
     }
-    psrc += offset;
-    while (nRequest--) {
-        *pdst = epicsConvertDoubleToFloat(*psrc);
-        ++psrc; ++pdst;
-        if (++offset == no_elements)
-            psrc = (epicsFloat64 *) paddr->pfield;
+    if (WRAPS(nRequest, no_elements, offset)) {
+        const long N = no_elements - offset;
+
+        convertDoubleFloat(pdst, psrc + offset, N);
+        convertDoubleFloat(pdst + N, psrc, nRequest - N);
     }
+    else
+        convertDoubleFloat(pdst, psrc + offset, nRequest);
     return 0;
 }
 
@@ -1647,12 +1749,14 @@ static long putDoubleFloat(dbAddr *paddr,
         *pdst = epicsConvertDoubleToFloat(*psrc);
         return 0;
     }
-    pdst += offset;
-    while (nRequest--) {
-        *pdst++ = epicsConvertDoubleToFloat(*psrc++);
-        if (++offset == no_elements)
-            pdst = (epicsFloat32 *) paddr->pfield;
+    if (WRAPS(nRequest, no_elements, offset)) {
+        const long N = no_elements - offset;
+
+        convertDoubleFloat(pdst + offset, psrc, N);
+        convertDoubleFloat(pdst, psrc + N, nRequest - N);
     }
+    else
+        convertDoubleFloat(pdst + offset, psrc, nRequest);
     return 0;
 }
 
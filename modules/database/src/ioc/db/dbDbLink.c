@@ -47,6 +47,8 @@
 #include "cvtFast.h"
 #include "dbDefs.h"
 #include "ellLib.h"
+#include "epicsMutex.h"
+#include "epicsThread.h"
 #include "epicsTime.h"
 #include "errlog.h"
 
@@ -86,6 +88,15 @@ static long processTarget(dbCommon *psrc, dbCommon *pdst);
 
 #define linkChannel(plink) ((dbChannel *) (plink)->value.pv_link.pvt)
 
+/* A parallel iocInit may resolve links into the same records at once */
+static epicsThreadOnceId initLinkOnce = EPICS_THREAD_ONCE_INIT;
+static epicsMutexId initLinkLock;
+
+static void initLinkLockCreate(void *junk)
+{
+    initLinkLock = epicsMutexMustCreate();
+}
+
 long dbDbInitLink(struct link *plink, short dbfType)
 {
     long status;
@@ -104,12 +115,15 @@ long dbDbInitLink(struct link *plink, short dbfType)
     plink->lset = &dbDb_lset;
     plink->type = DB_LINK;
     plink->value.pv_link.pvt = chan;
+    epicsThreadOnce(&initLinkOnce, initLinkLockCreate, NULL);
+    epicsMutexMustLock(initLinkLock);
     ellAdd(&precord->bklnk, &plink->value.pv_link.backlinknode);
     /* merging into the same lockset is deferred to the caller.
      * cf. initPVLinks()
      */
     dbLockSetMerge(NULL, plink->precord, precord);
     assert(plink->precord->lset->plockSet == precord->lset->plockSet);
+    epicsMutexUnlock(initLinkLock);
     return 0;
 }
 
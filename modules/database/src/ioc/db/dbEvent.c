@@ -28,6 +28,7 @@
 #include "cantProceed.h"
 #include "dbDefs.h"
 #include "epicsAssert.h"
+#include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsThread.h"
@@ -47,40 +48,31 @@
 #include "db_field_log.h"
 #include "dbFldTypes.h"
 #include "dbLock.h"
+#include "epicsExport.h"
 #include "link.h"
 #include "special.h"
 
-/* Queue size based on Ethernet MTU of 1500 bytes.
- * Assume <=66 bytes of ethernet+IP+TCP overhead
- * and 40 byte CA messages (DBF_TIME_DOUBLE).
- *
- * (1500-66)/40 -> 35
- */
-#define EVENTSPERQUE    36
-#define EVENTENTRIES    4      /* the number of que entries for each event */
-#define EVENTQUESIZE    (EVENTENTRIES  * EVENTSPERQUE)
-#define EVENTQEMPTY     ((struct evSubscrip *)NULL)
-
 /*
- * really a ring buffer
+ * Each subscription queues its updates in its own ring of field logs
+ * (evSubscrip::valque), so adding an update is O(1) and never depends
+ * on what other subscriptions have pending.  Subscriptions with updates
+ * waiting are kept in FIFO order on the ready list, and the event task
+ * delivers one update from each in turn.
  */
 struct event_que {
-    /* lock writers to the ring buffer only */
+    /* lock writers to the ready list and subscription rings */
     /* readers must never slow up writers */
     epicsMutexId            writelock;
-    db_field_log            *valque[EVENTQUESIZE];
-    struct evSubscrip       *evque[EVENTQUESIZE];
-    struct event_que        *nextque;       /* in case que quota exceeded */
+    ELLLIST                 ready;          /* evSubscrip::qnode */
     struct event_user       *evUser;        /* event user parent struct */
-    unsigned short          putix;
-    unsigned short          getix;
-    unsigned short          quota;          /* the number of assigned entries*/
-    unsigned short          nDuplicates;    /* N events duplicated on this q */
-    unsigned short          nCanceled;      /* the number of canceled entries */
+    unsigned long           nDuplicates;    /* N updates queued behind
+                                             * another for the same event */
+    unsigned                nGrown;         /* ring entries held beyond the
+                                             * default depth */
 };
 
 struct event_user {
-    struct event_que    firstque;       /* the first event que */
+    struct event_que    evque;          /* the event que */
 
     epicsMutexId        lock;
     epicsEventId        ppendsem;       /* Wait while empty */
@@ -90,6 +82,9 @@ struct event_user {
     void                *extralabor_arg;/* parameter to above */
 
     epicsThreadId       taskid;         /* event handler task id */
+    EVENTDISPATCHFUNC   *dispatch;      /* schedules db_event_run() */
+    void                *dispatch_arg;  /* instead of an event task */
+    epicsThreadId       runner;         /* thread in db_event_run() */
     struct evSubscrip   *pSuicideEvent; /* event that is deleteing itself */
     unsigned            queovr;         /* event que overflow count */
     unsigned char       pendexit;       /* exit pend task */
@@ -106,8 +101,14 @@ struct event_user {
  * into only 10 or 20 total steps part of the time.
  */
 
-#define RNGINC(OLD)\
-( (unsigned short) ( (OLD) >= (EVENTQUESIZE-1) ? 0 : (OLD)+1 ) )
+/*
+ * Rings are allocated from free lists, one for each of the depths a
+ * default subscription's ring can grow through (DB_EVENT_QUEUE_DEFAULT
+ * doubled, the last being DB_EVENT_QUEUE_BURST), so that growing a ring
+ * while holding the event queue lock doesn't call the heap allocator.
+ * Other depths set with the "q" filter come from the heap.
+ */
+#define NRINGSIZES 7
 
 #define LOCKEVQUE(EV_QUE)   epicsMutexMustLock((EV_QUE)->writelock)
 #define UNLOCKEVQUE(EV_QUE) epicsMutexUnlock((EV_QUE)->writelock)
@@ -115,25 +116,160 @@ struct event_user {
 #define UNLOCKREC(RECPTR)   epicsMutexUnlock((RECPTR)->mlok)
 
 static void *dbevEventUserFreeList;
-static void *dbevEventQueueFreeList;
+static void *dbevEventRingFreeList[NRINGSIZES];
 static void *dbevEventSubscriptionFreeList;
 static void *dbevFieldLogFreeList;
 
 static char *EVENT_PEND_NAME = "eventTask";
 
-static struct evSubscrip canceledEvent;
+static void event_user_free (struct event_user *evUser);
+
+/*
+ * Tell the event task, or the dispatcher which runs its work instead,
+ * that there is something to do
+ */
+static void event_wake (struct event_user *evUser)
+{
+    if (evUser->dispatch)
+        (*evUser->dispatch)(evUser->dispatch_arg);
+    else
+        epicsEventSignal(evUser->ppendsem);
+}
+
+/* Queue copies of array fields for new subscriptions */
+int dbEventArraySnapshots = 0;
+epicsExportAddress(int, dbEventArraySnapshots);
+
+/*
+ * Immutable copy of an array field, shared by the field logs of all
+ * subscriptions to that field that were posted together.  It is freed
+ * when the last of those field logs is deleted.
+ */
+typedef struct dbflSnapshot {
+    int                 refcount;       /* use atomic */
+    const void          *pfield;        /* field this is a copy of */
+    short               field_type;
+    long                no_elements;
+    epicsFloat64        data[1];        /* actually arbitrary size and type */
+} dbflSnapshot;
+
+/*
+ * Index of the n'th update in the subscription's ring, n < depth
+ */
+static unsigned ringIndex ( const struct evSubscrip *pevent, unsigned long n )
+{
+    unsigned long index = pevent->getix + n;
 
-static unsigned short ringSpace ( const struct event_que *pevq )
+    if ( index >= pevent->depth ) {
+        index -= pevent->depth;
+    }
+    return (unsigned) index;
+}
+
+/*
+ * Depth of the rings on the k'th ring free list
+ */
+static unsigned ringSize ( unsigned k )
 {
-    if ( pevq->evque[pevq->putix] == EVENTQEMPTY ) {
-        if ( pevq->getix > pevq->putix ) {
-            return ( unsigned short ) ( pevq->getix - pevq->putix );
+    unsigned depth = DB_EVENT_QUEUE_DEFAULT << k;
+
+    return depth < DB_EVENT_QUEUE_BURST ? depth : DB_EVENT_QUEUE_BURST;
+}
+
+static db_field_log ** ringAlloc ( unsigned depth )
+{
+    unsigned k;
+
+    for ( k = 0u; k < NRINGSIZES; k++ ) {
+        if ( ringSize ( k ) == depth ) {
+            return freeListCalloc ( dbevEventRingFreeList[k] );
         }
-        else {
-            return ( unsigned short ) ( ( EVENTQUESIZE + pevq->getix ) - pevq->putix );
+    }
+    return calloc ( depth, sizeof(db_field_log *) );
+}
+
+static void ringFree ( db_field_log **valque, unsigned depth )
+{
+    unsigned k;
+
+    for ( k = 0u; k < NRINGSIZES; k++ ) {
+        if ( ringSize ( k ) == depth ) {
+            freeListFree ( dbevEventRingFreeList[k], valque );
+            return;
         }
     }
-    return 0;
+    free ( valque );
+}
+
+/*
+ * Number of entries a default subscription's ring has grown by
+ */
+static unsigned ringGrown ( const struct evSubscrip *pevent )
+{
+    if ( pevent->chan->queue_depth != 0u ) {
+        return 0u;
+    }
+    return pevent->depth - DB_EVENT_QUEUE_DEFAULT;
+}
+
+/*
+ * Double the capacity of a subscription's ring, up to its maxdepth.
+ * All the rings of one event user together may only grow by
+ * DB_EVENT_QUEUE_BURST entries.  The event queue lock must be applied.
+ * Returns zero if it can't grow.
+ */
+static int ringGrow ( struct evSubscrip *pevent )
+{
+    struct event_que * const ev_que = pevent->ev_que;
+    unsigned depth = pevent->depth * 2u;
+    db_field_log **valque;
+    unsigned long i;
+
+    if ( pevent->depth >= pevent->maxdepth ) {
+        return 0;
+    }
+    if ( depth > pevent->maxdepth ) {
+        depth = pevent->maxdepth;
+    }
+    if ( ev_que->nGrown + depth - pevent->depth > DB_EVENT_QUEUE_BURST ) {
+        return 0;
+    }
+    valque = ringAlloc ( depth );
+    if ( ! valque ) {
+        return 0;
+    }
+    for ( i = 0u; i < pevent->npend; i++ ) {
+        valque[i] = pevent->valque[ringIndex(pevent, i)];
+    }
+    ringFree ( pevent->valque, pevent->depth );
+    ev_que->nGrown += depth - pevent->depth;
+    pevent->valque = valque;
+    pevent->depth = (unsigned short) depth;
+    pevent->getix = 0u;
+    return 1;
+}
+
+/*
+ * Return a grown ring to the default depth once it has been drained.
+ * The event queue lock must be applied.
+ */
+static void ringShrink ( struct evSubscrip *pevent )
+{
+    unsigned grown = ringGrown ( pevent );
+    db_field_log **valque;
+
+    if ( grown == 0u || pevent->npend > 0u ) {
+        return;
+    }
+    valque = ringAlloc ( DB_EVENT_QUEUE_DEFAULT );
+    if ( ! valque ) {
+        return;
+    }
+    ringFree ( pevent->valque, pevent->depth );
+    pevent->ev_que->nGrown -= grown;
+    pevent->valque = valque;
+    pevent->depth = DB_EVENT_QUEUE_DEFAULT;
+    pevent->getix = 0u;
 }
 
 /*
@@ -192,44 +328,48 @@ int dbel ( const char *pname, unsigned level )
             }
 
             if ( level > 1 ) {
-                unsigned nEntriesFree;
+                unsigned long nPending, nReplaced, nCoalesced;
                 const void * taskId;
                 LOCKEVQUE(pevent->ev_que);
-                nEntriesFree = ringSpace ( pevent->ev_que );
+                nPending = pevent->npend;
+                nReplaced = pevent->nreplace;
+                nCoalesced = pevent->ncoalesce;
                 taskId = ( void * ) pevent->ev_que->evUser->taskid;
                 UNLOCKEVQUE(pevent->ev_que);
-                if ( nEntriesFree == 0u ) {
+                if ( nPending == pevent->depth ) {
                     printf ( ", thread=%p, queue full",
                         (void *) taskId );
                 }
-                else if ( nEntriesFree == EVENTQUESIZE ) {
+                else if ( nPending == 0u ) {
                     printf ( ", thread=%p, queue empty",
                         (void *) taskId );
                 }
                 else {
-                    printf ( ", thread=%p, unused entries=%u",
-                        (void *) taskId, nEntriesFree );
+                    printf ( ", thread=%p, unused entries=%lu",
+                        (void *) taskId, pevent->depth - nPending );
+                }
+                printf ( ", depth=%u", pevent->depth );
+                if ( pevent->maxdepth > pevent->depth ) {
+                    printf ( " (max %u)", pevent->maxdepth );
+                }
+                if ( nReplaced ) {
+                    printf ( ", dropped=%lu", nReplaced );
+                }
+                if ( nCoalesced ) {
+                    printf ( ", coalesced=%lu", nCoalesced );
                 }
             }
 
             if ( level > 2 ) {
-                unsigned nDuplicates;
-                unsigned nCanceled;
-                if ( pevent->nreplace ) {
-                    printf (", discarded by replacement=%ld", pevent->nreplace);
-                }
+                unsigned long nDuplicates;
                 if ( ! pevent->useValque ) {
                     printf (", queueing disabled" );
                 }
                 LOCKEVQUE(pevent->ev_que);
                 nDuplicates = pevent->ev_que->nDuplicates;
-                nCanceled = pevent->ev_que->nCanceled;
                 UNLOCKEVQUE(pevent->ev_que);
                 if  ( nDuplicates ) {
-                    printf (", duplicate count =%u\n", nDuplicates );
-                }
-                if ( nCanceled ) {
-                    printf (", canceled count =%u\n", nCanceled );
+                    printf (", duplicate count =%lu", nDuplicates );
                 }
             }
 
@@ -261,13 +401,17 @@ int dbel ( const char *pname, unsigned level )
  */
 void db_init_event_freelists (void)
 {
+    unsigned k;
+
     if (!dbevEventUserFreeList) {
         freeListInitPvt(&dbevEventUserFreeList,
             sizeof(struct event_user),8);
     }
-    if (!dbevEventQueueFreeList) {
-        freeListInitPvt(&dbevEventQueueFreeList,
-            sizeof(struct event_que),8);
+    for (k = 0; k < NRINGSIZES; k++) {
+        if (!dbevEventRingFreeList[k]) {
+            freeListInitPvt(&dbevEventRingFreeList[k],
+                ringSize(k) * sizeof(db_field_log *), k ? 16 : 256);
+        }
     }
     if (!dbevEventSubscriptionFreeList) {
         freeListInitPvt(&dbevEventSubscriptionFreeList,
@@ -300,9 +444,10 @@ dbEventCtx db_init_events (void)
         return NULL;
     }
 
-    evUser->firstque.evUser = evUser;
-    evUser->firstque.writelock = epicsMutexCreate();
-    if (!evUser->firstque.writelock)
+    evUser->evque.evUser = evUser;
+    ellInit(&evUser->evque.ready);
+    evUser->evque.writelock = epicsMutexCreate();
+    if (!evUser->evque.writelock)
         goto fail;
 
     evUser->ppendsem = epicsEventCreate(epicsEventEmpty);
@@ -322,8 +467,8 @@ dbEventCtx db_init_events (void)
 fail:
     if(evUser->lock)
         epicsMutexDestroy (evUser->lock);
-    if(evUser->firstque.writelock)
-        epicsMutexDestroy (evUser->firstque.writelock);
+    if(evUser->evque.writelock)
+        epicsMutexDestroy (evUser->evque.writelock);
     if(evUser->ppendsem)
         epicsEventDestroy (evUser->ppendsem);
     if(evUser->pflush_sem)
@@ -335,11 +480,15 @@ fail:
 
 epicsShareFunc void db_cleanup_events(void)
 {
+    unsigned k;
+
     if(dbevEventUserFreeList) freeListCleanup(dbevEventUserFreeList);
     dbevEventUserFreeList = NULL;
 
-    if(dbevEventQueueFreeList) freeListCleanup(dbevEventQueueFreeList);
-    dbevEventQueueFreeList = NULL;
+    for(k = 0; k < NRINGSIZES; k++) {
+        if(dbevEventRingFreeList[k]) freeListCleanup(dbevEventRingFreeList[k]);
+        dbevEventRingFreeList[k] = NULL;
+    }
 
     if(dbevEventSubscriptionFreeList) freeListCleanup(dbevEventSubscriptionFreeList);
     dbevEventSubscriptionFreeList = NULL;
@@ -372,6 +521,12 @@ void db_close_events (dbEventCtx ctx)
     evUser->pendexit = TRUE;
     epicsMutexUnlock ( evUser->lock );
 
+    if (evUser->dispatch) {
+        /* the dispatcher no longer calls db_event_run() */
+        event_user_free(evUser);
+        return;
+    }
+
     /* notify the waiting task */
     epicsEventSignal(evUser->ppendsem);
 
@@ -380,25 +535,6 @@ void db_close_events (dbEventCtx ctx)
     /* evUser has been deleted by the worker */
 }
 
-/*
- * create_ev_que()
- */
-static struct event_que * create_ev_que ( struct event_user * const evUser )
-{
-    struct event_que * const ev_que = (struct event_que *)
-        freeListCalloc ( dbevEventQueueFreeList );
-    if ( ! ev_que ) {
-        return NULL;
-    }
-    ev_que->writelock = epicsMutexCreate();
-    if ( ! ev_que->writelock ) {
-        freeListFree ( dbevEventQueueFreeList, ev_que );
-        return NULL;
-    }
-    ev_que->evUser = evUser;
-    return ev_que;
-}
-
 /*
  * DB_ADD_EVENT()
  */
@@ -407,8 +543,9 @@ dbEventSubscription db_add_event (
     EVENTFUNC *user_sub, void *user_arg, unsigned select)
 {
     struct event_user * const evUser = (struct event_user *) ctx;
-    struct event_que * ev_que;
     struct evSubscrip * pevent;
+    unsigned depth = chan->queue_depth;
+    unsigned maxdepth = depth;
 
     /*
      * Don't add events which will not be triggered
@@ -422,48 +559,32 @@ dbEventSubscription db_add_event (
         return NULL;
     }
 
-    /* find an event que block with enough quota */
-    /* otherwise add a new one to the list */
-    epicsMutexMustLock ( evUser->lock );
-    ev_que = & evUser->firstque;
-    while ( TRUE ) {
-        int success = 0;
-        LOCKEVQUE ( ev_que );
-        success = ( ev_que->quota + ev_que->nCanceled <
-                                EVENTQUESIZE - EVENTENTRIES );
-        if ( success ) {
-            ev_que->quota += EVENTENTRIES;
-        }
-        UNLOCKEVQUE ( ev_que );
-        if ( success ) {
-            break;
-        }
-        if ( ! ev_que->nextque ) {
-            ev_que->nextque = create_ev_que ( evUser );
-            if ( ! ev_que->nextque ) {
-                ev_que = NULL;
-                break;
-            }
-        }
-        ev_que = ev_que->nextque;
+    if ( depth == 0u ) {
+        depth = DB_EVENT_QUEUE_DEFAULT;
+        maxdepth = DB_EVENT_QUEUE_BURST;
     }
-    epicsMutexUnlock ( evUser->lock );
-
-    if ( ! ev_que ) {
+    else if ( depth > DB_EVENT_QUEUE_MAX ) {
+        depth = maxdepth = DB_EVENT_QUEUE_MAX;
+    }
+    pevent->valque = ringAlloc ( depth );
+    if ( ! pevent->valque ) {
         freeListFree ( dbevEventSubscriptionFreeList, pevent );
         return NULL;
     }
 
+    pevent->depth =     (unsigned short) depth;
+    pevent->maxdepth =  (unsigned short) maxdepth;
+    pevent->getix =     0u;
     pevent->npend =     0ul;
     pevent->nreplace =  0ul;
+    pevent->ncoalesce = 0ul;
     pevent->user_sub =  user_sub;
     pevent->user_arg =  user_arg;
     pevent->chan =      chan;
     pevent->select =    (unsigned char) select;
-    pevent->pLastLog =  NULL; /* not yet in the queue */
     pevent->callBackInProgress = FALSE;
     pevent->enabled =   FALSE;
-    pevent->ev_que =    ev_que;
+    pevent->ev_que =    &evUser->evque;
 
     /*
      * Simple types values queued up for reliable interprocess
@@ -479,6 +600,15 @@ dbEventSubscription db_add_event (
         pevent->useValque = FALSE;
     }
 
+    /*
+     * Arrays may be copied too if requested, the copy being shared
+     * between all subscriptions to the field
+     */
+    pevent->useSnapshot = !pevent->useValque && dbEventArraySnapshots &&
+        dbChannelFieldType(chan) <= DBF_ENUM &&
+        (dbChannelElements(chan) > 1 ||
+         dbChannelSpecial(chan) == SPC_DBADDR);
+
     return pevent;
 }
 
@@ -517,24 +647,22 @@ void db_event_disable (dbEventSubscription event)
 /*
  * event_remove()
  * event queue lock _must_ be applied
- * this nulls the entry in the queue, but doesn't delete the db_field_log chunk
+ * this takes the oldest update off the subscription's ring and returns
+ * it, the caller must delete the db_field_log chunk
  */
-static void event_remove ( struct event_que *ev_que,
-    unsigned short index, struct evSubscrip *placeHolder )
+static db_field_log * event_remove ( struct event_que *ev_que,
+    struct evSubscrip *pevent )
 {
-    struct evSubscrip * const pevent = ev_que->evque[index];
+    db_field_log * const pLog = pevent->valque[pevent->getix];
 
-    ev_que->evque[index] = placeHolder;
-    ev_que->valque[index] = NULL;
-    if ( pevent->npend == 1u ) {
-        pevent->pLastLog = NULL;
-    }
-    else {
-        assert ( pevent->npend > 1u );
+    assert ( pevent->npend > 0u );
+    pevent->valque[pevent->getix] = NULL;
+    pevent->getix = (unsigned short) ringIndex ( pevent, 1u );
+    if ( --pevent->npend > 0u ) {
         assert ( ev_que->nDuplicates >= 1u );
         ev_que->nDuplicates--;
     }
-    pevent->npend--;
+    return pLog;
 }
 
 /*
@@ -547,7 +675,6 @@ static void event_remove ( struct event_que *ev_que,
 void db_cancel_event (dbEventSubscription event)
 {
     struct evSubscrip * const pevent = (struct evSubscrip *) event;
-    unsigned short getix;
 
     db_event_disable ( event );
 
@@ -571,21 +698,16 @@ void db_cancel_event (dbEventSubscription event)
      * here will block CA's TCP input queue then a dead lock
      * would be possible.
      */
-    for (   getix = pevent->ev_que->getix;
-            pevent->ev_que->evque[getix] != EVENTQEMPTY; ) {
-        if ( pevent->ev_que->evque[getix] == pevent ) {
-            assert ( pevent->ev_que->nCanceled < USHRT_MAX );
-            pevent->ev_que->nCanceled++;
-            event_remove ( pevent->ev_que, getix, &canceledEvent );
-        }
-        getix = RNGINC ( getix );
-        if ( getix == pevent->ev_que->getix ) {
-            break;
+    if ( pevent->npend > 0u ) {
+        ellDelete ( &pevent->ev_que->ready, &pevent->qnode );
+        while ( pevent->npend > 0u ) {
+            db_delete_field_log ( event_remove ( pevent->ev_que, pevent ) );
         }
     }
-    assert ( pevent->npend == 0u );
+    pevent->ev_que->nGrown -= ringGrown ( pevent );
 
-    if ( pevent->ev_que->evUser->taskid == epicsThreadGetIdSelf() ) {
+    if ( pevent->ev_que->evUser->taskid == epicsThreadGetIdSelf() ||
+            pevent->ev_que->evUser->runner == epicsThreadGetIdSelf() ) {
         pevent->ev_que->evUser->pSuicideEvent = pevent;
     }
     else {
@@ -596,10 +718,9 @@ void db_cancel_event (dbEventSubscription event)
         }
     }
 
-    pevent->ev_que->quota -= EVENTENTRIES;
-
     UNLOCKEVQUE (pevent->ev_que);
 
+    ringFree ( pevent->valque, pevent->depth );
     freeListFree ( dbevEventSubscriptionFreeList, pevent );
 
     return;
@@ -662,27 +783,88 @@ int db_post_extra_labor (dbEventCtx ctx)
     epicsMutexUnlock ( evUser->lock );
 
     if ( doit ) {
-        epicsEventSignal(evUser->ppendsem);
+        event_wake(evUser);
     }
 
     return DB_EVENT_OK;
 }
 
 /*
- *  DB_CREATE_EVENT_LOG()
+ *  SNAPSHOT_CREATE()
  *
  *  NOTE: This assumes that the db scan lock is already applied
- *        (as it copies data from the record)
  */
-db_field_log* db_create_event_log (struct evSubscrip *pevent)
+static dbflSnapshot* snapshot_create (struct dbChannel *chan)
+{
+    long no_elements = dbChannelElements(chan);
+    dbflSnapshot *psnap = malloc(offsetof(dbflSnapshot, data) +
+        no_elements * dbChannelFieldSize(chan));
+
+    if (!psnap)
+        return NULL;
+
+    psnap->refcount = 1;
+    psnap->pfield = dbChannelField(chan);
+    psnap->field_type = dbChannelFieldType(chan);
+
+    /* DBR and DBF type codes are the same up to DBF_ENUM */
+    if (dbGet(&chan->addr, dbChannelFieldType(chan), psnap->data,
+            NULL, &no_elements, NULL)) {
+        free(psnap);
+        return NULL;
+    }
+    psnap->no_elements = no_elements;
+    return psnap;
+}
+
+static void snapshot_release (dbflSnapshot *psnap)
+{
+    if (psnap && !epicsAtomicDecrIntT(&psnap->refcount))
+        free(psnap);
+}
+
+static void snapshot_dtor (db_field_log *pfl)
+{
+    snapshot_release((dbflSnapshot *) pfl->u.r.pvt);
+}
+
+/*
+ *  CREATE_EVENT_LOG()
+ *
+ *  The snapshot cache *ppsnap holds the last array snapshot made, which
+ *  is shared with this log if it is a copy of the same field.
+ */
+static db_field_log* create_event_log (struct evSubscrip *pevent,
+    dbflSnapshot **ppsnap)
 {
     db_field_log *pLog = (db_field_log *) freeListCalloc(dbevFieldLogFreeList);
 
     if (pLog) {
         struct dbChannel *chan = pevent->chan;
         struct dbCommon  *prec = dbChannelRecord(chan);
+        dbflSnapshot *psnap = *ppsnap;
+
         pLog->ctx = dbfl_context_event;
-        if (pevent->useValque) {
+        if (pevent->useSnapshot &&
+            (!psnap || psnap->pfield != dbChannelField(chan) ||
+             psnap->field_type != dbChannelFieldType(chan))) {
+            snapshot_release(psnap);
+            psnap = *ppsnap = snapshot_create(chan);
+        }
+        if (pevent->useSnapshot && psnap) {
+            epicsAtomicIncrIntT(&psnap->refcount);
+            pLog->type = dbfl_type_ref;
+            pLog->stat = prec->stat;
+            pLog->sevr = prec->sevr;
+            pLog->time = prec->time;
+            pLog->field_type  = dbChannelFieldType(chan);
+            pLog->field_size  = dbChannelFieldSize(chan);
+            pLog->no_elements = psnap->no_elements;
+            pLog->u.r.dtor  = snapshot_dtor;
+            pLog->u.r.pvt   = psnap;
+            pLog->u.r.field = psnap->data;
+        }
+        else if (pevent->useValque) {
             pLog->type = dbfl_type_val;
             pLog->stat = prec->stat;
             pLog->sevr = prec->sevr;
@@ -704,6 +886,21 @@ db_field_log* db_create_event_log (struct evSubscrip *pevent)
     return pLog;
 }
 
+/*
+ *  DB_CREATE_EVENT_LOG()
+ *
+ *  NOTE: This assumes that the db scan lock is already applied
+ *        (as it copies data from the record)
+ */
+db_field_log* db_create_event_log (struct evSubscrip *pevent)
+{
+    dbflSnapshot *psnap = NULL;
+    db_field_log *pLog = create_event_log(pevent, &psnap);
+
+    snapshot_release(psnap);
+    return pLog;
+}
+
 /*
  *  DB_CREATE_READ_LOG()
  *
@@ -726,8 +923,7 @@ db_field_log* db_create_read_log (struct dbChannel *chan)
 static void db_queue_event_log (evSubscrip *pevent, db_field_log *pLog)
 {
     struct event_que    *ev_que;
-    int firstEventFlag;
-    unsigned rngSpace;
+    int firstEventFlag = 0;
 
     ev_que = pevent->ev_que;
     /*
@@ -737,70 +933,45 @@ static void db_queue_event_log (evSubscrip *pevent, db_field_log *pLog)
 
     LOCKEVQUE (ev_que);
 
-    /*
-     * if we have an event on the queue and both the last
-     * event on the queue and the current event are emtpy
-     * (i.e. of type dbfl_type_rec), simply ignore duplicate
-     * events (saving empty events serves no purpose)
-     */
-    if (pevent->npend > 0u &&
-        (*pevent->pLastLog)->type == dbfl_type_rec &&
-        pLog->type == dbfl_type_rec) {
-        db_delete_field_log(pLog);
-        UNLOCKEVQUE (ev_que);
-        return;
-    }
+    if (pevent->npend > 0u) {
+        db_field_log **pLastLog =
+            &pevent->valque[ringIndex(pevent, pevent->npend - 1u)];
 
-    /*
-     * add to task local event que
-     */
-
-    /*
-     * if an event is on the queue and one of
-     * {flowCtrlMode, not room for one more of each monitor attached}
-     * then replace the last event on the queue (for this monitor)
-     */
-    rngSpace = ringSpace ( ev_que );
-    if ( pevent->npend>0u &&
-        (ev_que->evUser->flowCtrlMode || rngSpace<=EVENTSPERQUE) ) {
         /*
-         * replace last event if no space is left
+         * if both the last event on the queue and the current event
+         * are emtpy (i.e. of type dbfl_type_rec), simply merge the
+         * duplicate (saving empty events serves no purpose)
          */
-        if (*pevent->pLastLog) {
-            db_delete_field_log(*pevent->pLastLog);
-            *pevent->pLastLog = pLog;
+        if ((*pLastLog)->type == dbfl_type_rec &&
+            pLog->type == dbfl_type_rec) {
+            db_delete_field_log(pLog);
+            pevent->ncoalesce++;
         }
-        pevent->nreplace++;
         /*
-         * the event task has already been notified about
-         * this so we dont need to post the semaphore
+         * if one of {flowCtrlMode, no room left in this monitor's ring}
+         * then replace the last event on the queue (for this monitor).
+         * The event task has already been notified about it.
          */
-        firstEventFlag = 0;
-    }
-    /*
-     * Otherwise, the current entry must be available.
-     * Fill it in and advance the ring buffer.
-     */
-    else {
-        assert ( ev_que->evque[ev_que->putix] == EVENTQEMPTY );
-        ev_que->evque[ev_que->putix] = pevent;
-        ev_que->valque[ev_que->putix] = pLog;
-        pevent->pLastLog = &ev_que->valque[ev_que->putix];
-        if (pevent->npend>0u) {
+        else if (ev_que->evUser->flowCtrlMode ||
+                 (pevent->npend >= pevent->depth && !ringGrow(pevent))) {
+            db_delete_field_log(*pLastLog);
+            *pLastLog = pLog;
+            pevent->nreplace++;
+        }
+        else {
+            pevent->valque[ringIndex(pevent, pevent->npend)] = pLog;
+            pevent->npend++;
             ev_que->nDuplicates++;
         }
-        pevent->npend++;
+    }
+    else {
+        pevent->valque[pevent->getix] = pLog;
+        pevent->npend = 1u;
         /*
-         * if the ring buffer was empty before
-         * adding this event
+         * notify the event handler if no other events were ready
          */
-        if (rngSpace==EVENTQUESIZE) {
-            firstEventFlag = 1;
-        }
-        else {
-            firstEventFlag = 0;
-        }
-        ev_que->putix = RNGINC ( ev_que->putix );
+        firstEventFlag = ellCount(&ev_que->ready) == 0;
+        ellAdd(&ev_que->ready, &pevent->qnode);
     }
 
     UNLOCKEVQUE (ev_que);
@@ -815,7 +986,7 @@ static void db_queue_event_log (evSubscrip *pevent, db_field_log *pLog)
         /*
          * notify the event handler
          */
-        epicsEventSignal(ev_que->evUser->ppendsem);
+        event_wake(ev_que->evUser);
     }
 }
 
@@ -833,6 +1004,7 @@ unsigned int    caEventMask
 {
     struct dbCommon   * const prec = (struct dbCommon *) pRecord;
     struct evSubscrip *pevent;
+    dbflSnapshot *psnap = NULL;
 
     if (prec->mlis.count == 0) return DB_EVENT_OK;       /* no monitors set */
 
@@ -847,13 +1019,14 @@ unsigned int    caEventMask
          */
         if ( (dbChannelField(pevent->chan) == (void *)pField || pField==NULL) &&
             (caEventMask & pevent->select)) {
-            db_field_log *pLog = db_create_event_log(pevent);
+            db_field_log *pLog = create_event_log(pevent, &psnap);
             pLog = dbChannelRunPreChain(pevent->chan, pLog);
             if (pLog) db_queue_event_log(pevent, pLog);
         }
     }
 
     UNLOCKREC (prec);
+    snapshot_release(psnap);
     return DB_EVENT_OK;
 
 }
@@ -901,30 +1074,26 @@ static int event_read ( struct event_que *ev_que )
         return DB_EVENT_OK;
     }
 
-    while ( ev_que->evque[ev_que->getix] != EVENTQEMPTY ) {
-        struct evSubscrip *pevent = ev_que->evque[ev_que->getix];
-
-        pfl = ev_que->valque[ev_que->getix];
-        if ( pevent == &canceledEvent ) {
-            ev_que->evque[ev_que->getix] = EVENTQEMPTY;
-            if (ev_que->valque[ev_que->getix]) {
-                db_delete_field_log(ev_que->valque[ev_que->getix]);
-                ev_que->valque[ev_que->getix] = NULL;
-            }
-            ev_que->getix = RNGINC ( ev_que->getix );
-            assert ( ev_que->nCanceled > 0 );
-            ev_que->nCanceled--;
-            continue;
-        }
+    while ( ellCount ( &ev_que->ready ) ) {
+        struct evSubscrip *pevent = CONTAINER ( ellGet ( &ev_que->ready ),
+            struct evSubscrip, qnode );
 
         /*
          * Simple type values queued up for reliable interprocess
          * communication. (for other types they get whatever happens
          * to be there upon wakeup)
+         *
+         * Take one update and put the event back at the end of the
+         * ready list if it has more, so that all events get a turn.
+         * A ring that grew to take a burst is given back once empty.
          */
-
-        event_remove ( ev_que, ev_que->getix, EVENTQEMPTY );
-        ev_que->getix = RNGINC ( ev_que->getix );
+        pfl = event_remove ( ev_que, pevent );
+        if ( pevent->npend > 0u ) {
+            ellAdd ( &ev_que->ready, &pevent->qnode );
+        }
+        else {
+            ringShrink ( pevent );
+        }
 
         /*
          * create a local copy of the call back parameters while
@@ -957,7 +1126,7 @@ static int event_read ( struct event_que *ev_que )
             if (pfl) {
                 /* Issue user callback */
                 ( *user_sub ) ( pevent->user_arg, pevent->chan,
-                                ev_que->evque[ev_que->getix] != EVENTQEMPTY, pfl );
+                                ellCount ( &ev_que->ready ) != 0, pfl );
             }
             LOCKEVQUE (ev_que);
 
@@ -989,13 +1158,64 @@ static int event_read ( struct event_que *ev_que )
     return DB_EVENT_OK;
 }
 
+/*
+ * EVENT_LABOR()
+ *
+ * Run any labor offloaded to the event task
+ */
+static void event_labor (struct event_user *evUser)
+{
+    void (*pExtraLaborSub) (void *);
+    void *pExtraLaborArg;
+
+    /*
+     * check to see if the caller has offloaded
+     * labor to this task
+     */
+    epicsMutexMustLock ( evUser->lock );
+    evUser->extraLaborBusy = TRUE;
+    if ( evUser->extra_labor && evUser->extralabor_sub ) {
+        evUser->extra_labor = FALSE;
+        pExtraLaborSub = evUser->extralabor_sub;
+        pExtraLaborArg = evUser->extralabor_arg;
+    }
+    else {
+        pExtraLaborSub = NULL;
+        pExtraLaborArg = NULL;
+    }
+    if ( pExtraLaborSub ) {
+        epicsMutexUnlock ( evUser->lock );
+        (*pExtraLaborSub)(pExtraLaborArg);
+        epicsMutexMustLock ( evUser->lock );
+    }
+    evUser->extraLaborBusy = FALSE;
+    epicsMutexUnlock ( evUser->lock );
+}
+
+/*
+ * EVENT_USER_FREE()
+ */
+static void event_user_free (struct event_user *evUser)
+{
+    epicsMutexDestroy(evUser->evque.writelock);
+
+    epicsEventDestroy(evUser->ppendsem);
+    epicsEventDestroy(evUser->pflush_sem);
+    epicsMutexDestroy(evUser->lock);
+
+    if (dbevEventUserFreeList)
+        freeListFree(dbevEventUserFreeList, evUser);
+    else
+        fprintf(stderr, "%s exiting but dbevEventUserFreeList already NULL\n",
+                __FUNCTION__);
+}
+
 /*
  * EVENT_TASK()
  */
 static void event_task (void *pParm)
 {
     struct event_user * const evUser = (struct event_user *) pParm;
-    struct event_que * ev_que;
     unsigned char pendexit;
 
     /* init hook */
@@ -1006,66 +1226,17 @@ static void event_task (void *pParm)
     taskwdInsert ( epicsThreadGetIdSelf(), NULL, NULL );
 
     do {
-        void (*pExtraLaborSub) (void *);
-        void *pExtraLaborArg;
         epicsEventMustWait(evUser->ppendsem);
 
-        /*
-         * check to see if the caller has offloaded
-         * labor to this task
-         */
+        event_labor ( evUser );
+        event_read ( &evUser->evque );
         epicsMutexMustLock ( evUser->lock );
-        evUser->extraLaborBusy = TRUE;
-        if ( evUser->extra_labor && evUser->extralabor_sub ) {
-            evUser->extra_labor = FALSE;
-            pExtraLaborSub = evUser->extralabor_sub;
-            pExtraLaborArg = evUser->extralabor_arg;
-        }
-        else {
-            pExtraLaborSub = NULL;
-            pExtraLaborArg = NULL;
-        }
-        if ( pExtraLaborSub ) {
-            epicsMutexUnlock ( evUser->lock );
-            (*pExtraLaborSub)(pExtraLaborArg);
-            epicsMutexMustLock ( evUser->lock );
-        }
-        evUser->extraLaborBusy = FALSE;
-
-        for ( ev_que = &evUser->firstque; ev_que;
-                ev_que = ev_que->nextque ) {
-            epicsMutexUnlock ( evUser->lock );
-            event_read (ev_que);
-            epicsMutexMustLock ( evUser->lock );
-        }
         pendexit = evUser->pendexit;
         epicsMutexUnlock ( evUser->lock );
 
     } while( ! pendexit );
 
-    epicsMutexDestroy(evUser->firstque.writelock);
-
-    {
-        struct event_que    *nextque;
-
-        ev_que = evUser->firstque.nextque;
-        while (ev_que) {
-            nextque = ev_que->nextque;
-            epicsMutexDestroy(ev_que->writelock);
-            freeListFree(dbevEventQueueFreeList, ev_que);
-            ev_que = nextque;
-        }
-    }
-
-    epicsEventDestroy(evUser->ppendsem);
-    epicsEventDestroy(evUser->pflush_sem);
-    epicsMutexDestroy(evUser->lock);
-
-    if (dbevEventUserFreeList)
-        freeListFree(dbevEventUserFreeList, evUser);
-    else
-        fprintf(stderr, "%s exiting but dbevEventUserFreeList already NULL\n",
-                __FUNCTION__);
+    event_user_free ( evUser );
 
     taskwdRemove(epicsThreadGetIdSelf());
 
@@ -1096,6 +1267,10 @@ int db_start_events (
          epicsMutexUnlock ( evUser->lock );
          return DB_EVENT_OK;
      }
+     if (evUser->dispatch) {
+         epicsMutexUnlock ( evUser->lock );
+         return DB_EVENT_ERROR;
+     }
 
      evUser->init_func = init_func;
      evUser->init_func_arg = init_func_arg;
@@ -1112,6 +1287,54 @@ int db_start_events (
      return DB_EVENT_OK;
 }
 
+/*
+ * DB_START_EVENTS_DISPATCHED()
+ *
+ * Instead of starting an event task, call dispatch(dispatch_arg) each
+ * time the event task would be woken up.  The dispatcher must then
+ * arrange for db_event_run() to be called, and must not call it from
+ * more than one thread at a time.  It may be called with internal locks
+ * held, so it must not block or call back into this facility.  When
+ * db_close_events() is called the dispatcher must have stopped calling
+ * db_event_run().
+ */
+int db_start_events_dispatched (
+    dbEventCtx ctx, EVENTDISPATCHFUNC *dispatch, void *dispatch_arg )
+{
+    struct event_user * const evUser = (struct event_user *) ctx;
+
+    epicsMutexMustLock ( evUser->lock );
+    if ( evUser->taskid || evUser->dispatch ) {
+        epicsMutexUnlock ( evUser->lock );
+        return DB_EVENT_ERROR;
+    }
+    evUser->dispatch_arg = dispatch_arg;
+    evUser->dispatch = dispatch;
+    epicsMutexUnlock ( evUser->lock );
+    return DB_EVENT_OK;
+}
+
+/*
+ * DB_EVENT_RUN()
+ *
+ * Do the work of one event task wakeup for a dispatched event user
+ */
+void db_event_run (dbEventCtx ctx)
+{
+    struct event_user * const evUser = (struct event_user *) ctx;
+
+    LOCKEVQUE ( &evUser->evque );
+    evUser->runner = epicsThreadGetIdSelf ();
+    UNLOCKEVQUE ( &evUser->evque );
+
+    event_labor ( evUser );
+    event_read ( &evUser->evque );
+
+    LOCKEVQUE ( &evUser->evque );
+    evUser->runner = NULL;
+    UNLOCKEVQUE ( &evUser->evque );
+}
+
 /*
  * db_event_change_priority()
  */
@@ -1119,7 +1342,8 @@ void db_event_change_priority ( dbEventCtx ctx,
                                         unsigned epicsPriority )
 {
     struct event_user * const evUser = ( struct event_user * ) ctx;
-    epicsThreadSetPriority ( evUser->taskid, epicsPriority );
+    if ( evUser->taskid )
+        epicsThreadSetPriority ( evUser->taskid, epicsPriority );
 }
 
 /*
@@ -1135,7 +1359,7 @@ void db_event_flow_ctrl_mode_on (dbEventCtx ctx)
     /*
      * notify the event handler task
      */
-    epicsEventSignal(evUser->ppendsem);
+    event_wake(evUser);
 #ifdef DEBUG
     printf("fc on %lu\n", tickGet());
 #endif
@@ -1154,7 +1378,7 @@ void db_event_flow_ctrl_mode_off (dbEventCtx ctx)
     /*
      * notify the event handler task
      */
-    epicsEventSignal (evUser->ppendsem);
+    event_wake(evUser);
 #ifdef DEBUG
     printf("fc off %lu\n", tickGet());
 #endif
@@ -1173,6 +1397,30 @@ void db_delete_field_log (db_field_log *pfl)
     }
 }
 
+/*
+ * db_hold_field_log_data()
+ *
+ * Keep the array data of a shared snapshot field log alive after the log
+ * has been deleted, until db_release_field_log_data() is called with the
+ * returned handle.  Returns NULL for logs that do not hold a snapshot.
+ */
+void * db_hold_field_log_data (db_field_log *pfl)
+{
+    dbflSnapshot *psnap;
+
+    if (!pfl || pfl->type != dbfl_type_ref || pfl->u.r.dtor != snapshot_dtor)
+        return NULL;
+
+    psnap = (dbflSnapshot *) pfl->u.r.pvt;
+    epicsAtomicIncrIntT(&psnap->refcount);
+    return psnap;
+}
+
+void db_release_field_log_data (void *hold)
+{
+    snapshot_release((dbflSnapshot *) hold);
+}
+
 int db_available_logs(void)
 {
     return (int) freeListItemsAvail(dbevFieldLogFreeList);
@@ -41,6 +41,22 @@ struct dbChannel;
 struct db_field_log;
 struct evSubscrip;
 
+/* Non-zero to queue a shared copy of array fields with monitor updates */
+epicsShareExtern int dbEventArraySnapshots;
+
+/* Number of updates each subscription may have queued, unless the
+ * channel asks for a different depth (see the "q" channel filter).
+ * A subscription with the default depth starts with room for
+ * DB_EVENT_QUEUE_DEFAULT updates and grows its queue to absorb bursts,
+ * up to DB_EVENT_QUEUE_BURST which was the size of the event queue that
+ * the subscriptions of a client used to share.  The queues of one client
+ * together may only grow by DB_EVENT_QUEUE_BURST updates, and each goes
+ * back to the default depth once it has been emptied.
+ */
+#define DB_EVENT_QUEUE_DEFAULT  4
+#define DB_EVENT_QUEUE_BURST    144
+#define DB_EVENT_QUEUE_MAX      1024
+
 epicsShareFunc int db_event_list (
     const char *name, unsigned level);
 epicsShareFunc int dbel (
@@ -56,6 +72,13 @@ epicsShareFunc int db_start_events (
     dbEventCtx ctx, const char *taskname, void (*init_func)(void *),
     void *init_func_arg, unsigned osiPriority );
 epicsShareFunc void db_close_events (dbEventCtx ctx);
+
+/* Run event delivery from the caller's threads instead of an event task */
+typedef void EVENTDISPATCHFUNC (void *dispatch_arg);
+epicsShareFunc int db_start_events_dispatched (
+    dbEventCtx ctx, EVENTDISPATCHFUNC *dispatch, void *dispatch_arg );
+epicsShareFunc void db_event_run (dbEventCtx ctx);
+
 epicsShareFunc void db_event_flow_ctrl_mode_on (dbEventCtx ctx);
 epicsShareFunc void db_event_flow_ctrl_mode_off (dbEventCtx ctx);
 epicsShareFunc int db_add_extra_labor_event (
@@ -85,6 +108,8 @@ epicsShareFunc struct db_field_log* db_create_event_log (struct evSubscrip *peve
 epicsShareFunc struct db_field_log* db_create_read_log (struct dbChannel *chan);
 epicsShareFunc void db_delete_field_log (struct db_field_log *pfl);
 epicsShareFunc int db_available_logs(void);
+epicsShareFunc void * db_hold_field_log_data (struct db_field_log *pfl);
+epicsShareFunc void db_release_field_log_data (void *hold);
 
 #define DB_EVENT_OK 0
 #define DB_EVENT_ERROR (-1)
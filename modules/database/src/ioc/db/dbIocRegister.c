@@ -20,6 +20,7 @@
 #include "dbJLink.h"
 #include "dbLock.h"
 #include "dbNotify.h"
+#include "dbProcStats.h"
 #include "dbScan.h"
 #include "dbServer.h"
 #include "dbState.h"
@@ -332,6 +333,23 @@ static const iocshFuncDef dbLockShowLockedFuncDef =
 static void dbLockShowLockedCallFunc(const iocshArgBuf *args)
 { dbLockShowLocked(args[0].ival);}
 
+/* dbtop */
+static const iocshArg dbtopArg0 = { "count",iocshArgInt};
+static const iocshArg dbtopArg1 = { "interest level",iocshArgInt};
+static const iocshArg * const dbtopArgs[2] = {&dbtopArg0,&dbtopArg1};
+static const iocshFuncDef dbtopFuncDef = {"dbtop",2,dbtopArgs,
+    "Show the records with the longest total process time.\n"
+    "  count - number of records, 0 for 10\n"
+    "  interest level - 1 adds record type totals, 2 adds histograms\n"};
+static void dbtopCallFunc(const iocshArgBuf *args)
+{ dbtop(args[0].ival,args[1].ival);}
+
+/* dbtopReset */
+static const iocshFuncDef dbtopResetFuncDef = {"dbtopReset",0,0,
+    "Clear the record process time statistics.\n"};
+static void dbtopResetCallFunc(const iocshArgBuf *args)
+{ dbProcStatsReset();}
+
 /* scanOnceSetQueueSize */
 static const iocshArg scanOnceSetQueueSizeArg0 = { "size",iocshArgInt};
 static const iocshArg * const scanOnceSetQueueSizeArgs[1] =
@@ -357,6 +375,20 @@ static void scanOnceQueueShowCallFunc(const iocshArgBuf *args)
     scanOnceQueueShow(args[0].ival);
 }
 
+/* scanPeriodicSetThreads */
+static const iocshArg scanPeriodicSetThreadsArg0 = { "no of threads",iocshArgInt};
+static const iocshArg * const scanPeriodicSetThreadsArgs[1] =
+    {&scanPeriodicSetThreadsArg0};
+static const iocshFuncDef scanPeriodicSetThreadsFuncDef =
+    {"scanPeriodicSetThreads",1,scanPeriodicSetThreadsArgs,
+     "Split each periodic scan list by lock set across several threads.\n"
+     "A count of 0 uses one thread per CPU.\n"
+     "Must be called before iocInit().\n"};
+static void scanPeriodicSetThreadsCallFunc(const iocshArgBuf *args)
+{
+    scanPeriodicSetThreads(args[0].ival);
+}
+
 /* scanppl */
 static const iocshArg scanpplArg0 = { "rate",iocshArgDouble};
 static const iocshArg * const scanpplArgs[1] = {&scanpplArg0};
@@ -526,9 +558,12 @@ void dbIocRegister(void)
     iocshRegister(&tpnFuncDef,tpnCallFunc);
     iocshRegister(&dblsrFuncDef,dblsrCallFunc);
     iocshRegister(&dbLockShowLockedFuncDef,dbLockShowLockedCallFunc);
+    iocshRegister(&dbtopFuncDef,dbtopCallFunc);
+    iocshRegister(&dbtopResetFuncDef,dbtopResetCallFunc);
 
     iocshRegister(&scanOnceSetQueueSizeFuncDef,scanOnceSetQueueSizeCallFunc);
     iocshRegister(&scanOnceQueueShowFuncDef,scanOnceQueueShowCallFunc);
+    iocshRegister(&scanPeriodicSetThreadsFuncDef,scanPeriodicSetThreadsCallFunc);
     iocshRegister(&scanpplFuncDef,scanpplCallFunc);
     iocshRegister(&scanpelFuncDef,scanpelCallFunc);
     iocshRegister(&postEventFuncDef,postEventCallFunc);
@@ -31,9 +31,11 @@
 #include "dbBase.h"
 #include "dbLink.h"
 #include "dbCommon.h"
+#include "dbCommonPvt.h"
 #include "dbFldTypes.h"
 #include "dbLockPvt.h"
 #include "dbStaticLib.h"
+#include "dbStaticPvt.h"
 #include "link.h"
 
 typedef struct dbScanLockNode dbScanLockNode;
@@ -57,6 +59,9 @@ static epicsMutexId lockSetsGuard;
 static size_t recomputeCnt;
 #endif
 
+/* Counter which we increment whenever lockSets are merged or split */
+static size_t lockSetChanges;
+
 /*private routines */
 static void dbLockOnce(void* ignore)
 {
@@ -175,6 +180,11 @@ lockSet* dbLockGetRef(lockRecord *lr)
     return ls;
 }
 
+size_t dbLockChangeCount(void)
+{
+    return epicsAtomicGetSizeT(&lockSetChanges);
+}
+
 unsigned long dbLockGetLockId(dbCommon *precord)
 {
     unsigned long id=0;
@@ -556,6 +566,221 @@ static int freeLockRecord(void* junk, DBENTRY* pdbentry)
     return 0;
 }
 
+/* Records are packed in blocks aligned to this, a cache line */
+#define PACK_ALIGN 64
+
+typedef struct {
+    dbRecordNode *precnode;
+    size_t size;        /* dbCommonPvt + record, before rounding */
+    size_t parent;      /* union-find, the root is the first record */
+} packRecord;
+
+typedef struct {
+    size_t set;
+    size_t index;
+} packOrder;
+
+static int packCompareAddr(const void *a, const void *b)
+{
+    const packRecord *ra = *(const packRecord * const *)a;
+    const packRecord *rb = *(const packRecord * const *)b;
+    const char *pa = ra->precnode->precord;
+    const char *pb = rb->precnode->precord;
+
+    return pa < pb ? -1 : pa > pb;
+}
+
+static int packCompareFind(const void *key, const void *elem)
+{
+    const char *pa = key;
+    const char *pb = (*(const packRecord * const *)elem)->precnode->precord;
+
+    return pa < pb ? -1 : pa > pb;
+}
+
+static int packCompareOrder(const void *a, const void *b)
+{
+    const packOrder *oa = a, *ob = b;
+
+    if (oa->set != ob->set)
+        return oa->set < ob->set ? -1 : 1;
+    return oa->index < ob->index ? -1 : oa->index > ob->index;
+}
+
+static size_t packFind(packRecord *recs, size_t i)
+{
+    while (recs[i].parent != i) {
+        recs[i].parent = recs[recs[i].parent].parent;
+        i = recs[i].parent;
+    }
+    return i;
+}
+
+/* The record a link field will become a DB link to, if any */
+static dbCommon* packLinkTarget(dbBase *pdbbase, dbFldDes *pflddes,
+    DBLINK *plink)
+{
+    dbLinkInfo info;
+    dbCommon *ptarget = NULL;
+
+    if (!plink->text ||
+        dbParseLink(plink->text, pflddes->field_type, &info))
+        return NULL;
+
+    if (info.ltype == PV_LINK &&
+        !(info.modifiers & (pvlOptCA | pvlOptCP | pvlOptCPP))) {
+        DBENTRY entry;
+        const char *pname = info.target;
+
+        dbInitEntry(pdbbase, &entry);
+        if (!dbFindRecordPart(&entry, &pname)) {
+            dbRecordNode *precnode = entry.precnode;
+
+            if (precnode->flags & DBRN_FLAGS_ISALIAS)
+                precnode = precnode->aliasedRecnode;
+            ptarget = precnode->precord;
+        }
+        dbFinishEntry(&entry);
+    }
+    dbFreeLinkInfo(&info);
+    return ptarget;
+}
+
+/* Move the records of each future lockset next to each other in one
+ * arena, in cache line aligned blocks.  The locksets are predicted
+ * from the link text the same way dbLockSetMerge() will join them.
+ *
+ * Must be called before anything holds pointers to the records, so
+ * iocBuild() does it before the first record or device support init.
+ */
+long dbLockPackRecords(dbBase *pdbbase)
+{
+    DBENTRY entry;
+    packRecord *recs;
+    packRecord **byAddr;
+    packOrder *order;
+    size_t nrecs = 0, i, total;
+    char *arena, *pblock;
+    long status;
+
+    if (!pdbbase || pdbbase->recordArena)
+        return 0;
+
+    dbInitEntry(pdbbase, &entry);
+    for (status = dbFirstRecordType(&entry); !status;
+         status = dbNextRecordType(&entry))
+        nrecs += dbGetNRecords(&entry) - dbGetNAliases(&entry);
+    if (!nrecs) {
+        dbFinishEntry(&entry);
+        return 0;
+    }
+
+    recs = callocMustSucceed(nrecs, sizeof(*recs), "dbLockPackRecords");
+    byAddr = callocMustSucceed(nrecs, sizeof(*byAddr), "dbLockPackRecords");
+    order = callocMustSucceed(nrecs, sizeof(*order), "dbLockPackRecords");
+
+    i = 0;
+    for (status = dbFirstRecordType(&entry); !status;
+         status = dbNextRecordType(&entry)) {
+        for (status = dbFirstRecord(&entry); !status;
+             status = dbNextRecord(&entry)) {
+            if (dbIsAlias(&entry))
+                continue;
+            recs[i].precnode = entry.precnode;
+            recs[i].size = offsetof(dbCommonPvt, common) +
+                entry.precordType->rec_size;
+            recs[i].parent = i;
+            byAddr[i] = &recs[i];
+            i++;
+        }
+    }
+    dbFinishEntry(&entry);
+    assert(i == nrecs);
+    qsort(byAddr, nrecs, sizeof(*byAddr), packCompareAddr);
+
+    /* Join each record with the targets of its DB links */
+    total = PACK_ALIGN;
+    for (i = 0; i < nrecs; i++) {
+        dbCommon *prec = recs[i].precnode->precord;
+        dbRecordType *rtyp = prec->rdes;
+        short j;
+
+        total += (recs[i].size + PACK_ALIGN - 1) & ~(size_t)(PACK_ALIGN - 1);
+
+        for (j = 0; j < rtyp->no_links; j++) {
+            dbFldDes *pflddes = rtyp->papFldDes[rtyp->link_ind[j]];
+            dbCommon *ptarget = packLinkTarget(pdbbase, pflddes,
+                (DBLINK *)((char *)prec + pflddes->offset));
+            packRecord **ppfound;
+            size_t a, b;
+
+            if (!ptarget || ptarget == prec)
+                continue;
+            ppfound = bsearch(ptarget, byAddr, nrecs, sizeof(*byAddr),
+                packCompareFind);
+            if (!ppfound)
+                continue;
+
+            a = packFind(recs, i);
+            b = packFind(recs, *ppfound - recs);
+            if (a < b)
+                recs[b].parent = a;
+            else if (b < a)
+                recs[a].parent = b;
+        }
+    }
+    free(byAddr);
+
+    for (i = 0; i < nrecs; i++) {
+        order[i].set = packFind(recs, i);
+        order[i].index = i;
+    }
+    qsort(order, nrecs, sizeof(*order), packCompareOrder);
+
+    arena = calloc(1, total);
+    if (!arena) {
+        free(order);
+        free(recs);
+        return S_db_noMemory;
+    }
+    pblock = (char *)(((size_t)arena + PACK_ALIGN - 1) &
+        ~(size_t)(PACK_ALIGN - 1));
+
+    for (i = 0; i < nrecs; i++) {
+        dbRecordNode *precnode = recs[order[i].index].precnode;
+        size_t size = recs[order[i].index].size;
+        dbCommonPvt *ppvt = dbRec2Pvt(precnode->precord);
+        dbCommonPvt *pnew = (dbCommonPvt *)pblock;
+
+        memcpy(pnew, ppvt, size);
+        /* the record's name is also the node's */
+        if (precnode->recordname == ppvt->common.name)
+            precnode->recordname = pnew->common.name;
+        free(ppvt);
+        precnode->precord = &pnew->common;
+        precnode->flags |= DBRN_FLAGS_PACKED;
+        pblock += (size + PACK_ALIGN - 1) & ~(size_t)(PACK_ALIGN - 1);
+    }
+    free(order);
+    free(recs);
+
+    /* Aliases share the record of the node they alias */
+    dbInitEntry(pdbbase, &entry);
+    for (status = dbFirstRecordType(&entry); !status;
+         status = dbNextRecordType(&entry)) {
+        for (status = dbFirstRecord(&entry); !status;
+             status = dbNextRecord(&entry)) {
+            if (dbIsAlias(&entry))
+                entry.precnode->precord =
+                    entry.precnode->aliasedRecnode->precord;
+        }
+    }
+    dbFinishEntry(&entry);
+
+    pdbbase->recordArena = arena;
+    return 0;
+}
+
 void dbLockCleanupRecords(dbBase *pdbbase)
 {
 #ifndef LOCKSET_NOFREE
@@ -669,6 +894,8 @@ void dbLockSetMerge(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
 
     dbLockDecRef(B); /* last ref we hold */
 
+    epicsAtomicIncrSizeT(&lockSetChanges);
+
     assert(A==psecond->lset->plockSet);
 }
 
@@ -855,6 +1082,7 @@ void dbLockSetSplit(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
          */
         assert(epicsAtomicGetIntT(&ls->refcount)>=2);
 
+        epicsAtomicIncrSizeT(&lockSetChanges);
         return;
     }
 
@@ -40,10 +40,17 @@ epicsShareFunc void dbScanUnlockMany(dbLocker*);
 
 epicsShareFunc unsigned long dbLockGetLockId(
     struct dbCommon *precord);
+/* Incremented whenever lock sets are merged or split */
+epicsShareFunc size_t dbLockChangeCount(void);
 
 epicsShareFunc void dbLockInitRecords(struct dbBase *pdbbase);
 epicsShareFunc void dbLockCleanupRecords(struct dbBase *pdbbase);
 
+/* Re-pack the records of each lockset into contiguous memory,
+ * only before iocInit has announced its first init hook.
+ */
+epicsShareFunc long dbLockPackRecords(struct dbBase *pdbbase);
+
 
 /* Lock Set Report */
 epicsShareFunc long dblsr(char *recordname,int level);
@@ -0,0 +1,366 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Record processing time statistics, see dbProcStats.h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "epicsStdio.h"
+#include "epicsThread.h"
+#include "epicsTypes.h"
+
+#define epicsExportSharedSymbols
+#include "dbAccessDefs.h"
+#include "dbBase.h"
+#include "dbCommon.h"
+#include "dbCommonPvt.h"
+#include "dbStaticLib.h"
+#include "dbProcStats.h"
+#include "epicsExport.h"
+
+int dbProcStatsEnable = 1;
+epicsExportAddress(int, dbProcStatsEnable);
+
+/* One block for every record, allocated by dbProcStatsInit() */
+static dbProcStats *allStats;
+static size_t nStats;
+
+typedef void (*statsIterFunc)(dbRecordType *pdbRecordType,
+    dbCommon *precord, void *user);
+
+static void iterateRecords(dbBase *pdbbase, statsIterFunc func, void *user)
+{
+    dbRecordType *pdbRecordType;
+
+    for (pdbRecordType = (dbRecordType *)ellFirst(&pdbbase->recordTypeList);
+         pdbRecordType;
+         pdbRecordType = (dbRecordType *)ellNext(&pdbRecordType->node)) {
+        dbRecordNode *pdbRecordNode;
+
+        for (pdbRecordNode = (dbRecordNode *)ellFirst(&pdbRecordType->recList);
+             pdbRecordNode;
+             pdbRecordNode = (dbRecordNode *)ellNext(&pdbRecordNode->node)) {
+            dbCommon *precord = pdbRecordNode->precord;
+
+            if (!precord->name[0] ||
+                pdbRecordNode->flags & DBRN_FLAGS_ISALIAS)
+                continue;
+
+            func(pdbRecordType, precord, user);
+        }
+    }
+}
+
+static void countRecord(dbRecordType *pdbRecordType, dbCommon *precord,
+    void *user)
+{
+    (*(size_t *)user)++;
+}
+
+static void assignStats(dbRecordType *pdbRecordType, dbCommon *precord,
+    void *user)
+{
+    size_t *pnext = (size_t *)user;
+
+    dbRec2Pvt(precord)->procStats = &allStats[(*pnext)++];
+}
+
+static void clearStats(dbRecordType *pdbRecordType, dbCommon *precord,
+    void *user)
+{
+    dbRec2Pvt(precord)->procStats = NULL;
+}
+
+void dbProcStatsInit(dbBase *pdbbase)
+{
+    size_t next = 0;
+
+    dbProcStatsCleanup(pdbbase);
+    iterateRecords(pdbbase, countRecord, &nStats);
+    allStats = dbCalloc(nStats ? nStats : 1, sizeof(dbProcStats));
+    iterateRecords(pdbbase, assignStats, &next);
+}
+
+void dbProcStatsCleanup(dbBase *pdbbase)
+{
+    if (!allStats)
+        return;
+    if (pdbbase)
+        iterateRecords(pdbbase, clearStats, NULL);
+    free(allStats);
+    allStats = NULL;
+    nStats = 0;
+}
+
+dbProcStats * dbProcStatsGet(dbCommon *precord)
+{
+    return dbRec2Pvt(precord)->procStats;
+}
+
+void dbProcStatsAdd(dbCommon *precord, epicsUInt64 nsec)
+{
+    dbProcStats *pstats = dbRec2Pvt(precord)->procStats;
+    epicsThreadId tid = epicsThreadGetIdSelf();
+    epicsUInt64 bits = nsec >> 8;
+    int bin = 0;
+
+    if (!pstats)
+        return;
+
+    while (bits && bin < DB_PROC_STATS_BINS - 1) {
+        bits >>= 1;
+        bin++;
+    }
+    pstats->hist[bin]++;
+    pstats->count++;
+    pstats->nsec += nsec;
+    if (nsec > pstats->maxNsec)
+        pstats->maxNsec = nsec > 0xffffffffu ? 0xffffffffu : (epicsUInt32)nsec;
+
+    /* Scan threads keep processing the same records */
+    if (tid != pstats->tid) {
+        pstats->tid = tid;
+        epicsThreadGetName(tid, pstats->thread, sizeof(pstats->thread));
+    }
+}
+
+void dbProcStatsReset(void)
+{
+    size_t i;
+
+    for (i = 0; i < nStats; i++)
+        memset(&allStats[i], 0, sizeof(dbProcStats));
+}
+
+/* Keep the count records with the longest total time, longest first */
+typedef struct topRecords {
+    int count;
+    int found;
+    dbCommon **precs;
+    dbRecordType **ptypes;
+    double processes;
+    unsigned long records;
+} topRecords;
+
+static void rankRecord(dbRecordType *pdbRecordType, dbCommon *precord,
+    void *user)
+{
+    topRecords *ptop = (topRecords *)user;
+    dbProcStats *pstats = dbRec2Pvt(precord)->procStats;
+    int i;
+
+    if (!pstats || !pstats->count)
+        return;
+    ptop->processes += (double)pstats->count;
+    ptop->records++;
+
+    for (i = ptop->found; i > 0; i--) {
+        if (dbRec2Pvt(ptop->precs[i - 1])->procStats->nsec >= pstats->nsec)
+            break;
+        if (i < ptop->count) {
+            ptop->precs[i] = ptop->precs[i - 1];
+            ptop->ptypes[i] = ptop->ptypes[i - 1];
+        }
+    }
+    if (i < ptop->count) {
+        ptop->precs[i] = precord;
+        ptop->ptypes[i] = pdbRecordType;
+        if (ptop->found < ptop->count)
+            ptop->found++;
+    }
+}
+
+static int findTop(topRecords *ptop, int count)
+{
+    memset(ptop, 0, sizeof(topRecords));
+    if (!allStats || !pdbbase)
+        return -1;
+    ptop->count = count > 0 ? count : 10;
+    ptop->precs = dbCalloc(ptop->count, sizeof(dbCommon *));
+    ptop->ptypes = dbCalloc(ptop->count, sizeof(dbRecordType *));
+    iterateRecords(pdbbase, rankRecord, ptop);
+    return 0;
+}
+
+static void freeTop(topRecords *ptop)
+{
+    free(ptop->precs);
+    free(ptop->ptypes);
+}
+
+size_t dbProcStatsSummary(char *buf, size_t size, int count)
+{
+    topRecords top;
+    size_t len = 0;
+    int i;
+
+    if (!size)
+        return 0;
+    buf[0] = 0;
+    if (findTop(&top, count))
+        return 0;
+
+    for (i = 0; i < top.found && len + 1 < size; i++) {
+        dbProcStats *pstats = dbRec2Pvt(top.precs[i])->procStats;
+        int n = epicsSnprintf(buf + len, size - len, "%s %.0f %.1f %.1f %s\n",
+            top.precs[i]->name, (double)pstats->count,
+            pstats->nsec * 1e-3 / pstats->count, pstats->maxNsec * 1e-3,
+            pstats->thread[0] ? pstats->thread : "-");
+
+        if (n < 0)
+            break;
+        len += n;
+    }
+    if (len >= size)
+        len = size - 1;
+    buf[len] = 0;
+    freeTop(&top);
+    return len;
+}
+
+/* Upper bound of a histogram bin */
+static void binLabel(char *buf, size_t size, int bin)
+{
+    double ns = (double)(1ul << (bin < 22 ? bin + 8 : 30));
+
+    if (bin == DB_PROC_STATS_BINS - 1)
+        epicsSnprintf(buf, size, ">=%.3gs", ns * 1e-9);
+    else if (ns < 1e3)
+        epicsSnprintf(buf, size, "<%.3gns", ns);
+    else if (ns < 1e6)
+        epicsSnprintf(buf, size, "<%.3gus", ns * 1e-3);
+    else
+        epicsSnprintf(buf, size, "<%.3gms", ns * 1e-6);
+}
+
+static void printHistogram(const epicsUInt32 *hist)
+{
+    int i;
+
+    printf("    ");
+    for (i = 0; i < DB_PROC_STATS_BINS; i++) {
+        char label[16];
+
+        if (!hist[i])
+            continue;
+        binLabel(label, sizeof(label), i);
+        printf(" %s:%u", label, (unsigned)hist[i]);
+    }
+    printf("\n");
+}
+
+/* Record type totals */
+typedef struct typeTotal {
+    dbRecordType *pdbRecordType;
+    unsigned long records;
+    dbProcStats sum;
+} typeTotal;
+
+typedef struct typeTotals {
+    int n;
+    typeTotal *ptotals;
+} typeTotals;
+
+static void sumRecord(dbRecordType *pdbRecordType, dbCommon *precord,
+    void *user)
+{
+    typeTotals *ptotals = (typeTotals *)user;
+    dbProcStats *pstats = dbRec2Pvt(precord)->procStats;
+    typeTotal *ptotal;
+    int i;
+
+    if (!pstats || !pstats->count)
+        return;
+    for (i = 0; i < ptotals->n; i++) {
+        if (ptotals->ptotals[i].pdbRecordType == pdbRecordType)
+            break;
+    }
+    ptotal = &ptotals->ptotals[i];
+    if (i == ptotals->n) {
+        ptotals->n++;
+        ptotal->pdbRecordType = pdbRecordType;
+    }
+    ptotal->records++;
+    ptotal->sum.count += pstats->count;
+    ptotal->sum.nsec += pstats->nsec;
+    ptotal->sum.active += pstats->active;
+    if (pstats->maxNsec > ptotal->sum.maxNsec)
+        ptotal->sum.maxNsec = pstats->maxNsec;
+    for (i = 0; i < DB_PROC_STATS_BINS; i++)
+        ptotal->sum.hist[i] += pstats->hist[i];
+}
+
+static int compareTotals(const void *a, const void *b)
+{
+    const typeTotal *pa = a, *pb = b;
+
+    return pa->sum.nsec < pb->sum.nsec ? 1 :
+        pa->sum.nsec > pb->sum.nsec ? -1 : 0;
+}
+
+static void printStats(const char *name, const char *type,
+    const dbProcStats *pstats, const char *thread)
+{
+    printf("%-28s %-10s %10.0f %10.3f %9.1f %9.1f %7u  %s\n",
+        name, type, (double)pstats->count, pstats->nsec * 1e-6,
+        pstats->nsec * 1e-3 / pstats->count, pstats->maxNsec * 1e-3,
+        (unsigned)pstats->active, thread);
+}
+
+long dbtop(int count, int level)
+{
+    topRecords top;
+    int i;
+
+    if (findTop(&top, count)) {
+        printf("dbtop: The IOC has not been initialized\n");
+        return -1;
+    }
+    if (!dbProcStatsEnable)
+        printf("dbtop: Statistics are disabled, set dbProcStatsEnable\n");
+
+    printf("Records with the longest total process time,"
+        " from %.0f processes of %lu records\n", top.processes, top.records);
+    printf("%-28s %-10s %10s %10s %9s %9s %7s  %s\n", "Record", "Type",
+        "Count", "Total ms", "Mean us", "Max us", "Active", "Thread");
+    for (i = 0; i < top.found; i++) {
+        dbProcStats *pstats = dbRec2Pvt(top.precs[i])->procStats;
+
+        printStats(top.precs[i]->name, top.ptypes[i]->name, pstats,
+            pstats->thread);
+        if (level > 1)
+            printHistogram(pstats->hist);
+    }
+
+    if (level > 0) {
+        typeTotals totals;
+
+        totals.n = 0;
+        totals.ptotals = dbCalloc(ellCount(&pdbbase->recordTypeList) + 1,
+            sizeof(typeTotal));
+        iterateRecords(pdbbase, sumRecord, &totals);
+        qsort(totals.ptotals, totals.n, sizeof(typeTotal), compareTotals);
+
+        printf("\nRecord type totals, longest first\n");
+        printf("%-28s %-10s %10s %10s %9s %9s %7s\n", "Record type",
+            "Records", "Count", "Total ms", "Mean us", "Max us", "Active");
+        for (i = 0; i < totals.n; i++) {
+            typeTotal *ptotal = &totals.ptotals[i];
+            char records[16];
+
+            epicsSnprintf(records, sizeof(records), "%lu", ptotal->records);
+            printStats(ptotal->pdbRecordType->name, records, &ptotal->sum, "");
+            printHistogram(ptotal->sum.hist);
+        }
+        free(totals.ptotals);
+    }
+    freeTop(&top);
+    return 0;
+}
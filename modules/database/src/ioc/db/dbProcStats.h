@@ -0,0 +1,91 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/** @file dbProcStats.h
+ * @brief Record processing time statistics
+ *
+ * dbProcess() times each call of a record's process routine and adds it
+ * to the record's statistics: a count, the total and longest times, a
+ * histogram of the times in power of two bins, and how often the record
+ * was found already active (PACT set).  The name of the thread that last
+ * processed the record is kept too.
+ *
+ * The statistics of a record are only changed with the record locked, so
+ * no atomic operations are needed; the reports read them without locking
+ * and may see a partial update.  Record type totals are summed from the
+ * records when reported.  Times include any records that are processed
+ * by links from the record while it runs.
+ */
+
+#ifndef INCdbProcStatsH
+#define INCdbProcStatsH
+
+#include <stddef.h>
+
+#include "epicsTypes.h"
+#include "epicsThread.h"
+#include "shareLib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct dbBase;
+struct dbCommon;
+
+/** Histogram bins, bin 0 counts times below 256ns and bin N times from
+ * 2^(N+7) to 2^(N+8) ns.  The last bin counts everything from 2^30 ns.
+ */
+#define DB_PROC_STATS_BINS 24
+
+typedef struct dbProcStats {
+    epicsUInt64     count;      /**< @brief Calls of the process routine */
+    epicsUInt64     nsec;       /**< @brief Total time in them */
+    epicsUInt32     maxNsec;    /**< @brief Longest time, saturates */
+    epicsUInt32     active;     /**< @brief Times dbProcess found PACT set */
+    epicsUInt32     hist[DB_PROC_STATS_BINS];
+    epicsThreadId   tid;        /**< @brief Thread of the last process */
+    char            thread[16]; /**< @brief and its name */
+} dbProcStats;
+
+/** @brief Set to 0 to stop collecting statistics. */
+epicsShareExtern int dbProcStatsEnable;
+
+/** @brief Give each record its statistics, called by iocInit. */
+epicsShareFunc void dbProcStatsInit(struct dbBase *pdbbase);
+/** @brief Free the statistics, called by iocShutdown. */
+epicsShareFunc void dbProcStatsCleanup(struct dbBase *pdbbase);
+
+/** @brief The statistics of a record, NULL before iocInit. */
+epicsShareFunc dbProcStats * dbProcStatsGet(struct dbCommon *precord);
+
+/** @brief Add one process of a locked record taking nsec nanoseconds. */
+epicsShareFunc void dbProcStatsAdd(struct dbCommon *precord, epicsUInt64 nsec);
+
+/** @brief Clear the statistics of every record. */
+epicsShareFunc void dbProcStatsReset(void);
+
+/** @brief Write a summary of the count records with the longest total
+ * process time into buf, one line per record giving its name, process
+ * count, mean and longest times in microseconds and thread name.
+ * @return The length of the summary.
+ */
+epicsShareFunc size_t dbProcStatsSummary(char *buf, size_t size, int count);
+
+/** @brief Report the records with the longest total process time.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ *
+ * @param count Number of records to show, 0 for 10.
+ * @param level 1 adds the record type totals, 2 the histograms.
+ */
+epicsShareFunc long dbtop(int count, int level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCdbProcStatsH */
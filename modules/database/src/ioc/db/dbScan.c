@@ -88,15 +88,43 @@ typedef struct scan_element{
 
 #define OVERRUN_REPORT_DELAY 10.0   /* Time between initial reports */
 #define OVERRUN_REPORT_MAX 3600.0   /* Maximum time between reports */
-typedef struct periodic_scan_list {
+
+/* Each periodic scan list is split into one or more shards, each of
+ * which is processed by its own thread.  Records are assigned to a shard
+ * by their lock set, so records which share a lock set are always scanned
+ * by the same thread in phase order.  When lock sets are merged or split
+ * at run-time the records are re-sharded before the next scan, so a pass
+ * that is running at the time of the change may still see the records of
+ * one lock set in two shards.
+ */
+typedef struct periodic_shard {
     scan_list           scan_list;
+    struct periodic_scan_list *ppsl;
+    epicsEventId        startEvent;
+    epicsThreadId       tid;
+    unsigned long       nScans;
+    unsigned long       overruns;
+    double              lastTime;
+    double              maxTime;
+    double              sumTime;
+} periodic_shard;
+
+typedef struct periodic_scan_list {
     double              period;
     const char          *name;
     unsigned long       overruns;
     volatile enum ctl   scanCtl;
     epicsEventId        loopEvent;
+    int                 nShards;
+    periodic_shard      *shards;
+    int                 shardsBusy;
+    int                 shardsExit;
+    epicsEventId        shardsDone;
+    epicsMutexId        shardLock;  /* serializes adds, deletes, re-sharding */
+    size_t              lockChanges;
 } periodic_scan_list;
 
+static int periodicThreads = 1;  /* shards per periodic scan list */
 static int nPeriodic = 0;
 static periodic_scan_list **papPeriodic; /* pointer to array of pointers */
 static epicsThreadId *periodicTaskId;    /* array of thread ids */
@@ -139,6 +167,7 @@ static epicsMutexId ioscan_lock;
 static void onceTask(void *);
 static void initOnce(void);
 static void periodicTask(void *arg);
+static void periodicShardTask(void *arg);
 static void initPeriodic(void);
 static void deletePeriodic(void);
 static void spawnPeriodic(int ind);
@@ -146,6 +175,11 @@ static void eventCallback(epicsCallback *pcallback);
 static void ioscanInit(void);
 static void ioscanCallback(epicsCallback *pcallback);
 static void ioscanDestroy(void);
+static scan_list *periodicShardList(periodic_scan_list *ppsl,
+    struct dbCommon *precord);
+static void scanShard(periodic_shard *pps);
+static void scanShards(periodic_scan_list *ppsl);
+static void reshardPeriodic(periodic_scan_list *ppsl);
 static void printList(scan_list *psl, char *message);
 static void scanList(scan_list *psl);
 static void buildScanLists(void);
@@ -297,8 +331,11 @@ void scanAdd(struct dbCommon *precord)
     } else if (scan >= SCAN_1ST_PERIODIC) {
         periodic_scan_list *ppsl = papPeriodic[scan - SCAN_1ST_PERIODIC];
 
-        if (ppsl)
-            addToList(precord, &ppsl->scan_list);
+        if (ppsl) {
+            epicsMutexMustLock(ppsl->shardLock);
+            addToList(precord, periodicShardList(ppsl, precord));
+            epicsMutexUnlock(ppsl->shardLock);
+        }
     }
 }
 
@@ -358,8 +395,11 @@ void scanDelete(struct dbCommon *precord)
     } else if (scan >= SCAN_1ST_PERIODIC) {
         periodic_scan_list *ppsl = papPeriodic[scan - SCAN_1ST_PERIODIC];
 
-        if (ppsl)
-            deleteFromList(precord, &ppsl->scan_list);
+        if (ppsl) {
+            epicsMutexMustLock(ppsl->shardLock);
+            deleteFromList(precord, periodicShardList(ppsl, precord));
+            epicsMutexUnlock(ppsl->shardLock);
+        }
     }
 }
 
@@ -373,11 +413,23 @@ double scanPeriod(int scan) {
     return ppsl ? ppsl->period : 0.0;
 }
 
+int scanPeriodicSetThreads(int count)
+{
+    if (papPeriodic) {
+        fprintf(stderr, "scanPeriodicSetThreads: Scan system already initialized\n");
+        return -1;
+    }
+    if (count <= 0)
+        count = epicsThreadGetCPUs();
+    periodicThreads = count;
+    return 0;
+}
+
 int scanppl(double period)      /* print periodic scan list(s) */
 {
     dbMenu *pmenu = dbFindMenu(pdbbase, "menuScan");
-    char message[80];
-    int i;
+    char message[120];
+    int i, j;
 
     if (!pmenu || !papPeriodic) {
         printf("scanppl: dbScan subsystem not initialized\n");
@@ -400,7 +452,22 @@ int scanppl(double period)      /* print periodic scan list(s) */
 
         sprintf(message, "Records with SCAN = '%s' (%lu over-runs):",
             ppsl->name, ppsl->overruns);
-        printList(&ppsl->scan_list, message);
+        if (ppsl->nShards == 1) {
+            printList(&ppsl->shards[0].scan_list, message);
+            continue;
+        }
+
+        printf("%s\n", message);
+        for (j = 0; j < ppsl->nShards; j++) {
+            periodic_shard *pps = &ppsl->shards[j];
+            unsigned long nScans = pps->nScans;
+
+            sprintf(message, "  Thread %d: %.6f s last, %.6f s max, "
+                "%.6f s avg (%lu over-runs):", j, pps->lastTime,
+                pps->maxTime, nScans ? pps->sumTime / nScans : 0.0,
+                pps->overruns);
+            printList(&pps->scan_list, message);
+        }
     }
     return 0;
 }
@@ -795,8 +862,10 @@ static void periodicTask(void *arg)
         double delay;
         epicsTimeStamp now;
 
-        if (ppsl->scanCtl == ctlRun)
-            scanList(&ppsl->scan_list);
+        if (ppsl->scanCtl == ctlRun) {
+            reshardPeriodic(ppsl);
+            scanShards(ppsl);
+        }
 
         epicsTimeAddSeconds(&next, ppsl->period);
         epicsTimeGetMonotonic(&now);
@@ -841,16 +910,43 @@ static void periodicTask(void *arg)
         epicsEventWaitWithTimeout(ppsl->loopEvent, delay);
     }
 
+    /* Stop the shard threads */
+    ppsl->shardsExit = TRUE;
+    scanShards(ppsl);
+
     taskwdRemove(0);
     epicsEventSignal(startStopEvent);
 }
 
+static void periodicShardTask(void *arg)
+{
+    periodic_shard *pps = (periodic_shard *)arg;
+    periodic_scan_list *ppsl = pps->ppsl;
+
+    taskwdInsert(0, NULL, NULL);
+    epicsEventSignal(startStopEvent);
+
+    while (TRUE) {
+        epicsEventMustWait(pps->startEvent);
+        if (ppsl->shardsExit)
+            break;
+
+        scanShard(pps);
+        if (epicsAtomicDecrIntT(&ppsl->shardsBusy) == 0)
+            epicsEventMustTrigger(ppsl->shardsDone);
+    }
+
+    /* This must be the last use of ppsl, deletePeriodic() joins us */
+    if (epicsAtomicDecrIntT(&ppsl->shardsBusy) == 0)
+        epicsEventMustTrigger(ppsl->shardsDone);
+    taskwdRemove(0);
+}
 
 static void initPeriodic(void)
 {
     dbMenu *pmenu = dbFindMenu(pdbbase, "menuScan");
     double quantum = epicsThreadSleepQuantum();
-    int i;
+    int i, j;
 
     if (!pmenu) {
         errlogPrintf("initPeriodic: menuScan not present\n");
@@ -894,11 +990,22 @@ static void initPeriodic(void)
             continue;
         }
 
-        ppsl->scan_list.lock = epicsMutexMustCreate();
-        ellInit(&ppsl->scan_list.list);
         ppsl->name = choice;
         ppsl->scanCtl = ctlPause;
         ppsl->loopEvent = epicsEventMustCreate(epicsEventEmpty);
+        ppsl->shardsDone = epicsEventMustCreate(epicsEventEmpty);
+        ppsl->shardLock = epicsMutexMustCreate();
+        ppsl->nShards = periodicThreads;
+        ppsl->shards = dbCalloc(ppsl->nShards, sizeof(periodic_shard));
+        for (j = 0; j < ppsl->nShards; j++) {
+            periodic_shard *pps = &ppsl->shards[j];
+
+            pps->ppsl = ppsl;
+            pps->scan_list.lock = epicsMutexMustCreate();
+            ellInit(&pps->scan_list.list);
+            if (j > 0)
+                pps->startEvent = epicsEventMustCreate(epicsEventEmpty);
+        }
 
         number = ppsl->period / quantum;
         if ((ppsl->period < 2 * quantum) ||
@@ -913,15 +1020,27 @@ static void initPeriodic(void)
 
 static void deletePeriodic(void)
 {
-    int i;
+    int i, j;
 
     for (i = 0; i < nPeriodic; i++) {
         periodic_scan_list *ppsl = papPeriodic[i];
 
         if (!ppsl) continue;
-        ellFree(&ppsl->scan_list.list);
+        for (j = 0; j < ppsl->nShards; j++) {
+            periodic_shard *pps = &ppsl->shards[j];
+
+            /* Shard threads have exited, but may still be returning */
+            if (j > 0 && pps->tid)
+                epicsThreadMustJoin(pps->tid);
+            ellFree(&pps->scan_list.list);
+            epicsMutexDestroy(pps->scan_list.lock);
+            if (pps->startEvent)
+                epicsEventDestroy(pps->startEvent);
+        }
+        free(ppsl->shards);
+        epicsEventDestroy(ppsl->shardsDone);
+        epicsMutexDestroy(ppsl->shardLock);
         epicsEventDestroy(ppsl->loopEvent);
-        epicsMutexDestroy(ppsl->scan_list.lock);
         free(ppsl);
     }
 
@@ -932,18 +1051,140 @@ static void deletePeriodic(void)
 static void spawnPeriodic(int ind)
 {
     periodic_scan_list *ppsl = papPeriodic[ind];
-    char taskName[20];
+    char taskName[32];
+    int j;
 
     if (!ppsl) return;
 
+    for (j = 1; j < ppsl->nShards; j++) {
+        periodic_shard *pps = &ppsl->shards[j];
+        epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+
+        opts.priority = epicsThreadPriorityScanLow + ind;
+        opts.stackSize = epicsThreadStackBig;
+        opts.joinable = 1;
+        sprintf(taskName, "scan-%g-%d", ppsl->period, j);
+        pps->tid = epicsThreadCreateOpt(taskName, periodicShardTask,
+            (void *)pps, &opts);
+
+        epicsEventWait(startStopEvent);
+    }
+
     sprintf(taskName, "scan-%g", ppsl->period);
     periodicTaskId[ind] = epicsThreadCreate(
         taskName, epicsThreadPriorityScanLow + ind,
         epicsThreadGetStackSize(epicsThreadStackBig),
         periodicTask, (void *)ppsl);
+    ppsl->shards[0].tid = periodicTaskId[ind];
 
     epicsEventWait(startStopEvent);
 }
+
+/* Pick the shard of a periodic scan list that a record belongs on,
+ * called with ppsl->shardLock held.
+ */
+static scan_list *periodicShardList(periodic_scan_list *ppsl,
+    struct dbCommon *precord)
+{
+    scan_element *pse = precord->spvt;
+    int i;
+
+    if (ppsl->nShards == 1)
+        return &ppsl->shards[0].scan_list;
+
+    /* Lock sets may have been merged since the record was added */
+    if (pse && pse->pscan_list) {
+        for (i = 0; i < ppsl->nShards; i++) {
+            if (pse->pscan_list == &ppsl->shards[i].scan_list)
+                return pse->pscan_list;
+        }
+    }
+    i = dbLockGetLockId(precord) % ppsl->nShards;
+    return &ppsl->shards[i].scan_list;
+}
+
+/* Move records to the shard of their lock set after lock sets have been
+ * merged or split.  Called between scans, so the shard threads are idle.
+ */
+static void reshardPeriodic(periodic_scan_list *ppsl)
+{
+    size_t changes = dbLockChangeCount();
+    ELLLIST moved = ELLLIST_INIT;
+    scan_element *pse;
+    int i;
+
+    if (ppsl->nShards == 1 || changes == ppsl->lockChanges)
+        return;
+
+    epicsMutexMustLock(ppsl->shardLock);
+    ppsl->lockChanges = changes;
+    for (i = 0; i < ppsl->nShards; i++) {
+        scan_list *psl = &ppsl->shards[i].scan_list;
+
+        epicsMutexMustLock(psl->lock);
+        pse = (scan_element *)ellFirst(&psl->list);
+        while (pse) {
+            scan_element *pnext = (scan_element *)ellNext(&pse->node);
+            int shard = dbLockGetLockId(pse->precord) % ppsl->nShards;
+
+            if (shard != i) {
+                ellDelete(&psl->list, &pse->node);
+                ellAdd(&moved, &pse->node);
+                psl->modified = TRUE;
+            }
+            pse = pnext;
+        }
+        epicsMutexUnlock(psl->lock);
+    }
+    while ((pse = (scan_element *)ellGet(&moved))) {
+        struct dbCommon *precord = pse->precord;
+        int shard = dbLockGetLockId(precord) % ppsl->nShards;
+
+        addToList(precord, &ppsl->shards[shard].scan_list);
+    }
+    epicsMutexUnlock(ppsl->shardLock);
+}
+
+/* Process one shard, recording its execution time */
+static void scanShard(periodic_shard *pps)
+{
+    epicsTimeStamp start, end;
+    double elapsed;
+
+    epicsTimeGetMonotonic(&start);
+    scanList(&pps->scan_list);
+    epicsTimeGetMonotonic(&end);
+
+    elapsed = epicsTimeDiffInSeconds(&end, &start);
+    pps->lastTime = elapsed;
+    pps->sumTime += elapsed;
+    if (elapsed > pps->maxTime)
+        pps->maxTime = elapsed;
+    if (elapsed > pps->ppsl->period)
+        pps->overruns++;
+    pps->nScans++;
+}
+
+/* Run all shards of a periodic scan list and wait for them to finish.
+ * Shard 0 runs in the calling thread.  When shardsExit has been set the
+ * shard threads exit instead.
+ */
+static void scanShards(periodic_scan_list *ppsl)
+{
+    int i;
+
+    if (ppsl->nShards > 1) {
+        epicsAtomicSetIntT(&ppsl->shardsBusy, ppsl->nShards - 1);
+        for (i = 1; i < ppsl->nShards; i++)
+            epicsEventMustTrigger(ppsl->shards[i].startEvent);
+    }
+
+    if (!ppsl->shardsExit)
+        scanShard(&ppsl->shards[0]);
+
+    while (epicsAtomicGetIntT(&ppsl->shardsBusy) > 0)
+        epicsEventMustWait(ppsl->shardsDone);
+}
 
 static void ioscanCallback(epicsCallback *pcallback)
 {
@@ -67,6 +67,7 @@ epicsShareFunc int scanOnceCallback(struct dbCommon *, once_complete cb, void *u
 epicsShareFunc int scanOnceSetQueueSize(int size);
 epicsShareFunc int scanOnceQueueStatus(const int reset, scanOnceQueueStats *result);
 epicsShareFunc void scanOnceQueueShow(const int reset);
+epicsShareFunc int scanPeriodicSetThreads(int count);
 
 /*print periodic lists*/
 epicsShareFunc int scanppl(double rate);
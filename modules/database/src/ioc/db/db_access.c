@@ -40,6 +40,7 @@
 #include "dbChannel.h"
 #include "dbCommon.h"
 #include "dbEvent.h"
+#include "db_field_log.h"
 #include "dbLock.h"
 #include "dbNotify.h"
 #include "dbStaticLib.h"
@@ -805,6 +806,59 @@ int dbChannel_get_count(
     return 0;
 }
 
+/* Returns the array data of a shared snapshot field log if it can be used
+ * without conversion as the value of a plain buffer_type request, and sets
+ * *phold to a handle that keeps it alive until it is released with
+ * db_release_field_log_data().  *nRequest is reduced to the number of
+ * elements available.  Returns NULL if the caller must copy the data with
+ * dbChannel_get_count() instead. */
+const void * dbChannel_get_ref(struct dbChannel *chan,
+    int buffer_type, long *nRequest, void *pfl, void **phold)
+{
+    db_field_log *plog = pfl;
+    short field_type;
+
+    switch (buffer_type) {
+    case(oldDBR_STRING):
+        field_type = DBF_STRING;
+        break;
+    case(oldDBR_SHORT):
+        field_type = DBF_SHORT;
+        break;
+    case(oldDBR_FLOAT):
+        field_type = DBF_FLOAT;
+        break;
+    case(oldDBR_ENUM):
+        field_type = DBF_ENUM;
+        break;
+    case(oldDBR_CHAR):
+        field_type = DBF_CHAR;
+        break;
+    case(oldDBR_LONG):
+        field_type = DBF_LONG;
+        break;
+    case(oldDBR_DOUBLE):
+        field_type = DBF_DOUBLE;
+        break;
+    default:
+        return NULL;
+    }
+
+    /* signed and unsigned chars have the same representation */
+    if (!plog || plog->type != dbfl_type_ref || !(plog->field_type ==
+            field_type || (field_type == DBF_CHAR &&
+            plog->field_type == DBF_UCHAR)))
+        return NULL;
+
+    *phold = db_hold_field_log_data(plog);
+    if (!*phold)
+        return NULL;
+
+    if (*nRequest > plog->no_elements)
+        *nRequest = plog->no_elements;
+    return plog->u.r.field;
+}
+
 int dbChannel_put(struct dbChannel *chan, int src_type,
     const void *psrc, long no_elements)
 {
@@ -36,6 +36,8 @@ epicsShareFunc int dbChannel_put(struct dbChannel *chan, int src_type,
     const void *psrc, long no_elements);
 epicsShareFunc int dbChannel_get_count(struct dbChannel *chan,
     int buffer_type, void *pbuffer, long *nRequest, void *pfl);
+epicsShareFunc const void * dbChannel_get_ref(struct dbChannel *chan,
+    int buffer_type, long *nRequest, void *pfl, void **phold);
 
 
 #ifdef __cplusplus
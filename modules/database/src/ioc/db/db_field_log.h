@@ -121,6 +121,10 @@ typedef struct db_field_log {
  *  (see struct dbfl_ref).
  *  For this type all meta-data members are used.  The dbfl_ref side of the
  *  data union is used.
+ *  The referenced data may be shared with other field logs (array snapshots
+ *  made by db_post_events() when dbEventArraySnapshots is set), so it must
+ *  be treated as read-only.  Code which wants to modify it must make a copy
+ *  and then release the original by calling its dtor.
  *
  * dbfl_type_val - Internal value
  *  Used to store small scalar data.  Meta-data and value are
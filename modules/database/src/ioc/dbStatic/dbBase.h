@@ -111,6 +111,7 @@ typedef struct dbInfoNode {         /*non-field per-record information*/
 #define DBRN_FLAGS_VISIBLE 1
 #define DBRN_FLAGS_ISALIAS 2
 #define DBRN_FLAGS_HASALIAS 4
+#define DBRN_FLAGS_PACKED 8 /* precord is in dbBase::recordArena */
 
 typedef struct dbRecordNode {
     ELLNODE         node;
@@ -184,5 +185,6 @@ typedef struct dbBase {
     struct gphPvt   *pgpHash;
     short           ignoreMissingMenus;
     short           loadCdefs;
+    void            *recordArena;   /* see dbLockPackRecords() */
 }dbBase;
 #endif
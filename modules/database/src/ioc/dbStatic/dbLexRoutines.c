@@ -18,11 +18,22 @@
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#  include <unistd.h>
+#  ifdef _POSIX_MAPPED_FILES
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    define DBCACHE_MMAP
+#  endif
+#endif
+
 #include "dbDefs.h"
 #include "dbmf.h"
 #include "ellLib.h"
 #include "epicsPrint.h"
 #include "epicsString.h"
+#include "epicsTypes.h"
 #include "errMdef.h"
 #include "freeList.h"
 #include "gpHash.h"
@@ -55,6 +66,9 @@ epicsExportAddress(int,dbQuietMacroWarnings);
 int dbRecordsAbcSorted=0;
 epicsExportAddress(int,dbRecordsAbcSorted);
 
+unsigned long dbCacheLoads=0;
+unsigned long dbCacheStores=0;
+
 /*private routines */
 static void yyerrorAbort(char *str);
 static void allocTemp(void *pvoid);
@@ -92,6 +106,13 @@ static void dbRecordHead(char *recordType,char*name,int visible);
 static void dbRecordField(char *name,char *value);
 static void dbRecordBody(void);
 
+static int dbCacheLoad(const char *filename, const char *dbpath,
+        const char *substitutions, long *pstatus);
+static void dbCacheEnd(long status);
+static void dbCacheRecordHead(const char *recordType, const char *name,
+        int visible);
+static void dbCacheOp(char op, const char *str1, const char *str2);
+
 /*private declarations*/
 #define MY_BUFFER_SIZE 1024
 static char *my_buffer=NULL;
@@ -104,6 +125,8 @@ typedef struct inputFile{
     char        *filename;
     FILE        *fp;
     int         line_num;
+    epicsUInt64 size;       /* bytes read, for database images */
+    epicsUInt64 hash;
 }inputFile;
 static ELLLIST inputFileList = ELLLIST_INIT;
 
@@ -118,6 +141,15 @@ typedef struct tempListNode {
 static ELLLIST tempList = ELLLIST_INIT;
 static void *freeListPvt = NULL;
 static int duplicate = FALSE;
+
+#define DBCACHE_HASH_INIT 14695981039346656037ULL
+#define DBCACHE_HASH_PRIME 1099511628211ULL
+
+static void dbCacheAddFile(const inputFile *pinputFile);
+static void dbCacheLine(const char *line);
+static void dbCacheDisable(void);
+static void dbCacheRecordField(DBENTRY *pdbentry, const char *name,
+        const char *value);
 
 static void yyerrorAbort(char *str)
 {
@@ -217,7 +249,7 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
 {
     long        status;
     inputFile   *pinputFile = NULL;
-    char        *penv;
+    const char  *dbpath;
     char        **macPairs;
 
     if (ellCount(&tempList)) {
@@ -230,15 +262,12 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
     if(*ppdbbase == 0) *ppdbbase = dbAllocBase();
     pdbbase = *ppdbbase;
     if(path && strlen(path)>0) {
-        dbPath(pdbbase,path);
+        dbpath = path;
     } else {
-        penv = getenv("EPICS_DB_INCLUDE_PATH");
-        if(penv) {
-            dbPath(pdbbase,penv);
-        } else {
-            dbPath(pdbbase,".");
-        }
+        dbpath = getenv("EPICS_DB_INCLUDE_PATH");
+        if(!dbpath) dbpath = ".";
     }
+    dbPath(pdbbase,dbpath);
     my_buffer = dbCalloc(MY_BUFFER_SIZE,sizeof(char));
     freeListInitPvt(&freeListPvt,sizeof(tempListNode),100);
     if(substitutions) {
@@ -259,9 +288,16 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
         macSuppressWarning(macHandle,dbQuietMacroWarnings);
     }
     pinputFile = dbCalloc(1,sizeof(inputFile));
+    pinputFile->hash = DBCACHE_HASH_INIT;
     if (filename) {
         pinputFile->filename = macEnvExpand(filename);
     }
+    if (!fp && pinputFile->filename &&
+        dbCacheLoad(pinputFile->filename, dbpath, substitutions, &status)) {
+        free(pinputFile->filename);
+        free(pinputFile);
+        goto loaded;
+    }
     if (!fp) {
         FILE *fp1 = 0;
 
@@ -286,6 +322,7 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
     ellAdd(&inputFileList,&pinputFile->node);
     status = pvt_yy_parse();
 
+loaded:
     if (ellCount(&tempList) && !yyAbort)
         epicsPrintf("dbReadCOM: Parser stack dirty w/o error. %d\n", ellCount(&tempList));
     while (ellCount(&tempList))
@@ -315,6 +352,7 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
         dbFinishEntry(pdbEntry);
     }
 cleanup:
+    dbCacheEnd(status);
     if(dbRecordsAbcSorted) {
         ELLNODE *cur;
         for(cur = ellFirst(&pdbbase->recordTypeList); cur; cur=ellNext(cur))
@@ -361,12 +399,16 @@ static int db_yyinput(char *buf, int max_size)
                     if (exp < 0) {
                         fprintf(stderr, "Warning: '%s' line %d has undefined macros\n",
                             pinputFileNow->filename, pinputFileNow->line_num+1);
+                        dbCacheDisable();
                     }
+                    dbCacheLine(mac_input_buffer);
                 }
             } else {
                 fgetsRtn = fgets(my_buffer,MY_BUFFER_SIZE,pinputFileNow->fp);
+                if(fgetsRtn) dbCacheLine(my_buffer);
             }
             if(fgetsRtn) break;
+            dbCacheAddFile(pinputFileNow);
             if(fclose(pinputFileNow->fp))
                 errPrintf(0,__FILE__, __LINE__,
                         "Closing file %s",pinputFileNow->filename);
@@ -408,11 +450,13 @@ static void dbIncludePrint(void)
 
 static void dbPathCmd(char *path)
 {
+    dbCacheDisable();
     dbPath(pdbbase,path);
 }
 
 static void dbAddPathCmd(char *path)
 {
+    dbCacheDisable();
     dbAddPath(pdbbase,path);
 }
 
@@ -422,6 +466,7 @@ static void dbIncludeNew(char *filename)
     FILE        *fp;
 
     pinputFile = dbCalloc(1,sizeof(inputFile));
+    pinputFile->hash = DBCACHE_HASH_INIT;
     pinputFile->filename = macEnvExpand(filename);
     pinputFile->path = dbOpenFile(pdbbase, pinputFile->filename, &fp);
     if (!fp) {
@@ -441,6 +486,7 @@ static void dbMenuHead(char *name)
     dbMenu              *pdbMenu;
     GPHENTRY            *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbMenuHead: Menu name can't be empty");
         return;
@@ -513,6 +559,7 @@ static void dbRecordtypeHead(char *name)
     dbRecordType        *pdbRecordType;
     GPHENTRY            *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbRecordtypeHead: Recordtype name can't be empty");
         return;
@@ -790,6 +837,8 @@ static void dbDevice(char *recordtype,char *linktype,
     dbRecordType        *pdbRecordType;
     GPHENTRY            *pgphentry;
     int                 i,link_type;
+
+    dbCacheDisable();
     pgphentry = gphFind(pdbbase->pgpHash,recordtype,&pdbbase->recordTypeList);
     if(!pgphentry) {
         epicsPrintf("Record type \"%s\" not found for device \"%s\"\n",
@@ -833,6 +882,7 @@ static void dbDriver(char *name)
     drvSup      *pdrvSup;
     GPHENTRY    *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbDriver: Driver name can't be empty");
         return;
@@ -856,6 +906,7 @@ static void dbLinkType(char *name, char *jlif_name)
     linkSup *pLinkSup;
     GPHENTRY *pgphentry;
 
+    dbCacheDisable();
     pgphentry = gphFind(pdbbase->pgpHash, name, &pdbbase->linkList);
     if (pgphentry) {
         return;
@@ -876,6 +927,7 @@ static void dbRegistrar(char *name)
     dbText      *ptext;
     GPHENTRY    *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbRegistrar: Registrar name can't be empty");
         return;
@@ -899,6 +951,7 @@ static void dbFunction(char *name)
     dbText     *ptext;
     GPHENTRY   *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbFunction: Function name can't be empty");
         return;
@@ -922,6 +975,7 @@ static void dbVariable(char *name, char *type)
     dbVariableDef       *pvar;
     GPHENTRY            *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbVariable: Variable name can't be empty");
         return;
@@ -946,6 +1000,7 @@ static void dbBreakHead(char *name)
     brkTable    *pbrkTable;
     GPHENTRY    *pgphentry;
 
+    dbCacheDisable();
     if (!*name) {
         yyerrorAbort("dbBreakHead: Breaktable name can't be empty");
         return;
@@ -1092,6 +1147,7 @@ static void dbRecordHead(char *recordType, char *name, int visible)
     DBENTRY *pdbentry;
     long status;
 
+    dbCacheRecordHead(recordType, name, visible);
     if(dbRecordNameValidate(name))
         return;
 
@@ -1191,6 +1247,7 @@ static void dbRecordField(char *name,char *value)
         yyerror(NULL);
         return;
     }
+    dbCacheRecordField(pdbentry, name, value);
 }
 
 static void dbRecordInfo(char *name, char *value)
@@ -1221,6 +1278,7 @@ static void dbRecordInfo(char *name, char *value)
         yyerror(NULL);
         return;
     }
+    dbCacheOp('I', name, value);
 }
 
 static void dbRecordAlias(char *name)
@@ -1229,6 +1287,7 @@ static void dbRecordAlias(char *name)
     tempListNode *ptempListNode;
     long status;
 
+    dbCacheOp('A', name, NULL);
     if(dbRecordNameValidate(name))
         return;
 
@@ -1249,6 +1308,7 @@ static void dbAlias(char *name, char *alias)
     DBENTRY dbEntry;
     DBENTRY *pdbEntry = &dbEntry;
 
+    dbCacheOp('G', name, alias);
     if(dbRecordNameValidate(alias))
         return;
 
@@ -1270,6 +1330,7 @@ static void dbRecordBody(void)
 {
     DBENTRY *pdbentry;
 
+    dbCacheOp('E', NULL, NULL);
     if (duplicate) {
         duplicate = FALSE;
         return;
@@ -1279,3 +1340,664 @@ static void dbRecordBody(void)
         yyerrorAbort("dbRecordBody: tempList not empty");
     dbFreeEntry(pdbentry);
 }
+
+/* Precompiled database images
+ *
+ * When EPICS_DB_CACHE_DIR names a directory, the parse of an instance
+ * database is recorded as a trace of its record, field, info and alias
+ * statements, with the values of string, numeric, menu and device
+ * fields already converted to their native form.  A later load of the
+ * same file with the same macros and search path maps the image and
+ * replays the trace instead of running the parser.  The image is only
+ * used if it was made against the same record type layouts and all of
+ * its input files, included ones too, still resolve to the same paths
+ * and content; otherwise the text is parsed and the image rewritten.
+ */
+
+#define DBCACHE_MAGIC "EPICSDBC"
+#define DBCACHE_VERSION 1
+#define DBCACHE_ENDIAN 0x01020304u
+
+typedef struct dbCacheHeader {
+    char        magic[8];
+    epicsUInt32 version;
+    epicsUInt32 endian;
+    epicsUInt32 nfiles;     /* input files described in the key */
+    epicsUInt32 spare;
+    epicsUInt64 layout;     /* dbCacheLayout() of the dbBase */
+    epicsUInt64 keyLen;     /* bytes of key after the header */
+    epicsUInt64 length;     /* bytes in the whole image */
+    epicsUInt64 check;      /* hash of everything after the header */
+} dbCacheHeader;
+
+typedef struct dbCacheBuf {
+    char        *buf;
+    size_t      len;
+    size_t      size;
+} dbCacheBuf;
+
+static struct {
+    char        *image;     /* name of the image, NULL if not recording */
+    int         ok;         /* cleared by statements an image can't hold */
+    epicsUInt32 nfiles;
+    epicsUInt64 layout;
+    dbCacheBuf  key;
+    dbCacheBuf  ops;
+} cacheWriter;
+
+typedef struct dbCacheReader {
+    char        *pos;
+    char        *end;
+    int         bad;
+} dbCacheReader;
+
+static epicsUInt64 dbCacheHash(epicsUInt64 hash, const void *pmem, size_t len)
+{
+    const unsigned char *pbyte = pmem;
+
+    /* 64-bit FNV-1a, which can be fed in pieces */
+    while (len--) {
+        hash ^= *pbyte++;
+        hash *= DBCACHE_HASH_PRIME;
+    }
+    return hash;
+}
+
+static epicsUInt64 dbCacheHashStr(epicsUInt64 hash, const char *str)
+{
+    return dbCacheHash(hash, str, strlen(str) + 1);
+}
+
+static epicsUInt64 dbCacheLayout(DBBASE *pdbbase)
+{
+    epicsUInt64 hash = DBCACHE_HASH_INIT;
+    dbMenu *pdbMenu;
+    dbRecordType *precordType;
+
+    hash = dbCacheHash(hash, &dbConvertStrict, sizeof(dbConvertStrict));
+    for (pdbMenu = (dbMenu *)ellFirst(&pdbbase->menuList); pdbMenu;
+         pdbMenu = (dbMenu *)ellNext(&pdbMenu->node)) {
+        int i;
+
+        hash = dbCacheHashStr(hash, pdbMenu->name);
+        for (i = 0; i < pdbMenu->nChoice; i++)
+            hash = dbCacheHashStr(hash, pdbMenu->papChoiceValue[i]);
+    }
+    for (precordType = (dbRecordType *)ellFirst(&pdbbase->recordTypeList);
+         precordType;
+         precordType = (dbRecordType *)ellNext(&precordType->node)) {
+        devSup *pdevSup;
+        int i;
+
+        hash = dbCacheHashStr(hash, precordType->name);
+        hash = dbCacheHash(hash, &precordType->rec_size,
+            sizeof(precordType->rec_size));
+        for (i = 0; i < precordType->no_fields; i++) {
+            dbFldDes *pflddes = precordType->papFldDes[i];
+
+            hash = dbCacheHashStr(hash, pflddes->name);
+            hash = dbCacheHash(hash, &pflddes->field_type,
+                sizeof(pflddes->field_type));
+            hash = dbCacheHash(hash, &pflddes->size, sizeof(pflddes->size));
+            hash = dbCacheHash(hash, &pflddes->offset,
+                sizeof(pflddes->offset));
+        }
+        for (pdevSup = (devSup *)ellFirst(&precordType->devList); pdevSup;
+             pdevSup = (devSup *)ellNext(&pdevSup->node))
+            hash = dbCacheHashStr(hash, pdevSup->choice);
+    }
+    return hash;
+}
+
+static void dbCacheDisable(void)
+{
+    cacheWriter.ok = FALSE;
+}
+
+static void dbCacheLine(const char *line)
+{
+    size_t len;
+
+    if (!cacheWriter.image)
+        return;
+    len = strlen(line);
+    pinputFileNow->size += len;
+    pinputFileNow->hash = dbCacheHash(pinputFileNow->hash, line, len);
+}
+
+static void dbCachePut(dbCacheBuf *pbuf, const void *pmem, size_t len)
+{
+    if (!cacheWriter.ok)
+        return;
+    if (pbuf->len + len > pbuf->size) {
+        size_t size = pbuf->size ? pbuf->size : 4096;
+        char *buf;
+
+        while (size < pbuf->len + len)
+            size *= 2;
+        buf = realloc(pbuf->buf, size);
+        if (!buf) {
+            cacheWriter.ok = FALSE;
+            return;
+        }
+        pbuf->buf = buf;
+        pbuf->size = size;
+    }
+    memcpy(pbuf->buf + pbuf->len, pmem, len);
+    pbuf->len += len;
+}
+
+static void dbCachePutBlob(dbCacheBuf *pbuf, const void *pmem, size_t len)
+{
+    epicsUInt32 len32 = (epicsUInt32) len;
+
+    dbCachePut(pbuf, &len32, sizeof(len32));
+    dbCachePut(pbuf, pmem, len);
+    dbCachePut(pbuf, "", 1);
+}
+
+static void dbCachePutStr(dbCacheBuf *pbuf, const char *str)
+{
+    dbCachePutBlob(pbuf, str, strlen(str));
+}
+
+static void dbCachePutOp(char op, const char *str1, const char *str2)
+{
+    dbCachePut(&cacheWriter.ops, &op, 1);
+    if (str1)
+        dbCachePutStr(&cacheWriter.ops, str1);
+    if (str2)
+        dbCachePutStr(&cacheWriter.ops, str2);
+}
+
+static void dbCacheRecordHead(const char *recordType, const char *name,
+    int visible)
+{
+    char vis = (char) visible;
+
+    if (!cacheWriter.image)
+        return;
+    dbCachePutOp('R', NULL, NULL);
+    dbCachePut(&cacheWriter.ops, &vis, 1);
+    dbCachePutStr(&cacheWriter.ops, recordType);
+    dbCachePutStr(&cacheWriter.ops, name);
+}
+
+static void dbCacheOp(char op, const char *str1, const char *str2)
+{
+    if (cacheWriter.image)
+        dbCachePutOp(op, str1, str2);
+}
+
+/* Field puts that worked are saved in native form when possible */
+static void dbCacheRecordField(DBENTRY *pdbentry, const char *name,
+    const char *value)
+{
+    dbFldDes *pflddes = pdbentry->pflddes;
+    char native;
+
+    if (!cacheWriter.image)
+        return;
+    native = pflddes->field_type <= DBF_DEVICE && pdbentry->pfield;
+    dbCachePutOp('F', name, NULL);
+    dbCachePut(&cacheWriter.ops, &native, 1);
+    if (!native)
+        dbCachePutStr(&cacheWriter.ops, value);
+    else if (pflddes->field_type == DBF_STRING)
+        dbCachePutStr(&cacheWriter.ops, pdbentry->pfield);
+    else
+        dbCachePutBlob(&cacheWriter.ops, pdbentry->pfield, pflddes->size);
+}
+
+static void dbCacheAddFile(const inputFile *pinputFile)
+{
+    char *fullname;
+
+    if (!cacheWriter.image)
+        return;
+    if (!pinputFile->filename) {
+        cacheWriter.ok = FALSE;
+        return;
+    }
+    fullname = dbMalloc((pinputFile->path ? strlen(pinputFile->path) : 0) +
+        strlen(pinputFile->filename) + 2);
+    fullname[0] = 0;
+    if (pinputFile->path) {
+        strcpy(fullname, pinputFile->path);
+        strcat(fullname, "/");
+    }
+    strcat(fullname, pinputFile->filename);
+    dbCachePutStr(&cacheWriter.key, pinputFile->filename);
+    dbCachePutStr(&cacheWriter.key, fullname);
+    dbCachePut(&cacheWriter.key, &pinputFile->size, sizeof(epicsUInt64));
+    dbCachePut(&cacheWriter.key, &pinputFile->hash, sizeof(epicsUInt64));
+    cacheWriter.nfiles++;
+    free(fullname);
+}
+
+static void dbCacheWrite(void)
+{
+    dbCacheHeader header;
+    char *tmpname;
+    FILE *fp;
+    int ok;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DBCACHE_MAGIC, sizeof(header.magic));
+    header.version = DBCACHE_VERSION;
+    header.endian = DBCACHE_ENDIAN;
+    header.nfiles = cacheWriter.nfiles;
+    header.layout = cacheWriter.layout;
+    header.keyLen = cacheWriter.key.len;
+    header.length = sizeof(header) + cacheWriter.key.len +
+        cacheWriter.ops.len;
+    header.check = dbCacheHash(DBCACHE_HASH_INIT, cacheWriter.key.buf,
+        cacheWriter.key.len);
+    header.check = dbCacheHash(header.check, cacheWriter.ops.buf,
+        cacheWriter.ops.len);
+
+    /* Write a temporary file and rename it so readers never see a
+     * partial image.
+     */
+    tmpname = dbMalloc(strlen(cacheWriter.image) + 5);
+    strcpy(tmpname, cacheWriter.image);
+    strcat(tmpname, ".tmp");
+    fp = fopen(tmpname, "wb");
+    ok = fp &&
+        fwrite(&header, sizeof(header), 1, fp) == 1 &&
+        fwrite(cacheWriter.key.buf, 1, cacheWriter.key.len, fp) ==
+            cacheWriter.key.len &&
+        fwrite(cacheWriter.ops.buf, 1, cacheWriter.ops.len, fp) ==
+            cacheWriter.ops.len;
+    if (fp && fclose(fp))
+        ok = FALSE;
+    if (ok && rename(tmpname, cacheWriter.image)) {
+        /* Some systems won't rename over an existing file */
+        remove(cacheWriter.image);
+        ok = !rename(tmpname, cacheWriter.image);
+    }
+    if (ok) {
+        dbCacheStores++;
+    }
+    else {
+        errlogPrintf("dbReadDatabase: Can't write database image \"%s\"\n",
+            cacheWriter.image);
+        if (fp)
+            remove(tmpname);
+    }
+    free(tmpname);
+}
+
+static void dbCacheEnd(long status)
+{
+    if (!cacheWriter.image)
+        return;
+    if (!status && cacheWriter.ok)
+        dbCacheWrite();
+    free(cacheWriter.image);
+    free(cacheWriter.key.buf);
+    free(cacheWriter.ops.buf);
+    memset(&cacheWriter, 0, sizeof(cacheWriter));
+}
+
+static void dbCacheGet(dbCacheReader *preader, void *pmem, size_t len)
+{
+    if (preader->bad || (size_t)(preader->end - preader->pos) < len) {
+        preader->bad = TRUE;
+        memset(pmem, 0, len);
+        return;
+    }
+    memcpy(pmem, preader->pos, len);
+    preader->pos += len;
+}
+
+/* Returns a pointer into the image, which is writable */
+static char *dbCacheGetBlob(dbCacheReader *preader, size_t *plen)
+{
+    epicsUInt32 len;
+    char *pmem;
+
+    dbCacheGet(preader, &len, sizeof(len));
+    if (preader->bad || (size_t)(preader->end - preader->pos) <= len ||
+        preader->pos[len]) {
+        preader->bad = TRUE;
+        *plen = 0;
+        return "";
+    }
+    pmem = preader->pos;
+    preader->pos += len + 1;
+    *plen = len;
+    return pmem;
+}
+
+static char *dbCacheGetStr(dbCacheReader *preader)
+{
+    size_t len;
+
+    return dbCacheGetBlob(preader, &len);
+}
+
+static int dbCacheCheckFile(dbCacheReader *preader)
+{
+    char *filename = dbCacheGetStr(preader);
+    char *fullname = dbCacheGetStr(preader);
+    epicsUInt64 size, hash, fileSize = 0, fileHash = DBCACHE_HASH_INIT;
+    char *path;
+    FILE *fp;
+    int ok;
+
+    dbCacheGet(preader, &size, sizeof(size));
+    dbCacheGet(preader, &hash, sizeof(hash));
+    if (preader->bad)
+        return FALSE;
+
+    /* The file must still be the first one found on the path */
+    path = dbOpenFile(pdbbase, filename, &fp);
+    if (!fp)
+        return FALSE;
+    if (path) {
+        size_t len = strlen(path);
+
+        ok = strncmp(fullname, path, len) == 0 && fullname[len] == '/' &&
+            strcmp(fullname + len + 1, filename) == 0;
+    }
+    else {
+        ok = strcmp(fullname, filename) == 0;
+    }
+
+    while (ok) {
+        char buf[8192];
+        size_t n = fread(buf, 1, sizeof(buf), fp);
+
+        if (!n)
+            break;
+        fileHash = dbCacheHash(fileHash, buf, n);
+        fileSize += n;
+    }
+    fclose(fp);
+    return ok && fileSize == size && fileHash == hash;
+}
+
+static void dbCacheReplayField(dbCacheReader *preader)
+{
+    char *name = dbCacheGetStr(preader);
+    DBENTRY *pdbentry;
+    dbFldDes *pflddes;
+    char native;
+    char *value;
+    size_t len;
+    long status;
+
+    dbCacheGet(preader, &native, 1);
+    value = dbCacheGetBlob(preader, &len);
+    if (duplicate || preader->bad)
+        return;
+    pdbentry = ((tempListNode *)ellFirst(&tempList))->item;
+    status = dbFindField(pdbentry, name);
+    pflddes = pdbentry->pflddes;
+    if (status || !native) {
+        if (!status)
+            status = dbPutString(pdbentry, value);
+    }
+    else if (!pdbentry->pfield || len > (size_t)pflddes->size) {
+        status = S_dbLib_badField;
+    }
+    else {
+        memcpy(pdbentry->pfield, value, len);
+        memset((char *)pdbentry->pfield + len, 0, pflddes->size - len);
+        if (strcmp(pflddes->name, "VAL") == 0) {
+            /* As dbPutString() does */
+            DBENTRY dbentry;
+
+            dbCopyEntryContents(pdbentry, &dbentry);
+            if (!dbFindField(&dbentry, "UDF"))
+                dbPutString(&dbentry, "0");
+            dbFinishEntry(&dbentry);
+        }
+    }
+    if (status) {
+        epicsPrintf("Can't set \"%s.%s\" from database image\n",
+            dbGetRecordName(pdbentry), name);
+        yyerror(NULL);
+    }
+}
+
+static void dbCacheReplayInfo(dbCacheReader *preader)
+{
+    char *name = dbCacheGetStr(preader);
+    char *value = dbCacheGetStr(preader);
+    DBENTRY *pdbentry;
+
+    if (duplicate || preader->bad)
+        return;
+    pdbentry = ((tempListNode *)ellFirst(&tempList))->item;
+    if (dbPutInfo(pdbentry, name, value)) {
+        epicsPrintf("Can't set \"%s\" info \"%s\" to \"%s\"\n",
+                    dbGetRecordName(pdbentry), name, value);
+        yyerror(NULL);
+    }
+}
+
+static long dbCacheReplay(dbCacheReader *preader, char *image)
+{
+    inputFile replayFile;
+
+    /* Errors are reported against the image */
+    memset(&replayFile, 0, sizeof(replayFile));
+    replayFile.filename = image;
+    pinputFileNow = &replayFile;
+    yyAbort = FALSE;
+    yyFailed = FALSE;
+    duplicate = FALSE;
+
+    while (preader->pos < preader->end && !preader->bad && !yyAbort) {
+        char op = *preader->pos++;
+
+        switch (op) {
+        case 'R': {
+                char visible, *recordType, *name;
+
+                dbCacheGet(preader, &visible, 1);
+                recordType = dbCacheGetStr(preader);
+                name = dbCacheGetStr(preader);
+                if (!preader->bad)
+                    dbRecordHead(recordType, name, visible);
+            }
+            break;
+        case 'F':
+            dbCacheReplayField(preader);
+            break;
+        case 'I':
+            dbCacheReplayInfo(preader);
+            break;
+        case 'A': {
+                char *name = dbCacheGetStr(preader);
+
+                if (!preader->bad)
+                    dbRecordAlias(name);
+            }
+            break;
+        case 'G': {
+                char *name = dbCacheGetStr(preader);
+                char *alias = dbCacheGetStr(preader);
+
+                if (!preader->bad)
+                    dbAlias(name, alias);
+            }
+            break;
+        case 'E':
+            dbRecordBody();
+            break;
+        default:
+            preader->bad = TRUE;
+        }
+    }
+    if (preader->bad)
+        yyerrorAbort("Corrupt database image");
+    pinputFileNow = NULL;
+    return (yyAbort || yyFailed) ? -1 : 0;
+}
+
+static int dbCacheMap(const char *image, char **pbase, size_t *plen)
+{
+#ifdef DBCACHE_MMAP
+    struct stat st;
+    void *base;
+    int fd = open(image, O_RDONLY);
+
+    if (fd < 0)
+        return FALSE;
+    if (fstat(fd, &st) || st.st_size < (off_t) sizeof(dbCacheHeader)) {
+        close(fd);
+        return FALSE;
+    }
+    /* A private mapping is copy-on-write, the replay edits strings */
+    base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return FALSE;
+    *pbase = base;
+    *plen = st.st_size;
+    return TRUE;
+#else
+    FILE *fp = fopen(image, "rb");
+    long len;
+    char *base;
+
+    if (!fp)
+        return FALSE;
+    if (fseek(fp, 0, SEEK_END) || (len = ftell(fp)) <
+        (long) sizeof(dbCacheHeader) || fseek(fp, 0, SEEK_SET)) {
+        fclose(fp);
+        return FALSE;
+    }
+    base = malloc(len);
+    if (!base || fread(base, 1, len, fp) != (size_t) len) {
+        free(base);
+        fclose(fp);
+        return FALSE;
+    }
+    fclose(fp);
+    *pbase = base;
+    *plen = len;
+    return TRUE;
+#endif
+}
+
+static void dbCacheUnmap(char *base, size_t len)
+{
+#ifdef DBCACHE_MMAP
+    munmap(base, len);
+#else
+    free(base);
+#endif
+}
+
+/* The image file for a load, NULL if images are disabled */
+static char * dbCacheImagePath(const char *filename, const char *dbpath,
+    const char *substitutions)
+{
+    const char *dir = getenv("EPICS_DB_CACHE_DIR");
+    epicsUInt64 hash = DBCACHE_HASH_INIT;
+    char *image;
+
+    if (!dir || !*dir)
+        return NULL;
+    if (!substitutions)
+        substitutions = "";
+
+    hash = dbCacheHashStr(hash, filename);
+    hash = dbCacheHashStr(hash, dbpath);
+    hash = dbCacheHashStr(hash, substitutions);
+    image = dbMalloc(strlen(dir) + 22);
+    sprintf(image, "%s/%08x%08x.dbc", dir,
+        (unsigned) (hash >> 32), (unsigned) (hash & 0xffffffffu));
+    return image;
+}
+
+char * dbCacheImageName(const char *filename, const char *path,
+    const char *substitutions)
+{
+    const char *dbpath = path;
+    char *expanded, *image;
+
+    if (!dbpath || !*dbpath) {
+        dbpath = getenv("EPICS_DB_INCLUDE_PATH");
+        if (!dbpath) dbpath = ".";
+    }
+    expanded = macEnvExpand(filename);
+    if (!expanded)
+        return NULL;
+    image = dbCacheImagePath(expanded, dbpath, substitutions);
+    free(expanded);
+    return image;
+}
+
+/* Returns TRUE if the database was loaded from an image, otherwise
+ * starts recording one if that's enabled.
+ */
+static int dbCacheLoad(const char *filename, const char *dbpath,
+    const char *substitutions, long *pstatus)
+{
+    epicsUInt64 layout;
+    char *image, *base;
+    size_t len;
+    int loaded = FALSE;
+
+    /* Only instance databases, not the DBD files */
+    if (!ellCount(&pdbbase->recordTypeList))
+        return FALSE;
+    image = dbCacheImagePath(filename, dbpath, substitutions);
+    if (!image)
+        return FALSE;
+    if (!substitutions)
+        substitutions = "";
+    layout = dbCacheLayout(pdbbase);
+
+    if (dbCacheMap(image, &base, &len)) {
+        dbCacheHeader header;
+        dbCacheReader reader;
+        epicsUInt32 i;
+        int ok;
+
+        memcpy(&header, base, sizeof(header));
+        ok = memcmp(header.magic, DBCACHE_MAGIC, sizeof(header.magic)) == 0 &&
+            header.version == DBCACHE_VERSION &&
+            header.endian == DBCACHE_ENDIAN &&
+            header.layout == layout &&
+            header.length == len &&
+            header.keyLen <= len - sizeof(header) &&
+            header.check == dbCacheHash(DBCACHE_HASH_INIT,
+                base + sizeof(header), len - sizeof(header));
+
+        reader.pos = base + sizeof(header);
+        reader.end = reader.pos + (ok ? header.keyLen : 0);
+        reader.bad = !ok;
+        ok = ok &&
+            strcmp(dbCacheGetStr(&reader), filename) == 0 &&
+            strcmp(dbCacheGetStr(&reader), dbpath) == 0 &&
+            strcmp(dbCacheGetStr(&reader), substitutions) == 0;
+        for (i = 0; ok && i < header.nfiles; i++)
+            ok = dbCacheCheckFile(&reader);
+
+        if (ok && !reader.bad) {
+            reader.end = base + len;
+            *pstatus = dbCacheReplay(&reader, image);
+            dbCacheLoads++;
+            loaded = TRUE;
+        }
+        dbCacheUnmap(base, len);
+    }
+    if (loaded) {
+        free(image);
+        return TRUE;
+    }
+
+    cacheWriter.image = image;
+    cacheWriter.ok = TRUE;
+    cacheWriter.layout = layout;
+    dbCachePutStr(&cacheWriter.key, filename);
+    dbCachePutStr(&cacheWriter.key, dbpath);
+    dbCachePutStr(&cacheWriter.key, substitutions);
+    return FALSE;
+}
@@ -17,28 +17,95 @@
 
 #include "dbDefs.h"
 #include "ellLib.h"
+#include "epicsAtomic.h"
 #include "epicsMutex.h"
 #include "epicsStdio.h"
 #include "epicsString.h"
+#include "epicsThread.h"
 
 #define epicsExportSharedSymbols
 #include "dbBase.h"
 #include "dbStaticLib.h"
 #include "dbStaticPvt.h"
 
+/*
+ * The directory is an open-addressing hash table with linear probing.
+ * Lookups take no locks: they announce themselves by incrementing a
+ * reader count, then probe the current table. Writers are serialized
+ * by a mutex; they never modify a slot that a reader may be using, they
+ * publish a new table or mark a slot as deleted and then wait until no
+ * reader that could still see the old data is running before freeing it.
+ * Each entry keeps its own copy of the name for lookups to compare, so a
+ * deleted entry doesn't depend on the record node; deleted entries are
+ * retired in batches to amortize the wait over many deletions.
+ *
+ * epicsAtomicSetPtrT() stores before its barrier and epicsAtomicGetPtrT()
+ * loads after it, so writers issue a write barrier before publishing a
+ * pointer and readers a read barrier after loading one, before they look
+ * at the data it guards (a slot's hash, a table or a filter).
+ *
+ * Reader counts come in two sets, selected by the low bit of the epoch,
+ * and are spread over several cache lines to keep concurrent lookups
+ * from different threads off each other's lines. A writer that needs to
+ * reclaim memory flips the epoch twice, each time waiting until the set
+ * of counts in use before the flip drops to zero.
+ *
+ * Once built by dbPvdFilterBuild() a blocked Bloom filter over all the
+ * names lets dbPvdMayExist() reject names that are not in the directory
+ * by looking at a single cache line. Names are added to the filter as
+ * they are added to the directory; deleted names are only removed when
+ * the filter is rebuilt, which happens whenever the table is resized or
+ * the filter has had more names added than it was sized for.
+ */
+
 typedef struct {
-    ELLLIST      list;
-    epicsMutexId lock;
-} dbPvdBucket;
+    unsigned int hash;          /* cached epicsStrHash() of the name */
+    PVDENTRY     *ppvdNode;     /* NULL if never used, use atomic */
+} dbPvdSlot;
 
-typedef struct dbPvd {
+typedef struct {
     unsigned int size;
     unsigned int mask;
-    dbPvdBucket **buckets;
+    dbPvdSlot    slots[1];      /* actually size */
+} dbPvdTable;
+
+#define FILTER_WORDS 16          /* 32-bit words per filter block */
+#define FILTER_BITS_PER_NAME 16
+#define FILTER_MIN_NAMES 256
+
+typedef struct {
+    unsigned int nblocks;       /* power of 2 */
+    unsigned int capacity;      /* names it was sized for */
+    unsigned int nadded;        /* names added */
+    epicsUInt32  blocks[1][FILTER_WORDS];   /* actually nblocks */
+} dbPvdFilter;
+
+#define NSTRIPES 16
+
+typedef union {
+    int  count;                 /* use atomic */
+    char pad[64];               /* one cache line per count */
+} dbPvdReaders;
+
+typedef struct dbPvd {
+    dbPvdTable   *table;        /* current table, use atomic */
+    dbPvdFilter  *filter;       /* NULL until built, use atomic */
+    epicsMutexId lock;          /* serializes writers */
+    unsigned int used;          /* slots used, including deleted ones */
+    unsigned int count;         /* live entries */
+    int          epoch;         /* use atomic */
+    ELLLIST      retired;       /* deleted entries, PVDENTRY::node */
+    dbPvdReaders readers[2][NSTRIPES];
 } dbPvd;
 
+/* Marks a slot whose entry was deleted, probes must continue past it */
+static PVDENTRY deletedEntry;
+
 unsigned int dbPvdHashTableSize = 0;
 
+/* Deleted entries are freed once this many have been retired */
+#define RETIRE_BATCH 256
+
 #define MIN_SIZE 256
 #define DEFAULT_SIZE 512
 #define MAX_SIZE 65536
@@ -61,6 +128,219 @@ int dbPvdTableSize(int size)
     return 0;
 }
 
+static dbPvdTable *tableCreate(unsigned int size)
+{
+    dbPvdTable *ptable = dbCalloc(1,
+        sizeof(dbPvdTable) + (size - 1) * sizeof(dbPvdSlot));
+
+    ptable->size = size;
+    ptable->mask = size - 1;
+    return ptable;
+}
+
+/* Reader side, the slot's hash may be read after this returns */
+static PVDENTRY * slotEntry(const dbPvdSlot *pslot)
+{
+    PVDENTRY *ppvdNode = (PVDENTRY *)
+        epicsAtomicGetPtrT((EpicsAtomicPtrT *) &pslot->ppvdNode);
+
+    epicsAtomicReadMemoryBarrier();
+    return ppvdNode;
+}
+
+/* Writer side, makes everything written so far visible first */
+static void publish(void *ppointer, void *value)
+{
+    epicsAtomicWriteMemoryBarrier();
+    epicsAtomicSetPtrT((EpicsAtomicPtrT *) ppointer, value);
+}
+
+/* Reader side, the data pointed to may be read after this returns */
+static void * acquire(void *ppointer)
+{
+    void *value = epicsAtomicGetPtrT((EpicsAtomicPtrT *) ppointer);
+
+    epicsAtomicReadMemoryBarrier();
+    return value;
+}
+
+/* Writer only, lock must be held. Returns the slot holding name or NULL */
+static dbPvdSlot * tableFind(dbPvdTable *ptable, const char *name,
+    unsigned int hash)
+{
+    unsigned int i = hash & ptable->mask;
+    PVDENTRY *ppvdNode;
+
+    while ((ppvdNode = ptable->slots[i].ppvdNode)) {
+        if (ppvdNode != &deletedEntry &&
+            ptable->slots[i].hash == hash &&
+            strcmp(name, ppvdNode->name) == 0)
+            return &ptable->slots[i];
+        i = (i + 1) & ptable->mask;
+    }
+    return NULL;
+}
+
+/* Writer only. Fills the first unused slot, never a deleted one which
+ * a reader may still be comparing against.
+ */
+static void tableInsert(dbPvdTable *ptable, PVDENTRY *ppvdNode,
+    unsigned int hash)
+{
+    unsigned int i = hash & ptable->mask;
+
+    while (ptable->slots[i].ppvdNode)
+        i = (i + 1) & ptable->mask;
+
+    ptable->slots[i].hash = hash;
+    publish(&ptable->slots[i].ppvdNode, ppvdNode);
+}
+
+/* Picks a filter block and 4 bits in it from the name's hash */
+static epicsUInt32 * filterBits(const dbPvdFilter *pfilter, unsigned int hash,
+    unsigned int bits[4])
+{
+    epicsUInt64 mix = hash * (((epicsUInt64) 0x9e3779b9u << 32) | 0x7f4a7c15u);
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        bits[i] = (unsigned int) (mix >> (28 + 9 * i)) & 0x1ff;
+    }
+    return (epicsUInt32 *) pfilter->blocks[hash & (pfilter->nblocks - 1)];
+}
+
+static void filterAdd(dbPvdFilter *pfilter, unsigned int hash)
+{
+    unsigned int bits[4];
+    epicsUInt32 *pblock = filterBits(pfilter, hash, bits);
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        pblock[bits[i] >> 5] |= 1u << (bits[i] & 31);
+    }
+    pfilter->nadded++;
+}
+
+static int filterTest(const dbPvdFilter *pfilter, unsigned int hash)
+{
+    unsigned int bits[4];
+    const epicsUInt32 *pblock = filterBits(pfilter, hash, bits);
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        if (!(pblock[bits[i] >> 5] & (1u << (bits[i] & 31))))
+            return 0;
+    }
+    return 1;
+}
+
+static int * readLock(dbPvd *ppvd)
+{
+    size_t stripe = ((size_t) epicsThreadGetIdSelf() >> 6) & (NSTRIPES - 1);
+    int *pcount = &ppvd->readers[epicsAtomicGetIntT(&ppvd->epoch) & 1]
+        [stripe].count;
+
+    epicsAtomicIncrIntT(pcount);
+    return pcount;
+}
+
+static void readUnlock(int *pcount)
+{
+    epicsAtomicDecrIntT(pcount);
+}
+
+/* Writer only, lock must be held. Returns when no lookup started before
+ * the call is still running.
+ */
+static void synchronize(dbPvd *ppvd)
+{
+    int pass;
+
+    for (pass = 0; pass < 2; pass++) {
+        dbPvdReaders *preaders = ppvd->readers[ppvd->epoch & 1];
+        int i;
+
+        epicsAtomicIncrIntT(&ppvd->epoch);
+        for (i = 0; i < NSTRIPES; i++) {
+            while (epicsAtomicGetIntT(&preaders[i].count))
+                epicsThreadSleep(0.0);
+        }
+    }
+}
+
+/* Writer only, lock must be held. Replaces the filter with one holding
+ * only the live entries, with room for as many again.
+ */
+static void filterRebuild(dbPvd *ppvd)
+{
+    dbPvdTable *ptable = ppvd->table;
+    dbPvdFilter *pold = ppvd->filter;
+    dbPvdFilter *pnew;
+    unsigned int capacity = ppvd->count * 2;
+    unsigned int nblocks = 1;
+    unsigned int i;
+
+    if (capacity < FILTER_MIN_NAMES)
+        capacity = FILTER_MIN_NAMES;
+    while (nblocks * FILTER_WORDS * 32 < capacity * FILTER_BITS_PER_NAME)
+        nblocks *= 2;
+
+    pnew = dbCalloc(1, sizeof(dbPvdFilter) +
+        (nblocks - 1) * sizeof(pnew->blocks[0]));
+    pnew->nblocks = nblocks;
+    pnew->capacity = capacity;
+    for (i = 0; i < ptable->size; i++) {
+        PVDENTRY *ppvdNode = ptable->slots[i].ppvdNode;
+
+        if (ppvdNode && ppvdNode != &deletedEntry)
+            filterAdd(pnew, ptable->slots[i].hash);
+    }
+    publish(&ppvd->filter, pnew);
+    if (pold) {
+        synchronize(ppvd);
+        free(pold);
+    }
+}
+
+/* Writer only, lock must be held. Frees the retired entries, no reader
+ * may still be looking at them.
+ */
+static void freeRetired(dbPvd *ppvd)
+{
+    ELLNODE *pnode;
+
+    while ((pnode = ellGet(&ppvd->retired)))
+        free(pnode);
+}
+
+/* Writer only, lock must be held. Moves the live entries to a new table,
+ * doubling its size if it is at least half full.
+ */
+static void tableResize(dbPvd *ppvd)
+{
+    dbPvdTable *pold = ppvd->table;
+    unsigned int size = pold->size;
+    dbPvdTable *pnew;
+    unsigned int i;
+
+    if ((ppvd->count + 1) * 2 > size)
+        size *= 2;
+    pnew = tableCreate(size);
+    for (i = 0; i < pold->size; i++) {
+        PVDENTRY *ppvdNode = pold->slots[i].ppvdNode;
+
+        if (ppvdNode && ppvdNode != &deletedEntry)
+            tableInsert(pnew, ppvdNode, pold->slots[i].hash);
+    }
+    publish(&ppvd->table, pnew);
+    ppvd->used = ppvd->count;
+    synchronize(ppvd);
+    free(pold);
+    freeRetired(ppvd);
+    if (ppvd->filter)
+        filterRebuild(ppvd);
+}
+
 void dbPvdInitPvt(dbBase *pdbbase)
 {
     dbPvd *ppvd;
@@ -71,10 +351,9 @@ void dbPvdInitPvt(dbBase *pdbbase)
         dbPvdHashTableSize = DEFAULT_SIZE;
     }
 
-    ppvd = (dbPvd *)dbMalloc(sizeof(dbPvd));
-    ppvd->size    = dbPvdHashTableSize;
-    ppvd->mask    = dbPvdHashTableSize - 1;
-    ppvd->buckets = dbCalloc(ppvd->size, sizeof(dbPvdBucket *));
+    ppvd = (dbPvd *)dbCalloc(1, sizeof(dbPvd));
+    ppvd->table = tableCreate(dbPvdHashTableSize);
+    ppvd->lock  = epicsMutexMustCreate();
 
     pdbbase->ppvd = ppvd;
     return;
@@ -83,118 +362,147 @@ void dbPvdInitPvt(dbBase *pdbbase)
 PVDENTRY *dbPvdFind(dbBase *pdbbase, const char *name, size_t lenName)
 {
     dbPvd *ppvd = pdbbase->ppvd;
-    dbPvdBucket *pbucket;
+    unsigned int hash = epicsMemHash(name, lenName, 0);
+    int *preaders = readLock(ppvd);
+    dbPvdTable *ptable = (dbPvdTable *) acquire(&ppvd->table);
+    unsigned int i = hash & ptable->mask;
     PVDENTRY *ppvdNode;
 
-    pbucket = ppvd->buckets[epicsMemHash(name, lenName, 0) & ppvd->mask];
-    if (pbucket == NULL) return NULL;
-
-    epicsMutexMustLock(pbucket->lock);
-    ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-    while (ppvdNode) {
-        const char *recordname = ppvdNode->precnode->recordname;
+    while ((ppvdNode = slotEntry(&ptable->slots[i]))) {
+        if (ppvdNode != &deletedEntry && ptable->slots[i].hash == hash) {
+            const char *recordname = ppvdNode->name;
 
-        if (strncmp(name, recordname, lenName) == 0 &&
-            strlen(recordname) == lenName)
-            break;
-        ppvdNode = (PVDENTRY *) ellNext((ELLNODE *)ppvdNode);
+            if (strncmp(name, recordname, lenName) == 0 &&
+                recordname[lenName] == '\0')
+                break;
+        }
+        i = (i + 1) & ptable->mask;
     }
-    epicsMutexUnlock(pbucket->lock);
+    readUnlock(preaders);
     return ppvdNode;
 }
-
+
 PVDENTRY *dbPvdAdd(dbBase *pdbbase, dbRecordType *precordType,
     dbRecordNode *precnode)
 {
     dbPvd *ppvd = pdbbase->ppvd;
-    dbPvdBucket *pbucket;
     PVDENTRY *ppvdNode;
     char *name = precnode->recordname;
-    unsigned int h;
+    unsigned int hash = epicsStrHash(name, 0);
 
-    h = epicsStrHash(name, 0) & ppvd->mask;
-    pbucket = ppvd->buckets[h];
-    if (pbucket == NULL) {
-        pbucket = dbCalloc(1, sizeof(dbPvdBucket));
-        ellInit(&pbucket->list);
-        pbucket->lock = epicsMutexCreate();
-        ppvd->buckets[h] = pbucket;
-    }
-
-    epicsMutexMustLock(pbucket->lock);
-    ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-    while (ppvdNode) {
-        if (strcmp(name, ppvdNode->precnode->recordname) == 0) {
-            epicsMutexUnlock(pbucket->lock);
-            return NULL;
-        }
-        ppvdNode = (PVDENTRY *) ellNext((ELLNODE *)ppvdNode);
+    epicsMutexMustLock(ppvd->lock);
+    if (tableFind(ppvd->table, name, hash)) {
+        epicsMutexUnlock(ppvd->lock);
+        return NULL;
     }
-    ppvdNode = dbCalloc(1, sizeof(PVDENTRY));
+    /* Keep at least a quarter of the slots unused so probes are short */
+    if ((ppvd->used + 1) * 4 > ppvd->table->size * 3)
+        tableResize(ppvd);
+
+    ppvdNode = dbCalloc(1, sizeof(PVDENTRY) + strlen(name) + 1);
     ppvdNode->precordType = precordType;
     ppvdNode->precnode = precnode;
-    ellAdd(&pbucket->list, (ELLNODE *)ppvdNode);
-    epicsMutexUnlock(pbucket->lock);
+    ppvdNode->name = strcpy((char *) (ppvdNode + 1), name);
+
+    /* Add to the filter first, so a lookup that can find the name in the
+     * table never has it rejected by the filter.
+     */
+    if (ppvd->filter)
+        filterAdd(ppvd->filter, hash);
+    tableInsert(ppvd->table, ppvdNode, hash);
+    ppvd->used++;
+    ppvd->count++;
+    if (ppvd->filter && ppvd->filter->nadded > ppvd->filter->capacity)
+        filterRebuild(ppvd);
+    epicsMutexUnlock(ppvd->lock);
     return ppvdNode;
 }
 
 void dbPvdDelete(dbBase *pdbbase, dbRecordNode *precnode)
 {
     dbPvd *ppvd = pdbbase->ppvd;
-    dbPvdBucket *pbucket;
-    PVDENTRY *ppvdNode;
+    dbPvdSlot *pslot;
     char *name = precnode->recordname;
 
-    pbucket = ppvd->buckets[epicsStrHash(name, 0) & ppvd->mask];
-    if (pbucket == NULL) return;
+    if (!name) return;
 
-    epicsMutexMustLock(pbucket->lock);
-    ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-    while (ppvdNode) {
-        if (ppvdNode->precnode &&
-            ppvdNode->precnode->recordname &&
-            strcmp(name, ppvdNode->precnode->recordname) == 0) {
-            ellDelete(&pbucket->list, (ELLNODE *)ppvdNode);
-            free(ppvdNode);
-            break;
+    epicsMutexMustLock(ppvd->lock);
+    pslot = tableFind(ppvd->table, name, epicsStrHash(name, 0));
+    if (pslot) {
+        PVDENTRY *ppvdNode = pslot->ppvdNode;
+
+        publish(&pslot->ppvdNode, &deletedEntry);
+        ppvd->count--;
+        ellAdd(&ppvd->retired, &ppvdNode->node);
+        if (ellCount(&ppvd->retired) >= RETIRE_BATCH) {
+            synchronize(ppvd);
+            freeRetired(ppvd);
         }
-        ppvdNode = (PVDENTRY *) ellNext((ELLNODE *)ppvdNode);
     }
-    epicsMutexUnlock(pbucket->lock);
+    epicsMutexUnlock(ppvd->lock);
     return;
 }
 
+void dbPvdFilterBuild(dbBase *pdbbase)
+{
+    dbPvd *ppvd = pdbbase->ppvd;
+
+    if (ppvd == NULL) return;
+
+    epicsMutexMustLock(ppvd->lock);
+    filterRebuild(ppvd);
+    epicsMutexUnlock(ppvd->lock);
+}
+
+int dbPvdMayExist(dbBase *pdbbase, const char *pname)
+{
+    dbPvd *ppvd = pdbbase->ppvd;
+    const char *pfn = strchr(pname, '.');
+    size_t lenName = pfn ? (size_t) (pfn - pname) : strlen(pname);
+    unsigned int hash = epicsMemHash(pname, lenName, 0);
+    dbPvdFilter *pfilter;
+    int *preaders;
+    int result = 1;
+
+    if (ppvd == NULL) return 0;
+
+    preaders = readLock(ppvd);
+    pfilter = (dbPvdFilter *) acquire(&ppvd->filter);
+    if (pfilter)
+        result = filterTest(pfilter, hash);
+    readUnlock(preaders);
+    return result;
+}
+
 void dbPvdFreeMem(dbBase *pdbbase)
 {
     dbPvd *ppvd = pdbbase->ppvd;
+    dbPvdTable *ptable;
     unsigned int h;
 
     if (ppvd == NULL) return;
     pdbbase->ppvd = NULL;
 
-    for (h = 0; h < ppvd->size; h++) {
-        dbPvdBucket *pbucket = ppvd->buckets[h];
-        PVDENTRY *ppvdNode;
+    ptable = ppvd->table;
+    for (h = 0; h < ptable->size; h++) {
+        PVDENTRY *ppvdNode = ptable->slots[h].ppvdNode;
 
-        if (pbucket == NULL) continue;
-        epicsMutexMustLock(pbucket->lock);
-        ppvd->buckets[h] = NULL;
-        while ((ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list))) {
-            ellDelete(&pbucket->list, (ELLNODE *)ppvdNode);
+        if (ppvdNode && ppvdNode != &deletedEntry)
             free(ppvdNode);
-        }
-        epicsMutexUnlock(pbucket->lock);
-        epicsMutexDestroy(pbucket->lock);
-        free(pbucket);
     }
-    free(ppvd->buckets);
+    free(ptable);
+    freeRetired(ppvd);
+    free(ppvd->filter);
+    epicsMutexDestroy(ppvd->lock);
     free(ppvd);
 }
 
 void dbPvdDump(dbBase *pdbbase, int verbose)
 {
-    unsigned int empty = 0;
     dbPvd *ppvd;
+    dbPvdTable *ptable;
+    unsigned long probes = 0;
+    unsigned int longest = 0;
     unsigned int h;
 
     if (!pdbbase) {
@@ -204,27 +512,32 @@ void dbPvdDump(dbBase *pdbbase, int verbose)
     ppvd = pdbbase->ppvd;
     if (ppvd == NULL) return;
 
-    printf("Process Variable Directory has %u buckets", ppvd->size);
+    epicsMutexMustLock(ppvd->lock);
+    ptable = ppvd->table;
+    printf("Process Variable Directory has %u entries in %u slots",
+        ppvd->count, ptable->size);
 
-    for (h = 0; h < ppvd->size; h++) {
-        dbPvdBucket *pbucket = ppvd->buckets[h];
-        PVDENTRY *ppvdNode;
-        int i = 1;
+    for (h = 0; h < ptable->size; h++) {
+        PVDENTRY *ppvdNode = ptable->slots[h].ppvdNode;
+        unsigned int len;
 
-        if (pbucket == NULL) {
-            empty++;
+        if (!ppvdNode || ppvdNode == &deletedEntry)
             continue;
-        }
-        epicsMutexMustLock(pbucket->lock);
-        ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-        printf("\n [%4u] %4d  ", h, ellCount(&pbucket->list));
-        while (ppvdNode && verbose) {
-            if (!(++i % 4))
-                printf("\n         ");
-            printf("  %s", ppvdNode->precnode->recordname);
-            ppvdNode = (PVDENTRY *) ellNext((ELLNODE*)ppvdNode);
-        }
-        epicsMutexUnlock(pbucket->lock);
+        /* Number of slots a lookup of this name has to examine */
+        len = ((h - ptable->slots[h].hash) & ptable->mask) + 1;
+        probes += len;
+        if (len > longest)
+            longest = len;
+        if (verbose)
+            printf("\n [%5u] %2u  %s", h, len,
+                ppvdNode->precnode->recordname);
     }
-    printf("\n%u buckets empty.\n", empty);
+    printf("\n%u slots deleted, probe length average %.2f, longest %u.\n",
+        ppvd->used - ppvd->count,
+        ppvd->count ? (double) probes / ppvd->count : 0.0, longest);
+    if (ppvd->filter)
+        printf("Name filter has %u bits, %u of %u names added.\n",
+            ppvd->filter->nblocks * FILTER_WORDS * 32,
+            ppvd->filter->nadded, ppvd->filter->capacity);
+    epicsMutexUnlock(ppvd->lock);
 }
@@ -597,6 +597,7 @@ void dbFreeBase(dbBase *pdbbase)
     gphFreeMem(pdbbase->pgpHash);
     dbPvdFreeMem(pdbbase);
     dbFreePath(pdbbase);
+    free(pdbbase->recordArena);
     free((void *)pdbbase);
     pdbbase = NULL;
     return;
@@ -1923,11 +1924,12 @@ char * dbGetString(DBENTRY *pdbentry)
             else if(pvlMask&pvlOptCP) ppind=3;
             else if(pvlMask&pvlOptCPP) ppind=4;
             else ppind=0;
-            dbMsgPrint(pdbentry, "%s%s%s%s",
+            dbMsgPrint(pdbentry, "%s%s%s%s%s",
                    plink->value.pv_link.pvname ? plink->value.pv_link.pvname : "",
                    (plink->flags & DBLINK_FLAG_TSELisTIME) ? ".TIME" : "",
                    ppstring[ppind],
-                   msstring[plink->value.pv_link.pvlMask&pvlOptMsMode]);
+                   msstring[plink->value.pv_link.pvlMask&pvlOptMsMode],
+                   (pvlMask & pvlOptLATEST) ? " LATEST" : "");
             break;
         }
         case VME_IO:
@@ -2355,6 +2357,8 @@ long dbParseLink(const char *str, short ftype, dbLinkInfo *pinfo)
         else if (strstr(pstr, "MSS")) pinfo->modifiers |= pvlOptMSS;
         else if (strstr(pstr, "MS")) pinfo->modifiers |= pvlOptMS;
 
+        if (strstr(pstr, "LATEST")) pinfo->modifiers |= pvlOptLATEST;
+
         /* filter modifiers based on link type */
         switch(ftype) {
         case DBF_INLINK: /* accept all */ break;
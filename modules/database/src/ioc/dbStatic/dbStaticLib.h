@@ -234,6 +234,15 @@ epicsShareFunc void dbCatString(char **string, int *stringLength,
 extern int dbStaticDebug;
 extern int dbConvertStrict;
 
+/* Databases loaded from and saved as images in EPICS_DB_CACHE_DIR */
+epicsShareExtern unsigned long dbCacheLoads;
+epicsShareExtern unsigned long dbCacheStores;
+/* The image file that dbReadDatabase() of filename with these path and
+ * substitutions uses, NULL if images are disabled; the caller frees it.
+ */
+epicsShareFunc char * dbCacheImageName(const char *filename,
+    const char *path, const char *substitutions);
+
 #define S_dbLib_recordTypeNotFound (M_dbLib|1) /* Record Type does not exist */
 #define S_dbLib_recExists (M_dbLib|3)          /* Record Already exists */
 #define S_dbLib_recNotFound (M_dbLib|5)        /* Record Not Found */
@@ -100,6 +100,7 @@ typedef struct{
     ELLNODE         node;
     dbRecordType    *precordType;
     dbRecordNode    *precnode;
+    const char      *name;      /* copy of precnode->recordname */
 }PVDENTRY;
 epicsShareFunc int dbPvdTableSize(int size);
 extern int dbStaticDebug;
@@ -108,6 +109,9 @@ PVDENTRY *dbPvdFind(DBBASE *pdbbase,const char *name,size_t lenname);
 PVDENTRY *dbPvdAdd(DBBASE *pdbbase,dbRecordType *precordType,dbRecordNode *precnode);
 void dbPvdDelete(DBBASE *pdbbase,dbRecordNode *precnode);
 void dbPvdFreeMem(DBBASE *pdbbase);
+epicsShareFunc void dbPvdFilterBuild(DBBASE *pdbbase);
+/* Zero if the record part of pname is certainly not in the directory */
+epicsShareFunc int dbPvdMayExist(DBBASE *pdbbase, const char *pname);
 
 #ifdef __cplusplus
 }
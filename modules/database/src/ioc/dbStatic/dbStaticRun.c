@@ -180,7 +180,8 @@ long dbFreeRecord(DBENTRY *pdbentry)
     if(!pdbRecordType) return(S_dbLib_recordTypeNotFound);
     if(!precnode) return(S_dbLib_recNotFound);
     if(!precnode->precord) return(S_dbLib_recNotFound);
-    free(dbRec2Pvt(precnode->precord));
+    if(!(precnode->flags & DBRN_FLAGS_PACKED))
+        free(dbRec2Pvt(precnode->precord));
     precnode->precord = NULL;
     return(0);
 }
@@ -374,7 +374,8 @@ static int yyerror(char *str)
     else
         epicsPrintf("Error");
     if (!yyFailed) {    /* Only print this stuff once */
-        epicsPrintf(" at or before \"%s\"", yytext);
+        if (!pinputFileNow || pinputFileNow->fp)    /* not an image */
+            epicsPrintf(" at or before \"%s\"", yytext);
         dbIncludePrint();
         yyFailed = TRUE;
     }
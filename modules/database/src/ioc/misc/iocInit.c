@@ -30,7 +30,10 @@
 #include "epicsGeneralTime.h"
 #include "epicsPrint.h"
 #include "epicsSignal.h"
+#include "epicsStdio.h"
 #include "epicsThread.h"
+#include "epicsThreadPool.h"
+#include "epicsTime.h"
 #include "errMdef.h"
 #include "iocsh.h"
 #include "taskwd.h"
@@ -52,6 +55,7 @@
 #include "dbFldTypes.h"
 #include "dbLock.h"
 #include "dbNotify.h"
+#include "dbProcStats.h"
 #include "dbScan.h"
 #include "dbServer.h"
 #include "dbStaticLib.h"
@@ -98,6 +102,46 @@ static void iterateRecords(recIterFunc func, void *user);
 int dbThreadRealtimeLock = 1;
 epicsExportAddress(int, dbThreadRealtimeLock);
 
+int iocInitThreads = 0;
+epicsExportAddress(int, iocInitThreads);
+
+int iocPackRecords = 0;
+epicsExportAddress(int, iocPackRecords);
+
+/*
+ * Record types whose support must not run at the same time as any other
+ * type's during a parallel iocInit.  Names may be added before the DBD
+ * file is loaded, so they are only matched up in initDatabase().
+ */
+typedef struct serialTypeNode {
+    ELLNODE node;
+    char name[1];
+} serialTypeNode;
+
+static ELLLIST serialTypeList = ELLLIST_INIT;
+
+/* How long each record type took in each phase of initDatabase() */
+enum {initPhaseRecord0, initPhaseLinks, initPhaseRecord1, initPhases};
+
+/*
+ * Record types which share hardware device support are initialized
+ * together as a group, since such support is seldom reentrant.
+ */
+typedef struct initTypeStats {
+    dbRecordType *pdbRecordType;
+    int serial;
+    unsigned long nRecords;
+    double seconds[initPhases];
+    recIterFunc func;       /* the phase being run */
+    int phase;
+    struct initTypeStats *pgroup;   /* first type of the group */
+    struct initTypeStats *pnext;    /* next type of the group */
+    epicsJob *job;          /* of the first type of a parallel group */
+} initTypeStats;
+
+static initTypeStats *typeStats;
+static int nTypeStats;
+
 enum iocStateEnum getIocState(void)
 {
     return iocState;
@@ -118,6 +162,11 @@ static int iocBuild_1(void)
         return -1;
     }
     errlogInit(0);
+
+    /* Before any hook or support can hold pointers to records */
+    if (iocPackRecords && dbLockPackRecords(pdbbase))
+        errlogPrintf("iocBuild: Can't pack records, left in place\n");
+
     initHookAnnounce(initHookAtIocBuild);
 
     if (!epicsThreadIsOkToBlock()) {
@@ -163,7 +212,9 @@ static int iocBuild_2(void)
 
     iterateRecords(prepareLinks, NULL);
 
+    dbPvdFilterBuild(pdbbase);
     dbLockInitRecords(pdbbase);
+    dbProcStatsInit(pdbbase);
     initDatabase();
     dbBkptInit();
     initHookAnnounce(initHookAfterInitDatabase); /* used by autosave pass 1 */
@@ -557,16 +608,310 @@ static void doInitRecord1(dbRecordType *pdbRecordType, dbCommon *precord,
         prset->init_record(precord, 1);
 }
 
+static int isSerialType(const char *name)
+{
+    serialTypeNode *pnode;
+
+    for (pnode = (serialTypeNode *)ellFirst(&serialTypeList);
+         pnode;
+         pnode = (serialTypeNode *)ellNext(&pnode->node)) {
+        if (!strcmp(pnode->name, name))
+            return 1;
+    }
+    return 0;
+}
+
+void iocInitSerialRecordType(const char *recordTypeName)
+{
+    serialTypeNode *pnode;
+
+    if (!recordTypeName || !recordTypeName[0])
+        return;
+    if (isSerialType(recordTypeName))
+        return;
+    pnode = dbCalloc(1, sizeof(serialTypeNode) + strlen(recordTypeName));
+    strcpy(pnode->name, recordTypeName);
+    ellAdd(&serialTypeList, &pnode->node);
+}
+
+static void initTypePhase(initTypeStats *pstats)
+{
+    dbRecordType *pdbRecordType = pstats->pdbRecordType;
+    dbRecordNode *pdbRecordNode;
+    epicsTimeStamp start, end;
+
+    epicsTimeGetCurrent(&start);
+    for (pdbRecordNode = (dbRecordNode *)ellFirst(&pdbRecordType->recList);
+         pdbRecordNode;
+         pdbRecordNode = (dbRecordNode *)ellNext(&pdbRecordNode->node)) {
+        dbCommon *precord = pdbRecordNode->precord;
+
+        if (!precord->name[0] ||
+            pdbRecordNode->flags & DBRN_FLAGS_ISALIAS)
+            continue;
+
+        pstats->func(pdbRecordType, precord, NULL);
+        if (pstats->phase == initPhaseRecord0)
+            pstats->nRecords++;
+    }
+    epicsTimeGetCurrent(&end);
+    pstats->seconds[pstats->phase] = epicsTimeDiffInSeconds(&end, &start);
+}
+
+static void initGroupPhase(initTypeStats *pstats)
+{
+    for (; pstats; pstats = pstats->pnext)
+        initTypePhase(pstats);
+}
+
+static void initGroupJob(void *arg, epicsJobMode mode)
+{
+    if (mode == epicsJobModeRun)
+        initGroupPhase((initTypeStats *)arg);
+}
+
+static initTypeStats * groupOf(initTypeStats *pstats)
+{
+    while (pstats->pgroup != pstats)
+        pstats = pstats->pgroup;
+    return pstats;
+}
+
+static void groupJoin(initTypeStats *pa, initTypeStats *pb)
+{
+    pa = groupOf(pa);
+    pb = groupOf(pb);
+    if (pa < pb)
+        pb->pgroup = pa;
+    else
+        pa->pgroup = pb;
+}
+
+/*
+ * Put record types whose records use the same hardware device support
+ * in one group.  Soft device support has a CONSTANT link type and each
+ * record's state is its own, so it doesn't tie types together.
+ */
+static void groupTypes(void)
+{
+    typedef struct {
+        const char *choice;
+        initTypeStats *pstats;
+    } devUse;
+    devUse *puses;
+    int nuses = 0, maxuses = 0;
+    int i, j;
+
+    for (i = 0; i < nTypeStats; i++) {
+        typeStats[i].pgroup = &typeStats[i];
+        typeStats[i].pnext = NULL;
+        maxuses += ellCount(&typeStats[i].pdbRecordType->devList);
+    }
+    puses = dbCalloc(maxuses ? maxuses : 1, sizeof(devUse));
+
+    for (i = 0; i < nTypeStats; i++) {
+        dbRecordType *pdbRecordType = typeStats[i].pdbRecordType;
+        int ndev = ellCount(&pdbRecordType->devList);
+        char *used;
+        dbRecordNode *pdbRecordNode;
+        devSup *pdevSup;
+
+        if (!ndev)
+            continue;
+        used = dbCalloc(ndev, 1);
+        for (pdbRecordNode = (dbRecordNode *)ellFirst(&pdbRecordType->recList);
+             pdbRecordNode;
+             pdbRecordNode = (dbRecordNode *)ellNext(&pdbRecordNode->node)) {
+            int dtyp = ((dbCommon *)pdbRecordNode->precord)->dtyp;
+
+            if (dtyp >= 0 && dtyp < ndev)
+                used[dtyp] = 1;
+        }
+        for (j = 0, pdevSup = (devSup *)ellFirst(&pdbRecordType->devList);
+             pdevSup;
+             j++, pdevSup = (devSup *)ellNext(&pdevSup->node)) {
+            int k;
+
+            if (!used[j] || pdevSup->link_type == CONSTANT)
+                continue;
+            for (k = 0; k < nuses; k++) {
+                if (!strcmp(puses[k].choice, pdevSup->choice))
+                    break;
+            }
+            if (k < nuses) {
+                groupJoin(puses[k].pstats, &typeStats[i]);
+            }
+            else {
+                puses[nuses].choice = pdevSup->choice;
+                puses[nuses++].pstats = &typeStats[i];
+            }
+        }
+        free(used);
+    }
+    free(puses);
+
+    /* A group is serial if any of its types is */
+    for (i = 0; i < nTypeStats; i++) {
+        initTypeStats *pgroup = groupOf(&typeStats[i]);
+
+        if (typeStats[i].serial)
+            pgroup->serial = 1;
+    }
+    for (i = nTypeStats - 1; i >= 0; i--) {
+        initTypeStats *pgroup = groupOf(&typeStats[i]);
+
+        if (pgroup != &typeStats[i]) {
+            typeStats[i].pnext = pgroup->pnext;
+            pgroup->pnext = &typeStats[i];
+        }
+    }
+    for (i = 0; i < nTypeStats; i++) {
+        typeStats[i].pgroup = groupOf(&typeStats[i]);
+        typeStats[i].serial = typeStats[i].pgroup->serial;
+    }
+}
+
+/*
+ * Run one phase for every record type.  With a pool the groups run in
+ * parallel, except for the serial ones which follow on this thread once
+ * all the others are done.
+ */
+static void initPhase(epicsThreadPool *pool, int phase, recIterFunc func)
+{
+    int i;
+
+    for (i = 0; i < nTypeStats; i++) {
+        initTypeStats *pstats = &typeStats[i];
+
+        pstats->func = func;
+        pstats->phase = phase;
+    }
+    for (i = 0; i < nTypeStats; i++) {
+        initTypeStats *pstats = &typeStats[i];
+
+        if (!pstats->job)
+            continue;
+        if (epicsJobQueue(pstats->job)) {
+            errlogPrintf("iocInit: Can't queue %s initialization\n",
+                pstats->pdbRecordType->name);
+            initGroupPhase(pstats);
+        }
+    }
+    if (pool)
+        epicsThreadPoolWait(pool, -1.0);
+
+    for (i = 0; i < nTypeStats; i++) {
+        initTypeStats *pstats = &typeStats[i];
+
+        if (pstats->pgroup == pstats && !pstats->job)
+            initGroupPhase(pstats);
+    }
+}
+
 static void initDatabase(void)
 {
+    epicsThreadPool *pool = NULL;
+    dbRecordType *pdbRecordType;
+    int i;
+
     dbChannelInit();
-    iterateRecords(doInitRecord0, NULL);
-    iterateRecords(doResolveLinks, NULL);
-    iterateRecords(doInitRecord1, NULL);
+
+    free(typeStats);
+    nTypeStats = ellCount(&pdbbase->recordTypeList);
+    typeStats = dbCalloc(nTypeStats ? nTypeStats : 1, sizeof(initTypeStats));
+    for (i = 0, pdbRecordType = (dbRecordType *)ellFirst(&pdbbase->recordTypeList);
+         pdbRecordType;
+         i++, pdbRecordType = (dbRecordType *)ellNext(&pdbRecordType->node)) {
+        typeStats[i].pdbRecordType = pdbRecordType;
+        typeStats[i].serial = isSerialType(pdbRecordType->name);
+    }
+    groupTypes();
+
+    if (iocInitThreads > 0) {
+        epicsThreadPoolConfig conf;
+
+        epicsThreadPoolConfigDefaults(&conf);
+        conf.initialThreads = conf.maxThreads = iocInitThreads;
+        conf.workerStack = epicsThreadGetStackSize(epicsThreadStackBig);
+        conf.workerPriority = epicsThreadGetPrioritySelf();
+        pool = epicsThreadPoolCreate(&conf);
+        if (!pool)
+            errlogPrintf("iocInit: Can't create thread pool, "
+                "initializing records serially\n");
+    }
+    /* Groups without a job run on this thread */
+    for (i = 0; pool && i < nTypeStats; i++) {
+        initTypeStats *pstats = &typeStats[i];
+        initTypeStats *pmember;
+        int nrecords = 0;
+
+        if (pstats->pgroup != pstats || pstats->serial)
+            continue;
+        for (pmember = pstats; pmember; pmember = pmember->pnext)
+            nrecords += ellCount(&pmember->pdbRecordType->recList);
+        if (nrecords)
+            pstats->job = epicsJobCreate(pool, initGroupJob, pstats);
+    }
+
+    initPhase(pool, initPhaseRecord0, doInitRecord0);
+    initPhase(pool, initPhaseLinks, doResolveLinks);
+    initPhase(pool, initPhaseRecord1, doInitRecord1);
+
+    if (pool) {
+        for (i = 0; i < nTypeStats; i++) {
+            if (typeStats[i].job)
+                epicsJobDestroy(typeStats[i].job);
+            typeStats[i].job = NULL;
+        }
+        epicsThreadPoolDestroy(pool);
+    }
 
     epicsAtExit(exitDatabase, NULL);
     return;
 }
+
+static int compareTypeStats(const void *a, const void *b)
+{
+    const initTypeStats *pa = a, *pb = b;
+    double ta = pa->seconds[0] + pa->seconds[1] + pa->seconds[2];
+    double tb = pb->seconds[0] + pb->seconds[1] + pb->seconds[2];
+
+    return ta < tb ? 1 : ta > tb ? -1 : 0;
+}
+
+void iocInitReport(int level)
+{
+    initTypeStats *sorted;
+    int i;
+
+    if (!typeStats) {
+        printf("iocInitReport: The IOC has not been initialized\n");
+        return;
+    }
+    sorted = dbCalloc(nTypeStats ? nTypeStats : 1, sizeof(initTypeStats));
+    memcpy(sorted, typeStats, nTypeStats * sizeof(initTypeStats));
+    qsort(sorted, nTypeStats, sizeof(initTypeStats), compareTypeStats);
+
+    printf("Record initialization times in ms, slowest first\n");
+    printf("%-20s %8s %10s %10s %10s\n",
+        "Record type", "Records", "Pass 0", "Links", "Pass 1");
+    for (i = 0; i < nTypeStats; i++) {
+        initTypeStats *pstats = &sorted[i];
+        dbRecordType *pgroup = pstats->pgroup->pdbRecordType;
+
+        if (!pstats->nRecords && level < 1)
+            continue;
+        printf("%-20s %8lu %10.3f %10.3f %10.3f%s%s%s\n",
+            pstats->pdbRecordType->name, pstats->nRecords,
+            pstats->seconds[initPhaseRecord0] * 1e3,
+            pstats->seconds[initPhaseLinks] * 1e3,
+            pstats->seconds[initPhaseRecord1] * 1e3,
+            pstats->serial && iocInitThreads > 0 ? "  serial" : "",
+            pgroup != pstats->pdbRecordType ? "  with " : "",
+            pgroup != pstats->pdbRecordType ? pgroup->name : "");
+    }
+    free(sorted);
+}
 
 /*
  *  Process database records at initialization ordered by phase
@@ -735,6 +1080,7 @@ int iocShutdown(void)
         scanCleanup();
         callbackCleanup();
 
+        dbProcStatsCleanup(pdbbase);
         iterateRecords(doFreeRecord, NULL);
         dbLockCleanupRecords(pdbbase);
 
@@ -742,6 +1088,11 @@ int iocShutdown(void)
         dbChannelExit();
         dbProcessNotifyExit();
         iocshFree();
+
+        /* the record types are about to go too */
+        free(typeStats);
+        typeStats = NULL;
+        nTypeStats = 0;
     }
 
     iocState = iocVoid;
@@ -754,4 +1105,8 @@ int iocShutdown(void)
 static void exitDatabase(void *dummy)
 {
     iocShutdown();
+    ellFree(&serialTypeList);
+    free(typeStats);
+    typeStats = NULL;
+    nTypeStats = 0;
 }
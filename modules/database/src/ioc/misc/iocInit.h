@@ -30,6 +30,20 @@ epicsShareFunc int iocRun(void);
 epicsShareFunc int iocPause(void);
 epicsShareFunc int iocShutdown(void);
 
+/* Parallel record initialization, off unless iocInitThreads is set.
+ * Types whose support isn't reentrant must be named first with
+ * iocInitSerialRecordType().
+ */
+epicsShareExtern int iocInitThreads;
+epicsShareFunc void iocInitSerialRecordType(const char *recordTypeName);
+epicsShareFunc void iocInitReport(int level);
+
+/* Pack each lockset's records together at the start of iocInit, see
+ * dbLockPackRecords().  Off by default, since record pointers taken
+ * before iocInit are left dangling.
+ */
+epicsShareExtern int iocPackRecords;
+
 #ifdef __cplusplus
 }
 #endif
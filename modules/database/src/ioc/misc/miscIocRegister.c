@@ -47,6 +47,27 @@ static void iocPauseCallFunc(const iocshArgBuf *args)
     iocshSetError(iocPause());
 }
 
+/* iocInitSerialRecordType */
+static const iocshArg iocInitSerialRecordTypeArg0 = {"recordType",iocshArgString};
+static const iocshArg * const iocInitSerialRecordTypeArgs[] =
+    {&iocInitSerialRecordTypeArg0};
+static const iocshFuncDef iocInitSerialRecordTypeFuncDef =
+    {"iocInitSerialRecordType",1,iocInitSerialRecordTypeArgs};
+static void iocInitSerialRecordTypeCallFunc(const iocshArgBuf *args)
+{
+    iocInitSerialRecordType(args[0].sval);
+}
+
+/* iocInitReport */
+static const iocshArg iocInitReportArg0 = {"interest level",iocshArgInt};
+static const iocshArg * const iocInitReportArgs[] = {&iocInitReportArg0};
+static const iocshFuncDef iocInitReportFuncDef =
+    {"iocInitReport",1,iocInitReportArgs};
+static void iocInitReportCallFunc(const iocshArgBuf *args)
+{
+    iocInitReport(args[0].ival);
+}
+
 /* coreRelease */
 static const iocshFuncDef coreReleaseFuncDef = {"coreRelease",0,NULL};
 static void coreReleaseCallFunc(const iocshArgBuf *args)
@@ -61,6 +82,9 @@ void miscIocRegister(void)
     iocshRegister(&iocBuildFuncDef,iocBuildCallFunc);
     iocshRegister(&iocRunFuncDef,iocRunCallFunc);
     iocshRegister(&iocPauseFuncDef,iocPauseCallFunc);
+    iocshRegister(&iocInitSerialRecordTypeFuncDef,
+        iocInitSerialRecordTypeCallFunc);
+    iocshRegister(&iocInitReportFuncDef,iocInitReportCallFunc);
     iocshRegister(&coreReleaseFuncDef, coreReleaseCallFunc);
 }
 
@@ -24,6 +24,8 @@
 #include <stdarg.h>
 #include <limits.h>
 
+#include "epicsAtomic.h"
+#include "epicsEndian.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsStdio.h"
@@ -373,6 +375,12 @@ static int tcp_version_action ( caHdrLargeArray *mp, void *pPayload,
         return RSRV_ERROR;
     }
 
+    if ( rsrvReactorActive ) {
+        /* the worker pool takes queued work in priority order */
+        client->priority = mp->m_dataType;
+        return RSRV_OK;
+    }
+
     tmp = mp->m_dataType - CA_PROTO_PRIORITY_MIN;
     tmp *= epicsThreadPriorityCAServerHigh - epicsThreadPriorityCAServerLow;
     tmp /= CA_PROTO_PRIORITY_MAX - CA_PROTO_PRIORITY_MIN;
@@ -480,6 +488,103 @@ static void no_read_access_event ( struct client *pClient,
     }
 }
 
+/*
+ *  net_format_is_host_format()
+ *
+ *  True if arrays of a plain DBR type have the same representation
+ *  on the wire as in host memory.
+ */
+static int net_format_is_host_format ( ca_uint16_t dataType )
+{
+    switch ( dataType ) {
+    case DBR_STRING:
+    case DBR_CHAR:
+        return TRUE;
+    case DBR_SHORT:
+    case DBR_ENUM:
+    case DBR_LONG:
+        return EPICS_BYTE_ORDER == EPICS_ENDIAN_BIG;
+    case DBR_FLOAT:
+    case DBR_DOUBLE:
+        return EPICS_BYTE_ORDER == EPICS_ENDIAN_BIG &&
+            EPICS_FLOAT_WORD_ORDER == EPICS_ENDIAN_BIG;
+    default:
+        return FALSE;
+    }
+}
+
+/*
+ *  read_reply_ref()
+ *
+ *  Queue a subscription update whose array data is a shared snapshot
+ *  that needs no conversion by reference, so that it is sent straight
+ *  from the snapshot.  Any status and time stamp which precede the
+ *  values are copied into the send buffer.  Returns FALSE if the whole
+ *  update must be copied into the send buffer instead.
+ *
+ *  send lock must be on while in this routine
+ */
+static int read_reply_ref ( struct event_ext *pevext, struct dbChannel *dbch,
+                          int eventsRemaining, db_field_log *pfl )
+{
+    struct client *pClient = pevext->pciu->client;
+    ca_uint16_t dataType = pevext->msg.m_dataType;
+    ca_uint16_t valueType = dataType % ( LAST_TYPE + 1 );
+    long item_count = pevext->msg.m_count ?
+        (long) pevext->msg.m_count : dbch->addr.no_elements;
+    long one = 1;
+    union {
+        struct dbr_time_string s;
+        struct dbr_time_double d;
+    } meta;
+    ca_uint32_t data_size;
+    const void *pData;
+    void *hold;
+    int status;
+
+    if ( ! pfl || ! net_format_is_host_format ( valueType ) ||
+            ! ( dbr_type_is_plain ( dataType ) ||
+                dbr_type_is_STS ( dataType ) ||
+                dbr_type_is_TIME ( dataType ) ) ) {
+        return FALSE;
+    }
+
+    pData = dbChannel_get_ref ( dbch, valueType, &item_count, pfl, &hold );
+    if ( ! pData ) {
+        return FALSE;
+    }
+
+    /* short updates to a fixed count need zero fill */
+    data_size = dbr_size_n ( valueType, item_count );
+    if ( item_count <= 0 || data_size < CAS_SEND_REF_MIN ||
+            ( pevext->msg.m_count && item_count < pevext->msg.m_count ) ) {
+        db_release_field_log_data ( hold );
+        return FALSE;
+    }
+
+    /* fetch the meta data with the first element, only the former is used */
+    if ( dataType != valueType ) {
+        if ( dbChannel_get_count ( dbch, dataType, &meta, &one, pfl ) < 0 ||
+                caNetConvert ( dataType, &meta, &meta, TRUE, 1 ) !=
+                    ECA_NORMAL ) {
+            db_release_field_log_data ( hold );
+            return FALSE;
+        }
+    }
+
+    status = cas_copy_in_ref ( pClient, pevext->msg.m_cmmd, dataType,
+        item_count, ECA_NORMAL, pevext->msg.m_available,
+        &meta, dbr_value_offset[dataType], pData, data_size, hold );
+    if ( status != ECA_NORMAL ) {
+        db_release_field_log_data ( hold );
+        return FALSE;
+    }
+
+    if ( ! eventsRemaining )
+        cas_send_bs_msg ( pClient, FALSE );
+    return TRUE;
+}
+
 /*
  *  read_reply()
  */
@@ -501,6 +606,12 @@ static void read_reply ( void *pArg, struct dbChannel *dbch,
 
     SEND_LOCK ( pClient );
 
+    if ( readAccess &&
+            read_reply_ref ( pevext, dbch, eventsRemaining, pfl ) ) {
+        SEND_UNLOCK ( pClient );
+        return;
+    }
+
     cid = ECA_NORMAL;
 
     /* If the client has requested a zero element count we interpret this as a
@@ -2129,6 +2240,8 @@ static int udp_version_action ( caHdrLargeArray *mp, void *pPayload, struct clie
 
     if ( CA_V411 ( mp->m_count ) ) {
         client->seqNoOfReq = mp->m_cid;
+        /* these clients accept replies up to the Ethernet MTU */
+        client->send.maxstk = ETHERNET_MAX_UDP;
     }
     else {
         client->seqNoOfReq = 0;
@@ -2191,10 +2304,16 @@ static int search_reply_udp ( caHdrLargeArray *mp, void *pPayload, struct client
     pName[mp->m_postsize-1] = '\0';
 
     /* Exit quickly if channel not on this node */
+    if (!dbChannelMayExist(pName)) {
+        epicsAtomicIncrSizeT(&rsrvSearchRejected);
+        return RSRV_OK;
+    }
     if (dbChannelTest(pName)) {
         DLOG ( 2, ( "CAS: Lookup for channel \"%s\" failed\n", pPayLoad ) );
+        epicsAtomicIncrSizeT(&rsrvSearchNotFound);
         return RSRV_OK;
     }
+    epicsAtomicIncrSizeT(&rsrvSearchFound);
 
     /*
      * stop further use of server if memory becomes scarce
@@ -2419,6 +2538,12 @@ int camessage ( struct client *client )
         caHdr *mp;
         void *pBody;
 
+        /* in reactor mode the rest waits until the socket takes more */
+        if ( client->sendBlocked && client->reactor ) {
+            status = RSRV_OK;
+            break;
+        }
+
         /* wait for at least a complete caHdr */
         bytes_left = client->recv.cnt - client->recv.stk;
         if ( bytes_left < sizeof(*mp) ) {
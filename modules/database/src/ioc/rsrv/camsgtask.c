@@ -34,6 +34,83 @@
 #include "rsrv.h"
 #include "server.h"
 
+/*
+ *  camsg_received()
+ *
+ *  Process the nchars bytes just received into the client's receive
+ *  buffer.  Returns non-zero if the client must be disconnected.
+ */
+int camsg_received ( struct client *client, unsigned nchars )
+{
+    int status;
+
+    epicsTimeGetCurrent ( &client->time_at_last_recv );
+    client->recv.cnt += nchars;
+
+    status = camessage ( client );
+    if (status == 0) {
+        /*
+         * if there is a partial message
+         * align it with the start of the buffer
+         */
+        if (client->recv.cnt > client->recv.stk) {
+            unsigned bytes_left;
+
+            bytes_left = client->recv.cnt - client->recv.stk;
+
+            /*
+             * overlapping regions handled
+             * properly by memmove
+             */
+            memmove (client->recv.buf,
+                &client->recv.buf[client->recv.stk], bytes_left);
+            client->recv.cnt = bytes_left;
+        }
+        else {
+            client->recv.cnt = 0ul;
+        }
+        return 0;
+    }
+    else {
+        char buf[64];
+
+        /* flush any queued messages before shutdown */
+        cas_send_bs_msg(client, 1);
+
+        client->recv.cnt = 0ul;
+
+        /*
+         * disconnect when there are severe message errors
+         */
+        ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
+        epicsPrintf ("CAS: forcing disconnect from %s\n", buf);
+        return -1;
+    }
+}
+
+/*
+ *  camsg_recv_failed()
+ *
+ *  Report a receive error which ends the connection
+ */
+void camsg_recv_failed ( int anerrno )
+{
+    /*
+     * normal conn lost conditions
+     */
+    if (    ( anerrno != SOCK_ECONNABORTED &&
+        anerrno != SOCK_ECONNRESET &&
+        anerrno != SOCK_ETIMEDOUT ) ||
+        CASDEBUG > 2 ) {
+        char sockErrBuf[64];
+
+        epicsSocketConvertErrorToString(
+            sockErrBuf, sizeof ( sockErrBuf ), anerrno);
+        errlogPrintf ( "CAS: Client disconnected - %s\n",
+            sockErrBuf );
+    }
+}
+
 /*
  *  camsgtask()
  *
@@ -94,63 +171,12 @@ void camsgtask ( void *pParm )
                 continue;
             }
 
-            /*
-             * normal conn lost conditions
-             */
-            if (    ( anerrno != SOCK_ECONNABORTED &&
-                anerrno != SOCK_ECONNRESET &&
-                anerrno != SOCK_ETIMEDOUT ) ||
-                CASDEBUG > 2 ) {
-                char sockErrBuf[64];
-
-                epicsSocketConvertErrorToString(
-                    sockErrBuf, sizeof ( sockErrBuf ), anerrno);
-                errlogPrintf ( "CAS: Client disconnected - %s\n",
-                    sockErrBuf );
-            }
+            camsg_recv_failed ( anerrno );
             break;
         }
 
-        epicsTimeGetCurrent ( &client->time_at_last_recv );
-        client->recv.cnt += ( unsigned ) nchars;
-
-        status = camessage ( client );
-        if (status == 0) {
-            /*
-             * if there is a partial message
-             * align it with the start of the buffer
-             */
-            if (client->recv.cnt > client->recv.stk) {
-                unsigned bytes_left;
-
-                bytes_left = client->recv.cnt - client->recv.stk;
-
-                /*
-                 * overlapping regions handled
-                 * properly by memmove
-                 */
-                memmove (client->recv.buf,
-                    &client->recv.buf[client->recv.stk], bytes_left);
-                client->recv.cnt = bytes_left;
-            }
-            else {
-                client->recv.cnt = 0ul;
-            }
-        }
-        else {
-            char buf[64];
-
-            /* flush any queued messages before shutdown */
-            cas_send_bs_msg(client, 1);
-
-            client->recv.cnt = 0ul;
-
-            /*
-             * disconnect when there are severe message errors
-             */
-            ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
-            epicsPrintf ("CAS: forcing disconnect from %s\n", buf);
-                break;
+        if ( camsg_received ( client, ( unsigned ) nchars ) ) {
+            break;
         }
     }
 
@@ -22,6 +22,7 @@
 #include <limits.h>
 
 #include "dbDefs.h"
+#include "epicsAtomic.h"
 #include "epicsSignal.h"
 #include "epicsTime.h"
 #include "errlog.h"
@@ -29,25 +30,215 @@
 
 #include "caerr.h"
 #include "net_convert.h"
+#include "dbEvent.h"
 
 #define epicsExportSharedSymbols
 #include "server.h"
 
+#if defined(_WIN32)
+    typedef WSABUF sendSegment;
+#   define SEGMENT_SET(pSeg, pBase, size) \
+        ( (pSeg)->buf = (char *) (pBase), (pSeg)->len = (size) )
+#   define SEGMENT_BASE(pSeg) ( (pSeg)->buf )
+#   define SEGMENT_SIZE(pSeg) ( (pSeg)->len )
+#else
+#   include <sys/uio.h>
+    typedef struct iovec sendSegment;
+#   define SEGMENT_SET(pSeg, pBase, size) \
+        ( (pSeg)->iov_base = (void *) (pBase), (pSeg)->iov_len = (size) )
+#   define SEGMENT_BASE(pSeg) ( (pSeg)->iov_base )
+#   define SEGMENT_SIZE(pSeg) ( (pSeg)->iov_len )
+#endif
+
+#ifdef __linux__
 /*
- *  cas_send_bs_msg()
+ * UDP replies waiting to be sent together by sendmmsg()
+ */
+#define CAS_DG_BATCH 32u
+struct cas_dg_batch {
+    unsigned            n;
+    struct mmsghdr      msgs[CAS_DG_BATCH];
+    struct iovec        iov[CAS_DG_BATCH];
+    struct sockaddr_in  addr[CAS_DG_BATCH];
+    char                buf[CAS_DG_BATCH][ETHERNET_MAX_UDP];
+};
+#endif
+
+/*
+ * Gather the unsent part of the stream into at most 2 * CAS_SEND_REFS + 1
+ * segments
+ */
+static unsigned send_gather ( struct client *pclient,
+    const struct send_cursor *pCur, sendSegment *pSeg )
+{
+    unsigned pos = pCur->bufSent;
+    unsigned refSent = pCur->refSent;
+    unsigned nSeg = 0u;
+    unsigned i;
+
+    for ( i = pCur->iRef; i < pclient->nSendRefs; i++ ) {
+        const struct send_ref *pRef = &pclient->sendRefs[i];
+        if ( pRef->bufOffset > pos ) {
+            SEGMENT_SET ( &pSeg[nSeg], &pclient->send.buf[pos],
+                pRef->bufOffset - pos );
+            nSeg++;
+            pos = pRef->bufOffset;
+        }
+        SEGMENT_SET ( &pSeg[nSeg], pRef->pData + refSent,
+            pRef->size - refSent );
+        nSeg++;
+        refSent = 0u;
+    }
+    if ( pclient->send.stk > pos ) {
+        SEGMENT_SET ( &pSeg[nSeg], &pclient->send.buf[pos],
+            pclient->send.stk - pos );
+        nSeg++;
+    }
+    return nSeg;
+}
+
+/*
+ * Advance the cursor over nBytes which have been sent, releasing the
+ * send references that are complete.  Returns true if nothing is left.
+ */
+static int send_advance ( struct client *pclient,
+    struct send_cursor *pCur, unsigned nBytes )
+{
+    while ( nBytes ) {
+        unsigned bufEnd = pCur->iRef < pclient->nSendRefs ?
+            pclient->sendRefs[pCur->iRef].bufOffset : pclient->send.stk;
+        unsigned n;
+
+        if ( pCur->bufSent < bufEnd ) {
+            n = bufEnd - pCur->bufSent;
+            if ( n > nBytes ) n = nBytes;
+            pCur->bufSent += n;
+        }
+        else {
+            struct send_ref *pRef = &pclient->sendRefs[pCur->iRef];
+
+            assert ( pCur->iRef < pclient->nSendRefs );
+            n = pRef->size - pCur->refSent;
+            if ( n > nBytes ) n = nBytes;
+            pCur->refSent += n;
+            if ( pCur->refSent == pRef->size ) {
+                db_release_field_log_data ( pRef->hold );
+                pRef->hold = NULL;
+                epicsAtomicAddSizeT ( &rsrvSendRefBytes, pRef->size );
+                pCur->iRef++;
+                pCur->refSent = 0u;
+            }
+        }
+        nBytes -= n;
+    }
+    return pCur->bufSent == pclient->send.stk &&
+        pCur->iRef == pclient->nSendRefs;
+}
+
+static int send_segments ( SOCKET sock, sendSegment *pSeg, unsigned nSeg )
+{
+#if defined(_WIN32)
+    DWORD nSent;
+    if ( WSASend ( sock, pSeg, nSeg, &nSent, 0, NULL, NULL ) ) {
+        return -1;
+    }
+    return (int) nSent;
+#elif defined(vxWorks)
+    /* the remaining segments go out on the next call */
+    return send ( sock, pSeg->iov_base, pSeg->iov_len, 0 );
+#else
+    struct msghdr msg;
+    memset ( &msg, 0, sizeof ( msg ) );
+    msg.msg_iov = pSeg;
+    msg.msg_iovlen = nSeg;
+    return sendmsg ( sock, &msg, 0 );
+#endif
+}
+
+/*
+ *  cas_discard_send()
  *
- *  (channel access server send message)
+ *  Drop everything queued for sending.
+ *  send lock must be on while in this routine
+ */
+void cas_discard_send ( struct client *pclient )
+{
+    unsigned i;
+
+    for ( i = 0u; i < pclient->nSendRefs; i++ ) {
+        db_release_field_log_data ( pclient->sendRefs[i].hold );
+    }
+    pclient->nSendRefs = 0u;
+    pclient->send.stk = 0u;
+    memset ( &pclient->sendCursor, 0, sizeof ( pclient->sendCursor ) );
+    ellFree ( &pclient->sendBacklog );
+    pclient->sendBlocked = FALSE;
+}
+
+/*
+ *  send_set_aside()
  *
+ *  Copy the unsent part of the send buffer and of the send references
+ *  into the backlog, leaving both empty.
  *
- * Set lock_needed=1 unless SEND_LOCK() is held by caller
+ *  send lock must be on while in this routine
  */
-void cas_send_bs_msg ( struct client *pclient, int lock_needed )
+static void send_set_aside ( struct client *pclient )
 {
-    int status;
+    sendSegment segments[2 * CAS_SEND_REFS + 1];
+    struct send_cursor *pCursor = &pclient->sendCursor;
+    struct send_backlog *pBlock;
+    unsigned nSeg = send_gather ( pclient, pCursor, segments );
+    unsigned size = 0u;
+    unsigned i;
+
+    for ( i = 0u; i < nSeg; i++ ) {
+        size += (unsigned) SEGMENT_SIZE ( &segments[i] );
+    }
+    if ( ! size ) {
+        return;
+    }
 
-    if ( lock_needed ) {
-        SEND_LOCK ( pclient );
+    pBlock = malloc ( offsetof ( struct send_backlog, data ) + size );
+    if ( ! pBlock ) {
+        errlogPrintf ( "CAS: no memory for a blocked send, disconnecting\n" );
+        pclient->disconnect = TRUE;
+        cas_discard_send ( pclient );
+        return;
+    }
+    pBlock->size = size;
+    pBlock->sent = 0u;
+    size = 0u;
+    for ( i = 0u; i < nSeg; i++ ) {
+        memcpy ( &pBlock->data[size], SEGMENT_BASE ( &segments[i] ),
+            SEGMENT_SIZE ( &segments[i] ) );
+        size += (unsigned) SEGMENT_SIZE ( &segments[i] );
     }
+    ellAdd ( &pclient->sendBacklog, &pBlock->node );
+
+    for ( i = pCursor->iRef; i < pclient->nSendRefs; i++ ) {
+        db_release_field_log_data ( pclient->sendRefs[i].hold );
+    }
+    pclient->nSendRefs = 0u;
+    pclient->send.stk = 0u;
+    memset ( pCursor, 0, sizeof ( *pCursor ) );
+}
+
+/*
+ *  cas_send_bs()
+ *
+ *  Send everything queued for a TCP circuit.  In reactor mode the
+ *  socket does not block, and whatever it will not take now is left
+ *  for the reactor to send when it is writable.  If needRoom is set
+ *  that is first moved to the backlog, emptying the send buffer.
+ *
+ *  send lock must be on while in this routine
+ */
+static void cas_send_bs ( struct client *pclient, int needRoom )
+{
+    sendSegment segments[2 * CAS_SEND_REFS + 1];
+    struct send_cursor *pCursor = &pclient->sendCursor;
+    int status;
 
     if ( CASDEBUG > 2 && pclient->send.stk ) {
         errlogPrintf ( "CAS: Sending a message of %d bytes\n", pclient->send.stk );
@@ -58,27 +249,45 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
             errlogPrintf ( "CAS: msg Discard for sock %d addr %x\n",
                 (int)pclient->sock, (unsigned) pclient->addr.sin_addr.s_addr );
         }
-        pclient->send.stk = 0u;
-        if(lock_needed)
-            SEND_UNLOCK(pclient);
+        cas_discard_send ( pclient );
         return;
     }
 
-    while ( pclient->send.stk && ! pclient->disconnect ) {
-        status = send ( pclient->sock, pclient->send.buf, pclient->send.stk, 0 );
+    while ( ( pclient->send.stk || ellCount ( &pclient->sendBacklog ) ) &&
+            ! pclient->disconnect ) {
+        struct send_backlog *pBlock =
+            (struct send_backlog *) ellFirst ( &pclient->sendBacklog );
+
+        if ( pBlock ) {
+            status = send ( pclient->sock, &pBlock->data[pBlock->sent],
+                (int) ( pBlock->size - pBlock->sent ), 0 );
+            if ( status >= 0 ) {
+                pBlock->sent += (unsigned) status;
+                if ( pBlock->sent == pBlock->size ) {
+                    ellDelete ( &pclient->sendBacklog, &pBlock->node );
+                    free ( pBlock );
+                }
+                if ( ! pclient->send.stk &&
+                        ! ellCount ( &pclient->sendBacklog ) ) {
+                    pclient->sendBlocked = FALSE;
+                    epicsTimeGetCurrent ( &pclient->time_at_last_send );
+                }
+                continue;
+            }
+        }
+        else {
+            unsigned nSeg = send_gather ( pclient, pCursor, segments );
+            status = send_segments ( pclient->sock, segments, nSeg );
+        }
         if ( status >= 0 ) {
-            unsigned transferSize = (unsigned) status;
-            if ( transferSize >= pclient->send.stk ) {
+            if ( send_advance ( pclient, pCursor, (unsigned) status ) ) {
+                memset ( pCursor, 0, sizeof ( *pCursor ) );
+                pclient->nSendRefs = 0u;
                 pclient->send.stk = 0;
+                pclient->sendBlocked = FALSE;
                 epicsTimeGetCurrent ( &pclient->time_at_last_send );
                 break;
             }
-            else {
-                unsigned bytesLeft = pclient->send.stk - transferSize;
-                memmove ( pclient->send.buf, &pclient->send.buf[transferSize],
-                    bytesLeft );
-                pclient->send.stk = bytesLeft;
-            }
         }
         else {
             int causeWasSocketHangup = 0;
@@ -86,7 +295,7 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
             char buf[64];
 
             if ( pclient->disconnect ) {
-                pclient->send.stk = 0u;
+                cas_discard_send ( pclient );
                 break;
             }
 
@@ -94,6 +303,15 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
                 continue;
             }
 
+            if ( anerrno == SOCK_EWOULDBLOCK && pclient->reactor ) {
+                if ( needRoom ) {
+                    send_set_aside ( pclient );
+                }
+                pclient->sendBlocked = TRUE;
+                casReactorWantSend ( pclient );
+                break;
+            }
+
             if ( anerrno == SOCK_ENOBUFS ) {
                 errlogPrintf (
                     "CAS: Out of network buffers, retrying send in 15 seconds\n" );
@@ -118,7 +336,7 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
                     buf, sockErrBuf);
             }
             pclient->disconnect = TRUE;
-            pclient->send.stk = 0u;
+            cas_discard_send ( pclient );
 
             /*
              * wakeup the receive thread
@@ -156,13 +374,44 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
         }
     }
 
+    DLOG ( 3, ( "------------------------------\n\n" ) );
+
+    return;
+}
+
+/*
+ *  cas_send_bs_msg()
+ *
+ *  (channel access server send message)
+ *
+ *
+ * Set lock_needed=1 unless SEND_LOCK() is held by caller
+ */
+void cas_send_bs_msg ( struct client *pclient, int lock_needed )
+{
+    if ( lock_needed ) {
+        SEND_LOCK ( pclient );
+    }
+
+    cas_send_bs ( pclient, FALSE );
+
     if ( lock_needed ) {
         SEND_UNLOCK(pclient);
     }
+}
 
-    DLOG ( 3, ( "------------------------------\n\n" ) );
-
-    return;
+/*
+ *  cas_send_bs_msg_all()
+ *
+ *  Like cas_send_bs_msg() but the send buffer is empty on return,
+ *  for callers that need room in it.  In reactor mode what could not
+ *  be sent is kept in the backlog.
+ *
+ *  send lock must be on while in this routine
+ */
+void cas_send_bs_msg_all ( struct client *pclient )
+{
+    cas_send_bs ( pclient, TRUE );
 }
 
 /*
@@ -201,8 +450,29 @@ void cas_send_dg_msg ( struct client * pclient )
         sizeDG -= sizeof (caHdr);
     }
 
-    status = sendto ( pclient->sock, pDG, sizeDG, 0,
-       (struct sockaddr *)&pclient->addr, sizeof(pclient->addr) );
+#ifdef __linux__
+    if ( pclient->dgBatch ) {
+        struct cas_dg_batch *pBatch = pclient->dgBatch;
+
+        if ( pBatch->n == CAS_DG_BATCH ) {
+            cas_send_dg_batch ( pclient );
+        }
+        assert ( (unsigned) sizeDG <= sizeof ( pBatch->buf[0] ) );
+        memcpy ( pBatch->buf[pBatch->n], pDG, sizeDG );
+        pBatch->iov[pBatch->n].iov_len = sizeDG;
+        pBatch->addr[pBatch->n] = pclient->addr;
+        pBatch->n++;
+        status = sizeDG;
+    }
+    else
+#endif
+    {
+        status = sendto ( pclient->sock, pDG, sizeDG, 0,
+           (struct sockaddr *)&pclient->addr, sizeof(pclient->addr) );
+        if ( status >= 0 ) {
+            epicsAtomicIncrSizeT ( &rsrvUdpReplies );
+        }
+    }
     if ( status >= 0 ) {
         if ( status >= sizeDG ) {
             epicsTimeGetCurrent ( &pclient->time_at_last_send );
@@ -236,6 +506,100 @@ void cas_send_dg_msg ( struct client * pclient )
     return;
 }
 
+/*
+ *  cas_attach_dg_batch()
+ *
+ *  Have cas_send_dg_msg() queue datagrams for cas_send_dg_batch()
+ *  instead of sending each one immediately
+ */
+void cas_attach_dg_batch ( struct client * pclient )
+{
+#ifdef __linux__
+    struct cas_dg_batch *pBatch = calloc ( 1, sizeof ( *pBatch ) );
+    unsigned i;
+
+    if ( ! pBatch ) {
+        return;
+    }
+    for ( i = 0u; i < CAS_DG_BATCH; i++ ) {
+        pBatch->iov[i].iov_base = pBatch->buf[i];
+        pBatch->msgs[i].msg_hdr.msg_iov = &pBatch->iov[i];
+        pBatch->msgs[i].msg_hdr.msg_iovlen = 1;
+        pBatch->msgs[i].msg_hdr.msg_name = &pBatch->addr[i];
+        pBatch->msgs[i].msg_hdr.msg_namelen = sizeof ( pBatch->addr[i] );
+    }
+    pclient->dgBatch = pBatch;
+#endif
+}
+
+/*
+ *  cas_send_dg_batch()
+ *
+ *  Send the datagrams queued by cas_send_dg_msg()
+ */
+void cas_send_dg_batch ( struct client * pclient )
+{
+#ifdef __linux__
+    struct cas_dg_batch *pBatch = pclient->dgBatch;
+    unsigned sent = 0u;
+
+    if ( ! pBatch ) {
+        return;
+    }
+
+    while ( sent < pBatch->n ) {
+        int status = sendmmsg ( pclient->sock, &pBatch->msgs[sent],
+            pBatch->n - sent, 0 );
+        if ( status > 0 ) {
+            epicsAtomicAddSizeT ( &rsrvUdpReplies, (size_t) status );
+            sent += (unsigned) status;
+        }
+        else if ( SOCKERRNO != SOCK_EINTR ) {
+            char sockErrBuf[64];
+            char buf[128];
+            epicsSocketConvertErrnoToString (
+                sockErrBuf, sizeof ( sockErrBuf ) );
+            ipAddrToDottedIP ( &pBatch->addr[sent], buf, sizeof(buf) );
+            errlogPrintf( "CAS: UDP send to %s failed: %s\n",
+                buf, sockErrBuf);
+            /* skip the datagram which failed */
+            sent++;
+        }
+    }
+    pBatch->n = 0u;
+#endif
+}
+
+/*
+ * Fill in a message header at the end of the outgoing message buffer
+ * and return a pointer to the message body which follows it.
+ */
+static char * cas_put_header (
+    struct client *pclient, ca_uint16_t response,
+    ca_uint32_t alignedPayloadSize, ca_uint16_t dataType,
+    ca_uint32_t nElem, ca_uint32_t cid, ca_uint32_t responseSpecific )
+{
+    caHdr *pMsg = (caHdr *) &pclient->send.buf[pclient->send.stk];
+
+    pMsg->m_cmmd = htons(response);
+    pMsg->m_dataType = htons(dataType);
+    pMsg->m_cid = htonl(cid);
+    pMsg->m_available = htonl(responseSpecific);
+    if (alignedPayloadSize < 0xffff && nElem < 0xffff) {
+        pMsg->m_postsize = htons(((ca_uint16_t) alignedPayloadSize));
+        pMsg->m_count = htons(((ca_uint16_t) nElem));
+        return (char *) (pMsg + 1);
+    }
+    else {
+        ca_uint32_t *pW32 = (ca_uint32_t *) (pMsg + 1);
+        pMsg->m_postsize = htons(0xffff);
+        pMsg->m_count = htons(0u);
+        pW32[0] = htonl(alignedPayloadSize);
+        pW32[1] = htonl(nElem);
+        return (char *) (pW32 + 2);
+    }
+}
+
 /*
  *
  *  cas_copy_in_header()
@@ -255,7 +619,7 @@ int cas_copy_in_header (
 {
     unsigned    msgSize;
     ca_uint32_t alignedPayloadSize;
-    caHdr *pMsg;
+    char *pPayload;
 
     if ( payloadSize > UINT_MAX - sizeof ( caHdr ) - 8u ) {
         return ECA_TOLARGE;
@@ -280,11 +644,11 @@ int cas_copy_in_header (
 
     if ( pclient->send.stk > pclient->send.maxstk - msgSize ) {
         if ( pclient->disconnect ) {
-            pclient->send.stk = 0;
+            cas_discard_send ( pclient );
         }
         else{
             if ( pclient->proto == IPPROTO_TCP) {
-                cas_send_bs_msg ( pclient, FALSE );
+                cas_send_bs_msg_all ( pclient );
             }
             else if ( pclient->proto == IPPROTO_UDP ) {
                 cas_send_dg_msg ( pclient );
@@ -295,37 +659,98 @@ int cas_copy_in_header (
         }
     }
 
-    pMsg = (caHdr *) &pclient->send.buf[pclient->send.stk];
-    pMsg->m_cmmd = htons(response);
-    pMsg->m_dataType = htons(dataType);
-    pMsg->m_cid = htonl(cid);
-    pMsg->m_available = htonl(responseSpecific);
-    if (alignedPayloadSize < 0xffff && nElem < 0xffff) {
-        pMsg->m_postsize = htons(((ca_uint16_t) alignedPayloadSize));
-        pMsg->m_count = htons(((ca_uint16_t) nElem));
-        if (ppPayload)
-            *ppPayload = (void *) (pMsg + 1);
-    }
-    else {
-        ca_uint32_t *pW32 = (ca_uint32_t *) (pMsg + 1);
-        pMsg->m_postsize = htons(0xffff);
-        pMsg->m_count = htons(0u);
-        pW32[0] = htonl(alignedPayloadSize);
-        pW32[1] = htonl(nElem);
-        if (ppPayload)
-            *ppPayload = (void *) (pW32 + 2);
-    }
+    pPayload = cas_put_header ( pclient, response, alignedPayloadSize,
+        dataType, nElem, cid, responseSpecific );
+    if ( ppPayload )
+        *ppPayload = pPayload;
 
     /* zero out pad bytes */
     if ( alignedPayloadSize > payloadSize ) {
-        char *p = ( char * ) *ppPayload;
-        memset ( p + payloadSize, '\0',
+        memset ( pPayload + payloadSize, '\0',
             alignedPayloadSize - payloadSize );
     }
 
     return ECA_NORMAL;
 }
 
+/*
+ *
+ *  cas_copy_in_ref()
+ *
+ *  Queue a TCP message whose payload is the prefixSize bytes at
+ *  pPrefix, which are copied into the outgoing message buffer, followed
+ *  by dataSize bytes sent directly from pData.  The send references
+ *  take over hold, which keeps pData valid, when this returns
+ *  ECA_NORMAL.  Otherwise the caller must release it.
+ *
+ *  send lock must be on while in this routine
+ */
+int cas_copy_in_ref (
+    struct client *pclient, ca_uint16_t response, ca_uint16_t dataType,
+    ca_uint32_t nElem, ca_uint32_t cid, ca_uint32_t responseSpecific,
+    const void *pPrefix, ca_uint32_t prefixSize,
+    const void *pData, ca_uint32_t dataSize, void *hold )
+{
+    unsigned    hdrSize = sizeof ( caHdr );
+    unsigned    padSize;
+    ca_uint32_t alignedPayloadSize;
+    char *pPayload;
+    struct send_ref *pRef;
+
+    if ( pclient->proto != IPPROTO_TCP ) {
+        return ECA_INTERNAL;
+    }
+
+    if ( prefixSize > MAX_TCP / 2 ||
+            dataSize > UINT_MAX - sizeof ( caHdr ) - MAX_TCP ) {
+        return ECA_TOLARGE;
+    }
+
+    alignedPayloadSize = CA_MESSAGE_ALIGN ( prefixSize + dataSize );
+    padSize = alignedPayloadSize - prefixSize - dataSize;
+
+    if ( alignedPayloadSize >= 0xffff || nElem >= 0xffff ) {
+        if ( ! CA_V49 ( pclient->minor_version_number ) ) {
+            return ECA_16KARRAYCLIENT;
+        }
+        hdrSize += 2 * sizeof ( ca_uint32_t );
+    }
+
+    /* clients are not prepared for more than a large buffer */
+    if ( rsrvLargeBufFreeListTCP &&
+            alignedPayloadSize + hdrSize > rsrvSizeofLargeBufTCP ) {
+        return ECA_TOLARGE;
+    }
+
+    if ( pclient->nSendRefs >= CAS_SEND_REFS ||
+            pclient->send.stk >
+                pclient->send.maxstk - hdrSize - prefixSize - padSize ) {
+        if ( pclient->disconnect ) {
+            cas_discard_send ( pclient );
+        }
+        else {
+            cas_send_bs_msg_all ( pclient );
+        }
+    }
+
+    pPayload = cas_put_header ( pclient, response, alignedPayloadSize,
+        dataType, nElem, cid, responseSpecific );
+    memcpy ( pPayload, pPrefix, prefixSize );
+    pclient->send.stk = (unsigned) ( pPayload + prefixSize -
+        pclient->send.buf );
+
+    pRef = &pclient->sendRefs[pclient->nSendRefs++];
+    pRef->pData = ( const char * ) pData;
+    pRef->hold = hold;
+    pRef->bufOffset = pclient->send.stk;
+    pRef->size = dataSize;
+
+    memset ( pPayload + prefixSize, '\0', padSize );
+    pclient->send.stk += padSize;
+
+    return ECA_NORMAL;
+}
+
 void cas_set_header_cid ( struct client *pClient, ca_uint32_t cid )
 {
     caHdr *pMsg = ( caHdr * ) &pClient->send.buf[pClient->send.stk];
@@ -23,6 +23,7 @@
 #include <errno.h>
 
 #include "addrList.h"
+#include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsSignal.h"
@@ -107,6 +108,17 @@ static void req_server (void *pParm)
             ellAdd ( &clientQ, &pClient->node );
             UNLOCK_CLIENTQ;
 
+            if ( rsrvReactorActive ) {
+                if ( casReactorAddClient ( pClient ) ) {
+                    LOCK_CLIENTQ;
+                    ellDelete ( &clientQ, &pClient->node );
+                    UNLOCK_CLIENTQ;
+                    destroy_tcp_client ( pClient );
+                    epicsThreadSleep ( 15.0 );
+                }
+                continue;
+            }
+
             id = epicsThreadCreate ( "CAS-client", epicsThreadPriorityCAServerLow,
                     epicsThreadGetStackSize ( epicsThreadStackBig ),
                     camsgtask, pClient );
@@ -485,6 +497,13 @@ void rsrv_init (void)
 
     rsrvCurrentClient = epicsThreadPrivateCreate ();
 
+    if ( rsrvReactorThreads > 0 ) {
+        rsrvReactorActive = ! casReactorInit ();
+        if ( ! rsrvReactorActive ) {
+            errlogPrintf ( "CAS: using a thread pair per client instead\n" );
+        }
+    }
+
     if ( envGetConfigParamPtr ( &EPICS_CAS_SERVER_PORT ) ) {
         ca_server_port = envGetInetPortConfigParam ( &EPICS_CAS_SERVER_PORT,
             (unsigned short) CA_SERVER_PORT );
@@ -928,6 +947,22 @@ void casr (unsigned level)
     }
     UNLOCK_CLIENTQ
 
+    if (level>=1) {
+        printf("UDP name searches: %lu found, %lu not found, "
+            "%lu rejected by name filter\n",
+            (unsigned long) epicsAtomicGetSizeT(&rsrvSearchFound),
+            (unsigned long) epicsAtomicGetSizeT(&rsrvSearchNotFound),
+            (unsigned long) epicsAtomicGetSizeT(&rsrvSearchRejected));
+        printf("UDP datagrams: %lu received with others, %lu dropped, "
+            "%lu replies sent\n",
+            (unsigned long) epicsAtomicGetSizeT(&rsrvUdpBatched),
+            (unsigned long) epicsAtomicGetSizeT(&rsrvUdpDropped),
+            (unsigned long) epicsAtomicGetSizeT(&rsrvUdpReplies));
+        printf("Array bytes sent without copying: %lu\n",
+            (unsigned long) epicsAtomicGetSizeT(&rsrvSendRefBytes));
+        casReactorShow(level);
+    }
+
     if (level>=1) {
         rsrv_iface_config *iface = (rsrv_iface_config *) ellFirst ( &servers );
         while (iface) {
@@ -1060,6 +1095,7 @@ void destroy_client ( struct client *client )
     }
 
     if ( client->proto == IPPROTO_TCP ) {
+        cas_discard_send ( client );
         if ( client->send.buf ) {
             if ( client->send.type == mbtSmallTCP ) {
                 freeListFree ( rsrvSmallBufFreeListTCP,  client->send.buf );
@@ -1128,6 +1164,8 @@ void destroy_client ( struct client *client )
         free ( client->pHostName );
     }
 
+    free ( client->dgBatch );
+
     freeListFree ( rsrvClientFreeList, client );
 }
 
@@ -1279,7 +1317,7 @@ struct client * create_client ( SOCKET sock, int proto )
         client->recv.type = mbtSmallTCP;
     }
     else if ( proto == IPPROTO_UDP ) {
-        client->send.buf = malloc ( MAX_UDP_SEND );
+        client->send.buf = malloc ( ETHERNET_MAX_UDP );
         client->send.maxstk = MAX_UDP_SEND;
         client->send.type = mbtUDP;
         client->recv.buf = malloc ( MAX_UDP_RECV );
@@ -1292,6 +1330,7 @@ struct client * create_client ( SOCKET sock, int proto )
     }
     client->send.stk = 0u;
     client->send.cnt = 0u;
+    client->nSendRefs = 0u;
     client->recv.stk = 0u;
     client->recv.cnt = 0u;
     client->evuser = NULL;
@@ -1503,8 +1542,13 @@ struct client *create_tcp_client (SOCKET sock , const osiSockAddr *peerAddr)
         }
     }
 
-    status = db_start_events ( client->evuser, "CAS-event",
-                NULL, NULL, priorityOfEvents );
+    if ( rsrvReactorActive ) {
+        status = casReactorStartEvents ( client );
+    }
+    else {
+        status = db_start_events ( client->evuser, "CAS-event",
+                    NULL, NULL, priorityOfEvents );
+    }
     if ( status != DB_EVENT_OK ) {
         errlogPrintf ( "CAS: unable to start the event facility\n" );
         destroy_tcp_client ( client );
@@ -0,0 +1,679 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS Base is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+/*
+ *  Reactor mode for the CA server.
+ *
+ *  Instead of a receive thread and an event thread for each client,
+ *  a few reactor threads wait in epoll for socket readiness and hand
+ *  the work to a fixed pool of worker threads.  Each client has two
+ *  work items, one which receives and runs requests and one which
+ *  delivers events and finishes sends left blocked by a full socket.
+ *  No worker ever waits for a client's socket.  While a send is blocked
+ *  its client's events and requests are left alone until the socket is
+ *  writable again.  Queued work is taken in order of the client's CA
+ *  priority, except that work which has waited too long goes first.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "dbDefs.h"
+#include "ellLib.h"
+#include "epicsEvent.h"
+#include "epicsMutex.h"
+#include "epicsSignal.h"
+#include "epicsStdio.h"
+#include "epicsThread.h"
+#include "errlog.h"
+#include "osiSock.h"
+#include "cantProceed.h"
+
+#define epicsExportSharedSymbols
+#include "dbEvent.h"
+#include "rsrv.h"
+#include "server.h"
+
+int rsrvReactorThreads = 0;
+int rsrvWorkerThreads = 0;
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+
+/* receives done by one run of the receive work before it yields */
+#define CAS_RECV_BATCH 8u
+
+#define CAS_EPOLL_EVENTS 64
+
+/* other work taken while queued work waits before it goes first */
+#define CAS_WORK_MAX_WAIT 64u
+
+typedef enum { workDone, workAgain, workClientGone } workStatus;
+
+struct cas_slot {
+    struct client       *client;    /* NULL when free */
+    epicsUInt32         gen;        /* tells a reused slot from the old one */
+};
+
+struct cas_reactor {
+    int                 epfd;
+    unsigned            index;
+    unsigned            nClients;   /* guarded by the pool lock */
+    epicsThreadId       tid;
+};
+
+static struct cas_pool {
+    epicsMutexId        lock;
+    epicsEventId        wakeup;
+    unsigned            nIdle;
+    unsigned            nQueued;
+    ELLLIST             queue[CA_PROTO_PRIORITY_MAX + 1];
+    unsigned            picks;      /* work taken from the queues */
+
+    struct cas_slot     *slots;
+    unsigned            nSlots;
+    unsigned            *freeSlots;
+    unsigned            nFreeSlots;
+
+    struct cas_reactor  *reactors;
+    unsigned            nReactors;
+    unsigned            nextReactor;
+    unsigned            nWorkers;
+
+    size_t              recvRuns;
+    size_t              eventRuns;
+    size_t              wakeups;
+    size_t              agedRuns;
+} pool;
+
+/*
+ * Queue work unless it is already queued, in which case nothing needs
+ * doing, or is running, in which case it runs again when finished.
+ *
+ * pool lock must be held
+ */
+static void work_schedule_locked ( struct cas_work *pWork )
+{
+    switch ( pWork->state ) {
+    case cwsIdle:
+        pWork->state = cwsQueued;
+        pWork->prio = pWork->client->priority;
+        pWork->queuedAt = pool.picks;
+        ellAdd ( &pool.queue[pWork->prio], &pWork->node );
+        pool.nQueued++;
+        if ( pool.nIdle ) {
+            epicsEventSignal ( pool.wakeup );
+        }
+        break;
+    case cwsRunning:
+        pWork->state = cwsRunAgain;
+        break;
+    default:
+        break;
+    }
+}
+
+static void work_schedule ( struct cas_work *pWork )
+{
+    epicsMutexMustLock ( pool.lock );
+    work_schedule_locked ( pWork );
+    epicsMutexUnlock ( pool.lock );
+}
+
+/*
+ * Make sure that the work never runs again, waiting for it
+ * to finish if it is running now.
+ */
+static void work_cancel ( struct cas_work *pWork )
+{
+    epicsMutexMustLock ( pool.lock );
+    switch ( pWork->state ) {
+    case cwsQueued:
+        ellDelete ( &pool.queue[pWork->prio], &pWork->node );
+        pool.nQueued--;
+        pWork->state = cwsCanceled;
+        break;
+    case cwsIdle:
+        pWork->state = cwsCanceled;
+        break;
+    case cwsRunning:
+    case cwsRunAgain:
+        pWork->state = cwsCanceling;
+        break;
+    default:
+        break;
+    }
+    while ( pWork->state != cwsCanceled ) {
+        epicsMutexUnlock ( pool.lock );
+        epicsThreadSleep ( 0.01 );
+        epicsMutexMustLock ( pool.lock );
+    }
+    epicsMutexUnlock ( pool.lock );
+}
+
+/*
+ * Ask the client's reactor to report the readiness in events.
+ *
+ * pool lock must be held
+ */
+static void reactor_arm_locked ( struct client *client, unsigned events )
+{
+    struct epoll_event ev;
+
+    if ( pool.slots[client->reactorSlot].client != client ) {
+        return;     /* being removed */
+    }
+    client->reactorEvents |= events;
+
+    ev.events = client->reactorEvents | EPOLLONESHOT;
+    ev.data.u64 = ( (epicsUInt64) pool.slots[client->reactorSlot].gen << 32 ) |
+        client->reactorSlot;
+    if ( epoll_ctl ( client->reactor->epfd, EPOLL_CTL_MOD,
+            client->sock, &ev ) < 0 ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString ( sockErrBuf, sizeof ( sockErrBuf ) );
+        errlogPrintf ( "CAS: epoll re-arm failed: %s\n", sockErrBuf );
+    }
+}
+
+static void reactor_arm ( struct client *client, unsigned events )
+{
+    epicsMutexMustLock ( pool.lock );
+    reactor_arm_locked ( client, events );
+    epicsMutexUnlock ( pool.lock );
+}
+
+/*
+ * Take the client out of its reactor, stop its work and destroy it.
+ * Called by its receive work, which therefore isn't running elsewhere.
+ */
+static void reactor_remove_client ( struct client *client )
+{
+    struct cas_reactor *pReactor = client->reactor;
+
+    epicsMutexMustLock ( pool.lock );
+    if ( client->sock != INVALID_SOCKET ) {
+        epoll_ctl ( pReactor->epfd, EPOLL_CTL_DEL, client->sock, NULL );
+    }
+    pool.slots[client->reactorSlot].client = NULL;
+    pool.slots[client->reactorSlot].gen++;
+    pool.freeSlots[pool.nFreeSlots++] = client->reactorSlot;
+    pReactor->nClients--;
+    epicsMutexUnlock ( pool.lock );
+
+    work_cancel ( &client->eventWork );
+
+    LOCK_CLIENTQ;
+    ellDelete ( &clientQ, &client->node );
+    UNLOCK_CLIENTQ;
+
+    destroy_tcp_client ( client );
+}
+
+/*
+ * Stop running requests while the send is blocked.  The event work
+ * schedules the receive work again when the socket has taken it all.
+ */
+static int recv_pause ( struct client *client )
+{
+    int blocked;
+
+    SEND_LOCK ( client );
+    blocked = client->sendBlocked;
+    client->recvPaused = blocked;
+    SEND_UNLOCK ( client );
+    return blocked;
+}
+
+static workStatus recv_work ( struct client *client )
+{
+    unsigned nRecv = 0u;
+    int resumed = client->recvPaused;
+
+    if ( recv_pause ( client ) ) {
+        return workDone;
+    }
+    /* requests received before the send was blocked */
+    if ( resumed && client->recv.cnt && camsg_received ( client, 0u ) ) {
+        reactor_remove_client ( client );
+        return workClientGone;
+    }
+
+    while ( castcp_ctl == ctlRun && ! client->disconnect ) {
+        long nchars;
+
+        if ( recv_pause ( client ) ) {
+            return workDone;
+        }
+
+        client->recv.stk = 0;
+        assert ( client->recv.maxstk >= client->recv.cnt );
+        nchars = recv ( client->sock, &client->recv.buf[client->recv.cnt],
+                (int) ( client->recv.maxstk - client->recv.cnt ), 0 );
+        if ( nchars == 0 ) {
+            if ( CASDEBUG > 0 ) {
+                errlogPrintf ( "CAS: nill message disconnect\n" );
+            }
+            break;
+        }
+        else if ( nchars < 0 ) {
+            int anerrno = SOCKERRNO;
+
+            if ( anerrno == SOCK_EINTR ) {
+                continue;
+            }
+            if ( anerrno == SOCK_EWOULDBLOCK ) {
+                /* all caught up, send the replies and wait for more */
+                cas_send_bs_msg ( client, TRUE );
+                reactor_arm ( client, EPOLLIN );
+                return workDone;
+            }
+            camsg_recv_failed ( anerrno );
+            break;
+        }
+
+        if ( camsg_received ( client, ( unsigned ) nchars ) ) {
+            break;
+        }
+
+        if ( ++nRecv == CAS_RECV_BATCH ) {
+            /* give other clients a turn */
+            return workAgain;
+        }
+    }
+
+    reactor_remove_client ( client );
+    return workClientGone;
+}
+
+static workStatus event_work ( struct client *client )
+{
+    int blocked, resume;
+
+    SEND_LOCK ( client );
+    if ( client->sendBlocked ) {
+        cas_send_bs_msg ( client, FALSE );
+    }
+    blocked = client->sendBlocked;
+    resume = ! blocked && client->recvPaused;
+    SEND_UNLOCK ( client );
+
+    if ( resume ) {
+        work_schedule ( &client->recvWork );
+    }
+    /* with a full socket new events would only add to the backlog */
+    if ( ! blocked ) {
+        db_event_run ( client->evuser );
+    }
+    return workDone;
+}
+
+static void event_dispatch ( void *pArg )
+{
+    struct client *client = pArg;
+
+    work_schedule ( &client->eventWork );
+}
+
+/*
+ * Take the queued work of the highest priority, unless work of a lower
+ * priority has waited for more than CAS_WORK_MAX_WAIT others, in which
+ * case the longest waiting of those goes first.
+ *
+ * pool lock must be held
+ */
+static struct cas_work * work_next_locked ( void )
+{
+    struct cas_work *pNext = NULL;
+    struct cas_work *pAged = NULL;
+    int prio;
+
+    if ( ! pool.nQueued ) {
+        return NULL;
+    }
+    for ( prio = CA_PROTO_PRIORITY_MAX; prio >= 0; prio-- ) {
+        struct cas_work *pWork = (struct cas_work *) ellFirst ( &pool.queue[prio] );
+
+        if ( ! pWork ) {
+            continue;
+        }
+        if ( ! pNext ) {
+            pNext = pWork;
+        }
+        else if ( pool.picks - pWork->queuedAt > CAS_WORK_MAX_WAIT &&
+                ( ! pAged || pool.picks - pWork->queuedAt >
+                    pool.picks - pAged->queuedAt ) ) {
+            pAged = pWork;
+        }
+    }
+    if ( pAged ) {
+        pNext = pAged;
+        pool.agedRuns++;
+    }
+    if ( pNext ) {
+        ellDelete ( &pool.queue[pNext->prio], &pNext->node );
+        pool.nQueued--;
+        pool.picks++;
+    }
+    return pNext;
+}
+
+static void worker_task ( void *pParm )
+{
+    epicsSignalInstallSigPipeIgnore ();
+
+    epicsMutexMustLock ( pool.lock );
+    while ( TRUE ) {
+        struct cas_work *pWork = work_next_locked ();
+        struct client *client;
+        workStatus status;
+
+        if ( ! pWork ) {
+            pool.nIdle++;
+            epicsMutexUnlock ( pool.lock );
+            epicsEventMustWait ( pool.wakeup );
+            epicsMutexMustLock ( pool.lock );
+            pool.nIdle--;
+            continue;
+        }
+
+        /* a single wakeup may stand for several queued items */
+        if ( pool.nQueued && pool.nIdle ) {
+            epicsEventSignal ( pool.wakeup );
+        }
+
+        pWork->state = cwsRunning;
+        client = pWork->client;
+        if ( pWork->isRecv ) {
+            pool.recvRuns++;
+        }
+        else {
+            pool.eventRuns++;
+        }
+        epicsMutexUnlock ( pool.lock );
+
+        epicsThreadPrivateSet ( rsrvCurrentClient, client );
+        if ( pWork->isRecv ) {
+            status = recv_work ( client );
+        }
+        else {
+            status = event_work ( client );
+        }
+        epicsThreadPrivateSet ( rsrvCurrentClient, NULL );
+
+        epicsMutexMustLock ( pool.lock );
+        if ( status == workClientGone ) {
+            continue;
+        }
+        switch ( pWork->state ) {
+        case cwsRunning:
+            pWork->state = cwsIdle;
+            if ( status == workAgain ) {
+                work_schedule_locked ( pWork );
+            }
+            break;
+        case cwsRunAgain:
+            pWork->state = cwsIdle;
+            work_schedule_locked ( pWork );
+            break;
+        case cwsCanceling:
+            pWork->state = cwsCanceled;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void reactor_task ( void *pParm )
+{
+    struct cas_reactor *pReactor = pParm;
+    struct epoll_event events[CAS_EPOLL_EVENTS];
+
+    while ( TRUE ) {
+        int i, n;
+
+        n = epoll_wait ( pReactor->epfd, events, CAS_EPOLL_EVENTS, -1 );
+        if ( n < 0 ) {
+            if ( errno != EINTR ) {
+                char sockErrBuf[64];
+                epicsSocketConvertErrnoToString (
+                    sockErrBuf, sizeof ( sockErrBuf ) );
+                errlogPrintf ( "CAS: epoll wait failed: %s\n", sockErrBuf );
+                epicsThreadSleep ( 1.0 );
+            }
+            continue;
+        }
+
+        epicsMutexMustLock ( pool.lock );
+        pool.wakeups++;
+        for ( i = 0; i < n; i++ ) {
+            unsigned slot = (unsigned) ( events[i].data.u64 & 0xffffffffu );
+            epicsUInt32 gen = (epicsUInt32) ( events[i].data.u64 >> 32 );
+            unsigned fired = events[i].events;
+            struct client *client;
+
+            if ( slot >= pool.nSlots || pool.slots[slot].gen != gen ) {
+                continue;
+            }
+            client = pool.slots[slot].client;
+            if ( ! client ) {
+                continue;
+            }
+
+            /* one shot, so nothing is armed now */
+            if ( fired & ( EPOLLIN | EPOLLERR | EPOLLHUP ) ) {
+                client->reactorEvents &= ~EPOLLIN;
+                work_schedule_locked ( &client->recvWork );
+            }
+            if ( fired & ( EPOLLOUT | EPOLLERR | EPOLLHUP ) ) {
+                client->reactorEvents &= ~EPOLLOUT;
+                work_schedule_locked ( &client->eventWork );
+            }
+            if ( client->reactorEvents ) {
+                reactor_arm_locked ( client, 0u );
+            }
+        }
+        epicsMutexUnlock ( pool.lock );
+    }
+}
+
+int casReactorInit ( void )
+{
+    unsigned i;
+    int nWorkers = rsrvWorkerThreads;
+
+    if ( nWorkers <= 0 ) {
+        nWorkers = 2 * epicsThreadGetCPUs ();
+    }
+    if ( nWorkers < 2 ) {
+        /* receive work may wait for event work, see rsrv_extra_labor() */
+        nWorkers = 2;
+    }
+
+    pool.lock = epicsMutexMustCreate ();
+    pool.wakeup = epicsEventMustCreate ( epicsEventEmpty );
+    for ( i = 0u; i <= CA_PROTO_PRIORITY_MAX; i++ ) {
+        ellInit ( &pool.queue[i] );
+    }
+
+    pool.nReactors = (unsigned) rsrvReactorThreads;
+    pool.reactors = callocMustSucceed ( pool.nReactors,
+        sizeof ( *pool.reactors ), "casReactorInit" );
+    for ( i = 0u; i < pool.nReactors; i++ ) {
+        struct cas_reactor *pReactor = &pool.reactors[i];
+        char name[32];
+
+        pReactor->index = i;
+        pReactor->epfd = epoll_create1 ( EPOLL_CLOEXEC );
+        if ( pReactor->epfd < 0 ) {
+            char sockErrBuf[64];
+            epicsSocketConvertErrnoToString ( sockErrBuf, sizeof ( sockErrBuf ) );
+            errlogPrintf ( "CAS: epoll create failed: %s\n", sockErrBuf );
+            return -1;
+        }
+        epicsSnprintf ( name, sizeof ( name ), "CAS-reactor%u", i );
+        pReactor->tid = epicsThreadMustCreate ( name,
+            epicsThreadPriorityCAServerHigh,
+            epicsThreadGetStackSize ( epicsThreadStackSmall ),
+            reactor_task, pReactor );
+    }
+
+    for ( i = 0u; i < (unsigned) nWorkers; i++ ) {
+        char name[32];
+
+        epicsSnprintf ( name, sizeof ( name ), "CAS-worker%u", i );
+        epicsThreadMustCreate ( name, epicsThreadPriorityCAServerLow,
+            epicsThreadGetStackSize ( epicsThreadStackBig ),
+            worker_task, NULL );
+    }
+    pool.nWorkers = (unsigned) nWorkers;
+    return 0;
+}
+
+int casReactorStartEvents ( struct client *client )
+{
+    memset ( &client->recvWork, 0, sizeof ( client->recvWork ) );
+    client->recvWork.client = client;
+    client->recvWork.state = cwsIdle;
+    client->recvWork.isRecv = TRUE;
+    memset ( &client->eventWork, 0, sizeof ( client->eventWork ) );
+    client->eventWork.client = client;
+    client->eventWork.state = cwsIdle;
+
+    return db_start_events_dispatched ( client->evuser,
+        event_dispatch, client );
+}
+
+int casReactorAddClient ( struct client *client )
+{
+    struct cas_reactor *pReactor;
+    struct epoll_event ev;
+    osiSockIoctl_t yes = TRUE;
+    unsigned slot;
+
+    if ( socket_ioctl ( client->sock, FIONBIO, &yes ) < 0 ) {
+        errlogPrintf ( "CAS: unable to make client socket non-blocking\n" );
+        return -1;
+    }
+
+    epicsMutexMustLock ( pool.lock );
+    if ( ! pool.nFreeSlots ) {
+        unsigned nSlots = pool.nSlots ? 2u * pool.nSlots : 64u;
+        struct cas_slot *pSlots = realloc ( pool.slots,
+            nSlots * sizeof ( *pSlots ) );
+        unsigned *pFree = realloc ( pool.freeSlots,
+            nSlots * sizeof ( *pFree ) );
+
+        if ( pSlots ) {
+            pool.slots = pSlots;
+        }
+        if ( pFree ) {
+            pool.freeSlots = pFree;
+        }
+        if ( ! pSlots || ! pFree ) {
+            epicsMutexUnlock ( pool.lock );
+            errlogPrintf ( "CAS: no memory for reactor client\n" );
+            return -1;
+        }
+        for ( slot = nSlots; slot > pool.nSlots; slot-- ) {
+            pool.slots[slot - 1u].client = NULL;
+            pool.slots[slot - 1u].gen = 0u;
+            pool.freeSlots[pool.nFreeSlots++] = slot - 1u;
+        }
+        pool.nSlots = nSlots;
+    }
+    slot = pool.freeSlots[--pool.nFreeSlots];
+    pool.slots[slot].client = client;
+
+    pReactor = &pool.reactors[pool.nextReactor++ % pool.nReactors];
+    pReactor->nClients++;
+    client->reactor = pReactor;
+    client->reactorSlot = slot;
+    client->reactorEvents = 0u;
+
+    /* nothing armed until the receive work has caught up */
+    ev.events = EPOLLONESHOT;
+    ev.data.u64 = ( (epicsUInt64) pool.slots[slot].gen << 32 ) | slot;
+    if ( epoll_ctl ( pReactor->epfd, EPOLL_CTL_ADD, client->sock, &ev ) < 0 ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString ( sockErrBuf, sizeof ( sockErrBuf ) );
+        pool.slots[slot].client = NULL;
+        pool.freeSlots[pool.nFreeSlots++] = slot;
+        pReactor->nClients--;
+        client->reactor = NULL;
+        epicsMutexUnlock ( pool.lock );
+        errlogPrintf ( "CAS: epoll add failed: %s\n", sockErrBuf );
+        return -1;
+    }
+
+    /* sends the version reply queued by create_tcp_client() */
+    work_schedule_locked ( &client->recvWork );
+    epicsMutexUnlock ( pool.lock );
+    return 0;
+}
+
+/*
+ * send lock must be held
+ */
+void casReactorWantSend ( struct client *client )
+{
+    reactor_arm ( client, EPOLLOUT );
+}
+
+void casReactorShow ( unsigned level )
+{
+    unsigned i;
+
+    if ( ! rsrvReactorActive ) {
+        return;
+    }
+
+    epicsMutexMustLock ( pool.lock );
+    printf ( "Reactor mode: %u reactor thread%s, %u worker%s, "
+        "%u busy, %u work items queued\n",
+        pool.nReactors, pool.nReactors == 1 ? "" : "s",
+        pool.nWorkers, pool.nWorkers == 1 ? "" : "s",
+        pool.nWorkers - pool.nIdle, pool.nQueued );
+    printf ( "    %lu receive runs, %lu event runs, %lu reactor wakeups, "
+        "%lu run out of priority order\n",
+        (unsigned long) pool.recvRuns, (unsigned long) pool.eventRuns,
+        (unsigned long) pool.wakeups, (unsigned long) pool.agedRuns );
+    if ( level >= 2 ) {
+        for ( i = 0u; i < pool.nReactors; i++ ) {
+            printf ( "    CAS-reactor%u: %u client%s\n", i,
+                pool.reactors[i].nClients,
+                pool.reactors[i].nClients == 1 ? "" : "s" );
+        }
+    }
+    epicsMutexUnlock ( pool.lock );
+}
+
+#else /* __linux__ */
+
+int casReactorInit ( void )
+{
+    errlogPrintf ( "CAS: reactor mode is not supported on this target\n" );
+    return -1;
+}
+
+int casReactorStartEvents ( struct client *client )
+{
+    return -1;
+}
+
+int casReactorAddClient ( struct client *client )
+{
+    return -1;
+}
+
+void casReactorWantSend ( struct client *client ) {}
+
+void casReactorShow ( unsigned level ) {}
+
+#endif /* __linux__ */
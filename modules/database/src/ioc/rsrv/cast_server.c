@@ -37,8 +37,10 @@
 #include <string.h>
 #include <errno.h>
 
+#include "cantProceed.h"
 #include "dbDefs.h"
 #include "envDefs.h"
+#include "epicsAtomic.h"
 #include "epicsMutex.h"
 #include "epicsTime.h"
 #include "errlog.h"
@@ -108,6 +110,174 @@ static void clean_addrq(struct client *client)
 
 }
 
+#ifdef __linux__
+/*
+ * Datagrams received together by recvmmsg()
+ */
+#define CAS_UDP_BATCH 32u
+typedef struct {
+    struct mmsghdr      msgs[CAS_UDP_BATCH];
+    struct iovec        iov[CAS_UDP_BATCH];
+    struct sockaddr_in  addr[CAS_UDP_BATCH];
+    char                control[CAS_UDP_BATCH][CMSG_SPACE(sizeof(epicsUInt32))];
+    char                done[CAS_UDP_BATCH];
+    epicsUInt32         drops;  /* last SO_RXQ_OVFL count seen */
+    char                buf[CAS_UDP_BATCH][ETHERNET_MAX_UDP];
+} recvBatch;
+
+/*
+ * Receive up to CAS_UDP_BATCH datagrams, waiting only for the first
+ */
+static int recv_batch(SOCKET sock, recvBatch *pb)
+{
+    unsigned i;
+    int n;
+
+    for (i = 0; i < CAS_UDP_BATCH; i++) {
+        struct msghdr *pHdr = &pb->msgs[i].msg_hdr;
+
+        pb->iov[i].iov_base = pb->buf[i];
+        pb->iov[i].iov_len = sizeof(pb->buf[i]);
+        pHdr->msg_iov = &pb->iov[i];
+        pHdr->msg_iovlen = 1;
+        pHdr->msg_name = &pb->addr[i];
+        pHdr->msg_namelen = sizeof(pb->addr[i]);
+        pHdr->msg_control = pb->control[i];
+        pHdr->msg_controllen = sizeof(pb->control[i]);
+        pHdr->msg_flags = 0;
+        pb->done[i] = 0;
+    }
+
+    n = recvmmsg(sock, pb->msgs, CAS_UDP_BATCH, MSG_WAITFORONE, NULL);
+    if (n <= 0)
+        return n;
+
+    if (n > 1)
+        epicsAtomicAddSizeT(&rsrvUdpBatched, (size_t) n);
+
+    for (i = 0; i < (unsigned) n; i++) {
+        struct msghdr *pHdr = &pb->msgs[i].msg_hdr;
+        struct cmsghdr *pCmsg;
+
+        /* the kernel counts datagrams lost to a full receive queue */
+        for (pCmsg = CMSG_FIRSTHDR(pHdr); pCmsg;
+                pCmsg = CMSG_NXTHDR(pHdr, pCmsg)) {
+            if (pCmsg->cmsg_level == SOL_SOCKET &&
+                    pCmsg->cmsg_type == SO_RXQ_OVFL) {
+                epicsUInt32 drops;
+
+                memcpy(&drops, CMSG_DATA(pCmsg), sizeof(drops));
+                epicsAtomicAddSizeT(&rsrvUdpDropped,
+                    (size_t) (epicsUInt32) (drops - pb->drops));
+                pb->drops = drops;
+            }
+        }
+        if (pHdr->msg_flags & MSG_TRUNC) {
+            epicsAtomicIncrSizeT(&rsrvUdpDropped);
+            pb->done[i] = 1;
+        }
+    }
+    return n;
+}
+#endif
+
+/*
+ * CAST_REQUEST
+ *
+ * Process one datagram, which is already in client->recv.buf
+ */
+static void cast_request(struct client *client,
+    const struct sockaddr_in *pFrom, unsigned size)
+{
+    int status;
+    int count = 0;
+    size_t idx;
+
+    for (idx=0; casIgnoreAddrs[idx]; idx++)
+    {
+        if (pFrom->sin_addr.s_addr==casIgnoreAddrs[idx]) {
+            return; /* ignore */
+        }
+    }
+
+    if (casudp_ctl != ctlRun)
+        return;
+
+    client->recv.cnt = size;
+    client->recv.stk = 0ul;
+    epicsTimeGetCurrent(&client->time_at_last_recv);
+
+    client->minor_version_number = CA_UKN_MINOR_VERSION;
+    client->seqNoOfReq = 0;
+
+    /*
+     * If we are talking to a new client flush to the old one
+     * in case we are holding UDP messages waiting to
+     * see if the next message is for this same client.
+     */
+    if (client->send.stk>sizeof(caHdr)) {
+        status = memcmp(&client->addr, pFrom, sizeof(*pFrom));
+        if(status){
+            /*
+             * if the address is different
+             */
+            cas_send_dg_msg(client);
+        }
+    }
+    if (client->send.stk<=sizeof(caHdr)) {
+        client->addr = *pFrom;
+        /* raised by the version message of newer clients */
+        client->send.maxstk = MAX_UDP_SEND;
+    }
+
+    if (CASDEBUG>1) {
+        char    buf[40];
+
+        ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
+        errlogPrintf ("CAS: cast server msg of %d bytes from addr %s\n",
+            client->recv.cnt, buf);
+    }
+
+    if (CASDEBUG>2)
+        count = ellCount (&client->chanList);
+
+    status = camessage ( client );
+    if(status == RSRV_OK){
+        if(client->recv.cnt !=
+            client->recv.stk){
+            char buf[40];
+
+            ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
+
+            epicsPrintf ("CAS: partial (damaged?) UDP msg of %d bytes from %s ?\n",
+                client->recv.cnt - client->recv.stk, buf);
+
+            epicsTimeToStrftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S",
+                &client->time_at_last_recv);
+            epicsPrintf ("CAS: message received at %s\n", buf);
+        }
+    }
+    else if (CASDEBUG>0){
+        char buf[40];
+
+        ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
+
+        epicsPrintf ("CAS: invalid (damaged?) UDP request from %s ?\n", buf);
+
+        epicsTimeToStrftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S",
+            &client->time_at_last_recv);
+        epicsPrintf ("CAS: message received at %s\n", buf);
+    }
+
+    if (CASDEBUG>2) {
+        if ( ellCount (&client->chanList) ) {
+            errlogPrintf ("CAS: Fnd %d name matches (%d tot)\n",
+                ellCount(&client->chanList)-count,
+                ellCount(&client->chanList));
+        }
+    }
+}
+
 /*
  * CAST_SERVER
  *
@@ -118,15 +288,19 @@ void cast_server(void *pParm)
 {
     rsrv_iface_config *conf = pParm;
     int                 status;
-    int                 count=0;
     int                 mysocket=0;
-    struct sockaddr_in  new_recv_addr;
-    osiSocklen_t        recv_addr_size;
     osiSockIoctl_t      nchars;
     SOCKET              recv_sock, reply_sock;
     struct client      *client;
+#ifdef __linux__
+    recvBatch           *pBatch;
+    int                 yes = 1;
+#else
+    struct sockaddr_in  new_recv_addr;
+    osiSocklen_t        recv_addr_size;
 
     recv_addr_size = sizeof(new_recv_addr);
+#endif
 
     reply_sock = conf->udp;
 
@@ -154,6 +328,15 @@ void cast_server(void *pParm)
 
     casAttachThreadToClient ( client );
 
+#ifdef __linux__
+    pBatch = callocMustSucceed(1, sizeof(*pBatch), "cast_server");
+    cas_attach_dg_batch ( client );
+    if (setsockopt(recv_sock, SOL_SOCKET, SO_RXQ_OVFL,
+            (char *) &yes, sizeof(yes)) < 0) {
+        errlogPrintf ("CAS: UDP receive queue drops will not be counted\n");
+    }
+#endif
+
     /*
      * add placeholder for the first version message should it be needed
      */
@@ -165,6 +348,9 @@ void cast_server(void *pParm)
     epicsEventSignal(casudp_startStopEvent);
 
     while (TRUE) {
+#ifdef __linux__
+        status = recv_batch(recv_sock, pBatch);
+#else
         status = recvfrom (
             recv_sock,
             client->recv.buf,
@@ -172,6 +358,7 @@ void cast_server(void *pParm)
             0,
             (struct sockaddr *)&new_recv_addr,
             &recv_addr_size);
+#endif
         if (status < 0) {
             if (SOCKERRNO != SOCK_EINTR) {
                 char sockErrBuf[64];
@@ -181,92 +368,34 @@ void cast_server(void *pParm)
                         sockErrBuf);
                 epicsThreadSleep(1.0);
             }
-
-        } else {
-            size_t idx;
-            for(idx=0; casIgnoreAddrs[idx]; idx++)
-            {
-                if(new_recv_addr.sin_addr.s_addr==casIgnoreAddrs[idx]) {
-                    status = -1; /* ignore */
-                    break;
-                }
-            }
         }
-
-        if (status >= 0 && casudp_ctl == ctlRun) {
-            client->recv.cnt = (unsigned) status;
-            client->recv.stk = 0ul;
-            epicsTimeGetCurrent(&client->time_at_last_recv);
-
-            client->minor_version_number = CA_UKN_MINOR_VERSION;
-            client->seqNoOfReq = 0;
+        else {
+#ifdef __linux__
+            unsigned i, j, n = (unsigned) status;
 
             /*
-             * If we are talking to a new client flush to the old one
-             * in case we are holding UDP messages waiting to
-             * see if the next message is for this same client.
+             * Take the datagrams from each sender together so that
+             * the replies to it are coalesced
              */
-            if (client->send.stk>sizeof(caHdr)) {
-                status = memcmp(&client->addr,
-                    &new_recv_addr, recv_addr_size);
-                if(status){
-                    /*
-                     * if the address is different
-                     */
-                    cas_send_dg_msg(client);
-                    client->addr = new_recv_addr;
-                }
-            }
-            else {
-                client->addr = new_recv_addr;
-            }
-
-            if (CASDEBUG>1) {
-                char    buf[40];
-
-                ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
-                errlogPrintf ("CAS: cast server msg of %d bytes from addr %s\n",
-                    client->recv.cnt, buf);
-            }
-
-            if (CASDEBUG>2)
-                count = ellCount (&client->chanList);
-
-            status = camessage ( client );
-            if(status == RSRV_OK){
-                if(client->recv.cnt !=
-                    client->recv.stk){
-                    char buf[40];
-
-                    ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
-
-                    epicsPrintf ("CAS: partial (damaged?) UDP msg of %d bytes from %s ?\n",
-                        client->recv.cnt - client->recv.stk, buf);
-
-                    epicsTimeToStrftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S",
-                        &client->time_at_last_recv);
-                    epicsPrintf ("CAS: message received at %s\n", buf);
-                }
-            }
-            else if (CASDEBUG>0){
-                char buf[40];
-
-                ipAddrToDottedIP (&client->addr, buf, sizeof(buf));
-
-                epicsPrintf ("CAS: invalid (damaged?) UDP request from %s ?\n", buf);
-
-                epicsTimeToStrftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S",
-                    &client->time_at_last_recv);
-                epicsPrintf ("CAS: message received at %s\n", buf);
-            }
-
-            if (CASDEBUG>2) {
-                if ( ellCount (&client->chanList) ) {
-                    errlogPrintf ("CAS: Fnd %d name matches (%d tot)\n",
-                        ellCount(&client->chanList)-count,
-                        ellCount(&client->chanList));
+            for (i = 0; i < n; i++) {
+                if (pBatch->done[i])
+                    continue;
+                for (j = i; j < n; j++) {
+                    if (pBatch->done[j] ||
+                        pBatch->addr[j].sin_addr.s_addr !=
+                            pBatch->addr[i].sin_addr.s_addr ||
+                        pBatch->addr[j].sin_port != pBatch->addr[i].sin_port)
+                        continue;
+                    pBatch->done[j] = 1;
+                    memcpy(client->recv.buf, pBatch->buf[j],
+                        pBatch->msgs[j].msg_len);
+                    cast_request(client, &pBatch->addr[j],
+                        pBatch->msgs[j].msg_len);
                 }
             }
+#else
+            cast_request(client, &new_recv_addr, (unsigned) status);
+#endif
         }
 
         /*
@@ -283,6 +412,7 @@ void cast_server(void *pParm)
             cas_send_dg_msg (client);
             clean_addrq (client);
         }
+        cas_send_dg_batch (client);
     }
 
     /* ATM never reached, just a placeholder */
@@ -30,6 +30,12 @@ extern "C" {
 
 epicsShareFunc void rsrv_register_server(void);
 
+/* Reactor mode, set before iocInit.  rsrvReactorThreads of 0 keeps
+ * two threads per client, rsrvWorkerThreads of 0 uses two per CPU.
+ */
+epicsShareExtern int rsrvReactorThreads;
+epicsShareExtern int rsrvWorkerThreads;
+
 epicsShareFunc void casr (unsigned level);
 epicsShareFunc int casClientInitiatingCurrentThread (
                         char * pBuf, size_t bufSize );
@@ -34,4 +34,6 @@ void rsrvRegistrar(void)
 }
 
 epicsExportAddress(int, CASDEBUG);
+epicsExportAddress(int, rsrvReactorThreads);
+epicsExportAddress(int, rsrvWorkerThreads);
 epicsExportRegistrar(rsrvRegistrar);
@@ -72,6 +72,62 @@ struct message_buffer {
   enum messageBufferType    type;
 };
 
+/*
+ * Data sent by reference rather than copied into the send buffer, see
+ * cas_copy_in_ref().  The size bytes at pData follow the first bufOffset
+ * bytes of the send buffer on the wire.  hold keeps the data alive and
+ * is released once it has been sent or discarded.
+ */
+#define CAS_SEND_REFS 16u
+struct send_ref {
+  const char                *pData;
+  void                      *hold;
+  unsigned                  bufOffset;
+  unsigned                  size;
+};
+
+/* smaller payloads are copied into the send buffer */
+#define CAS_SEND_REF_MIN ( 1024 * 4u )
+
+/*
+ * Position in the outgoing byte stream, which is the send buffer
+ * interleaved with the data of the send references.
+ */
+struct send_cursor {
+  unsigned                  bufSent;  /* bytes of send.buf already sent */
+  unsigned                  iRef;     /* first reference not completely sent */
+  unsigned                  refSent;  /* bytes of sendRefs[iRef] already sent */
+};
+
+/*
+ * Part of the outgoing stream set aside in reactor mode when the socket
+ * would block, so that the send buffer can be reused without waiting.
+ * Sent before anything in the send buffer, see cas_send_bs().
+ */
+struct send_backlog {
+  ELLNODE                   node;
+  unsigned                  size;
+  unsigned                  sent;
+  char                      data[1];
+};
+
+/*
+ * Work run for a client by the reactor's worker pool, see casreactor.c.
+ * Each client has one for receiving requests and one for delivering
+ * events, and neither runs on more than one worker at a time.
+ */
+enum casWorkState {
+    cwsIdle, cwsQueued, cwsRunning, cwsRunAgain, cwsCanceling, cwsCanceled
+};
+struct cas_work {
+  ELLNODE                   node;
+  struct client             *client;
+  enum casWorkState         state;      /* guarded by the pool lock */
+  unsigned                  prio;       /* queue used while cwsQueued */
+  unsigned                  queuedAt;   /* pool pick count when queued */
+  int                       isRecv;
+};
+
 extern epicsThreadPrivateId rsrvCurrentClient;
 
 typedef struct client {
@@ -80,6 +136,20 @@ typedef struct client {
   struct message_buffer send;
   /*! accessed by receive thread w/o locks cf. camsgtask() */
   struct message_buffer recv;
+  /*! guarded by SEND_LOCK(), sent in order with send */
+  struct send_ref       sendRefs[CAS_SEND_REFS];
+  unsigned              nSendRefs;
+  /*! guarded by SEND_LOCK(), progress of a send left to the reactor */
+  struct send_cursor    sendCursor;
+  ELLLIST               sendBacklog;
+  char                  sendBlocked;
+  /*! reactor mode, requests are not run while the send is blocked */
+  char                  recvPaused;
+  /*! reactor mode only, see casreactor.c */
+  struct cas_work       recvWork, eventWork;
+  struct cas_reactor    *reactor;
+  unsigned              reactorSlot;
+  unsigned              reactorEvents;
   epicsMutexId          lock;
   epicsMutexId          putNotifyLock;
   epicsMutexId          chanListLock;
@@ -95,6 +165,7 @@ typedef struct client {
   char                  *pHostName;
   epicsEventId          blockSem; /* used whenever the client blocks */
   SOCKET                sock, udpRecv;
+  struct cas_dg_batch   *dgBatch;     /* UDP only, see cas_attach_dg_batch() */
   int                   proto;
   epicsThreadId         tid;
   unsigned              minor_version_number;
@@ -206,6 +277,13 @@ GLBLTYPE void               *rsrvLargeBufFreeListTCP;
 GLBLTYPE unsigned           rsrvSizeofLargeBufTCP;
 GLBLTYPE void               *rsrvPutNotifyFreeList;
 GLBLTYPE unsigned           rsrvChannelCount; /* locked by clientQlock */
+GLBLTYPE size_t             rsrvSearchFound; /* UDP searches, use atomic */
+GLBLTYPE size_t             rsrvSearchRejected; /* by the name filter */
+GLBLTYPE size_t             rsrvSearchNotFound; /* passed the filter */
+GLBLTYPE size_t             rsrvUdpDropped; /* by the receive queue, or truncated */
+GLBLTYPE size_t             rsrvUdpBatched; /* received with others in one call */
+GLBLTYPE size_t             rsrvUdpReplies; /* datagrams sent */
+GLBLTYPE size_t             rsrvSendRefBytes; /* sent by reference */
 
 GLBLTYPE epicsEventId       casudp_startStopEvent;
 GLBLTYPE epicsEventId       beacon_startStopEvent;
@@ -230,7 +308,10 @@ extern "C" {
 
 void camsgtask (void *client);
 void cas_send_bs_msg ( struct client *pclient, int lock_needed );
+void cas_send_bs_msg_all ( struct client *pclient );
 void cas_send_dg_msg ( struct client *pclient );
+void cas_attach_dg_batch ( struct client *pclient );
+void cas_send_dg_batch ( struct client *pclient );
 void rsrv_online_notify_task (void *);
 void cast_server (void *);
 struct client *create_client ( SOCKET sock, int proto );
@@ -239,6 +320,18 @@ struct client *create_tcp_client ( SOCKET sock, const osiSockAddr* peerAddr );
 void destroy_tcp_client ( struct client * );
 void casAttachThreadToClient ( struct client * );
 int camessage ( struct client *client );
+int camsg_received ( struct client *client, unsigned nchars );
+void camsg_recv_failed ( int anerrno );
+
+/*
+ * reactor mode
+ */
+GLBLTYPE int                rsrvReactorActive;
+int casReactorInit ( void );
+int casReactorAddClient ( struct client *client );
+int casReactorStartEvents ( struct client *client );
+void casReactorWantSend ( struct client *client );
+void casReactorShow ( unsigned level );
 void rsrv_extra_labor ( void * pArg );
 int rsrvCheckPut ( const struct channel_in_use *pciu );
 int rsrv_version_reply ( struct client *client );
@@ -263,6 +356,12 @@ int cas_copy_in_header (
 void cas_set_header_cid ( struct client *pClient, ca_uint32_t );
 void cas_set_header_count (struct client *pClient, ca_uint32_t count);
 void cas_commit_msg ( struct client *pClient, ca_uint32_t size );
+int cas_copy_in_ref (
+    struct client *pClient, ca_uint16_t response, ca_uint16_t dataType,
+    ca_uint32_t nElem, ca_uint32_t cid, ca_uint32_t responseSpecific,
+    const void *pPrefix, ca_uint32_t prefixSize,
+    const void *pData, ca_uint32_t dataSize, void *hold );
+void cas_discard_send ( struct client *pClient );
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,87 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* devProcStats.c */
+
+/*
+ * Long string input of the records with the longest total process time,
+ * INP "@N" gives the number of records, default 5.  See dbtop.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "alarm.h"
+#include "dbCommon.h"
+#include "dbProcStats.h"
+#include "devSup.h"
+#include "recGbl.h"
+
+#include "lsiRecord.h"
+#include "epicsExport.h"
+
+static long add_lsi(dbCommon *pcommon) {
+    lsiRecord *prec = (lsiRecord *) pcommon;
+    const char *parm;
+    char *end;
+    long count = 5;
+
+    if (prec->inp.type != INST_IO)
+        return S_dev_badInpType;
+
+    parm = prec->inp.value.instio.string;
+    while (*parm == ' ')
+        parm++;
+    if (*parm) {
+        count = strtol(parm, &end, 0);
+        if (end == parm || count <= 0)
+            return S_dev_badInpType;
+    }
+    prec->dpvt = (void *) count;
+
+    return 0;
+}
+
+static long del_lsi(dbCommon *pcommon) {
+    pcommon->dpvt = NULL;
+    return 0;
+}
+
+static struct dsxt dsxtLsiProcStats = {
+    add_lsi, del_lsi
+};
+
+static long init_lsi(int pass)
+{
+    if (pass == 0)
+        devExtend(&dsxtLsiProcStats);
+
+    return 0;
+}
+
+static long read_lsi(lsiRecord *prec)
+{
+    size_t len = dbProcStatsSummary(prec->val, prec->sizv,
+        (int) (long) prec->dpvt);
+
+    if (len) {
+        prec->len = len + 1;
+        prec->udf = FALSE;
+    }
+    else {
+        prec->val[0] = 0;
+        prec->len = 1;
+        prec->udf = TRUE;
+        recGblSetSevr(prec, UDF_ALARM, prec->udfs);
+    }
+
+    return 0;
+}
+
+lsidset devLsiProcStats = {
+    {5, NULL, init_lsi, NULL, NULL }, read_lsi
+};
+epicsExportAddress(dset, devLsiProcStats);
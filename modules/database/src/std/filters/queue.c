@@ -0,0 +1,94 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Sets the depth of the monitor event queue used by subscriptions
+ *  to a channel.
+ */
+
+#include <stdio.h>
+
+#include "freeList.h"
+#include "db_field_log.h"
+#include "dbEvent.h"
+#include "chfPlugin.h"
+#include "epicsExport.h"
+
+typedef struct myStruct {
+    epicsInt32 n;
+} myStruct;
+
+static void *myStructFreeList;
+
+static const
+chfPluginArgDef opts[] = {
+    chfInt32(myStruct, n, "n", 1, 0),
+    chfPluginArgEnd
+};
+
+static void * allocPvt(void)
+{
+    myStruct *my = (myStruct*) freeListCalloc(myStructFreeList);
+    return (void *) my;
+}
+
+static void freePvt(void *pvt)
+{
+    freeListFree(myStructFreeList, pvt);
+}
+
+static int parse_ok(void *pvt)
+{
+    myStruct *my = (myStruct*) pvt;
+
+    if (my->n < 1 || my->n > DB_EVENT_QUEUE_MAX)
+        return -1;
+
+    return 0;
+}
+
+static long channel_open(dbChannel *chan, void *pvt)
+{
+    myStruct *my = (myStruct*) pvt;
+
+    chan->queue_depth = (unsigned short) my->n;
+    return 0;
+}
+
+static void channel_report(dbChannel *chan, void *pvt, int level, const unsigned short indent)
+{
+    myStruct *my = (myStruct*) pvt;
+    printf("%*sQueue (q): n=%d\n", indent, "", my->n);
+}
+
+static chfPluginIf pif = {
+    allocPvt,
+    freePvt,
+
+    NULL, /* parse_error, */
+    parse_ok,
+
+    channel_open,
+    NULL, /* channelRegisterPre, */
+    NULL, /* channelRegisterPost, */
+    channel_report,
+    NULL /* channel_close */
+};
+
+static void queueInitialize(void)
+{
+    static int firstTime = 1;
+
+    if (!firstTime) return;
+    firstTime = 0;
+
+    if (!myStructFreeList)
+        freeListInitPvt(&myStructFreeList, sizeof(myStruct), 64);
+
+    chfPluginRegister("q", &pif, opts);
+}
+
+epicsExportRegistrar(queueInitialize);
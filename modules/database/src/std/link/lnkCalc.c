@@ -10,6 +10,8 @@
 /*  Usage
  *      {calc:{expr:"A*B", args:[{...}, ...], units:"mm"}}
  *  First link in 'args' is 'A', second is 'B', and so forth.
+ *  An input link with nelm:N reads arrays of up to N elements from its
+ *  args and returns an array, using calcPerformArray().
  */
 
 #include <string.h>
@@ -47,6 +49,7 @@ typedef struct calc_link {
         ps_expr, ps_major, ps_minor,
         ps_args, ps_out,
         ps_prec,
+        ps_nelm,
         ps_units,
         ps_time,
         ps_error
@@ -67,6 +70,11 @@ typedef struct calc_link {
     double arg[CALCPERFORM_NARGS];
     epicsTimeStamp time;
     double val;
+    long nelm;          /* maximum array size, 1 for a scalar link */
+    double *col[CALCPERFORM_NARGS];
+    unsigned long count[CALCPERFORM_NARGS];
+    double *vals;
+    double *alvals;
 } calc_link;
 
 static lset lnkCalc_lset;
@@ -94,6 +102,7 @@ static jlink* lnkCalc_alloc(short dbfType)
     clink->pstate = ps_init;
     clink->prec = 15;   /* standard value for a double */
     clink->tinp = -1;
+    clink->nelm = 1;
 
     return &clink->jlink;
 }
@@ -115,6 +124,7 @@ static void lnkCalc_free(jlink *pjlink)
     free(clink->post_major);
     free(clink->post_minor);
     free(clink->units);
+    free(clink->vals);
     free(clink);
 }
 
@@ -127,6 +137,15 @@ static jlif_result lnkCalc_integer(jlink *pjlink, long long num)
         return jlif_continue;
     }
 
+    if (clink->pstate == ps_nelm) {
+        if (num < 1 || num > 0x7fffffff) {
+            errlogPrintf("lnkCalc: Bad 'nelm' parameter %lld\n", num);
+            return jlif_stop;
+        }
+        clink->nelm = num;
+        return jlif_continue;
+    }
+
     if (clink->pstate != ps_args) {
         errlogPrintf("lnkCalc: Unexpected integer %lld\n", num);
         return jlif_stop;
@@ -269,6 +288,9 @@ static jlif_result lnkCalc_map_key(jlink *pjlink, const char *key, size_t len)
             clink->pstate = ps_args;
         else if (!strncmp(key, "prec", len))
             clink->pstate = ps_prec;
+        else if (!strncmp(key, "nelm", len) &&
+            clink->dbfType == DBF_INLINK)
+            clink->pstate = ps_nelm;
         else if (!strncmp(key, "time", len))
             clink->pstate = ps_time;
         else {
@@ -313,6 +335,22 @@ static jlif_result lnkCalc_end_map(jlink *pjlink)
         return jlif_stop;
     }
 
+    if (clink->nelm > 1) {
+        /* Array buffers for the args, result and alarm results */
+        double *pbuf = calloc((clink->nArgs + 2) * clink->nelm,
+            sizeof(double));
+        int i;
+
+        if (!pbuf) {
+            errlogPrintf("lnkCalc: Out of memory\n");
+            return jlif_stop;
+        }
+        clink->vals = pbuf;
+        clink->alvals = pbuf + clink->nelm;
+        for (i = 0; i < clink->nArgs; i++)
+            clink->col[i] = pbuf + (i + 2) * clink->nelm;
+    }
+
     return jlif_continue;
 }
 
@@ -383,6 +421,10 @@ static void lnkCalc_report(const jlink *pjlink, int level, int indent)
         clink->expr, clink->prec, clink->val,
         clink->units ? clink->units : "");
 
+    if (clink->nelm > 1)
+        printf("%*s  Array of up to %ld elements\n", indent, "",
+            clink->nelm);
+
     if (level > 0) {
         if (clink->sevr)
             printf("%*s  Alarm: %s, %s\n", indent, "",
@@ -457,6 +499,17 @@ static void lnkCalc_open(struct link *plink)
         child->precord = plink->precord;
         dbJLinkInit(child);
         dbLoadLink(child, DBR_DOUBLE, &clink->arg[i]);
+
+        if (clink->nelm > 1) {
+            long nReq = clink->nelm;
+
+            if (dbLoadLinkArray(child, DBR_DOUBLE, clink->col[i], &nReq) ||
+                nReq < 1) {
+                clink->col[i][0] = clink->arg[i];
+                nReq = 1;
+            }
+            clink->count[i] = nReq;
+        }
     }
 
     if (clink->out.type == JSON_LINK) {
@@ -487,6 +540,7 @@ static void lnkCalc_remove(struct dbLocker *locker, struct link *plink)
     free(clink->post_major);
     free(clink->post_minor);
     free(clink->units);
+    free(clink->vals);
     free(clink);
     plink->value.json.jlink = NULL;
 }
@@ -524,7 +578,10 @@ static int lnkCalc_getDBFtype(const struct link *plink)
 
 static long lnkCalc_getElements(const struct link *plink, long *nelements)
 {
-    *nelements = 1;
+    calc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct calc_link, jlink);
+
+    *nelements = clink->nelm;
     return 0;
 }
 
@@ -532,20 +589,117 @@ static long lnkCalc_getElements(const struct link *plink, long *nelements)
 struct lcvt {
     double *pval;
     epicsTimeStamp *ptime;
+    long nReq;          /* elements to read, 0 for 1 */
 };
 
 static long readLocked(struct link *pinp, void *vvt)
 {
     struct lcvt *pvt = (struct lcvt *) vvt;
-    long nReq = 1;
+    long nReq = pvt->nReq ? pvt->nReq : 1;
     long status = dbGetLink(pinp, DBR_DOUBLE, pvt->pval, NULL, &nReq);
 
     if (!status && pvt->ptime)
         dbGetTimeStamp(pinp, pvt->ptime);
+    pvt->nReq = nReq;
 
     return status;
 }
 
+/* Evaluate an alarm expression for each element, true if any are set */
+static int arrayAlarm(calc_link *clink, const double **pargs, long n,
+    const char *post)
+{
+    long i;
+
+    memcpy(clink->alvals, clink->vals, n * sizeof(double));
+    if (calcPerformArray(pargs, clink->count, clink->alvals, n, post))
+        return 0;
+    for (i = 0; i < n; i++) {
+        if (clink->alvals[i])
+            return 1;
+    }
+    return 0;
+}
+
+static long lnkCalc_getArray(struct link *plink, short dbrType,
+    void *pbuffer, long *pnRequest)
+{
+    calc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct calc_link, jlink);
+    dbCommon *prec = plink->precord;
+    const double *pargs[CALCPERFORM_NARGS] = {NULL};
+    long size = dbValueSize(dbrType);
+    long n = clink->nelm;
+    int arrays = 0;
+    int i;
+    long status;
+    FASTCONVERT conv = dbFastPutConvertRoutine[DBR_DOUBLE][dbrType];
+
+    /* Any link errors will trigger a LINK/INVALID alarm in the child link */
+    for (i = 0; i < clink->nArgs; i++) {
+        struct link *child = &clink->inp[i];
+
+        if (!dbLinkIsConstant(child)) {
+            struct lcvt vt = {clink->col[i], NULL, clink->nelm};
+
+            if (i == clink->tinp) {
+                vt.ptime = &clink->time;
+                status = dbLinkDoLocked(child, readLocked, &vt);
+                if (status == S_db_noLSET)
+                    status = readLocked(child, &vt);
+
+                if (dbLinkIsConstant(&prec->tsel) &&
+                    prec->tse == epicsTimeEventDeviceTime) {
+                    prec->time = clink->time;
+                }
+            }
+            else
+                status = readLocked(child, &vt);
+            clink->count[i] = status ? 0 : vt.nReq;
+        }
+        pargs[i] = clink->col[i];
+
+        /* Inputs with one element apply to every element */
+        if (clink->count[i] != 1) {
+            arrays = 1;
+            if (n > (long) clink->count[i])
+                n = clink->count[i];
+        }
+    }
+    if (!arrays)
+        n = 1;
+    if (n > (pnRequest ? *pnRequest : 1))
+        n = pnRequest ? *pnRequest : 1;
+    clink->stat = 0;
+    clink->sevr = 0;
+
+    status = calcPerformArray(pargs, clink->count, clink->vals, n,
+        clink->post_expr);
+    for (i = 0; !status && i < n; i++)
+        status = conv(&clink->vals[i], (char *) pbuffer + i * size, NULL);
+    if (status)
+        return status;
+    if (n > 0)
+        clink->val = clink->vals[0];
+    if (pnRequest)
+        *pnRequest = n;
+
+    if (clink->post_major &&
+        arrayAlarm(clink, pargs, n, clink->post_major)) {
+        clink->stat = LINK_ALARM;
+        clink->sevr = MAJOR_ALARM;
+        recGblSetSevr(prec, clink->stat, clink->sevr);
+    }
+    else if (clink->post_minor &&
+        arrayAlarm(clink, pargs, n, clink->post_minor)) {
+        clink->stat = LINK_ALARM;
+        clink->sevr = MINOR_ALARM;
+        recGblSetSevr(prec, clink->stat, clink->sevr);
+    }
+
+    return 0;
+}
+
 static long lnkCalc_getValue(struct link *plink, short dbrType, void *pbuffer,
     long *pnRequest)
 {
@@ -559,6 +713,9 @@ static long lnkCalc_getValue(struct link *plink, short dbrType, void *pbuffer,
     if(INVALID_DB_REQ(dbrType))
         return S_db_badDbrtype;
 
+    if (clink->nelm > 1)
+        return lnkCalc_getArray(plink, dbrType, pbuffer, pnRequest);
+
     conv = dbFastPutConvertRoutine[DBR_DOUBLE][dbrType];
 
     /* Any link errors will trigger a LINK/INVALID alarm in the child link */
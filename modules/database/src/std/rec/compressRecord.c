@@ -21,6 +21,7 @@
 #include <math.h>
 
 #include "dbDefs.h"
+#include "cantProceed.h"
 #include "epicsPrint.h"
 #include "alarm.h"
 #include "dbStaticLib.h"
@@ -81,6 +82,196 @@ rset compressRSET = {
 epicsExportAddress(rset,compressRSET);
 
 
+/* Sliding window of the last N samples for the Running algorithms.
+ * The median is kept between two heaps of ring slots, lo holding the
+ * smaller half and hi the larger, so the upper median is the top of hi.
+ */
+typedef struct compressWindow {
+    epicsInt32 size;    /* N */
+    epicsInt32 count;   /* samples in the window */
+    epicsInt32 next;    /* ring slot for the next sample */
+    epicsInt32 nlo, nhi;
+    double sumsq;
+    double *val;        /* ring of samples */
+    epicsInt32 *loc;    /* heap index of each slot, -1-index when in lo */
+    epicsInt32 *lo;     /* max-heap */
+    epicsInt32 *hi;     /* min-heap */
+} compressWindow;
+
+static int isRunning(compressRecord *prec)
+{
+    return prec->alg == compressALG_Running_Median ||
+        prec->alg == compressALG_Running_RMS;
+}
+
+static compressWindow * windowCreate(epicsInt32 size)
+{
+    compressWindow *w;
+
+    if (size < 1)
+        size = 1;
+    w = dbCalloc(1, sizeof(compressWindow));
+    w->size = size;
+    w->val = dbCalloc(size, sizeof(double));
+    w->loc = dbCalloc(3 * size, sizeof(epicsInt32));
+    w->lo = w->loc + size;
+    w->hi = w->lo + size;
+    return w;
+}
+
+static void windowDestroy(compressWindow *w)
+{
+    if (!w)
+        return;
+    free(w->val);
+    free(w->loc);
+    free(w);
+}
+
+static int heapBefore(const compressWindow *w, int isLo,
+    epicsInt32 a, epicsInt32 b)
+{
+    return isLo ? w->val[a] > w->val[b] : w->val[a] < w->val[b];
+}
+
+static void heapSet(compressWindow *w, int isLo, epicsInt32 i,
+    epicsInt32 slot)
+{
+    if (isLo) {
+        w->lo[i] = slot;
+        w->loc[slot] = -1 - i;
+    }
+    else {
+        w->hi[i] = slot;
+        w->loc[slot] = i;
+    }
+}
+
+static void heapSiftUp(compressWindow *w, int isLo, epicsInt32 i)
+{
+    epicsInt32 *heap = isLo ? w->lo : w->hi;
+    epicsInt32 slot = heap[i];
+
+    while (i > 0) {
+        epicsInt32 parent = (i - 1) / 2;
+
+        if (!heapBefore(w, isLo, slot, heap[parent]))
+            break;
+        heapSet(w, isLo, i, heap[parent]);
+        i = parent;
+    }
+    heapSet(w, isLo, i, slot);
+}
+
+static void heapSiftDown(compressWindow *w, int isLo, epicsInt32 i)
+{
+    epicsInt32 *heap = isLo ? w->lo : w->hi;
+    epicsInt32 n = isLo ? w->nlo : w->nhi;
+    epicsInt32 slot = heap[i];
+
+    for (;;) {
+        epicsInt32 child = 2 * i + 1;
+
+        if (child >= n)
+            break;
+        if (child + 1 < n && heapBefore(w, isLo, heap[child + 1], heap[child]))
+            child++;
+        if (!heapBefore(w, isLo, heap[child], slot))
+            break;
+        heapSet(w, isLo, i, heap[child]);
+        i = child;
+    }
+    heapSet(w, isLo, i, slot);
+}
+
+static void heapPush(compressWindow *w, int isLo, epicsInt32 slot)
+{
+    epicsInt32 i = isLo ? w->nlo++ : w->nhi++;
+
+    heapSet(w, isLo, i, slot);
+    heapSiftUp(w, isLo, i);
+}
+
+static void heapRemove(compressWindow *w, int isLo, epicsInt32 i)
+{
+    epicsInt32 *heap = isLo ? w->lo : w->hi;
+    epicsInt32 n = isLo ? --w->nlo : --w->nhi;
+    epicsInt32 last = heap[n];
+    epicsInt32 at;
+
+    if (i == n)
+        return;
+    heapSet(w, isLo, i, last);
+    heapSiftUp(w, isLo, i);
+    at = w->loc[last];
+    heapSiftDown(w, isLo, isLo ? -1 - at : at);
+}
+
+static epicsInt32 heapPop(compressWindow *w, int isLo)
+{
+    epicsInt32 top = isLo ? w->lo[0] : w->hi[0];
+
+    heapRemove(w, isLo, 0);
+    return top;
+}
+
+/* Replace the oldest sample, O(log N) with the median, O(1) without */
+static void windowAdd(compressWindow *w, double value, int median)
+{
+    epicsInt32 slot = w->next;
+
+    if (w->count == w->size) {
+        double old = w->val[slot];
+
+        if (median) {
+            epicsInt32 at = w->loc[slot];
+
+            if (at < 0)
+                heapRemove(w, 1, -1 - at);
+            else
+                heapRemove(w, 0, at);
+        }
+        w->sumsq -= old * old;
+        w->count--;
+    }
+    w->val[slot] = value;
+    w->sumsq += value * value;
+    w->count++;
+    if (++w->next == w->size) {
+        epicsInt32 i;
+
+        /* Drop the rounding errors of the running sum once per lap */
+        w->next = 0;
+        w->sumsq = 0.0;
+        for (i = 0; i < w->count; i++)
+            w->sumsq += w->val[i] * w->val[i];
+    }
+
+    if (median) {
+        epicsInt32 nhigh = w->count - w->count / 2;
+
+        if ((w->nlo && value <= w->val[w->lo[0]]) ||
+            (w->nhi && value < w->val[w->hi[0]]))
+            heapPush(w, 1, slot);
+        else
+            heapPush(w, 0, slot);
+        while (w->nhi > nhigh)
+            heapPush(w, 1, heapPop(w, 0));
+        while (w->nhi < nhigh)
+            heapPush(w, 0, heapPop(w, 1));
+    }
+}
+
+static double windowMedian(const compressWindow *w)
+{
+    return w->val[w->hi[0]];
+}
+
+static double windowRMS(const compressWindow *w)
+{
+    return w->sumsq > 0.0 ? sqrt(w->sumsq / w->count) : 0.0;
+}
+
 static void reset(compressRecord *prec)
 {
     prec->nuse = 0;
@@ -92,6 +283,9 @@ static void reset(compressRecord *prec)
     if (prec->alg == compressALG_Average && prec->sptr == NULL) {
         prec->sptr = calloc(prec->nsam, sizeof(double));
     }
+    /* the sliding window restarts empty, sized for the current N */
+    windowDestroy(prec->winp);
+    prec->winp = isRunning(prec) ? windowCreate(prec->n) : NULL;
 
     if (prec->bptr && prec->nsam)
         memset(prec->bptr, 0, prec->nsam * sizeof(double));
@@ -137,21 +331,99 @@ static void put_value(compressRecord *prec, double *psource, int n)
 }
 
 
-/* qsort comparison function (for median calculation) */
-static int compare(const void *arg1, const void *arg2)
+/* Kernels for the N to 1 algorithms.  Four independent accumulators
+ * break the dependency between iterations so the compiler can keep
+ * them in vector registers.
+ */
+static double array_low(const double *psource, epicsInt32 n)
+{
+    double m0 = psource[0], m1 = m0, m2 = m0, m3 = m0;
+    epicsInt32 i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        m0 = psource[i]     < m0 ? psource[i]     : m0;
+        m1 = psource[i + 1] < m1 ? psource[i + 1] : m1;
+        m2 = psource[i + 2] < m2 ? psource[i + 2] : m2;
+        m3 = psource[i + 3] < m3 ? psource[i + 3] : m3;
+    }
+    for (; i < n; i++)
+        m0 = psource[i] < m0 ? psource[i] : m0;
+    m0 = m1 < m0 ? m1 : m0;
+    m2 = m3 < m2 ? m3 : m2;
+    return m2 < m0 ? m2 : m0;
+}
+
+static double array_high(const double *psource, epicsInt32 n)
 {
-    double a = *(double *)arg1;
-    double b = *(double *)arg2;
+    double m0 = psource[0], m1 = m0, m2 = m0, m3 = m0;
+    epicsInt32 i;
 
-    if      ( a <  b ) return -1;
-    else if ( a == b ) return  0;
-    else               return  1;
+    for (i = 0; i + 4 <= n; i += 4) {
+        m0 = psource[i]     > m0 ? psource[i]     : m0;
+        m1 = psource[i + 1] > m1 ? psource[i + 1] : m1;
+        m2 = psource[i + 2] > m2 ? psource[i + 2] : m2;
+        m3 = psource[i + 3] > m3 ? psource[i + 3] : m3;
+    }
+    for (; i < n; i++)
+        m0 = psource[i] > m0 ? psource[i] : m0;
+    m0 = m1 > m0 ? m1 : m0;
+    m2 = m3 > m2 ? m3 : m2;
+    return m2 > m0 ? m2 : m0;
+}
+
+static double array_sum(const double *psource, epicsInt32 n)
+{
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    epicsInt32 i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        s0 += psource[i];
+        s1 += psource[i + 1];
+        s2 += psource[i + 2];
+        s3 += psource[i + 3];
+    }
+    for (; i < n; i++)
+        s0 += psource[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+/* Partially reorder psource until element k is the one a full sort
+ * would put there, in O(n) time on average.
+ */
+static double array_select(double *psource, epicsInt32 n, epicsInt32 k)
+{
+    epicsInt32 lo = 0, hi = n - 1;
+
+    while (lo < hi) {
+        double pivot = psource[lo + (hi - lo) / 2];
+        epicsInt32 i = lo, j = hi;
+
+        while (i <= j) {
+            while (psource[i] < pivot)
+                i++;
+            while (pivot < psource[j])
+                j--;
+            if (i <= j) {
+                double tmp = psource[i];
+
+                psource[i++] = psource[j];
+                psource[j--] = tmp;
+            }
+        }
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            break;
+    }
+    return psource[k];
 }
 
 static int compress_array(compressRecord *prec,
     double *psource, int no_elements)
 {
-    epicsInt32 i,j;
+    epicsInt32 i;
     epicsInt32 n, nnew;
     epicsInt32 nsam = prec->nsam;
     double value;
@@ -179,43 +451,31 @@ static int compress_array(compressRecord *prec,
     switch (prec->alg){
     case compressALG_N_to_1_Low_Value:
         /* compress N to 1 keeping the lowest value */
-        for (i = 0; i < nnew; i++) {
-            value = *psource++;
-            for (j = 1; j < n; j++, psource++) {
-                if (value > *psource)
-                    value = *psource;
-            }
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = array_low(psource, n);
             put_value(prec, &value, 1);
         }
         break;
     case compressALG_N_to_1_High_Value:
         /* compress N to 1 keeping the highest value */
-        for (i = 0; i < nnew; i++){
-            value = *psource++;
-            for (j = 1; j < n; j++, psource++) {
-                if (value < *psource)
-                    value = *psource;
-            }
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = array_high(psource, n);
             put_value(prec, &value, 1);
         }
         break;
     case compressALG_N_to_1_Average:
         /* compress N to 1 keeping the average value */
-        for (i = 0; i < nnew; i++) {
-            value = 0;
-            for (j = 0; j < n; j++, psource++)
-                value += *psource;
-            value /= n;
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = array_sum(psource, n) / n;
             put_value(prec, &value, 1);
         }
         break;
 
     case compressALG_N_to_1_Median:
         /* compress N to 1 keeping the median value */
-        /* note: sorts source array (OK; it's a work pointer) */
-        for (i = 0; i < nnew; i++, psource += nnew) {
-            qsort(psource, n, sizeof(double), compare);
-            value = psource[n / 2];
+        /* note: reorders source array (OK; it's a work pointer) */
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = array_select(psource, n, n / 2);
             put_value(prec, &value, 1);
         }
         break;
@@ -242,37 +502,61 @@ static int array_average(compressRecord *prec,
         nnow=no_elements;
     psum = (double *)prec->sptr;
 
-    /* add in the new waveform */
-    if (inx == 0) {
+    if (prec->n <= 0)
+        prec->n = 1;
+    n = prec->n;
+    inx++;
+
+    /* add in the new waveform, scaling the sum on the last one */
+    if (n == 1) {
+        memcpy(psum, psource, nnow * sizeof(double));
+    } else if (inx == 1) {
+        memcpy(psum, psource, nnow * sizeof(double));
+        memset(psum + nnow, 0, (nuse - nnow) * sizeof(double));
+    } else if (inx < n) {
         for (i = 0; i < nnow; i++)
-            *psum++ = *psource++;
-        for (i = nnow; i < nuse; i++)
-            *psum++ = 0;
+            psum[i] += psource[i];
     } else {
+        multiplier = 1.0 / n;
         for (i = 0; i < nnow; i++)
-            *psum++ += *psource++;
+            psum[i] = (psum[i] + psource[i]) * multiplier;
     }
 
     /* do we need to calculate the result */
-    inx++;
-    if (prec->n <= 0)
-        prec->n = 1;
-    n = prec->n;
     if (inx < n) {
         prec->inx = inx;
         return 1;
     }
-    if (n > 1) {
-        psum = (double *)prec->sptr;
-        multiplier = 1.0 / n;
-        for (i = 0; i < nuse; i++, psum++)
-            *psum = *psum * multiplier;
-    }
     put_value(prec, prec->sptr, nuse);
     prec->inx = 0;
     return 0;
 }
 
+/* Each input sample moves the window along and adds one result */
+static int running_window(compressRecord *prec,
+    double *psource, epicsInt32 no_elements)
+{
+    compressWindow *w = prec->winp;
+    int median = (prec->alg == compressALG_Running_Median);
+    epicsInt32 nsam = prec->nsam;
+    epicsInt32 i;
+
+    if (!w)
+        w = prec->winp = windowCreate(prec->n);
+
+    /* results overwrite the samples in the work buffer */
+    for (i = 0; i < no_elements; i++) {
+        windowAdd(w, psource[i], median);
+        psource[i] = median ? windowMedian(w) : windowRMS(w);
+    }
+    if (no_elements > nsam) {
+        psource += no_elements - nsam;
+        no_elements = nsam;
+    }
+    put_value(prec, psource, no_elements);
+    return 0;
+}
+
 static int compress_scalar(struct compressRecord *prec,double *psource)
 {
     double value = *psource;
@@ -360,6 +644,10 @@ static long process(struct dbCommon *pcommon)
             put_value(prec, prec->wptr, nelements);
             status = 0;
         }
+        else if (alg == compressALG_Running_Median ||
+                 alg == compressALG_Running_RMS) {
+            status = running_window(prec, prec->wptr, nelements);
+        }
         else if (nelements > 1) {
             status = compress_array(prec, prec->wptr, nelements);
         }
@@ -0,0 +1,389 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Measure how the CA server scales with the number of client circuits.
+ * Each circuit subscribes to one record which is updated every
+ * millisecond.  First checks that circuits which stop reading their
+ * replies don't hold up the others.  Run as
+ *     benchRsrvScale        thread pair per client
+ *     benchRsrvScale N [W]  N reactor threads and W workers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cantProceed.h"
+#include "epicsStdio.h"
+#include "epicsStdlib.h"
+#include "epicsString.h"
+#include "epicsThread.h"
+#include "epicsTime.h"
+#include "envDefs.h"
+#include "osiSock.h"
+#include "caProto.h"
+#include "dbAccess.h"
+#include "dbUnitTest.h"
+#include "iocInit.h"
+#include "rsrv.h"
+#include "testMain.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+#ifdef __linux__
+
+#include <poll.h>
+
+#define MAXCLIENTS 1024
+#define WINDOW 1.0
+
+/* more than the workers of a small reactor pool */
+#define NSTALLED 8
+
+/* DBR_DOUBLE of the CA protocol, see db_access.h */
+#define CA_DBR_DOUBLE 6
+#define CA_MINOR_PROTOCOL_REVISION 13
+
+typedef struct {
+    SOCKET sock;
+    unsigned sid;
+    int connected;
+    unsigned nUpdates;
+    unsigned nBuf;
+    char buf[256];
+} benchClient;
+
+static benchClient clients[MAXCLIENTS];
+static struct pollfd pfds[MAXCLIENTS];
+static unsigned short port;
+
+static void putHeader(char *pBuf, unsigned cmmd, unsigned postsize,
+    unsigned dataType, unsigned count, unsigned cid, unsigned available)
+{
+    caHdr hdr;
+
+    hdr.m_cmmd = htons(cmmd);
+    hdr.m_postsize = htons(postsize);
+    hdr.m_dataType = htons(dataType);
+    hdr.m_count = htons(count);
+    hdr.m_cid = htonl(cid);
+    hdr.m_available = htonl(available);
+    memcpy(pBuf, &hdr, sizeof(hdr));
+}
+
+static void sendAll(benchClient *pc, const char *pBuf, size_t size)
+{
+    if (send(pc->sock, pBuf, size, 0) != (int) size)
+        testAbort("CA request send failed");
+}
+
+static void openClient(benchClient *pc)
+{
+    char msg[2 * sizeof(caHdr) + 8];
+    osiSockAddr addr;
+
+    pc->sock = epicsSocketCreate(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (pc->sock == INVALID_SOCKET)
+        testAbort("Can't create socket");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.ia.sin_family = AF_INET;
+    addr.ia.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.ia.sin_port = htons(port);
+    if (connect(pc->sock, &addr.sa, sizeof(addr.ia)))
+        testAbort("Can't connect to the CA server");
+
+    putHeader(msg, CA_PROTO_VERSION, 0, CA_PROTO_PRIORITY_MIN,
+        CA_MINOR_PROTOCOL_REVISION, 0, 0);
+    putHeader(msg + sizeof(caHdr), CA_PROTO_CREATE_CHAN, 8, 0, 0,
+        pc - clients, CA_MINOR_PROTOCOL_REVISION);
+    memset(msg + 2 * sizeof(caHdr), 0, 8);
+    strcpy(msg + 2 * sizeof(caHdr), "x");
+    sendAll(pc, msg, sizeof(msg));
+}
+
+static void subscribe(benchClient *pc)
+{
+    char msg[sizeof(caHdr) + 16];
+
+    putHeader(msg, CA_PROTO_EVENT_ADD, 16, CA_DBR_DOUBLE, 1, pc->sid,
+        pc - clients);
+    memset(msg + sizeof(caHdr), 0, 16);
+    msg[sizeof(caHdr) + 13] = DBE_VALUE;
+    sendAll(pc, msg, sizeof(msg));
+}
+
+/* Consume complete messages, returns the bytes used */
+static unsigned parse(benchClient *pc)
+{
+    unsigned used = 0;
+
+    while (pc->nBuf - used >= sizeof(caHdr)) {
+        caHdr hdr;
+        unsigned size;
+
+        memcpy(&hdr, pc->buf + used, sizeof(hdr));
+        size = sizeof(hdr) + ntohs(hdr.m_postsize);
+        if (size > sizeof(pc->buf))
+            testAbort("Unexpected %u byte reply", size);
+        if (pc->nBuf - used < size)
+            break;
+
+        switch (ntohs(hdr.m_cmmd)) {
+        case CA_PROTO_CREATE_CHAN:
+            pc->sid = ntohl(hdr.m_available);
+            pc->connected = 1;
+            subscribe(pc);
+            break;
+        case CA_PROTO_EVENT_ADD:
+            pc->nUpdates++;
+            break;
+        case CA_PROTO_CREATE_CH_FAIL:
+            testAbort("Channel creation failed");
+        }
+        used += size;
+    }
+    return used;
+}
+
+static void pollClients(unsigned n, int timeout)
+{
+    unsigned i;
+
+    if (poll(pfds, n, timeout) <= 0)
+        return;
+
+    for (i = 0; i < n; i++) {
+        benchClient *pc = &clients[i];
+        unsigned used;
+        int nchars;
+
+        if (!(pfds[i].revents & (POLLIN | POLLERR | POLLHUP)))
+            continue;
+
+        nchars = recv(pc->sock, pc->buf + pc->nBuf,
+            sizeof(pc->buf) - pc->nBuf, 0);
+        if (nchars <= 0)
+            testAbort("Circuit %u closed by the server", i);
+        pc->nBuf += nchars;
+
+        used = parse(pc);
+        memmove(pc->buf, pc->buf + used, pc->nBuf - used);
+        pc->nBuf -= used;
+    }
+}
+
+/* Send echo requests until the server stops taking them */
+static void flood(benchClient *pc)
+{
+    static char msg[sizeof(caHdr) + 1024];
+    osiSockIoctl_t yes = TRUE;
+    epicsTimeStamp last, now;
+
+    putHeader(msg, CA_PROTO_ECHO, sizeof(msg) - sizeof(caHdr), 0, 0, 0, 0);
+    if (socket_ioctl(pc->sock, FIONBIO, &yes) < 0)
+        testAbort("Can't make the socket non-blocking");
+
+    epicsTimeGetCurrent(&last);
+    do {
+        if (send(pc->sock, msg, sizeof(msg), 0) > 0)
+            epicsTimeGetCurrent(&last);
+        else
+            epicsThreadSleep(0.01);
+        epicsTimeGetCurrent(&now);
+    } while (epicsTimeDiffInSeconds(&now, &last) < 0.5);
+}
+
+static void testStalled(void)
+{
+    benchClient *pc = &clients[NSTALLED];
+    epicsTimeStamp start, now;
+    unsigned i;
+
+    for (i = 0; i < NSTALLED; i++) {
+        openClient(&clients[i]);
+        flood(&clients[i]);
+    }
+
+    openClient(pc);
+    pfds[0].fd = pc->sock;
+    pfds[0].events = POLLIN;
+    epicsTimeGetCurrent(&start);
+    do {
+        int nchars;
+
+        if (poll(pfds, 1, 100) <= 0)
+            goto next;
+        nchars = recv(pc->sock, pc->buf + pc->nBuf,
+            sizeof(pc->buf) - pc->nBuf, 0);
+        if (nchars <= 0)
+            break;
+        pc->nBuf += nchars;
+        nchars = parse(pc);
+        memmove(pc->buf, pc->buf + nchars, pc->nBuf - nchars);
+        pc->nBuf -= nchars;
+    next:
+        epicsTimeGetCurrent(&now);
+    } while (!pc->nUpdates && epicsTimeDiffInSeconds(&now, &start) < 5.0);
+
+    testOk(pc->nUpdates > 0, "Subscribed with %u stalled circuits",
+        NSTALLED);
+
+    for (i = 0; i <= NSTALLED; i++)
+        epicsSocketDestroy(clients[i].sock);
+    memset(clients, 0, sizeof(clients));
+}
+
+static int threadCount(void)
+{
+    char line[80];
+    int n = -1;
+    FILE *fp = fopen("/proc/self/status", "r");
+
+    if (!fp)
+        return -1;
+    while (fgets(line, sizeof(line), fp))
+        if (sscanf(line, "Threads: %d", &n) == 1)
+            break;
+    fclose(fp);
+    return n;
+}
+
+static unsigned short freePort(void)
+{
+    SOCKET sock = epicsSocketCreate(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    osiSockAddr addr;
+    osiSocklen_t len = sizeof(addr.ia);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.ia.sin_family = AF_INET;
+    addr.ia.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (sock == INVALID_SOCKET ||
+        bind(sock, &addr.sa, sizeof(addr.ia)) ||
+        getsockname(sock, &addr.sa, &len))
+        testAbort("Can't find a free port");
+    epicsSocketDestroy(sock);
+    return ntohs(addr.ia.sin_port);
+}
+
+static void runBench(DBADDR *paddr, unsigned nOld, unsigned n)
+{
+    epicsTimeStamp start, stop, deadline;
+    unsigned i, nConnected, posted = 0, nSilent = 0;
+    unsigned long delivered = 0;
+    double connectTime, elapsed;
+    double val = 0.0;
+
+    /* Connect and subscribe the new circuits */
+    epicsTimeGetCurrent(&start);
+    for (i = nOld; i < n; i++) {
+        openClient(&clients[i]);
+        pfds[i].fd = clients[i].sock;
+        pfds[i].events = POLLIN;
+    }
+    do {
+        pollClients(n, 100);
+        for (nConnected = 0, i = nOld; i < n; i++)
+            nConnected += clients[i].nUpdates > 0;
+    } while (nConnected < n - nOld);
+    epicsTimeGetCurrent(&stop);
+    connectTime = epicsTimeDiffInSeconds(&stop, &start);
+
+    for (i = 0; i < n; i++)
+        clients[i].nUpdates = 0;
+
+    /* Post an update every millisecond and count deliveries */
+    epicsTimeGetCurrent(&start);
+    deadline = start;
+    epicsTimeAddSeconds(&deadline, WINDOW);
+    do {
+        val += 1.0;
+        dbPutField(paddr, DBR_DOUBLE, &val, 1);
+        posted++;
+        pollClients(n, 1);
+        epicsTimeGetCurrent(&stop);
+    } while (epicsTimeLessThan(&stop, &deadline));
+    /* Let queued updates drain */
+    for (i = 0; i < 20; i++)
+        pollClients(n, 10);
+    epicsTimeGetCurrent(&stop);
+    elapsed = epicsTimeDiffInSeconds(&stop, &start);
+
+    for (i = 0; i < n; i++) {
+        delivered += clients[i].nUpdates;
+        nSilent += clients[i].nUpdates == 0;
+    }
+
+    testOk(nSilent == 0,
+        "%4u circuits: connect %6.1f ms, %8.0f updates/s, "
+        "%3.0f%% of posts delivered, %4d threads",
+        n, connectTime * 1e3, delivered / elapsed,
+        100.0 * delivered / ((double) n * posted), threadCount());
+}
+
+MAIN(benchRsrvScale)
+{
+    static const unsigned nclients[] = {16, 64, 256, 1024};
+    char portStr[16];
+    DBADDR addr;
+    unsigned i, n = 0;
+
+    testPlan(NELEMENTS(nclients) + 1);
+
+    if (argc > 1 && epicsParseInt32(argv[1], &rsrvReactorThreads, 10, NULL))
+        testAbort("Bad reactor thread count '%s'", argv[1]);
+    if (argc > 2 && epicsParseInt32(argv[2], &rsrvWorkerThreads, 10, NULL))
+        testAbort("Bad worker thread count '%s'", argv[2]);
+    if (rsrvReactorThreads)
+        testDiag("Reactor mode, %d reactor thread%s",
+            rsrvReactorThreads, rsrvReactorThreads == 1 ? "" : "s");
+    else
+        testDiag("Thread pair per client");
+
+    osiSockAttach();
+    port = freePort();
+    epicsSnprintf(portStr, sizeof(portStr), "%u", port);
+    epicsEnvSet("EPICS_CAS_SERVER_PORT", portStr);
+    epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1");
+    epicsEnvSet("EPICS_CAS_BEACON_ADDR_LIST", "127.0.0.1");
+    epicsEnvSet("EPICS_CAS_AUTO_BEACON_ADDR_LIST", "NO");
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("xRecord.db", NULL, NULL);
+
+    rsrv_register_server();
+    if (iocInit())
+        testAbort("iocInit failed");
+    if (dbNameToAddr("x", &addr))
+        testAbort("No record x");
+
+    testStalled();
+
+    for (i = 0; i < NELEMENTS(nclients); i++) {
+        runBench(&addr, n, nclients[i]);
+        n = nclients[i];
+    }
+
+    /* The CA server doesn't stop, so skip the IOC shutdown */
+    for (i = 0; i < n; i++)
+        epicsSocketDestroy(clients[i].sock);
+
+    return testDone();
+}
+
+#else /* __linux__ */
+
+MAIN(benchRsrvScale)
+{
+    testPlan(1);
+    testSkip(1, "Needs poll() and /proc/self/status");
+    return testDone();
+}
+
+#endif /* __linux__ */
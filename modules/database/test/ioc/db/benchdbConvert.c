@@ -5,7 +5,9 @@
 * EPICS BASE is distributed subject to a Software License Agreement found
 * in file LICENSE that is included with this distribution.
 \*************************************************************************/
-#include "string.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "cantProceed.h"
 #include "dbAddr.h"
@@ -14,6 +16,7 @@
 #include "epicsTime.h"
 #include "epicsMath.h"
 #include "epicsAssert.h"
+#include "epicsTypes.h"
 
 #include "epicsUnitTest.h"
 #include "testMain.h"
@@ -85,10 +88,10 @@ static void runBench(size_t nelem, size_t niter, size_t nrep)
 
         reptimes[i] = epicsTimeDiffInSeconds(&stop, &start);
 
-        testDiag("%lu bytes in %.03f ms.  %.1f MB/s",
-                 (unsigned long)(nelem*niter),
+        testDiag("%lu bytes in %.03f ms.  %.2f GB/s",
+                 (unsigned long)(nelem*niter*sizeof(short)),
                  reptimes[i]*1e3,
-                 (nelem*niter)/reptimes[i]/1e6);
+                 (nelem*niter*sizeof(short))/reptimes[i]/1e9);
     }
 
     {
@@ -99,10 +102,10 @@ static void runBench(size_t nelem, size_t niter, size_t nrep)
         }
 
         mean = sum/nrep;
-        testDiag("Final: %.04f ms +- %.05f ms.  %.1f MB/s  (for %lu elements)",
+        testDiag("Final: %.04f ms +- %.05f ms.  %.2f GB/s  (for %lu elements)",
                  mean*1e3,
                  sqrt(sum2/nrep - mean*mean)*1e3,
-                 (nelem*niter)/mean/1e6,
+                 (nelem*niter*sizeof(short))/mean/1e9,
                  (unsigned long)nelem);
     }
 
@@ -112,9 +115,105 @@ done:
     free(tdat.output);
 }
 
+/* Numeric field types, DBF_CHAR through DBF_ENUM, which have the
+ * same index in the DBR types.
+ */
+static const struct {
+    const char *name;
+    size_t size;
+} numTypes[] = {
+    {"CHAR", 1}, {"UCHAR", 1}, {"SHORT", 2}, {"USHORT", 2},
+    {"LONG", 4}, {"ULONG", 4}, {"INT64", 8}, {"UINT64", 8},
+    {"FLOAT", 4}, {"DOUBLE", 8}, {"ENUM", 2},
+};
+
+/* Time converting nelem elements starting at offset, reporting the
+ * rate in GB/s of source plus destination bytes.
+ */
+static double matrixRate(int put, short src, short dst, void *psrc,
+    void *pdst, size_t nelem, long offset, size_t niter)
+{
+    size_t bytes = nelem * (numTypes[src - DBF_CHAR].size +
+        numTypes[dst - DBF_CHAR].size);
+    epicsTimeStamp start, stop;
+    DBADDR addr;
+    size_t i;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.no_elements = nelem;
+    if (put) {
+        PUTCONVERTFUNC putter = dbPutConvertRoutine[src][dst];
+
+        addr.field_type = dst;
+        addr.field_size = numTypes[dst - DBF_CHAR].size;
+        addr.pfield = pdst;
+        epicsTimeGetCurrent(&start);
+        for (i = 0; i < niter; i++)
+            putter(&addr, psrc, nelem, nelem, offset);
+        epicsTimeGetCurrent(&stop);
+    }
+    else {
+        GETCONVERTFUNC getter = dbGetConvertRoutine[src][dst];
+
+        addr.field_type = src;
+        addr.field_size = numTypes[src - DBF_CHAR].size;
+        addr.pfield = psrc;
+        epicsTimeGetCurrent(&start);
+        for (i = 0; i < niter; i++)
+            getter(&addr, pdst, nelem, nelem, offset);
+        epicsTimeGetCurrent(&stop);
+    }
+    return bytes * niter / epicsTimeDiffInSeconds(&stop, &start) / 1e9;
+}
+
+static void runMatrix(int put, size_t nelem, long offset, size_t niter)
+{
+    double *values = callocMustSucceed(nelem, sizeof(double), "runMatrix");
+    void *psrc = callocMustSucceed(nelem, sizeof(epicsFloat64), "runMatrix");
+    void *pdst = callocMustSucceed(nelem, sizeof(epicsFloat64), "runMatrix");
+    char line[160];
+    size_t i;
+    short src, dst;
+
+    testDiag("%s conversions of %lu elements at offset %ld, GB/s",
+             put ? "dbPut" : "dbGet", (unsigned long)nelem, offset);
+    strcpy(line, "from/to ");
+    for (dst = DBF_CHAR; dst <= DBF_ENUM; dst++)
+        sprintf(line + strlen(line), " %6.6s", numTypes[dst - DBF_CHAR].name);
+    testDiag("%s", line);
+
+    for (i = 0; i < nelem; i++)
+        values[i] = i % 100;
+
+    for (src = DBF_CHAR; src <= DBF_ENUM; src++) {
+        DBADDR addr;
+
+        /* Fill the source with small values of its own type */
+        memset(&addr, 0, sizeof(addr));
+        addr.field_type = src;
+        addr.field_size = numTypes[src - DBF_CHAR].size;
+        addr.no_elements = nelem;
+        addr.pfield = psrc;
+        dbPutConvertRoutine[DBR_DOUBLE][src](&addr, values, nelem, nelem, 0);
+
+        sprintf(line, "%-8s", numTypes[src - DBF_CHAR].name);
+        for (dst = DBF_CHAR; dst <= DBF_ENUM; dst++)
+            sprintf(line + strlen(line), " %6.2f",
+                matrixRate(put, src, dst, psrc, pdst, nelem, offset, niter));
+        testDiag("%s", line);
+    }
+
+    free(values);
+    free(psrc);
+    free(pdst);
+}
+
 MAIN(benchdbConvert)
 {
     testPlan(0);
+    runMatrix(0, 10000, 0, 2000);
+    runMatrix(1, 10000, 0, 2000);
+    runMatrix(0, 10000, 3333, 2000);
     runBench(1, 10000000, 10);
     runBench(2,  5000000, 10);
     runBench(10, 1000000, 10);
@@ -0,0 +1,96 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Measure how long loading a large database takes when it is parsed
+ * as text, and when it is replayed from a precompiled image.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "epicsTime.h"
+#include "envDefs.h"
+#include "dbAccess.h"
+#include "dbStaticLib.h"
+#include "dbUnitTest.h"
+#include "testMain.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+#define NRECORDS 100000
+
+static const char dbFile[] = "benchdbLoad.db";
+
+static void writeDb(void)
+{
+    FILE *fp = fopen(dbFile, "w");
+    int i;
+
+    if (!fp)
+        testAbort("Can't create %s", dbFile);
+    for (i = 0; i < NRECORDS; i++) {
+        fprintf(fp,
+            "record(x, \"$(P)rec%d\") {\n"
+            "    field(DESC, \"Benchmark record %d\")\n"
+            "    field(VAL, %d)\n"
+            "    field(F64, %d.25)\n"
+            "    field(U16, 0x%x)\n"
+            "    field(SCAN, \"Passive\")\n"
+            "    field(PHAS, %d)\n"
+            "    field(LNK, \"$(P)rec%d.VAL NPP\")\n"
+            "    info(autosaveFields, \"VAL\")\n"
+            "}\n",
+            i, i, i, i, i & 0xffff, i % 10, (i + 1) % NRECORDS);
+    }
+    fclose(fp);
+}
+
+static double timeLoad(const char *what, unsigned long *ploads)
+{
+    epicsTimeStamp start, stop;
+    unsigned long loads;
+    double elapsed;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    loads = dbCacheLoads;
+    epicsTimeGetCurrent(&start);
+    testdbReadDatabase(dbFile, NULL, "P=bench:");
+    epicsTimeGetCurrent(&stop);
+    *ploads = dbCacheLoads - loads;
+    elapsed = epicsTimeDiffInSeconds(&stop, &start);
+
+    testDiag("%-24s %9.1f ms, %9.0f records/s", what, elapsed * 1e3,
+        NRECORDS / elapsed);
+    testdbCleanup();
+    return elapsed;
+}
+
+MAIN(benchdbLoad)
+{
+    unsigned long loads;
+    double text, image;
+
+    testPlan(2);
+    testDiag("Loading %d records", NRECORDS);
+    writeDb();
+
+    epicsEnvSet("EPICS_DB_CACHE_DIR", "");
+    text = timeLoad("text", &loads);
+
+    epicsEnvSet("EPICS_DB_CACHE_DIR", ".");
+    timeLoad("text, saving an image", &loads);
+    testOk(loads == 0, "First load parsed the text");
+    image = timeLoad("image", &loads);
+    testOk(loads == 1, "Second load used the image, %.1f times faster",
+        text / image);
+
+    remove(dbFile);
+    return testDone();
+}
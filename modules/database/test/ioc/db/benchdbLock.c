@@ -0,0 +1,130 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Measure processing of many small locksets whose records were loaded
+ * far apart, with and without iocPackRecords.
+ *
+ * Each lockset is a chain of records joined by FLNK.  The database is
+ * written one chain step at a time, so the records of a chain end up
+ * NCHAINS records apart unless they are packed.  Chains are processed
+ * in a shuffled order, as a scan list would be.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cantProceed.h"
+#include "epicsTime.h"
+#include "dbAccess.h"
+#include "dbLock.h"
+#include "dbStaticLib.h"
+#include "dbUnitTest.h"
+#include "iocInit.h"
+#include "testMain.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+#define NCHAINS 20000
+#define CHAINLEN 5
+#define NPASSES 20
+
+static const char dbFile[] = "benchdbLock.db";
+
+static void writeDb(void)
+{
+    FILE *fp = fopen(dbFile, "w");
+    int c, k;
+
+    if (!fp)
+        testAbort("Can't create %s", dbFile);
+    for (k = 0; k < CHAINLEN; k++) {
+        for (c = 0; c < NCHAINS; c++) {
+            fprintf(fp, "record(x, \"c%d:%d\") {\n", c, k);
+            if (k + 1 < CHAINLEN)
+                fprintf(fp, "    field(FLNK, \"c%d:%d\")\n", c, k + 1);
+            fprintf(fp, "}\n");
+        }
+    }
+    fclose(fp);
+}
+
+static double timeProcess(int pack, const int *shuffle)
+{
+    dbCommon **heads = callocMustSucceed(NCHAINS, sizeof(*heads),
+        "timeProcess");
+    epicsTimeStamp start, stop;
+    double elapsed;
+    char name[32];
+    int i, pass;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase(dbFile, NULL, NULL);
+
+    iocPackRecords = pack;
+    testIocInitOk();
+    iocPackRecords = 0;
+
+    for (i = 0; i < NCHAINS; i++) {
+        sprintf(name, "c%d:0", shuffle[i]);
+        heads[i] = testdbRecordPtr(name);
+    }
+    sprintf(name, "c%d:1", shuffle[0]);
+    testOk(((char *)testdbRecordPtr(name) - (char *)heads[0] < 4096) == pack,
+        "Chain records are %s", pack ? "adjacent" : "apart");
+
+    epicsTimeGetCurrent(&start);
+    for (pass = 0; pass < NPASSES; pass++) {
+        for (i = 0; i < NCHAINS; i++) {
+            dbScanLock(heads[i]);
+            dbProcess(heads[i]);
+            dbScanUnlock(heads[i]);
+        }
+    }
+    epicsTimeGetCurrent(&stop);
+    elapsed = epicsTimeDiffInSeconds(&stop, &start);
+
+    testDiag("%-9s %8.1f ms, %6.1f ns per record", pack ? "packed" : "in place",
+        elapsed * 1e3, elapsed * 1e9 / (NPASSES * NCHAINS * CHAINLEN));
+
+    testIocShutdownOk();
+    testdbCleanup();
+    free(heads);
+    return elapsed;
+}
+
+MAIN(benchdbLock)
+{
+    int *shuffle = callocMustSucceed(NCHAINS, sizeof(*shuffle), "benchdbLock");
+    double unpacked, packed;
+    int i;
+
+    testPlan(2);
+    testDiag("%d locksets of %d records, %d passes",
+        NCHAINS, CHAINLEN, NPASSES);
+    writeDb();
+
+    srand(1);
+    for (i = 0; i < NCHAINS; i++)
+        shuffle[i] = i;
+    for (i = NCHAINS - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = shuffle[i];
+
+        shuffle[i] = shuffle[j];
+        shuffle[j] = tmp;
+    }
+
+    unpacked = timeProcess(0, shuffle);
+    packed = timeProcess(1, shuffle);
+    testDiag("Packed records process %.2f times as fast", unpacked / packed);
+
+    remove(dbFile);
+    free(shuffle);
+    return testDone();
+}
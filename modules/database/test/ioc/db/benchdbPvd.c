@@ -0,0 +1,124 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Measure PV directory lookup rates against the number of records
+ * and the number of threads doing lookups concurrently.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cantProceed.h"
+#include "epicsEvent.h"
+#include "epicsThread.h"
+#include "epicsTime.h"
+#include "errlog.h"
+#include "dbStaticLib.h"
+#include "dbAccess.h"
+#include "dbUnitTest.h"
+#include "testMain.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+#define NLOOKUPS 2000000
+#define MAXTHREADS 8
+
+typedef struct {
+    char (*names)[24];
+    size_t nrecs;
+    size_t first;
+    size_t nfound;
+    epicsEventId done;
+} benchThread;
+
+static void lookupThread(void *arg)
+{
+    benchThread *pbt = arg;
+    DBENTRY entry;
+    size_t i, j = pbt->first;
+
+    dbInitEntry(pdbbase, &entry);
+    for (i = 0; i < NLOOKUPS; i++) {
+        /* Stride through the names to defeat the caches */
+        j = (j + 7919) % pbt->nrecs;
+        pbt->nfound += !dbFindRecord(&entry, pbt->names[j]);
+    }
+    dbFinishEntry(&entry);
+    epicsEventMustTrigger(pbt->done);
+}
+
+static void runBench(char (*names)[24], size_t nrecs, int nthreads)
+{
+    benchThread bt[MAXTHREADS];
+    epicsTimeStamp start, stop;
+    size_t nfound = 0;
+    double elapsed;
+    int i;
+
+    epicsTimeGetCurrent(&start);
+    for (i = 0; i < nthreads; i++) {
+        bt[i].names = names;
+        bt[i].nrecs = nrecs;
+        bt[i].first = i * (nrecs / nthreads);
+        bt[i].nfound = 0;
+        bt[i].done = epicsEventMustCreate(epicsEventEmpty);
+        epicsThreadMustCreate("benchPvd", epicsThreadPriorityMedium,
+            epicsThreadGetStackSize(epicsThreadStackSmall),
+            lookupThread, &bt[i]);
+    }
+    for (i = 0; i < nthreads; i++) {
+        epicsEventMustWait(bt[i].done);
+        epicsEventDestroy(bt[i].done);
+        nfound += bt[i].nfound;
+    }
+    epicsTimeGetCurrent(&stop);
+
+    elapsed = epicsTimeDiffInSeconds(&stop, &start);
+    testOk(nfound == (size_t) nthreads * NLOOKUPS,
+        "%6lu records, %d thread%s: %.2f M lookups/s",
+        (unsigned long) nrecs, nthreads, nthreads == 1 ? " " : "s",
+        nthreads * NLOOKUPS / elapsed / 1e6);
+}
+
+MAIN(benchdbPvd)
+{
+    static const size_t nrecs[] = {1000, 10000, 100000};
+    char (*names)[24];
+    DBENTRY entry;
+    size_t n = 0;
+    int i, t;
+
+    testPlan(12);
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    names = callocMustSucceed(nrecs[NELEMENTS(nrecs) - 1], sizeof(*names),
+        "benchdbPvd");
+
+    dbInitEntry(pdbbase, &entry);
+    if (dbFindRecordType(&entry, "x"))
+        testAbort("No record type 'x'");
+
+    for (i = 0; i < NELEMENTS(nrecs); i++) {
+        /* Add records to reach the next size */
+        for (; n < nrecs[i]; n++) {
+            sprintf(names[n], "bench:pvd:%lu", (unsigned long) n);
+            if (dbCreateRecord(&entry, names[n]))
+                testAbort("Can't create record %s", names[n]);
+        }
+        for (t = 1; t <= MAXTHREADS; t *= 2)
+            runBench(names, n, t);
+    }
+    dbFinishEntry(&entry);
+
+    testdbCleanup();
+    free(names);
+
+    return testDone();
+}
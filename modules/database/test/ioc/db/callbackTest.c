@@ -111,10 +111,17 @@ MAIN(callbackTest)
         for (j = 0; j < 5; j++)
             setupError[i][j] = timeError[i][j] = defaultError[j];
 
-    testPlan(2);
+    testPlan(5);
 
+    testOk1(callbackSetQueueSize(2000) == 0);
     callbackInit();
     epicsThreadSleep(1.0);
+    {
+        callbackQueueStats stats;
+
+        callbackQueueStatus(0, &stats);
+        testOk(stats.size == 2048, "Queue size rounded up to %d", stats.size);
+    }
 
     finished = epicsEventMustCreate(epicsEventEmpty);
 
@@ -196,6 +203,23 @@ MAIN(callbackTest)
     printStats(timeError[1], "MID");
     printStats(timeError[2], "HIGH");
 
+    {
+        callbackThreadStats stats;
+        size_t total = 0;
+
+        callbackThreadStatus(0, &stats);
+        for (i = 0; i < NUM_CALLBACK_PRIORITIES; i++) {
+            testDiag("%s: %lu callbacks in %lu batches after %lu wakeups",
+                i == 0 ? "LOW" : i == 1 ? "MID" : "HIGH",
+                (unsigned long)stats.numCallbacks[i],
+                (unsigned long)stats.numBatches[i],
+                (unsigned long)stats.numWakeups[i]);
+            total += stats.numCallbacks[i];
+        }
+        testOk(total == 2 * NCALLBACKS, "%lu callbacks counted",
+            (unsigned long)total);
+    }
+
     for (i = 0; i < NCALLBACKS ; i++) {
         free(pcbt[i]);
     }
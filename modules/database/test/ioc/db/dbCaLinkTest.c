@@ -573,6 +573,158 @@ static void testreTargetTypeChange(void)
     free(buftarg2);
 }
 
+static void testCoalesce(void)
+{
+    xRecord *psrc, *ptarg;
+    DBLINK *psrclnk;
+    caLink *pca;
+    epicsInt32 val;
+    int i;
+
+    testDiag("Puts through a LATEST link are coalesced");
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("dbCaLinkTest1.db", NULL, "TARGET=target CA LATEST");
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    psrc = (xRecord*)testdbRecordPtr("source");
+    ptarg= (xRecord*)testdbRecordPtr("target");
+    psrclnk = &psrc->lnk;
+    pca = psrclnk->value.pv_link.pvt;
+
+    testOk1(pca->coalesce);
+
+    waitForUpdateN(psrclnk, 1);
+
+    /* Hold the target so the first put stays in flight */
+    dbScanLock((dbCommon*)ptarg);
+    val = 1;
+    testOk1(dbPutLink(psrclnk, DBR_LONG, &val, 1) == 0);
+    for (i = 0; i < 500 && !ellCount(&pca->putTags); i++)
+        epicsThreadSleep(0.01);
+    epicsThreadSleep(0.1);
+
+    for (val = 2; val <= 5; val++)
+        dbPutLink(psrclnk, DBR_LONG, &val, 1);
+    dbScanUnlock((dbCommon*)ptarg);
+
+    for (i = 0; i < 500; i++) {
+        dbScanLock((dbCommon*)ptarg);
+        val = ptarg->val;
+        dbScanUnlock((dbCommon*)ptarg);
+        if (val == 5)
+            break;
+        epicsThreadSleep(0.01);
+    }
+    testOp("%d", val, ==, 5);
+    testOp("%lu", pca->nCoalesced, ==, 3ul);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
+#define NSHARDED 16
+
+static void testWorkers(void)
+{
+    xRecord *psrc[NSHARDED], *ptarg;
+    dbCaWorker *pworker[NSHARDED];
+    unsigned i, j, nused = 0, nconnected = 0;
+    unsigned long nputs = 0;
+    int ok = 1, sameContext = 1;
+
+    testDiag("Links shared between 4 workers");
+    dbCaLinkWorkers = 4;
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    for (i = 0; i < NSHARDED; i++) {
+        char macros[16];
+
+        epicsSnprintf(macros, sizeof(macros), "N=%u", i);
+        testdbReadDatabase("dbCaLinkTest4.db", NULL, macros);
+    }
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    for (i = 0; i < NSHARDED; i++) {
+        char name[16];
+        caLink *pca;
+
+        epicsSnprintf(name, sizeof(name), "source%u", i);
+        psrc[i] = (xRecord*)testdbRecordPtr(name);
+        pca = psrc[i]->lnk.value.pv_link.pvt;
+        pworker[i] = pca->pworker;
+        for (j = 0; j < i && pworker[j] != pworker[i]; j++) {}
+        if (j == i)
+            nused++;
+    }
+    testOk(nused > 1, "%d links use %u workers", NSHARDED, nused);
+
+    for (i = 0; i < NSHARDED; i++)
+        sameContext &= dbCaLinkContext(&psrc[i]->lnk) ==
+            dbCaWorkerContext(pworker[i]->index);
+    testOk(sameContext, "Each link is in its worker's CA context");
+    testOk1(dbCaWorkerContext(0) == dbCaClientContext);
+    testOk1(dbCaWorkerContext(1) != dbCaClientContext);
+    testOk1(dbCaWorkerContext(4) == NULL);
+
+    for (j = 0; j < 500 && nconnected < NSHARDED; j++) {
+        epicsThreadSleep(0.01);
+        for (nconnected = 0, i = 0; i < NSHARDED; i++) {
+            dbScanLock((dbCommon*)psrc[i]);
+            nconnected += dbCaIsLinkConnected(&psrc[i]->lnk);
+            dbScanUnlock((dbCommon*)psrc[i]);
+        }
+    }
+    testOp("%u", nconnected, ==, NSHARDED);
+
+    for (i = 0; i < NSHARDED; i++) {
+        epicsInt32 val = 100 + i;
+
+        dbScanLock((dbCommon*)psrc[i]);
+        ok &= dbPutLink(&psrc[i]->lnk, DBR_LONG, &val, 1) == 0;
+        dbScanUnlock((dbCommon*)psrc[i]);
+    }
+    dbCaSync();
+
+    for (i = 0; i < NSHARDED; i++) {
+        char name[16];
+
+        epicsSnprintf(name, sizeof(name), "target%u", i);
+        ptarg = (xRecord*)testdbRecordPtr(name);
+        dbScanLock((dbCommon*)ptarg);
+        ok &= ptarg->val == 100 + i;
+        dbScanUnlock((dbCommon*)ptarg);
+    }
+    testOk(ok, "Puts through every worker arrived");
+
+    for (i = 0; i < NSHARDED; i++) {
+        for (j = 0; j < i && pworker[j] != pworker[i]; j++) {}
+        if (j == i)
+            nputs += pworker[i]->nPuts;
+    }
+    testOp("%lu", nputs, >=, (unsigned long)NSHARDED);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+    dbCaLinkWorkers = 1;
+}
+
 void dbCaLinkTest_testCAC(void);
 
 static void testCAC(void)
@@ -618,7 +770,7 @@ static void testCAC(void)
 
 MAIN(dbCaLinkTest)
 {
-    testPlan(101);
+    testPlan(113);
     testNativeLink();
     testStringLink();
     testCP();
@@ -627,6 +779,8 @@ MAIN(dbCaLinkTest)
     testArrayLink(1,10);
     testArrayLink(10,10);
     testreTargetTypeChange();
+    testCoalesce();
+    testWorkers();
     testCAC();
     return testDone();
 }
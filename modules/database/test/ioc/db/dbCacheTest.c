@@ -0,0 +1,238 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Check that databases loaded from a precompiled image match the
+ * text load, and that images are ignored once their inputs change.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#  include <direct.h>
+#  define mkdir(dir, mode) _mkdir(dir)
+#  define rmdir(dir) _rmdir(dir)
+#else
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  ifdef vxWorks
+#    define mkdir(dir, mode) mkdir(dir)
+#  endif
+#endif
+
+#include "epicsStdio.h"
+#include "epicsString.h"
+#include "epicsTime.h"
+#include "envDefs.h"
+#include "dbAccess.h"
+#include "dbStaticLib.h"
+#include "dbUnitTest.h"
+#include "testMain.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+/* The databases and their images all go here, and are removed after */
+static const char tmpDir[] = "dbCacheTest.tmp";
+static const char mainFile[] = "dbCacheTest.db";
+static const char incFile[] = "dbCacheTestInc.db";
+
+static const char mainText[] =
+    "record(x, \"cache$(N):a\") {\n"
+    "    field(DESC, \"Record \\\"a\\\" $(N)\")\n"
+    "    field(VAL, \"$(N)\")\n"
+    "    field(C8, -5)\n"
+    "    field(U16, 0x1234)\n"
+    "    field(I64, -1234567890123)\n"
+    "    field(F32, 1.5)\n"
+    "    field(F64, 2.5e-3)\n"
+    "    field(SCAN, \"1 second\")\n"
+    "    field(LNK, \"cache$(N):b.VAL CP\")\n"
+    "    info(autosaveFields, \"VAL\")\n"
+    "    alias(\"cache$(N):alias\")\n"
+    "}\n"
+    "include \"dbCacheTestInc.db\"\n"
+    "record(\"*\", \"cache$(N):a\") {\n"
+    "    field(PHAS, 2)\n"
+    "}\n"
+    "alias(\"cache$(N):b\", \"cache$(N):balias\")\n";
+
+static const char incText[] =
+    "record(x, \"cache$(N):b\") {\n"
+    "    field(U32, 4000000000)\n"
+    "    field(PINI, YES)\n"
+    "}\n";
+
+static char runTag[64];
+
+static void writeFile(const char *name, const char *text, const char *extra)
+{
+    char path[64];
+    FILE *fp;
+
+    epicsSnprintf(path, sizeof(path), "%s/%s", tmpDir, name);
+    fp = fopen(path, "w");
+    if (!fp)
+        testAbort("Can't create %s", path);
+    /* A new tag each run so the first load can't find an old image */
+    fprintf(fp, "# %s\n%s%s", runTag, text, extra);
+    fclose(fp);
+}
+
+/* Hash of every field, info item and alias in the database */
+static unsigned fingerprint(int *pnrec)
+{
+    DBENTRY entry;
+    unsigned hash = 0;
+    long status;
+
+    *pnrec = 0;
+    dbInitEntry(pdbbase, &entry);
+    for (status = dbFirstRecordType(&entry); !status;
+         status = dbNextRecordType(&entry)) {
+        long rstatus;
+
+        for (rstatus = dbFirstRecord(&entry); !rstatus;
+             rstatus = dbNextRecord(&entry)) {
+            long fstatus;
+
+            hash = epicsStrHash(dbGetRecordName(&entry), hash);
+            if (dbIsAlias(&entry)) {
+                hash = epicsStrHash("alias", hash);
+                continue;
+            }
+            (*pnrec)++;
+            for (fstatus = dbFirstField(&entry, 0); !fstatus;
+                 fstatus = dbNextField(&entry, 0)) {
+                const char *pstr = dbGetString(&entry);
+
+                hash = epicsStrHash(dbGetFieldName(&entry), hash);
+                hash = epicsStrHash(pstr ? pstr : "(null)", hash);
+            }
+            for (fstatus = dbFirstInfo(&entry); !fstatus;
+                 fstatus = dbNextInfo(&entry)) {
+                hash = epicsStrHash(dbGetInfoName(&entry), hash);
+                hash = epicsStrHash(dbGetInfoString(&entry), hash);
+            }
+        }
+    }
+    dbFinishEntry(&entry);
+    return hash;
+}
+
+typedef struct {
+    unsigned long loads;
+    unsigned long stores;
+    unsigned hash;
+    int nrec;
+} loadResult;
+
+static loadResult load(const char *macros)
+{
+    loadResult res;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    res.loads = dbCacheLoads;
+    res.stores = dbCacheStores;
+    testdbReadDatabase(mainFile, tmpDir, macros);
+    res.loads = dbCacheLoads - res.loads;
+    res.stores = dbCacheStores - res.stores;
+    res.hash = fingerprint(&res.nrec);
+    return res;
+}
+
+static void removeImage(const char *macros)
+{
+    char *image = dbCacheImageName(mainFile, tmpDir, macros);
+
+    if (image)
+        remove(image);
+    free(image);
+}
+
+static void cleanup(void)
+{
+    char path[64];
+
+    epicsEnvSet("EPICS_DB_CACHE_DIR", tmpDir);
+    removeImage("N=1");
+    removeImage("N=2");
+    epicsSnprintf(path, sizeof(path), "%s/%s", tmpDir, mainFile);
+    remove(path);
+    epicsSnprintf(path, sizeof(path), "%s/%s", tmpDir, incFile);
+    remove(path);
+    rmdir(tmpDir);
+}
+
+MAIN(dbCacheTest)
+{
+    loadResult text, image, other;
+    epicsTimeStamp now;
+
+    testPlan(12);
+
+    epicsTimeGetCurrent(&now);
+    epicsTimeToStrftime(runTag, sizeof(runTag), "%Y-%m-%d %H:%M:%S.%09f",
+        &now);
+    /* Start cold, even after a run that didn't finish */
+    cleanup();
+    mkdir(tmpDir, 0777);
+    writeFile(mainFile, mainText, "");
+    writeFile(incFile, incText, "");
+
+    testDiag("First load parses the text and saves an image");
+    text = load("N=1");
+    testdbCleanup();
+    testOk(text.loads == 0 && text.stores == 1,
+        "%lu loads, %lu stores", text.loads, text.stores);
+    testOk(text.nrec == 2, "%d records", text.nrec);
+
+    testDiag("Second load uses the image");
+    image = load("N=1");
+    testOk(image.loads == 1 && image.stores == 0,
+        "%lu loads, %lu stores", image.loads, image.stores);
+    testOk(image.hash == text.hash && image.nrec == text.nrec,
+        "Database matches the text load");
+    testIocInitOk();
+    testdbGetFieldEqual("cache1:a.VAL", DBR_LONG, 1);
+    testdbGetFieldEqual("cache1:a.UDF", DBR_UCHAR, 0);
+    testdbGetFieldEqual("cache1:alias.DESC", DBR_STRING, "Record \"a\" 1");
+    testdbGetFieldEqual("cache1:balias.U32", DBR_ULONG, 4000000000u);
+    testIocShutdownOk();
+    testdbCleanup();
+
+    testDiag("Other macros have their own image");
+    other = load("N=2");
+    testdbCleanup();
+    testOk(other.loads == 0 && other.stores == 1 && other.hash != text.hash,
+        "%lu loads, %lu stores", other.loads, other.stores);
+
+    testDiag("Changing an included file invalidates the image");
+    writeFile(incFile, incText, "record(x, \"cache$(N):c\") {}\n");
+    other = load("N=1");
+    testdbCleanup();
+    testOk(other.loads == 0 && other.stores == 1 && other.nrec == 3,
+        "%lu loads, %lu stores, %d records",
+        other.loads, other.stores, other.nrec);
+    image = load("N=1");
+    testdbCleanup();
+    testOk(image.loads == 1 && image.hash == other.hash,
+        "%lu loads of the new image", image.loads);
+
+    testDiag("Images are only used when enabled");
+    epicsEnvSet("EPICS_DB_CACHE_DIR", "");
+    text = load("N=1");
+    testdbCleanup();
+    testOk(text.loads == 0 && text.stores == 0 && text.hash == other.hash,
+        "%lu loads, %lu stores", text.loads, text.stores);
+
+    cleanup();
+    epicsEnvSet("EPICS_DB_CACHE_DIR", "");
+    return testDone();
+}
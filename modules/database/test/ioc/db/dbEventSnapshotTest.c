@@ -0,0 +1,164 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Check that array monitor updates are queued as shared snapshots
+ * when dbEventArraySnapshots is set.
+ */
+
+#include <string.h>
+
+#include "epicsEvent.h"
+#include "epicsThread.h"
+
+#include "dbAccess.h"
+#include "dbChannel.h"
+#include "dbEvent.h"
+#include "db_field_log.h"
+#include "dbUnitTest.h"
+#include "errlog.h"
+#include "testMain.h"
+
+#include "arrRecord.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+#define NUPDATES 3
+
+typedef struct {
+    int count;
+    int type[NUPDATES];
+    double value[NUPDATES];
+    const void *field[NUPDATES];
+} subPvt;
+
+static subPvt subA, subB;
+static epicsEventId gate, done;
+static int nCalls;
+static void *hold;
+static const double *pHeld;
+
+static void onUpdate(void *user_arg, struct dbChannel *chan,
+    int eventsRemaining, struct db_field_log *pfl)
+{
+    subPvt *pvt = user_arg;
+    int i = pvt->count++;
+
+    /* Hold the event task until all updates have been posted */
+    if (nCalls++ == 0)
+        epicsEventMustWait(gate);
+
+    if (i < NUPDATES) {
+        pvt->type[i] = pfl->type;
+        pvt->field[i] = pfl->type == dbfl_type_ref ? pfl->u.r.field : NULL;
+        if (pfl->type == dbfl_type_ref && pfl->no_elements > 0)
+            pvt->value[i] = ((double *) pfl->u.r.field)[0];
+        /* Keep the first update's data beyond the life of its log */
+        if (pvt == &subA && i == 0) {
+            hold = db_hold_field_log_data(pfl);
+            pHeld = pfl->u.r.field;
+        }
+        else
+            dbChannelGetField(chan, DBR_DOUBLE, &pvt->value[i], NULL,
+                NULL, pfl);
+    }
+    if (nCalls == 2 * NUPDATES)
+        epicsEventMustTrigger(done);
+}
+
+static void postValue(arrRecord *prec, double value)
+{
+    dbScanLock((dbCommon *) prec);
+    ((double *) prec->bptr)[0] = value;
+    prec->nord = 1;
+    db_post_events(prec, &prec->val, DBE_VALUE);
+    dbScanUnlock((dbCommon *) prec);
+}
+
+MAIN(dbEventSnapshotTest)
+{
+    dbEventCtx ctx;
+    dbChannel *chanA, *chanB;
+    dbEventSubscription evA, evB;
+    arrRecord *prec;
+    int i;
+
+    testPlan(7 + 4 * NUPDATES);
+
+    gate = epicsEventMustCreate(epicsEventEmpty);
+    done = epicsEventMustCreate(epicsEventEmpty);
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("dbChArrTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    prec = (arrRecord *) testdbRecordPtr("f64");
+
+    ctx = db_init_events();
+    testOk1(ctx != NULL);
+    testOk1(db_start_events(ctx, "snapshot", NULL, NULL,
+        epicsThreadPriorityLow) == DB_EVENT_OK);
+
+    chanA = dbChannelCreate("f64");
+    chanB = dbChannelCreate("f64");
+    testOk1(chanA && chanB && !dbChannelOpen(chanA) && !dbChannelOpen(chanB));
+
+    dbEventArraySnapshots = 1;
+    evA = db_add_event(ctx, chanA, onUpdate, &subA, DBE_VALUE);
+    evB = db_add_event(ctx, chanB, onUpdate, &subB, DBE_VALUE);
+    dbEventArraySnapshots = 0;
+    testOk1(evA && evB);
+    db_event_enable(evA);
+    db_event_enable(evB);
+
+    for (i = 0; i < NUPDATES; i++)
+        postValue(prec, 1.0 + i);
+    epicsEventMustTrigger(gate);
+    epicsEventMustWait(done);
+
+    for (i = 0; i < NUPDATES; i++) {
+        testOk(subA.type[i] == dbfl_type_ref && subB.type[i] == dbfl_type_ref,
+            "Update %d types %s, %s", i, dbflTypeStr(subA.type[i]),
+            dbflTypeStr(subB.type[i]));
+        testOk(subA.value[i] == 1.0 + i, "A update %d value %g", i,
+            subA.value[i]);
+        testOk(subB.value[i] == 1.0 + i, "B update %d value %g", i,
+            subB.value[i]);
+        testOk(subA.field[i] && subA.field[i] == subB.field[i],
+            "Update %d data shared", i);
+    }
+
+    testOk(hold != NULL, "Snapshot data held");
+    testOk(pHeld && pHeld[0] == 1.0, "Held data value %g",
+        pHeld ? pHeld[0] : 0.0);
+    db_release_field_log_data(hold);
+
+    {
+        db_field_log *pfl = db_create_read_log(chanA);
+        testOk(pfl && !db_hold_field_log_data(pfl),
+            "Read logs hold no snapshot");
+        db_delete_field_log(pfl);
+    }
+
+    db_cancel_event(evA);
+    db_cancel_event(evB);
+    db_close_events(ctx);
+    dbChannelDelete(chanA);
+    dbChannelDelete(chanB);
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    epicsEventDestroy(gate);
+    epicsEventDestroy(done);
+
+    return testDone();
+}
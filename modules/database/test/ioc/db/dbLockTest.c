@@ -25,6 +25,8 @@
 
 #include "dbAccess.h"
 #include "errlog.h"
+#include "initHooks.h"
+#include "iocInit.h"
 
 void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
 
@@ -414,12 +416,88 @@ static void testLinkNOP(void)
     testdbCleanup();
 }
 
+static void createRecord(const char *name, const char *sdis)
+{
+    DBENTRY entry;
+
+    dbInitEntry(pdbbase, &entry);
+    if(dbFindRecordType(&entry, "x") || dbCreateRecord(&entry, name))
+        testAbort("Can't create %s", name);
+    if(sdis && (dbFindField(&entry, "SDIS") || dbPutString(&entry, sdis)))
+        testAbort("Can't set %s.SDIS", name);
+    dbFinishEntry(&entry);
+}
+
+static dbCommon *hookPa1;
+
+static void packHook(initHookState state)
+{
+    if (state == initHookAtIocBuild && iocPackRecords)
+        hookPa1 = testdbRecordPtr("packa1");
+}
+
+static void testPack(void)
+{
+    DBENTRY entry;
+    dbCommon *pa1, *pa2, *pb1, *pb2;
+    ptrdiff_t step;
+
+    testDiag("Test packing each lockset's records together");
+
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("dbLockTest.db", NULL, NULL);
+
+    /* interleave two locksets */
+    createRecord("packa1", "packa2");
+    createRecord("packb1", "packb2 NPP");
+    createRecord("packa2", NULL);
+    createRecord("packb2", NULL);
+    dbInitEntry(pdbbase, &entry);
+    if(dbFindRecord(&entry, "packa2") || dbCreateAlias(&entry, "packalias"))
+        testAbort("Can't create alias");
+    dbFinishEntry(&entry);
+
+    initHookRegister(packHook);
+    iocPackRecords = 1;
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+    iocPackRecords = 0;
+
+    pa1 = testdbRecordPtr("packa1");
+    pa2 = testdbRecordPtr("packa2");
+    pb1 = testdbRecordPtr("packb1");
+    pb2 = testdbRecordPtr("packb2");
+    step = (char*)pa2 - (char*)pa1;
+
+    /* loaded as a1, b1, a2, b2 */
+    testOk((char*)pb1 - (char*)pa2 == step && (char*)pb2 - (char*)pb1 == step,
+           "Records ordered by lockset, %ld bytes apart", (long)step);
+    testOk1(step % 64 == 0);
+    testOk1(testdbRecordPtr("packalias")==pa2);
+    testOk(hookPa1 == pa1, "The first init hook sees the packed records");
+    compareSets(1, "packa1", "packa2");
+    compareSets(1, "packb1", "packb2");
+    compareSets(0, "packa1", "packb1");
+    compareSets(1, "recd", "recf");
+
+    testdbPutFieldOk("packalias.VAL", DBR_LONG, 42);
+    testdbGetFieldEqual("packa2.VAL", DBR_LONG, 42);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
 MAIN(dbLockTest)
 {
 #ifdef LOCKSET_DEBUG
-    testPlan(100);
+    testPlan(110);
 #else
-    testPlan(88);
+    testPlan(98);
 #endif
     testSets();
     testSingleLock();
@@ -428,5 +506,6 @@ MAIN(dbLockTest)
     testLinkMake();
     testLinkChange();
     testLinkNOP();
+    testPack();
     return testDone();
 }
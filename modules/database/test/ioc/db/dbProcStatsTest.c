@@ -0,0 +1,115 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Check the record processing time statistics reported by dbtop.
+ */
+
+#include <string.h>
+
+#include "epicsThread.h"
+#include "dbAccess.h"
+#include "dbCommon.h"
+#include "dbLock.h"
+#include "dbProcStats.h"
+#include "dbUnitTest.h"
+#include "testMain.h"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void processMany(dbCommon *prec, int n)
+{
+    dbScanLock(prec);
+    while (n--)
+        dbProcess(prec);
+    dbScanUnlock(prec);
+}
+
+MAIN(dbProcStatsTest)
+{
+    dbCommon *pa, *pb;
+    dbProcStats *psa, *psb;
+    epicsUInt64 sum = 0;
+    char summary[256];
+    char thread[16];
+    int i;
+
+    testPlan(15);
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("dbProcStatsTest.db", NULL, NULL);
+
+    testOk1(dbtop(0, 0) == -1);
+
+    testIocInitOk();
+    pa = testdbRecordPtr("proc:a");
+    pb = testdbRecordPtr("proc:b");
+    psa = dbProcStatsGet(pa);
+    psb = dbProcStatsGet(pb);
+    testOk(psa && psb && psa != psb, "Each record has statistics");
+
+    processMany(pa, 1000);
+    processMany(pb, 1);
+
+    testOk(psa->count == 1000, "proc:a processed %.0f times",
+        (double)psa->count);
+    testOk(psb->count == 1, "proc:b processed %.0f times",
+        (double)psb->count);
+    for (i = 0; i < DB_PROC_STATS_BINS; i++)
+        sum += psa->hist[i];
+    testOk(sum == psa->count, "Histogram holds every process");
+    testOk(psa->maxNsec > 0 && psa->maxNsec * 1000.0 >= psa->nsec,
+        "Longest time %u ns covers the mean", (unsigned)psa->maxNsec);
+    epicsThreadGetName(epicsThreadGetIdSelf(), thread, sizeof(thread));
+    testOk(strcmp(psa->thread, thread) == 0, "Processed by '%s'",
+        psa->thread);
+
+    testDiag("Processing an active record counts it as active");
+    dbScanLock(pa);
+    pa->pact = TRUE;
+    dbProcess(pa);
+    pa->pact = FALSE;
+    dbScanUnlock(pa);
+    testOk(psa->active == 1 && psa->count == 1000, "%u active",
+        (unsigned)psa->active);
+
+    testDiag("Records are ranked by total time");
+    dbProcStatsSummary(summary, sizeof(summary), 1);
+    testDiag("Summary: %s", summary);
+    testOk(strncmp(summary, "proc:a 1000 ", 12) == 0 &&
+        strchr(summary, '\n') == summary + strlen(summary) - 1,
+        "Summary lists proc:a only");
+    testOk(dbProcStatsSummary(summary, 8, 5) == 7 && strlen(summary) == 7,
+        "Truncated summary leaves room for the nil");
+    testOk1(dbtop(0, 2) == 0);
+
+    testDiag("Collection can be disabled");
+    dbProcStatsEnable = 0;
+    processMany(pa, 10);
+    dbScanLock(pa);
+    pa->pact = TRUE;
+    dbProcess(pa);
+    pa->pact = FALSE;
+    dbScanUnlock(pa);
+    dbProcStatsEnable = 1;
+    testOk(psa->count == 1000 && psa->active == 1,
+        "%.0f processes, %u active", (double)psa->count,
+        (unsigned)psa->active);
+
+    dbProcStatsReset();
+    testOk(psa->count == 0 && psa->nsec == 0 && psa->hist[0] == 0,
+        "Reset clears the statistics");
+    dbProcStatsSummary(summary, sizeof(summary), 5);
+    testOk(summary[0] == 0, "Summary is empty");
+
+    testIocShutdownOk();
+    testOk(dbProcStatsGet(pa) == NULL, "Statistics freed by iocShutdown");
+    testdbCleanup();
+
+    return testDone();
+}
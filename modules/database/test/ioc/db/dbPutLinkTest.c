@@ -187,6 +187,8 @@ static const struct testDataT {
     {"qq MSICA", CA_LINK, pvlOptInpNative|pvlOptCA|pvlOptMSI, "qq CA MSI"},
 
     {"x1 CA", CA_LINK, pvlOptInpNative|pvlOptCA, "x1 CA NMS"},
+    {"x1 CA LATEST", CA_LINK, pvlOptInpNative|pvlOptCA|pvlOptLATEST,
+        "x1 CA NMS LATEST"},
     {NULL}
 };
 
@@ -700,7 +702,7 @@ void testTSEL(void)
 
 MAIN(dbPutLinkTest)
 {
-    testPlan(342);
+    testPlan(346);
     testLinkParse();
     testLinkFailParse();
     testCADBSet();
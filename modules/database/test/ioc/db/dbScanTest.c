@@ -10,17 +10,23 @@
  *  Author: Michael Davidsaver <mdavidsaver@bnl.gov>
  */
 
+#include <stdio.h>
 #include <string.h>
 
 #include "dbScan.h"
 #include "epicsEvent.h"
+#include "epicsMutex.h"
 
 #include "dbUnitTest.h"
 #include "testMain.h"
 
 #include "dbAccess.h"
+#include "dbLock.h"
+#include "epicsThread.h"
 #include "errlog.h"
 
+#include "xRecord.h"
+
 void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
 
 static epicsEventId waiter;
@@ -66,9 +72,126 @@ static void testOnce(void)
     epicsEventDestroy(waiter);
 }
 
+static const char *shardRecs[] = {
+    "reca", "recb", "recc", "recd", "rece", "recf", "recg"
+};
+#define NSHARDRECS NELEMENTS(shardRecs)
+static epicsMutexId shardGuard;
+static epicsThreadId shardThread[NSHARDRECS];
+static int shardMixed;
+
+static void shardClbk(xRecord *prec)
+{
+    size_t i;
+
+    epicsMutexMustLock(shardGuard);
+    for (i = 0; i < NSHARDRECS; i++) {
+        if (strcmp(prec->name, shardRecs[i]) == 0) {
+            epicsThreadId self = epicsThreadGetIdSelf();
+
+            if (shardThread[i] && shardThread[i] != self)
+                shardMixed = 1;
+            shardThread[i] = self;
+        }
+    }
+    epicsMutexUnlock(shardGuard);
+}
+
+/* Copy out what the scan threads saw, optionally starting again */
+static int shardSnapshot(epicsThreadId *threads, int reset)
+{
+    int mixed;
+
+    epicsMutexMustLock(shardGuard);
+    memcpy(threads, shardThread, sizeof(shardThread));
+    mixed = shardMixed;
+    if (reset) {
+        memset(shardThread, 0, sizeof(shardThread));
+        shardMixed = 0;
+    }
+    epicsMutexUnlock(shardGuard);
+    return mixed;
+}
+
+static void testPeriodicShards(void)
+{
+    epicsThreadId threads[NSHARDRECS];
+    size_t i, other;
+    int mixed;
+
+    testDiag("check periodic scan split by lock set");
+
+    shardGuard = epicsMutexMustCreate();
+
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("dbLockTest.db", NULL, NULL);
+
+    testOk1(scanPeriodicSetThreads(2) == 0);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testOk1(scanPeriodicSetThreads(2) != 0);
+
+    for (i = 0; i < NSHARDRECS; i++) {
+        xRecord *prec = (xRecord *)testdbRecordPtr(shardRecs[i]);
+        char field[40];
+
+        dbScanLock((dbCommon *)prec);
+        prec->clbk = shardClbk;
+        dbScanUnlock((dbCommon *)prec);
+        sprintf(field, "%s.SCAN", shardRecs[i]);
+        testdbPutFieldOk(field, DBF_STRING, ".1 second");
+    }
+
+    epicsThreadSleep(0.5);
+
+    mixed = shardSnapshot(threads, 1);
+    for (i = 0; i < NSHARDRECS; i++)
+        testOk(threads[i] != NULL, "%s was scanned", shardRecs[i]);
+    testOk(!mixed, "Records always scanned by the same thread");
+
+    /* recb,recc and recd,rece,recf share lock sets */
+    testOk1(threads[1] == threads[2]);
+    testOk1(threads[3] == threads[4]);
+    testOk1(threads[4] == threads[5]);
+
+    testDiag("check re-sharding after lock sets are merged");
+
+    for (other = 1; other < NSHARDRECS; other++) {
+        if (threads[other] != threads[0])
+            break;
+    }
+    if (other == NSHARDRECS) {
+        testSkip(2, "All records were scanned by one thread");
+    }
+    else {
+        testdbPutFieldOk("reca.SDIS", DBF_STRING, shardRecs[other]);
+        epicsThreadSleep(0.3);
+        shardSnapshot(threads, 1);
+        epicsThreadSleep(0.5);
+
+        mixed = shardSnapshot(threads, 0);
+        testOk(threads[0] == threads[other],
+            "reca and %s scanned by the same thread", shardRecs[other]);
+        testOk(!mixed, "Records always scanned by the same thread");
+    }
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+    scanPeriodicSetThreads(1);
+    epicsMutexDestroy(shardGuard);
+}
+
 MAIN(dbScanTest)
 {
-    testPlan(3);
+    testPlan(26);
     testOnce();
+    testPeriodicShards();
     return testDone();
 }
@@ -4,10 +4,12 @@
 * in file LICENSE that is included with this distribution.
  \*************************************************************************/
 
+#include <stdio.h>
 #include <string.h>
 
 #include <errlog.h>
 #include <dbAccess.h>
+#include <dbChannel.h>
 #include <dbStaticLib.h>
 #include <dbStaticPvt.h>
 #include <dbUnitTest.h>
@@ -290,11 +292,97 @@ static void testDbVerify(const char *record)
     dbFinishEntry(&entry);
 }
 
+#define NPVDRECS 2000
+
+/* Enough records to make the PV directory grow several times */
+static void testPvd(void)
+{
+    DBENTRY entry;
+    char name[32], field[40];
+    int i, nAdded = 0, nFound = 0, nDeleted = 0, nMissing = 0;
+
+    testDiag("testPvd() with %d records", NPVDRECS);
+
+    dbInitEntry(pdbbase, &entry);
+    if (dbFindRecordType(&entry, "x"))
+        testAbort("No record type 'x'");
+
+    for (i = 0; i < NPVDRECS; i++) {
+        sprintf(name, "pvd:%d", i);
+        nAdded += !dbCreateRecord(&entry, name);
+    }
+    testOk(nAdded == NPVDRECS, "Created %d records", nAdded);
+    testOk1(dbCreateRecord(&entry, "pvd:0") == S_dbLib_recExists);
+
+    for (i = 0; i < NPVDRECS; i++) {
+        sprintf(name, "pvd:%d", i);
+        sprintf(field, "%s.VAL", name);
+        nFound += !dbFindRecord(&entry, field) &&
+            strcmp(entry.precnode->recordname, name) == 0;
+    }
+    testOk(nFound == NPVDRECS, "Found %d records", nFound);
+
+    for (i = 0; i < NPVDRECS; i += 2) {
+        sprintf(name, "pvd:%d", i);
+        nDeleted += !dbFindRecord(&entry, name) && !dbDeleteRecord(&entry);
+    }
+    testOk(nDeleted == NPVDRECS / 2, "Deleted %d records", nDeleted);
+
+    nFound = 0;
+    for (i = 0; i < NPVDRECS; i++) {
+        sprintf(name, "pvd:%d", i);
+        if (dbFindRecord(&entry, name))
+            nMissing++;
+        else
+            nFound += (i & 1);
+    }
+    testOk(nFound == NPVDRECS / 2 && nMissing == NPVDRECS / 2,
+        "Found %d remaining records, %d deleted ones missing",
+        nFound, nMissing);
+
+    for (i = 1; i < NPVDRECS; i += 2) {
+        sprintf(name, "pvd:%d", i);
+        if (!dbFindRecord(&entry, name))
+            dbDeleteRecord(&entry);
+    }
+    testOk1(dbFindRecord(&entry, "pvd:1") == S_dbLib_recNotFound);
+    testOk1(dbFindRecord(&entry, "testrec") == 0);
+
+    dbFinishEntry(&entry);
+}
+
+/* The name filter is built by iocInit */
+static void testPvdFilter(void)
+{
+    DBENTRY entry;
+    char name[32];
+    int i, nPassed = 0;
+
+    testDiag("testPvdFilter()");
+
+    testOk1(dbChannelMayExist("testrec"));
+    testOk1(dbChannelMayExist("testrec.VAL"));
+    testOk1(dbChannelMayExist("testalias3.{}"));
+
+    for (i = 0; i < 1000; i++) {
+        sprintf(name, "missing:%d.VAL", i);
+        nPassed += dbChannelMayExist(name);
+    }
+    testOk(nPassed < 50, "%d of 1000 missing names passed the filter",
+        nPassed);
+
+    dbInitEntry(pdbbase, &entry);
+    testOk1(dbFindRecord(&entry, "testrec") == 0 &&
+        dbCreateAlias(&entry, "testalias4") == 0);
+    dbFinishEntry(&entry);
+    testOk1(dbChannelMayExist("testalias4.VAL"));
+}
+
 void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
 
 MAIN(dbStaticTest)
 {
-    testPlan(310);
+    testPlan(323);
     testdbPrepare();
 
     testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
@@ -313,6 +401,7 @@ MAIN(dbStaticTest)
     testRec2Entry("testalias");
     testRec2Entry("testalias2");
     testRec2Entry("testalias3");
+    testPvd();
 
     eltc(0);
     testIocInitOk();
@@ -332,6 +421,7 @@ MAIN(dbStaticTest)
     testRec2Entry("testalias3");
 
     testDbVerify("testrec");
+    testPvdFilter();
 
     testIocShutdownOk();
 
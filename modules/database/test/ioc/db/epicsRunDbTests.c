@@ -26,9 +26,12 @@ int dbCaStatsTest(void);
 int dbShutdownTest(void);
 int dbScanTest(void);
 int scanIoTest(void);
+int dbEventSnapshotTest(void);
 int dbLockTest(void);
 int dbPutLinkTest(void);
 int dbStaticTest(void);
+int dbCacheTest(void);
+int dbProcStatsTest(void);
 int dbCaLinkTest(void);
 int testDbChannel(void);
 int chfPluginTest(void);
@@ -48,9 +51,12 @@ void epicsRunDbTests(void)
     runTest(dbShutdownTest);
     runTest(dbScanTest);
     runTest(scanIoTest);
+    runTest(dbEventSnapshotTest);
     runTest(dbLockTest);
     runTest(dbPutLinkTest);
     runTest(dbStaticTest);
+    runTest(dbCacheTest);
+    runTest(dbProcStatsTest);
     runTest(dbCaLinkTest);
     runTest(testDbChannel);
     runTest(arrShorthandTest);
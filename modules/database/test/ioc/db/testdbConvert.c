@@ -6,11 +6,15 @@
 * in file LICENSE that is included with this distribution.
 \*************************************************************************/
 #include "string.h"
+#include "float.h"
 
 #include "cantProceed.h"
 #include "dbConvert.h"
 #include "dbDefs.h"
 #include "epicsAssert.h"
+#include "epicsConvert.h"
+#include "epicsMath.h"
+#include "epicsTypes.h"
 
 #include "epicsUnitTest.h"
 #include "testMain.h"
@@ -149,10 +153,85 @@ static void testBasicPut(void)
     free(scratch);
 }
 
+static void testConvertWrap(void)
+{
+    epicsInt16 field[11];
+    epicsFloat64 buf[11];
+    DBADDR addr;
+    long i;
+    int ok;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.field_type = DBF_SHORT;
+    addr.field_size = sizeof(epicsInt16);
+    addr.no_elements = NELEMENTS(field);
+    addr.pfield = field;
+
+    testDiag("Test SHORT<->DOUBLE conversion of a circular buffer");
+
+    for (i = 0; i < NELEMENTS(field); i++)
+        field[i] = (epicsInt16)(i - 5);
+
+    dbGetConvertRoutine[DBF_SHORT][DBR_DOUBLE](&addr, buf,
+        NELEMENTS(buf), NELEMENTS(field), 7);
+    for (ok = 1, i = 0; i < NELEMENTS(buf); i++)
+        ok &= buf[i] == field[(i + 7) % NELEMENTS(field)];
+    testOk(ok, "Get with wrap at offset 7");
+
+    for (i = 0; i < NELEMENTS(buf); i++)
+        buf[i] = 100.0 + i;
+    dbPutConvertRoutine[DBR_DOUBLE][DBF_SHORT](&addr, buf,
+        NELEMENTS(buf), NELEMENTS(field), 3);
+    for (ok = 1, i = 0; i < NELEMENTS(buf); i++)
+        ok &= field[(i + 3) % NELEMENTS(field)] == 100 + i;
+    testOk(ok, "Put with wrap at offset 3");
+}
+
+static void testDoubleFloat(void)
+{
+    epicsFloat64 input[] = {0.0, -0.0, 1.5, -2.25, 1e300, -1e300,
+        1e-300, -1e-300, FLT_MAX, -FLT_MAX, FLT_MIN, -FLT_MIN,
+        3e38, 4e38, 0.0, 0.0, 0.0};
+    epicsFloat32 output[NELEMENTS(input)];
+    DBADDR addr;
+    long i;
+    int ok;
+
+    input[14] = epicsINF;
+    input[15] = -epicsINF;
+    input[16] = epicsNAN;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.field_type = DBF_DOUBLE;
+    addr.field_size = sizeof(epicsFloat64);
+    addr.no_elements = NELEMENTS(input);
+    addr.pfield = input;
+
+    testDiag("Test DOUBLE->FLOAT conversion saturates");
+
+    for (i = 0; i < NELEMENTS(input); i += 5) {
+        long j;
+
+        memset(output, 0, sizeof(output));
+        dbGetConvertRoutine[DBF_DOUBLE][DBR_FLOAT](&addr, output,
+            NELEMENTS(output), NELEMENTS(input), i);
+        for (ok = 1, j = 0; j < NELEMENTS(output); j++) {
+            epicsFloat64 val = input[(i + j) % NELEMENTS(input)];
+            epicsFloat32 expect = epicsConvertDoubleToFloat(val);
+
+            ok &= isnan(val) ? isnan(output[j]) != 0 :
+                memcmp(&output[j], &expect, sizeof(expect)) == 0;
+        }
+        testOk(ok, "Get at offset %ld matches epicsConvertDoubleToFloat()", i);
+    }
+}
+
 MAIN(testdbConvert)
 {
-    testPlan(15);
+    testPlan(21);
     testBasicGet();
     testBasicPut();
+    testConvertWrap();
+    testDoubleFloat();
     return testDone();
 }
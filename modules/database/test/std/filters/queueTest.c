@@ -0,0 +1,294 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Tests for the queue depth filter and per-subscription event queues
+ */
+
+#include <string.h>
+
+#include "caeventmask.h"
+#include "dbStaticLib.h"
+#include "dbAccessDefs.h"
+#include "db_field_log.h"
+#include "dbCommon.h"
+#include "dbChannel.h"
+#include "dbEvent.h"
+#include "dbLock.h"
+#include "chfPlugin.h"
+#include "epicsEvent.h"
+#include "epicsThread.h"
+#include "errlog.h"
+#include "epicsUnitTest.h"
+#include "dbUnitTest.h"
+#include "testMain.h"
+
+#include "arrRecord.h"
+
+void filterTest_registerRecordDeviceDriver(struct dbBase *);
+
+#define NPOSTS 12
+#define NBURST 100
+#define NSUBS 3
+
+typedef struct subPvt {
+    dbChannel *chan;
+    dbEventSubscription sub;
+    int count;
+    epicsUInt32 value[NPOSTS];
+} subPvt;
+
+static epicsEventId gate, done;
+static int nExpected, nCalls;
+
+static void onBlock(void *user_arg, struct dbChannel *chan,
+    int eventsRemaining, struct db_field_log *pfl)
+{
+    /* Hold the event task until all updates have been posted */
+    epicsEventMustWait(gate);
+}
+
+static void onUpdate(void *user_arg, struct dbChannel *chan,
+    int eventsRemaining, struct db_field_log *pfl)
+{
+    subPvt *pvt = user_arg;
+
+    if (pvt->count < NPOSTS && pfl->type == dbfl_type_val)
+        pvt->value[pvt->count] = (epicsUInt32) pfl->u.v.field.dbf_long;
+    pvt->count++;
+    if (++nCalls == nExpected)
+        epicsEventMustTrigger(done);
+}
+
+static void subscribe(dbEventCtx ctx, subPvt *pvt, const char *name,
+    unsigned depth)
+{
+    memset(pvt, 0, sizeof(*pvt));
+    pvt->chan = dbChannelCreate(name);
+    if (!pvt->chan || dbChannelOpen(pvt->chan))
+        testAbort("Can't open channel '%s'", name);
+    pvt->sub = db_add_event(ctx, pvt->chan, onUpdate, pvt, DBE_VALUE);
+    if (!pvt->sub)
+        testAbort("Can't subscribe to '%s'", name);
+    testOk(((evSubscrip *) pvt->sub)->depth == depth,
+        "'%s' queue depth %u", name, ((evSubscrip *) pvt->sub)->depth);
+    db_event_enable(pvt->sub);
+}
+
+static void unsubscribe(subPvt *pvt)
+{
+    db_cancel_event(pvt->sub);
+    dbChannelDelete(pvt->chan);
+}
+
+static void testParse(void)
+{
+    dbChannel *pch;
+    const chFilterPlugin *plug;
+    char myname[] = "q";
+
+    testDiag("Queue depth filter arguments");
+
+    testOk(!!(plug = dbFindFilter(myname, strlen(myname))),
+        "plugin '%s' registered correctly", myname);
+
+    testOk(!(pch = dbChannelCreate("y.NORD{q:{n:0}}")),
+        "dbChannel with q (n=0) failed");
+    testOk(!(pch = dbChannelCreate("y.NORD{q:{n:2000}}")),
+        "dbChannel with q (n=2000) failed");
+    testOk(!(pch = dbChannelCreate("y.NORD{q:{}}")),
+        "dbChannel with q (no parm) failed");
+
+    testOk(!!(pch = dbChannelCreate("y.NORD{q:{n:8}}")),
+        "dbChannel with q (n=8) created");
+    if (!pch)
+        return;
+    testOk(!dbChannelOpen(pch), "dbChannel with q opened");
+    testOk(pch->queue_depth == 8, "channel queue depth %u",
+        pch->queue_depth);
+    testOk(ellCount(&pch->pre_chain) == 0 && ellCount(&pch->post_chain) == 0,
+        "q adds no filters to the event chains");
+    dbChannelDelete(pch);
+}
+
+static void postNord(arrRecord *prec, epicsUInt32 nord)
+{
+    dbScanLock((dbCommon *) prec);
+    prec->nord = nord;
+    db_post_events(prec, &prec->nord, DBE_VALUE);
+    db_post_events(prec, prec->bptr, DBE_VALUE);
+    dbScanUnlock((dbCommon *) prec);
+}
+
+static void testQueues(void)
+{
+    static const unsigned depths[NSUBS] = {DB_EVENT_QUEUE_DEFAULT, 8, 1};
+    /* The default queue grows to take the burst */
+    static const unsigned kept[NSUBS] = {NPOSTS, 8, 1};
+    static const char *names[NSUBS] = {
+        "y.NORD", "y.NORD{q:{n:8}}", "y.NORD{q:{n:1}}"
+    };
+    subPvt subs[NSUBS], arr;
+    dbChannel *blockChan;
+    dbEventSubscription blockSub;
+    dbEventCtx ctx;
+    arrRecord *prec = (arrRecord *) testdbRecordPtr("y");
+    int i, j;
+
+    testDiag("Per-subscription queue overflow and coalescing");
+
+    ctx = db_init_events();
+    testOk1(db_start_events(ctx, "queueTest", NULL, NULL,
+        epicsThreadPriorityLow) == DB_EVENT_OK);
+
+    blockChan = dbChannelCreate("y.DESC");
+    if (!blockChan || dbChannelOpen(blockChan))
+        testAbort("Can't open channel 'y.DESC'");
+    blockSub = db_add_event(ctx, blockChan, onBlock, NULL, DBE_ALARM);
+    db_event_enable(blockSub);
+
+    for (i = 0; i < NSUBS; i++)
+        subscribe(ctx, &subs[i], names[i], depths[i]);
+    subscribe(ctx, &arr, "y", DB_EVENT_QUEUE_DEFAULT);
+
+    nExpected = NPOSTS + 8 + 1 + 1;
+
+    db_post_single_event(blockSub);
+    for (i = 1; i <= NPOSTS; i++)
+        postNord(prec, i);
+
+    for (i = 0; i < NSUBS; i++) {
+        evSubscrip *pevent = (evSubscrip *) subs[i].sub;
+
+        testOk(pevent->npend == kept[i] &&
+            pevent->nreplace == NPOSTS - kept[i] &&
+            pevent->ncoalesce == 0,
+            "'%s' pending %lu, dropped %lu, coalesced %lu", names[i],
+            pevent->npend, pevent->nreplace, pevent->ncoalesce);
+    }
+    testOk(((evSubscrip *) arr.sub)->npend == 1 &&
+        ((evSubscrip *) arr.sub)->nreplace == 0 &&
+        ((evSubscrip *) arr.sub)->ncoalesce == NPOSTS - 1,
+        "'y' pending %lu, dropped %lu, coalesced %lu",
+        ((evSubscrip *) arr.sub)->npend, ((evSubscrip *) arr.sub)->nreplace,
+        ((evSubscrip *) arr.sub)->ncoalesce);
+    testOk(((evSubscrip *) subs[0].sub)->depth == 16 &&
+        ((evSubscrip *) subs[0].sub)->maxdepth == DB_EVENT_QUEUE_BURST,
+        "'%s' queue grew to %u", names[0], ((evSubscrip *) subs[0].sub)->depth);
+
+    epicsEventMustTrigger(gate);
+    epicsEventMustWait(done);
+
+    for (i = 0; i < NSUBS; i++) {
+        int ok = subs[i].count == (int) kept[i];
+
+        /* The last value queued was replaced by each newer update */
+        for (j = 0; ok && j < subs[i].count; j++) {
+            epicsUInt32 expect = j + 1 < subs[i].count ? j + 1 : NPOSTS;
+
+            ok = subs[i].value[j] == expect;
+        }
+        testOk(ok, "'%s' got %d updates, last %u", names[i], subs[i].count,
+            subs[i].count ? subs[i].value[subs[i].count - 1] : 0);
+    }
+    testOk(arr.count == 1, "'y' got %d update", arr.count);
+    testOk(((evSubscrip *) subs[0].sub)->depth == DB_EVENT_QUEUE_DEFAULT,
+        "'%s' queue shrank to %u once empty", names[0],
+        ((evSubscrip *) subs[0].sub)->depth);
+
+    for (i = 0; i < NSUBS; i++)
+        unsubscribe(&subs[i]);
+    unsubscribe(&arr);
+    db_cancel_event(blockSub);
+    dbChannelDelete(blockChan);
+    db_close_events(ctx);
+}
+
+static void testBudget(void)
+{
+    subPvt subs[2];
+    dbChannel *blockChan;
+    dbEventSubscription blockSub;
+    dbEventCtx ctx;
+    arrRecord *prec = (arrRecord *) testdbRecordPtr("y");
+    evSubscrip *pev0, *pev1;
+    int i;
+
+    testDiag("Queue growth shared by the subscriptions of a client");
+
+    ctx = db_init_events();
+    testOk1(db_start_events(ctx, "queueBudget", NULL, NULL,
+        epicsThreadPriorityLow) == DB_EVENT_OK);
+
+    blockChan = dbChannelCreate("y.DESC");
+    if (!blockChan || dbChannelOpen(blockChan))
+        testAbort("Can't open channel 'y.DESC'");
+    blockSub = db_add_event(ctx, blockChan, onBlock, NULL, DBE_ALARM);
+    db_event_enable(blockSub);
+
+    for (i = 0; i < 2; i++)
+        subscribe(ctx, &subs[i], "y.NORD", DB_EVENT_QUEUE_DEFAULT);
+    pev0 = (evSubscrip *) subs[0].sub;
+    pev1 = (evSubscrip *) subs[1].sub;
+
+    db_post_single_event(blockSub);
+    for (i = 1; i <= NBURST; i++)
+        postNord(prec, i);
+
+    /* Both double to 64, a further doubling would exceed the allowance */
+    testOk(pev0->depth == 64 && pev1->depth == 64 &&
+        pev0->npend == 64 && pev1->npend == 64,
+        "queues grew to %u and %u, holding %lu and %lu updates",
+        pev0->depth, pev1->depth, pev0->npend, pev1->npend);
+
+    nCalls = 0;
+    nExpected = 64 + 64;
+    epicsEventMustTrigger(gate);
+    epicsEventMustWait(done);
+
+    testOk(pev0->depth == DB_EVENT_QUEUE_DEFAULT &&
+        pev1->depth == DB_EVENT_QUEUE_DEFAULT,
+        "queues shrank to %u and %u once empty", pev0->depth, pev1->depth);
+
+    for (i = 0; i < 2; i++)
+        unsubscribe(&subs[i]);
+    db_cancel_event(blockSub);
+    dbChannelDelete(blockChan);
+    db_close_events(ctx);
+}
+
+MAIN(queueTest)
+{
+    testPlan(28);
+
+    gate = epicsEventMustCreate(epicsEventEmpty);
+    done = epicsEventMustCreate(epicsEventEmpty);
+
+    testdbPrepare();
+
+    testdbReadDatabase("filterTest.dbd", NULL, NULL);
+
+    filterTest_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("arrTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testParse();
+    testQueues();
+    testBudget();
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    epicsEventDestroy(gate);
+    epicsEventDestroy(done);
+
+    return testDone();
+}
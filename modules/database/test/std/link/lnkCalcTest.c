@@ -108,6 +108,60 @@ static void testCalc()
         testOk(sevr == MINOR_ALARM, "Alarm severity = MINOR (%d)", sevr);
     }
 
+    testDiag("testing lnkCalc array input");
+
+    {
+        epicsFloat64 arr[8];
+        epicsInt32 i32[8];
+        epicsEnum16 stat, sevr;
+        long nReq, nelm = 0;
+
+        testPutLongStr("io.INPUT", "{calc:{"
+            "expr:'A*B+C',"
+            "major:'VAL>30',"
+            "args:[{const:[1,2,3,4,5]},10,{const:[0.5,0.5,0.5,0.5]}],"
+            "nelm:8"
+            "}}");
+        if (testOk1(pinp->type == JSON_LINK))
+            testDiag("Link was set to '%s'", pinp->value.json.string);
+
+        status = dbGetNelements(pinp, &nelm);
+        testOk(!status && nelm == 8, "dbGetNelements returned %ld", nelm);
+
+        nReq = 8;
+        status = dbGetLink(pinp, DBF_DOUBLE, arr, NULL, &nReq);
+        testOk(!status, "dbGetLink succeeded (status = %ld)", status);
+        testOk(nReq == 4, "Got shortest array length (%ld)", nReq);
+        testOk(arr[0] == 10.5 && arr[1] == 20.5 && arr[3] == 40.5,
+            "Got %g %g %g %g", arr[0], arr[1], arr[2], arr[3]);
+        testOk(recGblResetAlarms(pio) & DBE_ALARM, "Record alarm was raised");
+        status = dbGetAlarm(pinp, &stat, &sevr);
+        testOk(!status && sevr == MAJOR_ALARM,
+            "Alarm severity = MAJOR (%d)", sevr);
+
+        nReq = 2;
+        status = dbGetLink(pinp, DBF_LONG, i32, NULL, &nReq);
+        testOk(!status && nReq == 2, "Got %ld elements", nReq);
+        testOk(i32[0] == 10 && i32[1] == 20, "Got %d %d", i32[0], i32[1]);
+        recGblResetAlarms(pio);
+        status = dbGetAlarm(pinp, &stat, &sevr);
+        testOk(!status && sevr == NO_ALARM,
+            "No alarm for the first elements (%d)", sevr);
+
+        status = dbGetLink(pinp, DBF_DOUBLE, &f64, NULL, NULL);
+        testOk(!status && f64 == 10.5, "Scalar read got %g", f64);
+
+        testPutLongStr("io.INPUT", "{calc:{"
+            "expr:'A+B',"
+            "args:[2,3],"
+            "nelm:8"
+            "}}");
+        nReq = 8;
+        status = dbGetLink(pinp, DBF_DOUBLE, arr, NULL, &nReq);
+        testOk(!status && nReq == 1 && arr[0] == 5.0,
+            "Scalar args give one element (%ld, %g)", nReq, arr[0]);
+    }
+
     testDiag("testing lnkCalc output");
 
     {
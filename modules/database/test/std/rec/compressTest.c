@@ -5,12 +5,16 @@
 * in file LICENSE that is included with this distribution.
 \*************************************************************************/
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "dbUnitTest.h"
 #include "testMain.h"
 #include "dbLock.h"
 #include "errlog.h"
 #include "dbAccess.h"
 #include "epicsMath.h"
+#include "cantProceed.h"
 
 #include "aiRecord.h"
 #include "compressRecord.h"
@@ -346,10 +350,159 @@ void testLIFOCirc(void)
     testdbCleanup();
 }
 
+static
+void processAll(void)
+{
+    static const char *names[] = {"low", "high", "avg", "med", "rmed", "rrms"};
+    unsigned i;
+
+    for (i = 0; i < NELEMENTS(names); i++) {
+        dbCommon *prec = testdbRecordPtr(names[i]);
+
+        dbScanLock(prec);
+        dbProcess(prec);
+        dbScanUnlock(prec);
+    }
+}
+
+/* Compare the last n results of a compress record, oldest first */
+static
+void checkTail(const char *pv, const double *expect, long n, double tol)
+{
+    double *buf = callocMustSucceed(1024, sizeof(double), "checkTail");
+    long nReq = 1024, i;
+    int match;
+    DBADDR addr;
+
+    if (dbNameToAddr(pv, &addr))
+        testAbort("Unknown PV '%s'", pv);
+
+    dbScanLock(addr.precord);
+    if (dbGet(&addr, DBR_DOUBLE, buf, NULL, &nReq, NULL))
+        testAbort("Failed to get '%s'", pv);
+    dbScanUnlock(addr.precord);
+
+    match = nReq >= n;
+    for (i = 0; match && i < n; i++) {
+        double actual = buf[nReq - n + i];
+
+        if (!(fabs(actual - expect[i]) <= tol)) {
+            testDiag("[%ld] -> %f != %f", i, expect[i], actual);
+            match = 0;
+        }
+    }
+    testOk(match, "%s matches %ld results", pv, n);
+    free(buf);
+}
+
+static
+void testArrayAlgs(void)
+{
+    static const double input[] = {5, 1, 4, 2, 0, 0, 0, 9};
+    static const double low[] = {1, 0};
+    static const double high[] = {5, 9};
+    static const double avg[] = {3, 2.25};
+    static const double med[] = {4, 0};
+    static const double rmed[] = {5, 5, 4, 2, 2, 0, 0, 0};
+    double rrms[NELEMENTS(input)];
+    double *wave, *expect;
+    unsigned i, j, k;
+
+    testDiag("Test N to 1 and Running algorithms with array input");
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("compressArrayTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    for (i = 0; i < NELEMENTS(input); i++) {
+        double sumsq = input[i] * input[i];
+
+        if (i > 0)
+            sumsq += input[i - 1] * input[i - 1];
+        rrms[i] = sqrt(sumsq / (i > 0 ? 2 : 1));
+    }
+
+    testdbPutArrFieldOk("wf", DBR_DOUBLE, NELEMENTS(input), input);
+    processAll();
+
+    testdbGetArrFieldEqual("low", DBR_DOUBLE, 4, NELEMENTS(low), low);
+    testdbGetArrFieldEqual("high", DBR_DOUBLE, 4, NELEMENTS(high), high);
+    testdbGetArrFieldEqual("avg", DBR_DOUBLE, 4, NELEMENTS(avg), avg);
+    testdbGetArrFieldEqual("med", DBR_DOUBLE, 4, NELEMENTS(med), med);
+    checkTail("rmed", rmed, NELEMENTS(rmed), 0.0);
+    checkTail("rrms", rrms, NELEMENTS(rrms), 1e-9);
+
+    testDiag("Compare the Running algorithms with sorting every window");
+
+    wave = callocMustSucceed(1024, sizeof(double), "testArrayAlgs");
+    expect = callocMustSucceed(1024, sizeof(double), "testArrayAlgs");
+
+    for (k = 3; k <= 8; k += 5) {
+        double history[8 + 256];
+
+        testdbPutFieldOk("rmed.N", DBF_LONG, k);
+        testdbPutFieldOk("rrms.N", DBF_LONG, k);
+
+        /* Three waveforms follow each other through the same window */
+        for (j = 0; j < 3 * 256; j++) {
+            wave[j % 256] = rand() % 100;
+            history[j % 256 + 8] = wave[j % 256];
+            if (j % 256 != 255)
+                continue;
+
+            testdbPutArrFieldOk("wf", DBR_DOUBLE, 256, wave);
+            processAll();
+
+            for (i = 0; i < 256; i++) {
+                double sorted[8];
+                unsigned n = j < 256 && i + 1 < k ? i + 1 : k, a, b;
+
+                for (a = 0; a < n; a++) {
+                    double v = history[i + 8 - a];
+
+                    for (b = a; b > 0 && sorted[b - 1] > v; b--)
+                        sorted[b] = sorted[b - 1];
+                    sorted[b] = v;
+                }
+                expect[i] = sorted[n / 2];
+            }
+            checkTail("rmed", expect, 256, 0.0);
+
+            for (i = 0; i < 256; i++) {
+                unsigned n = j < 256 && i + 1 < k ? i + 1 : k, a;
+                double sumsq = 0.0;
+
+                for (a = 0; a < n; a++)
+                    sumsq += history[i + 8 - a] * history[i + 8 - a];
+                expect[i] = sqrt(sumsq / n);
+            }
+            checkTail("rrms", expect, 256, 1e-6);
+
+            memcpy(history, history + 256, 8 * sizeof(double));
+        }
+    }
+
+    free(wave);
+    free(expect);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
 MAIN(compressTest)
 {
-    testPlan(116);
+    testPlan(145);
     testFIFOCirc();
     testLIFOCirc();
+    testArrayAlgs();
     return testDone();
 }
@@ -20,6 +20,7 @@ int arrayOpTest(void);
 int asTest(void);
 int linkRetargetLinkTest(void);
 int linkInitTest(void);
+int parallelInitTest(void);
 int asyncSoftTest(void);
 int simmTest(void);
 int mbbioDirectTest(void);
@@ -43,6 +44,8 @@ void epicsRunRecordTests(void)
 
     runTest(linkInitTest);
 
+    runTest(parallelInitTest);
+
     runTest(asyncSoftTest);
 
     runTest(simmTest);
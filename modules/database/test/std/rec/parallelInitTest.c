@@ -0,0 +1,150 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Initialize a database of linked records with and without the
+ * parallel iocInit, and check that both get the same result.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "dbAccess.h"
+#include "dbLock.h"
+#include "dbUnitTest.h"
+#include "epicsStdio.h"
+#include "epicsTempFile.h"
+#include "errlog.h"
+#include "iocInit.h"
+#include "link.h"
+
+#include "aiRecord.h"
+#include "aoRecord.h"
+#include "calcRecord.h"
+#include "longoutRecord.h"
+
+#include "testMain.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+#define NSETS 100
+
+/* Find the iocInitReport line for a record type */
+static int reportLine(FILE *fp, const char *type, char *line, size_t size)
+{
+    size_t len = strlen(type);
+
+    rewind(fp);
+    while (fgets(line, size, fp)) {
+        if (!strncmp(line, type, len) && line[len] == ' ')
+            return 1;
+    }
+    line[0] = 0;
+    return 0;
+}
+
+static void testReport(int serialAo)
+{
+    FILE *fp = epicsTempFile();
+    char line[128], other[128];
+
+    if (!fp) {
+        testAbort("Can't create a temporary file");
+        return;
+    }
+    epicsSetThreadStdout(fp);
+    iocInitReport(0);
+    epicsSetThreadStdout(NULL);
+
+    /* Either type may lead the group, depending on the DBD order */
+    testOk(reportLine(fp, "longin", line, sizeof(line)) &&
+        reportLine(fp, "ai", other, sizeof(other)) &&
+        (strstr(line, " with ai") || strstr(other, " with longin")),
+        "longin shares General Time support with ai: %s", line);
+    if (serialAo)
+        testOk(reportLine(fp, "ao", line, sizeof(line)) &&
+            strstr(line, " serial"), "ao is serial: %s", line);
+    fclose(fp);
+}
+
+static void testInit(int nthreads, int serialAo)
+{
+    unsigned long lockId0 = 0;
+    int i, linksOk = 1, locksOk = 1, valuesOk = 1;
+
+    testDiag("iocInit with iocInitThreads = %d", nthreads);
+    iocInitThreads = nthreads;
+
+    testdbPrepare();
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+    for (i = 0; i < NSETS; i++) {
+        char macros[16];
+
+        sprintf(macros, "N=%d", i);
+        testdbReadDatabase("parallelInitTest.db", NULL, macros);
+    }
+    testdbReadDatabase("parallelInitGroup.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    for (i = 0; i < NSETS; i++) {
+        char name[16];
+        aiRecord *pai;
+        calcRecord *pcalc;
+        aoRecord *pao;
+        longoutRecord *plo;
+        unsigned long lockId;
+
+        sprintf(name, "ai%d", i);
+        pai = (aiRecord *)testdbRecordPtr(name);
+        sprintf(name, "calc%d", i);
+        pcalc = (calcRecord *)testdbRecordPtr(name);
+        sprintf(name, "ao%d", i);
+        pao = (aoRecord *)testdbRecordPtr(name);
+        sprintf(name, "lo%d", i);
+        plo = (longoutRecord *)testdbRecordPtr(name);
+
+        linksOk &= pai->inp.type == DB_LINK && pcalc->inpa.type == DB_LINK &&
+            pao->dol.type == DB_LINK && pao->out.type == DB_LINK;
+
+        lockId = dbLockGetLockId((dbCommon *)pai);
+        locksOk &= lockId == dbLockGetLockId((dbCommon *)pcalc) &&
+            lockId == dbLockGetLockId((dbCommon *)pao) &&
+            lockId == dbLockGetLockId((dbCommon *)plo);
+        if (i == 0)
+            lockId0 = lockId;
+        else
+            locksOk &= lockId != lockId0;
+
+        dbScanLock((dbCommon *)plo);
+        valuesOk &= plo->val == i;
+        dbScanUnlock((dbCommon *)plo);
+    }
+    testOk(linksOk, "All links resolved as DB links");
+    testOk(locksOk, "Each set of linked records shares its own lock set");
+    testOk(valuesOk, "Constant links loaded by init_record pass 1");
+
+    testReport(serialAo);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
+MAIN(parallelInitTest)
+{
+    testPlan(14);
+    testInit(0, 0);
+    iocInitSerialRecordType("ao");
+    iocInitSerialRecordType("ao");
+    testInit(4, 1);
+    testInit(1, 1);
+    iocInitThreads = 0;
+    return testDone();
+}
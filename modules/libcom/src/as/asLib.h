@@ -27,6 +27,16 @@ extern "C" {
  */
 LIBCOM_API extern int asCheckClientIP;
 
+/* Maximum number of access decisions remembered by the decision cache,
+ * which is emptied when it fills up.  Zero disables the cache.
+ * Clients of the same ASG with the same user, host and level share a
+ * decision while the results of the ASG's CALC rules are unchanged.
+ */
+LIBCOM_API extern int asCacheSize;
+/* Decision cache lookups that found and didn't find an entry */
+LIBCOM_API extern unsigned long asCacheHits;
+LIBCOM_API extern unsigned long asCacheMisses;
+
 typedef struct asgMember *ASMEMBERPVT;
 typedef struct asgClient *ASCLIENTPVT;
 typedef int (*ASINPUTFUNCPTR)(char *buf,int max_size);
@@ -30,6 +30,9 @@
 #include "asLib.h"
 
 int asCheckClientIP;
+int asCacheSize = 4096;
+unsigned long asCacheHits;
+unsigned long asCacheMisses;
 
 static epicsMutexId asLock;
 #define LOCK epicsMutexMustLock(asLock)
@@ -42,6 +45,23 @@ int   asActive = FALSE;
 
 static void         *freeListPvt = NULL;
 
+/*
+ * Decision cache. The access a client gets depends only on its ASG,
+ * level, user and host, and on which CALC rules of the ASG currently
+ * pass, so decisions are remembered under a key made from those.
+ * Entries refer to ASGs of the current pasbase, so the cache is
+ * flushed whenever a new configuration is installed.
+ */
+typedef struct asCacheEntry {
+    ELLNODE         node;
+    asAccessRights  access;
+    int             trapMask;
+    char            key[1];
+} ASCACHEENTRY;
+
+static struct gphPvt *asCacheHash = NULL;
+static ELLLIST      asCacheList = ELLLIST_INIT;
+
 
 #define DEFAULT "DEFAULT"
 
@@ -64,6 +84,7 @@ static long asAsgAddRuleOptions(ASGRULE *pasgrule,int trapMask);
 static long asAsgRuleUagAdd(ASGRULE *pasgrule,const char *name);
 static long asAsgRuleHagAdd(ASGRULE *pasgrule,const char *name);
 static long asAsgRuleCalc(ASGRULE *pasgrule,const char *calc);
+static void asCacheFlush(void);
 
 /*
   asInitialize can be called while access security is already active.
@@ -652,6 +673,15 @@ int epicsStdCall asDumpFP(
         if(print_end_brace) fprintf(fp,"}\n");
         pasg = (ASG *)ellNext(&pasg->node);
     }
+    if(verbose) {
+        unsigned long lookups = asCacheHits + asCacheMisses;
+
+        fprintf(fp,"Decision cache: %d entries, %lu hits, %lu misses",
+            ellCount(&asCacheList), asCacheHits, asCacheMisses);
+        if(lookups)
+            fprintf(fp,", hit ratio %.1f%%",100.0 * asCacheHits / lookups);
+        fprintf(fp,"\n");
+    }
     return(0);
 }
 
@@ -974,24 +1004,55 @@ static long asComputeAsgPvt(ASG *pasg)
     return(0);
 }
 
-static long asComputePvt(ASCLIENTPVT asClientPvt)
+static void asCacheFlush(void)
+{
+    ELLNODE     *pnode;
+
+    if(asCacheHash) {
+        gphFreeMem(asCacheHash);
+        asCacheHash = NULL;
+    }
+    while((pnode = ellGet(&asCacheList)))
+        free(pnode);
+}
+
+/*
+ * Build the cache key for a client. Returns FALSE if the key would not
+ * fit, in which case the decision is computed without the cache.
+ */
+static int asCacheKey(char *key, size_t size, ASG *pasg, ASGCLIENT *pasgclient)
+{
+    ASGRULE     *pasgrule;
+    size_t      len;
+    int         n;
+
+    n = epicsSnprintf(key, size, "%d:%u:", pasgclient->level,
+        (unsigned) strlen(pasgclient->user));
+    if(n < 0 || (size_t) n >= size) return(FALSE);
+    len = n;
+    /*One character per CALC rule, '1' if the rule passes*/
+    pasgrule = (ASGRULE *)ellFirst(&pasg->ruleList);
+    while(pasgrule) {
+        if(pasgrule->calc) {
+            if(len + 1 >= size) return(FALSE);
+            key[len++] = (!(pasg->inpBad & pasgrule->inpUsed)
+                && (pasgrule->result==1)) ? '1' : '0';
+        }
+        pasgrule = (ASGRULE *)ellNext(&pasgrule->node);
+    }
+    n = epicsSnprintf(key + len, size - len, ":%s%s",
+        pasgclient->user, pasgclient->host);
+    return(n >= 0 && (size_t) n < size - len);
+}
+
+static void asComputeRules(ASG *pasg, ASGCLIENT *pasgclient,
+    asAccessRights *paccess, int *ptrapMask)
 {
     asAccessRights      access=asNOACCESS;
     int                 trapMask=0;
-    ASGCLIENT           *pasgclient = asClientPvt;
-    ASGMEMBER           *pasgMember;
-    ASG                 *pasg;
     ASGRULE             *pasgrule;
-    asAccessRights      oldaccess;
     GPHENTRY            *pgphentry;
 
-    if(!asActive) return(S_asLib_asNotActive);
-    if(!pasgclient) return(S_asLib_badClient);
-    pasgMember = pasgclient->pasgMember;
-    if(!pasgMember) return(S_asLib_badMember);
-    pasg = pasgMember->pasg;
-    if(!pasg) return(S_asLib_badAsg);
-    oldaccess=pasgclient->access;
     pasgrule = (ASGRULE *)ellFirst(&pasg->ruleList);
     while(pasgrule) {
         if(access == asWRITE) break;
@@ -1037,6 +1098,60 @@ check_calc:
 next_rule:
         pasgrule = (ASGRULE *)ellNext(&pasgrule->node);
     }
+    *paccess = access;
+    *ptrapMask = trapMask;
+}
+
+static long asComputePvt(ASCLIENTPVT asClientPvt)
+{
+    asAccessRights      access=asNOACCESS;
+    int                 trapMask=0;
+    ASGCLIENT           *pasgclient = asClientPvt;
+    ASGMEMBER           *pasgMember;
+    ASG                 *pasg;
+    asAccessRights      oldaccess;
+    GPHENTRY            *pgphentry = NULL;
+    ASCACHEENTRY        *pentry;
+    char                key[256];
+
+    if(!asActive) return(S_asLib_asNotActive);
+    if(!pasgclient) return(S_asLib_badClient);
+    pasgMember = pasgclient->pasgMember;
+    if(!pasgMember) return(S_asLib_badMember);
+    pasg = pasgMember->pasg;
+    if(!pasg) return(S_asLib_badAsg);
+    oldaccess=pasgclient->access;
+    if(asCacheSize <= 0
+    || !asCacheKey(key, sizeof(key), pasg, pasgclient)) {
+        asComputeRules(pasg, pasgclient, &access, &trapMask);
+        goto done;
+    }
+    if(asCacheHash)
+        pgphentry = gphFind(asCacheHash, key, pasg);
+    if(pgphentry) {
+        pentry = pgphentry->userPvt;
+        access = pentry->access;
+        trapMask = pentry->trapMask;
+        asCacheHits++;
+        goto done;
+    }
+    asCacheMisses++;
+    asComputeRules(pasg, pasgclient, &access, &trapMask);
+    if(ellCount(&asCacheList) >= asCacheSize) asCacheFlush();
+    if(!asCacheHash) gphInitPvt(&asCacheHash, 1024);
+    pentry = malloc(sizeof(ASCACHEENTRY) + strlen(key));
+    if(!pentry) goto done;
+    strcpy(pentry->key, key);
+    pentry->access = access;
+    pentry->trapMask = trapMask;
+    pgphentry = gphAdd(asCacheHash, pentry->key, pasg);
+    if(!pgphentry) {
+        free(pentry);
+        goto done;
+    }
+    pgphentry->userPvt = pentry;
+    ellAdd(&asCacheList, &pentry->node);
+done:
     pasgclient->access = access;
     pasgclient->trapMask = trapMask;
     if(pasgclient->pcallback && oldaccess!=access) {
@@ -1058,6 +1173,12 @@ void asFreeAll(ASBASE *pasbase)
     ASGUAG      *pasguag;
     void        *pnext;
 
+    /* Cached decisions may refer to the ASGs being freed */
+    if(asLock) {
+        LOCK;
+        asCacheFlush();
+        UNLOCK;
+    }
     puag = (UAG *)ellFirst(&pasbase->uagList);
     while(puag) {
         puagname = (UAGNAME *)ellFirst(&puag->list);
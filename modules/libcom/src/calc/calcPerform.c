@@ -49,6 +49,7 @@ LIBCOM_API long
     double *ptop;                       /* stack pointer */
     double top;                         /* value from top of stack */
     epicsInt32 itop;                    /* integer from top of stack */
+    epicsUInt16 offset;                 /* conditional jump distance */
     int op;
     int nargs;
 
@@ -385,6 +386,18 @@ LIBCOM_API long
         case COND_END:
             break;
 
+        case COND_IF_JUMP:
+            memcpy(&offset, pinst, sizeof(epicsUInt16));
+            pinst += sizeof(epicsUInt16);
+            if (*ptop-- == 0.0)
+                pinst += offset;
+            break;
+
+        case COND_ELSE_JUMP:
+            memcpy(&offset, pinst, sizeof(epicsUInt16));
+            pinst += sizeof(epicsUInt16) + offset;
+            break;
+
         default:
             errlogPrintf("calcPerform: Bad Opcode %d at %p\n", op, pinst-1);
             return -1;
@@ -398,6 +411,464 @@ LIBCOM_API long
     return 0;
 }
 
+/* calcPerformArray
+ *
+ * Evaluate the postfix expression for every element of the input arrays.
+ * Expressions that the optimizer has compiled are evaluated CALC_BLOCK
+ * elements at a time, with each instruction working through the whole
+ * block in a simple loop that the compiler can vectorize. Both branches
+ * of a conditional are evaluated, then the condition selects between
+ * them for each element. Other expressions fall back to calcPerform().
+ */
+#define CALC_BLOCK 64
+
+/* Maximum number of stack entries the expression could need when it is
+ * evaluated in blocks, or zero if it can't be.
+ */
+static int block_depth(const char *pinst)
+{
+    int depth = 0;
+    int op;
+
+    while ((op = *pinst++) != END_EXPRESSION) {
+        switch (op) {
+        case LITERAL_DOUBLE:
+            pinst += sizeof(double);
+            depth++;
+            break;
+        case LITERAL_INT:
+            pinst += sizeof(epicsInt32);
+            depth++;
+            break;
+        case MIN:
+        case MAX:
+        case FINITE:
+        case ISNAN:
+            pinst++;
+            break;
+        case COND_IF_JUMP:
+        case COND_ELSE_JUMP:
+            pinst += sizeof(epicsUInt16);
+            break;
+
+        /* Unoptimized conditionals have no branch offsets, and random
+         * numbers must be generated in the same order as calcPerform()
+         */
+        case COND_IF:
+        case COND_ELSE:
+        case COND_END:
+        case RANDOM:
+            return 0;
+
+        case FETCH_VAL:
+        case FETCH_A:
+        case FETCH_B:
+        case FETCH_C:
+        case FETCH_D:
+        case FETCH_E:
+        case FETCH_F:
+        case FETCH_G:
+        case FETCH_H:
+        case FETCH_I:
+        case FETCH_J:
+        case FETCH_K:
+        case FETCH_L:
+        case CONST_PI:
+        case CONST_D2R:
+        case CONST_R2D:
+            depth++;
+            break;
+        }
+    }
+    return depth;
+}
+
+static double array_arg(const double **pargs, const unsigned long *pcounts,
+    int i, unsigned long j)
+{
+    if (!pargs[i])
+        return 0.0;
+    if (pcounts && pcounts[i] == 1)
+        return pargs[i][0];
+    return pargs[i][j];
+}
+
+#define BLOCK_TOP(k) (stack + (top - (k)) * CALC_BLOCK)
+
+#define BLOCK_PUSH(value) \
+    px = BLOCK_TOP(-1); \
+    top++; \
+    for (i = 0; i < m; i++) \
+        px[i] = (value); \
+    break
+
+#define BLOCK_UNARY(expr) \
+    px = BLOCK_TOP(0); \
+    for (i = 0; i < m; i++) { \
+        double x = px[i]; \
+        px[i] = (expr); \
+    } \
+    break
+
+#define BLOCK_BINARY(expr) \
+    py = BLOCK_TOP(0); \
+    px = BLOCK_TOP(1); \
+    top--; \
+    for (i = 0; i < m; i++) { \
+        double x = px[i]; \
+        double y = py[i]; \
+        px[i] = (expr); \
+    } \
+    break
+
+/* Evaluate one block of m elements starting at element base */
+static long calc_block(const char *pinst, const double **pargs,
+    const unsigned long *pcounts, unsigned long base, int m,
+    double *stack, double *stores, double *presult)
+{
+    const char *ends[CALCPERFORM_STACK];    /* where to select a branch */
+    int nends = 0;
+    int top = -1;                           /* index of top entry */
+    unsigned stored = 0;                    /* args assigned so far */
+    epicsUInt16 offset;
+    epicsInt32 itop;
+    double lit;
+    double *px, *py;
+    int op, nargs, i, k;
+
+    while ((op = *pinst++) != END_EXPRESSION) {
+        switch (op) {
+
+        case LITERAL_DOUBLE:
+            memcpy(&lit, pinst, sizeof(double));
+            pinst += sizeof(double);
+            BLOCK_PUSH(lit);
+
+        case LITERAL_INT:
+            memcpy(&itop, pinst, sizeof(epicsInt32));
+            pinst += sizeof(epicsInt32);
+            BLOCK_PUSH(itop);
+
+        case FETCH_VAL:
+            px = BLOCK_TOP(-1);
+            top++;
+            memcpy(px, presult, m * sizeof(double));
+            break;
+
+        case FETCH_A:
+        case FETCH_B:
+        case FETCH_C:
+        case FETCH_D:
+        case FETCH_E:
+        case FETCH_F:
+        case FETCH_G:
+        case FETCH_H:
+        case FETCH_I:
+        case FETCH_J:
+        case FETCH_K:
+        case FETCH_L:
+            k = op - FETCH_A;
+            px = BLOCK_TOP(-1);
+            top++;
+            if (stored & (1u << k))
+                memcpy(px, stores + k * CALC_BLOCK, m * sizeof(double));
+            else if (pargs[k] && !(pcounts && pcounts[k] == 1))
+                memcpy(px, pargs[k] + base, m * sizeof(double));
+            else {
+                lit = array_arg(pargs, pcounts, k, 0);
+                for (i = 0; i < m; i++)
+                    px[i] = lit;
+            }
+            break;
+
+        case STORE_A:
+        case STORE_B:
+        case STORE_C:
+        case STORE_D:
+        case STORE_E:
+        case STORE_F:
+        case STORE_G:
+        case STORE_H:
+        case STORE_I:
+        case STORE_J:
+        case STORE_K:
+        case STORE_L:
+            k = op - STORE_A;
+            memcpy(stores + k * CALC_BLOCK, BLOCK_TOP(0), m * sizeof(double));
+            stored |= 1u << k;
+            top--;
+            break;
+
+        case CONST_PI:
+            BLOCK_PUSH(PI);
+
+        case CONST_D2R:
+            BLOCK_PUSH(PI/180.);
+
+        case CONST_R2D:
+            BLOCK_PUSH(180./PI);
+
+        case UNARY_NEG:
+            BLOCK_UNARY(-x);
+
+        case ADD:
+            BLOCK_BINARY(x + y);
+
+        case SUB:
+            BLOCK_BINARY(x - y);
+
+        case MULT:
+            BLOCK_BINARY(x * y);
+
+        case DIV:
+            BLOCK_BINARY(x / y);
+
+        case MODULO:
+            BLOCK_BINARY((epicsInt32) y ?
+                (double) ((epicsInt32) x % (epicsInt32) y) : epicsNAN);
+
+        case POWER:
+            BLOCK_BINARY(pow(x, y));
+
+        case ABS_VAL:
+            BLOCK_UNARY(fabs(x));
+
+        case EXP:
+            BLOCK_UNARY(exp(x));
+
+        case LOG_10:
+            BLOCK_UNARY(log10(x));
+
+        case LOG_E:
+            BLOCK_UNARY(log(x));
+
+        case MAX:
+            nargs = *pinst++;
+            while (--nargs) {
+                py = BLOCK_TOP(0);
+                px = BLOCK_TOP(1);
+                top--;
+                for (i = 0; i < m; i++) {
+                    if (px[i] < py[i] || isnan(py[i]))
+                        px[i] = py[i];
+                }
+            }
+            break;
+
+        case MIN:
+            nargs = *pinst++;
+            while (--nargs) {
+                py = BLOCK_TOP(0);
+                px = BLOCK_TOP(1);
+                top--;
+                for (i = 0; i < m; i++) {
+                    if (px[i] > py[i] || isnan(py[i]))
+                        px[i] = py[i];
+                }
+            }
+            break;
+
+        case SQU_RT:
+            BLOCK_UNARY(sqrt(x));
+
+        case ACOS:
+            BLOCK_UNARY(acos(x));
+
+        case ASIN:
+            BLOCK_UNARY(asin(x));
+
+        case ATAN:
+            BLOCK_UNARY(atan(x));
+
+        case ATAN2:
+            BLOCK_BINARY(atan2(y, x));  /* Args backwards, as above */
+
+        case COS:
+            BLOCK_UNARY(cos(x));
+
+        case SIN:
+            BLOCK_UNARY(sin(x));
+
+        case TAN:
+            BLOCK_UNARY(tan(x));
+
+        case COSH:
+            BLOCK_UNARY(cosh(x));
+
+        case SINH:
+            BLOCK_UNARY(sinh(x));
+
+        case TANH:
+            BLOCK_UNARY(tanh(x));
+
+        case CEIL:
+            BLOCK_UNARY(ceil(x));
+
+        case FLOOR:
+            BLOCK_UNARY(floor(x));
+
+        case FINITE:
+            nargs = *pinst++;
+            px = BLOCK_TOP(nargs - 1);
+            for (i = 0; i < m; i++) {
+                int all = 1;
+
+                for (k = 0; k < nargs; k++)
+                    all = all && finite(BLOCK_TOP(k)[i]);
+                px[i] = all;
+            }
+            top -= nargs - 1;
+            break;
+
+        case ISINF:
+            BLOCK_UNARY(isinf(x));
+
+        case ISNAN:
+            nargs = *pinst++;
+            px = BLOCK_TOP(nargs - 1);
+            for (i = 0; i < m; i++) {
+                int any = 0;
+
+                for (k = 0; k < nargs; k++)
+                    any = any || isnan(BLOCK_TOP(k)[i]);
+                px[i] = any;
+            }
+            top -= nargs - 1;
+            break;
+
+        case NINT:
+            BLOCK_UNARY((epicsInt32) (x >= 0 ? x + 0.5 : x - 0.5));
+
+        case REL_OR:
+            BLOCK_BINARY(x || y);
+
+        case REL_AND:
+            BLOCK_BINARY(x && y);
+
+        case REL_NOT:
+            BLOCK_UNARY(!x);
+
+        case BIT_OR:
+            BLOCK_BINARY((double)(d2i(x) | d2i(y)));
+
+        case BIT_AND:
+            BLOCK_BINARY((double)(d2i(x) & d2i(y)));
+
+        case BIT_EXCL_OR:
+            BLOCK_BINARY((double)(d2i(x) ^ d2i(y)));
+
+        case BIT_NOT:
+            BLOCK_UNARY((double)~d2i(x));
+
+        case RIGHT_SHIFT_ARITH:
+            BLOCK_BINARY((double)(d2i(x) >> (d2i(y) & 31)));
+
+        case LEFT_SHIFT_ARITH:
+            BLOCK_BINARY((double)(d2i(x) << (d2i(y) & 31)));
+
+        case RIGHT_SHIFT_LOGIC:
+            BLOCK_BINARY((double)(d2ui(x) >> (d2ui(y) & 31u)));
+
+        case NOT_EQ:
+            BLOCK_BINARY(x != y);
+
+        case LESS_THAN:
+            BLOCK_BINARY(x < y);
+
+        case LESS_OR_EQ:
+            BLOCK_BINARY(x <= y);
+
+        case EQUAL:
+            BLOCK_BINARY(x == y);
+
+        case GR_OR_EQ:
+            BLOCK_BINARY(x >= y);
+
+        case GR_THAN:
+            BLOCK_BINARY(x > y);
+
+        case COND_IF_JUMP:
+            /* Keep the condition, evaluate the true branch */
+            pinst += sizeof(epicsUInt16);
+            break;
+
+        case COND_ELSE_JUMP:
+            /* Keep the true value, evaluate the false branch */
+            if (nends == CALCPERFORM_STACK)
+                return -1;
+            memcpy(&offset, pinst, sizeof(epicsUInt16));
+            pinst += sizeof(epicsUInt16);
+            ends[nends++] = pinst + offset;
+            break;
+
+        default:
+            errlogPrintf("calcPerformArray: Bad Opcode %d at %p\n",
+                op, pinst-1);
+            return -1;
+        }
+
+        /* Select the branch for each element at the end of a conditional */
+        while (nends && pinst == ends[nends - 1]) {
+            double *pcond = BLOCK_TOP(2);
+            double *ptrue = BLOCK_TOP(1);
+            double *pfalse = BLOCK_TOP(0);
+
+            for (i = 0; i < m; i++)
+                pcond[i] = pcond[i] != 0.0 ? ptrue[i] : pfalse[i];
+            top -= 2;
+            nends--;
+        }
+    }
+
+    if (top != 0)
+        return -1;
+    memcpy(presult, stack, m * sizeof(double));
+    return 0;
+}
+
+LIBCOM_API long
+    calcPerformArray(const double **pargs, const unsigned long *pcounts,
+        double *presults, unsigned long n, const char *pinst)
+{
+    int depth = block_depth(pinst);
+    double *stack = NULL;
+    unsigned long base;
+    int i;
+
+    for (i = 0; i < CALCPERFORM_NARGS; i++) {
+        if (pargs[i] && pcounts && pcounts[i] != 1 && pcounts[i] < n)
+            return -1;
+    }
+
+    if (depth > 0)
+        stack = malloc((depth + CALCPERFORM_NARGS) * CALC_BLOCK *
+            sizeof(double));
+
+    if (!stack) {
+        double args[CALCPERFORM_NARGS];
+
+        for (base = 0; base < n; base++) {
+            for (i = 0; i < CALCPERFORM_NARGS; i++)
+                args[i] = array_arg(pargs, pcounts, i, base);
+            if (calcPerform(args, &presults[base], pinst))
+                return -1;
+        }
+        return 0;
+    }
+
+    for (base = 0; base < n; base += CALC_BLOCK) {
+        int m = n - base < CALC_BLOCK ? (int) (n - base) : CALC_BLOCK;
+
+        if (calc_block(pinst, pargs, pcounts, base, m, stack,
+                stack + depth * CALC_BLOCK, presults + base)) {
+            free(stack);
+            return -1;
+        }
+    }
+    free(stack);
+    return 0;
+}
+
 #if defined(_WIN32) && defined(_M_X64) && !defined(_MINGW)
 #  pragma optimize("", on)
 #endif
@@ -423,6 +894,10 @@ calcArgUsage(const char *pinst, unsigned long *pinputs, unsigned long *pstores)
         case ISNAN:
             pinst++;
             break;
+        case COND_IF_JUMP:
+        case COND_ELSE_JUMP:
+            pinst += sizeof(epicsUInt16);
+            break;
 
         case FETCH_A:
         case FETCH_B:
@@ -510,6 +985,10 @@ static int cond_search(const char **ppinst, int match)
         case ISNAN:
             pinst++;
             break;
+        case COND_IF_JUMP:
+        case COND_ELSE_JUMP:
+            pinst += sizeof(epicsUInt16);
+            break;
         case COND_IF:
             count++;
             break;
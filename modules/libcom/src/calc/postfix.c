@@ -15,6 +15,7 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
@@ -26,6 +27,7 @@
 #include "postfix.h"
 #include "postfixPvt.h"
 #include "libComAPI.h"
+#include "epicsExport.h"
 
 
 /* declarations for postfix */
@@ -202,6 +204,461 @@ static int
 }
 
 
+/* The optimizer
+ *
+ * Rewrites the byte-code that postfix() generated, evaluating the
+ * sub-expressions whose operands are all constants, dropping the
+ * branches that constant conditions can never select and turning the
+ * remaining conditionals into forward jumps. It keeps a stack that
+ * mirrors the run-time stack, recording where the code for each entry
+ * starts and whether its value is already known. The expression is only
+ * replaced if the whole rewrite succeeds.
+ */
+int postfixOptimize = 1;
+epicsExportAddress(int, postfixOptimize);
+
+#define OPT_MAX_CONDS CALCPERFORM_STACK
+
+typedef struct {
+    size_t start;       /* offset of the first instruction for this value */
+    int known;          /* value is a compile-time constant */
+    double value;
+} opt_value;
+
+typedef enum {
+    OPT_COND_DYNAMIC,
+    OPT_COND_TRUE,
+    OPT_COND_FALSE
+} opt_cond_type;
+
+typedef struct {
+    size_t start;       /* offset of the condition's code */
+    size_t patch;       /* offset of the jump still to be resolved */
+    size_t mark;        /* offset where an unused false branch starts */
+    opt_cond_type type;
+    int in_else;        /* the COND_ELSE has been seen */
+    int pending;        /* COND_ENDs of nested conditionals still to come */
+} opt_cond;
+
+typedef struct {
+    char *pout;
+    size_t len;
+    size_t size;
+    opt_value stack[CALCPERFORM_STACK + 1];
+    int depth;
+    opt_cond conds[OPT_MAX_CONDS];
+    int nconds;
+    int skip;           /* COND_ENDs to ignore */
+} optimizer;
+
+/* Length of the instruction at pinst, including any inline data */
+static size_t inst_length(const char *pinst)
+{
+    switch (*pinst) {
+    case LITERAL_DOUBLE:
+        return 1 + sizeof(double);
+    case LITERAL_INT:
+        return 1 + sizeof(epicsInt32);
+    case MIN:
+    case MAX:
+    case FINITE:
+    case ISNAN:
+        return 2;
+    case COND_IF_JUMP:
+    case COND_ELSE_JUMP:
+        return 1 + sizeof(epicsUInt16);
+    default:
+        return 1;
+    }
+}
+
+/* Number of run-time stack entries the operator at pinst consumes */
+static int inst_operands(const char *pinst)
+{
+    switch (*pinst) {
+    case MIN:
+    case MAX:
+    case FINITE:
+    case ISNAN:
+        return pinst[1];
+    case ADD:
+    case SUB:
+    case MULT:
+    case DIV:
+    case MODULO:
+    case POWER:
+    case ATAN2:
+    case REL_OR:
+    case REL_AND:
+    case BIT_OR:
+    case BIT_AND:
+    case BIT_EXCL_OR:
+    case RIGHT_SHIFT_ARITH:
+    case LEFT_SHIFT_ARITH:
+    case RIGHT_SHIFT_LOGIC:
+    case NOT_EQ:
+    case LESS_THAN:
+    case LESS_OR_EQ:
+    case EQUAL:
+    case GR_OR_EQ:
+    case GR_THAN:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+static int opt_emit(optimizer *popt, const void *pdata, size_t len)
+{
+    if (popt->len + len > popt->size)
+        return -1;
+    memcpy(popt->pout + popt->len, pdata, len);
+    popt->len += len;
+    return 0;
+}
+
+static int opt_push(optimizer *popt, size_t start, int known, double value)
+{
+    opt_value *pval;
+
+    if (popt->depth >= CALCPERFORM_STACK)
+        return -1;
+    pval = &popt->stack[++popt->depth];
+    pval->start = start;
+    pval->known = known;
+    pval->value = value;
+    return 0;
+}
+
+/* Point the jump at offset patch to the current end of the code */
+static int opt_patch(optimizer *popt, size_t patch)
+{
+    size_t skip = popt->len - patch - sizeof(epicsUInt16);
+    epicsUInt16 offset = (epicsUInt16) skip;
+
+    if (offset != skip)
+        return -1;
+    memcpy(popt->pout + patch, &offset, sizeof(epicsUInt16));
+    return 0;
+}
+
+/* Replace the code for a constant with the shortest literal */
+static int opt_literal(optimizer *popt, size_t start, double value)
+{
+    epicsInt32 lit_i = (epicsInt32) value;
+    char op;
+
+    popt->len = start;
+    if (value == (double) lit_i && !(value == 0 && 1 / value < 0)) {
+        op = LITERAL_INT;
+        if (opt_emit(popt, &op, 1) ||
+            opt_emit(popt, &lit_i, sizeof(epicsInt32)))
+            return -1;
+    } else {
+        op = LITERAL_DOUBLE;
+        if (opt_emit(popt, &op, 1) ||
+            opt_emit(popt, &value, sizeof(double)))
+            return -1;
+    }
+    return opt_push(popt, start, TRUE, value);
+}
+
+/* Evaluate an operator whose operands are all known, using the same
+ * code as at run-time so the results can't differ.
+ */
+static int opt_fold(optimizer *popt, const char *pinst, int nargs)
+{
+    char code[CALCPERFORM_STACK * (1 + sizeof(double)) + 3];
+    double args[CALCPERFORM_NARGS];
+    double result = 0;
+    opt_value *pval = &popt->stack[popt->depth - nargs + 1];
+    char *pcode = code;
+    int i;
+
+    for (i = 0; i < nargs; i++) {
+        *pcode++ = LITERAL_DOUBLE;
+        memcpy(pcode, &pval[i].value, sizeof(double));
+        pcode += sizeof(double);
+    }
+    memcpy(pcode, pinst, inst_length(pinst));
+    pcode += inst_length(pinst);
+    *pcode = END_EXPRESSION;
+
+    if (calcPerform(args, &result, code))
+        return -1;
+    popt->depth -= nargs;
+    return opt_literal(popt, pval->start, result);
+}
+
+/* Value of a constant operand such as PI */
+static double opt_constant(const char *pinst)
+{
+    char code[2];
+    double args[CALCPERFORM_NARGS];
+    double value = 0;
+
+    code[0] = *pinst;
+    code[1] = END_EXPRESSION;
+    calcPerform(args, &value, code);
+    return value;
+}
+
+static int opt_operator(optimizer *popt, const char *pinst)
+{
+    int nargs = inst_operands(pinst);
+    size_t start;
+    int i, known = TRUE;
+
+    if (nargs < 1 || nargs > popt->depth)
+        return -1;
+    for (i = 0; i < nargs; i++)
+        known = known && popt->stack[popt->depth - i].known;
+    if (known)
+        return opt_fold(popt, pinst, nargs);
+
+    start = popt->stack[popt->depth - nargs + 1].start;
+    popt->depth -= nargs;
+    if (opt_emit(popt, pinst, inst_length(pinst)))
+        return -1;
+    return opt_push(popt, start, FALSE, 0);
+}
+
+/* Conditionals
+ *
+ * A branch that a constant condition can't select is compiled as usual,
+ * then the code it generated is discarded when the branch ends. The end
+ * of a false branch isn't always marked by its own COND_END; postfix()
+ * only generates that once the enclosing expression is complete, so in
+ * "a ? b ? c : d : e" both COND_ENDs come after e. The false branch of
+ * the inner conditional ends at the outer COND_ELSE instead, and its
+ * COND_END is ignored when it turns up.
+ */
+static int opt_cond_if(optimizer *popt)
+{
+    opt_value *pval;
+    opt_cond *pcond;
+    char op = COND_IF_JUMP;
+    epicsUInt16 offset = 0;
+
+    if (popt->depth < 1 || popt->nconds >= OPT_MAX_CONDS)
+        return -1;
+    pval = &popt->stack[popt->depth--];
+    pcond = &popt->conds[popt->nconds++];
+    pcond->start = pval->start;
+    pcond->in_else = FALSE;
+    pcond->pending = 0;
+
+    if (pval->known) {
+        popt->len = pval->start;
+        pcond->type = pval->value != 0.0 ? OPT_COND_TRUE : OPT_COND_FALSE;
+        return 0;
+    }
+    pcond->type = OPT_COND_DYNAMIC;
+    if (opt_emit(popt, &op, 1))
+        return -1;
+    pcond->patch = popt->len;
+    return opt_emit(popt, &offset, sizeof(epicsUInt16));
+}
+
+/* End the false branch of the innermost conditional, returns the number
+ * of COND_ENDs that are still to come for it, or -1 on error.
+ */
+static int opt_cond_close(optimizer *popt)
+{
+    opt_cond *pcond = &popt->conds[popt->nconds - 1];
+
+    if (!pcond->in_else || popt->depth < 1)
+        return -1;
+
+    switch (pcond->type) {
+    case OPT_COND_DYNAMIC:
+        if (opt_patch(popt, pcond->patch))
+            return -1;
+        popt->depth--;
+        if (opt_push(popt, pcond->start, FALSE, 0))
+            return -1;
+        break;
+
+    case OPT_COND_TRUE:
+        /* Discard the false branch, the true value is under it */
+        popt->depth--;
+        popt->len = pcond->mark;
+        break;
+
+    case OPT_COND_FALSE:
+        break;
+    }
+    popt->nconds--;
+    return pcond->pending;
+}
+
+static int opt_cond_else(optimizer *popt)
+{
+    char op = COND_ELSE_JUMP;
+    epicsUInt16 offset = 0;
+    opt_cond *pcond;
+
+    if (popt->nconds < 1)
+        return -1;
+
+    /* This also ends any nested conditionals' false branches */
+    while (popt->conds[popt->nconds - 1].in_else) {
+        int pending = opt_cond_close(popt);
+
+        if (pending < 0 || popt->nconds < 1)
+            return -1;
+        popt->conds[popt->nconds - 1].pending += 1 + pending;
+    }
+    pcond = &popt->conds[popt->nconds - 1];
+    pcond->in_else = TRUE;
+    if (popt->depth < 1)
+        return -1;
+
+    switch (pcond->type) {
+    case OPT_COND_DYNAMIC:
+        popt->depth--;
+        if (opt_emit(popt, &op, 1) ||
+            opt_emit(popt, &offset, sizeof(epicsUInt16)) ||
+            opt_patch(popt, pcond->patch))
+            return -1;
+        pcond->patch = popt->len - sizeof(epicsUInt16);
+        break;
+
+    case OPT_COND_TRUE:
+        pcond->mark = popt->len;
+        break;
+
+    case OPT_COND_FALSE:
+        /* Discard the true branch */
+        popt->depth--;
+        popt->len = pcond->start;
+        break;
+    }
+    return 0;
+}
+
+static int opt_cond_end(optimizer *popt)
+{
+    int pending;
+
+    if (popt->skip > 0) {
+        popt->skip--;
+        return 0;
+    }
+    if (popt->nconds < 1)
+        return -1;
+    pending = opt_cond_close(popt);
+    if (pending < 0)
+        return -1;
+    popt->skip += pending;
+    return 0;
+}
+
+/* Optimize the expression in pdest in place. Returns non-zero and leaves
+ * the expression alone if it can't be done in size bytes.
+ */
+static int optimize(char *pdest, size_t size)
+{
+    optimizer *popt = malloc(sizeof(optimizer));
+    const char *pinst = pdest;
+    int status = -1;
+    int op;
+
+    if (!popt)
+        return -1;
+    popt->pout = malloc(size);
+    if (!popt->pout)
+        goto done;
+    popt->len = 0;
+    popt->size = size;
+    popt->depth = 0;
+    popt->nconds = 0;
+    popt->skip = 0;
+
+    while ((op = *pinst) != END_EXPRESSION) {
+        size_t len = inst_length(pinst);
+        size_t start = popt->len;
+        epicsInt32 lit_i;
+        double lit_d;
+        int fail;
+
+        switch (op) {
+        case LITERAL_DOUBLE:
+            memcpy(&lit_d, pinst + 1, sizeof(double));
+            fail = opt_emit(popt, pinst, len) ||
+                opt_push(popt, start, TRUE, lit_d);
+            break;
+
+        case LITERAL_INT:
+            memcpy(&lit_i, pinst + 1, sizeof(epicsInt32));
+            fail = opt_emit(popt, pinst, len) ||
+                opt_push(popt, start, TRUE, lit_i);
+            break;
+
+        case CONST_PI:
+        case CONST_D2R:
+        case CONST_R2D:
+            /* The literal would be longer, keep the opcode */
+            fail = opt_emit(popt, pinst, len) ||
+                opt_push(popt, start, TRUE, opt_constant(pinst));
+            break;
+
+        case FETCH_VAL:
+        case FETCH_A: case FETCH_B: case FETCH_C: case FETCH_D:
+        case FETCH_E: case FETCH_F: case FETCH_G: case FETCH_H:
+        case FETCH_I: case FETCH_J: case FETCH_K: case FETCH_L:
+        case RANDOM:
+            fail = opt_emit(popt, pinst, len) ||
+                opt_push(popt, start, FALSE, 0);
+            break;
+
+        case STORE_A: case STORE_B: case STORE_C: case STORE_D:
+        case STORE_E: case STORE_F: case STORE_G: case STORE_H:
+        case STORE_I: case STORE_J: case STORE_K: case STORE_L:
+            fail = popt->depth < 1 || opt_emit(popt, pinst, len);
+            popt->depth--;
+            break;
+
+        case COND_IF:
+            fail = opt_cond_if(popt);
+            break;
+
+        case COND_ELSE:
+            fail = opt_cond_else(popt);
+            break;
+
+        case COND_END:
+            fail = opt_cond_end(popt);
+            break;
+
+        case COND_IF_JUMP:
+        case COND_ELSE_JUMP:
+        case NOT_GENERATED:
+            fail = TRUE;
+            break;
+
+        default:
+            fail = opt_operator(popt, pinst);
+        }
+        if (fail)
+            goto done;
+        pinst += len;
+    }
+
+    op = END_EXPRESSION;
+    if (popt->nconds == 0 && popt->skip == 0 && popt->depth == 1 &&
+        !opt_emit(popt, &op, 1)) {
+        memcpy(pdest, popt->pout, popt->len);
+        status = 0;
+    }
+
+done:
+    free(popt->pout);
+    free(popt);
+    return status;
+}
+
+
 /* postfix
  *
  * convert an infix expression to a postfix expression
@@ -216,6 +673,7 @@ LIBCOM_API long
     int runtime_depth = 0;
     int cond_count = 0;
     char * const pdest = pout;
+    const char * const pinfix = psrc;
     char *pnext;
 
     if (psrc == NULL || *psrc == '\0' ||
@@ -478,6 +936,13 @@ LIBCOM_API long
         *perror = CALC_ERR_INCOMPLETE;
         goto bad;
     }
+
+    if (postfixOptimize) {
+        size_t len = pout - pdest + 1;
+        size_t size = INFIX_TO_POSTFIX_SIZE(strlen(pinfix) + 1);
+
+        optimize(pdest, len > size ? len : size);
+    }
     return 0;
 
 bad:
@@ -594,12 +1059,15 @@ LIBCOM_API void
         "COND_IF",
         "COND_ELSE",
         "COND_END",
+        "COND_IF_JUMP",
+        "COND_ELSE_JUMP",
     /* Misc */
         "NOT_GENERATED"
     };
     char op;
     double lit_d;
     epicsInt32 lit_i;
+    epicsUInt16 offset;
 
     while ((op = *pinst) != END_EXPRESSION) {
         switch (op) {
@@ -620,6 +1088,12 @@ LIBCOM_API void
             printf("\t%s, %d arg(s)\n", opcodes[(int) op], *++pinst);
             pinst++;
             break;
+        case COND_IF_JUMP:
+        case COND_ELSE_JUMP:
+            memcpy(&offset, ++pinst, sizeof(epicsUInt16));
+            printf("\t%s +%u\n", opcodes[(int) op], offset);
+            pinst += sizeof(epicsUInt16);
+            break;
         default:
             printf("\t%s\n", opcodes[(int) op]);
             pinst++;
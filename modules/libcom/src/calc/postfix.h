@@ -113,6 +113,18 @@
 extern "C" {
 #endif
 
+/** \brief Optimize expressions as they are compiled
+ *
+ * When non-zero (the default) postfix() evaluates any sub-expressions
+ * whose operands are all constants, drops the branch of a conditional
+ * operator that a constant condition can never select, and turns the
+ * remaining conditionals into forward jumps so calcPerform() no longer
+ * has to search for the matching \c : operator at run-time. The
+ * optimized byte-code never needs more than INFIX_TO_POSTFIX_SIZE(n)
+ * bytes. Set this to zero to get the byte-code exactly as parsed.
+ */
+LIBCOM_API extern int postfixOptimize;
+
 /** \brief Compile an infix expression into postfix byte-code
  *
  * Converts an expression from an infix string to postfix byte-code
@@ -314,6 +326,35 @@ LIBCOM_API long
 LIBCOM_API long
     calcPerform(double *parg, double *presult, const char *ppostfix);
 
+/** \brief Run the calculation engine over arrays of inputs
+ *
+ * Evaluates the postfix expression once for each of \c n elements, taking
+ * the value of each argument A-L from the same element of its input array.
+ * Expressions that were optimized by postfix() are evaluated in blocks of
+ * elements, one instruction at a time, which allows the compiler to use
+ * SIMD instructions for the simpler operators. Expressions that use
+ * \c RNDM or were compiled without the optimizer are evaluated by calling
+ * calcPerform() for each element.
+ *
+ * \param pargs Pointer to an array of CALCPERFORM_NARGS pointers to the
+ * input arrays for arguments A-L. A NULL pointer gives an argument that
+ * is always zero. Assignments to an argument only affect the rest of the
+ * expression for the same element; the input arrays are never modified.
+ * \param pcounts Optional array of CALCPERFORM_NARGS element counts for
+ * the input arrays. An input with a count of 1 provides the same value to
+ * every element. If \c pcounts is NULL all of the input arrays must have
+ * at least \c n elements.
+ * \param presults Array of \c n results. The existing values are provided
+ * to the expression as \c VAL.
+ * \param n Number of elements to calculate.
+ * \param ppostfix The postfix expression created by postfix().
+ * \return Status value 0 for OK, or non-zero if an error is discovered
+ * during the evaluation process or an input array is too short.
+ */
+LIBCOM_API long
+    calcPerformArray(const double **pargs, const unsigned long *pcounts,
+        double *presults, unsigned long n, const char *ppostfix);
+
 /** \brief Find the inputs and outputs of an expression
  *
  * Software using the calc subsystem may need to know what expression
@@ -332,6 +373,10 @@ LIBCOM_API long
  *
  * Bit 0 of the bitmap at \c *pstores will be set if the expression assigns
  * a value to the argument A, bit 1 for argument B etc.
+ *
+ * Arguments that only appear in a conditional branch which the optimizer
+ * removed (see postfixOptimize) are not reported, since they can never
+ * affect the result.
  * \param ppostfix A postfix expression created by postfix().
  * \param pinputs Bitmap pointer.
  * \param pstores Bitmap pointer.
@@ -21,6 +21,9 @@
  *     a byte giving the number of arguments to process.
  *  4. You can't use strlen() on an RPN buffer since the literal values
  *     can contain zero bytes.
+ *  5. The optimizer replaces COND_IF and COND_ELSE with COND_IF_JUMP and
+ *     COND_ELSE_JUMP, which are followed by an unaligned 16-bit count of
+ *     bytes to skip forward, and drops the COND_END that closes them.
  */
 
 #ifndef INCpostfixPvth
@@ -99,6 +102,8 @@ typedef enum {
     COND_IF,
     COND_ELSE,
     COND_END,
+    COND_IF_JUMP,
+    COND_ELSE_JUMP,
     /* Misc */
     NOT_GENERATED
 } rpn_opcode;
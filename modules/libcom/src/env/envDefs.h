@@ -68,6 +68,9 @@ LIBCOM_API extern const ENV_PARAM EPICS_BUILD_TARGET_ARCH;
 LIBCOM_API extern const ENV_PARAM EPICS_TZ;
 LIBCOM_API extern const ENV_PARAM EPICS_TS_NTP_INET;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_IGNORE_SERVERS;
+LIBCOM_API extern const ENV_PARAM EPICS_HOST_NAME_LOOKUPS;
+LIBCOM_API extern const ENV_PARAM EPICS_HOST_NAME_TTL;
+LIBCOM_API extern const ENV_PARAM EPICS_HOST_NAME_NEG_TTL;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_LOG_PORT;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_LOG_INET;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_LOG_FILE_LIMIT;
@@ -33,6 +33,7 @@
 #include "errlog.h"
 #include "epicsStdio.h"
 #include "epicsExit.h"
+#include "epicsAtomic.h"
 
 
 #define BUFFER_SIZE 1280
@@ -46,8 +47,8 @@ static void errlogThread(void);
 
 static char *msgbufGetFree(int noConsoleMessage);
 static void msgbufSetSize(int size); /* Send 'size' chars plus trailing '\0' */
-static char *msgbufGetSend(int *noConsoleMessage);
-static void msgbufFreeSend(void);
+static struct msgNode *msgbufGetSend(void);
+static void msgbufFreeSend(struct msgNode *pnode);
 
 typedef struct listenerNode{
     ELLNODE node;
@@ -55,17 +56,28 @@ typedef struct listenerNode{
     void *pPrivate;
 } listenerNode;
 
-/*each message consists of a msgNode immediately followed by the message */
+/* Messages are formatted into a per-thread staging buffer, then copied
+ * into a ring shared by all producers.  Space in the ring is reserved by
+ * advancing head with a compare-and-swap, so producers never block each
+ * other or the errlogThread, which is the only consumer and advances tail.
+ *
+ * Each message in the ring is a msgNode immediately followed by the
+ * message.  The committed field is 0 until the message has been copied,
+ * then holds the total size of the node.  A negative value marks padding
+ * up to the end of the buffer, for a message that didn't fit there.
+ */
 typedef struct msgNode {
-    ELLNODE node;
-    char *message;
-    int length;
+    int committed;
     int noConsoleMessage;
 } msgNode;
 
+typedef struct msgStage {
+    int noConsoleMessage;
+    char message[1];
+} msgStage;
+
 static struct {
     epicsEventId waitForWork; /*errlogThread waits for this*/
-    epicsMutexId msgQueueLock;
     epicsMutexId listenerLock;
     epicsEventId waitForFlush; /*errlogFlush waits for this*/
     epicsEventId flush; /*errlogFlush sets errlogThread does a Try*/
@@ -73,16 +85,18 @@ static struct {
     epicsEventId waitForExit; /*errlogExitHandler waits for this*/
     int          atExit;      /*TRUE when errlogExitHandler is active*/
     ELLLIST      listenerList;
-    ELLLIST      msgQueue;
-    msgNode      *pnextSend;
+    epicsThreadPrivateId stageId;
+    size_t       head;        /*bytes ever reserved, producers advance*/
+    size_t       tail;        /*bytes ever released, errlogThread advances*/
     int          errlogInitFailed;
-    int          buffersize;
+    int          buffersize;  /*a power of 2*/
     int          maxMsgSize;
     int          msgNeeded;
     int          sevToLog;
     int          toConsole;
     FILE         *console;
-    int          missedMessages;
+    int          missedMessages; /*producers increment atomically*/
+    int          discarded;   /*missedMessages taken by errlogThread*/
     char         *pbuffer;
 } pvtData;
 
@@ -469,21 +483,26 @@ static void errlogInitPvt(void *arg)
     epicsThreadId tid;
 
     pvtData.errlogInitFailed = TRUE;
-    pvtData.buffersize = pconfig->bufsize;
     pvtData.maxMsgSize = pconfig->maxMsgSize;
     pvtData.msgNeeded = adjustToWorstCaseAlignment(pvtData.maxMsgSize +
         sizeof(msgNode));
+    /* The ring positions are masked, so round the size up to a power of 2.
+     * Any message must fit in the space left after wrapping to the start.
+     */
+    pvtData.buffersize = 1;
+    while (pvtData.buffersize < pconfig->bufsize ||
+           pvtData.buffersize < 2 * pvtData.msgNeeded)
+        pvtData.buffersize <<= 1;
     ellInit(&pvtData.listenerList);
-    ellInit(&pvtData.msgQueue);
     pvtData.toConsole = TRUE;
     pvtData.console = NULL;
     pvtData.waitForWork = epicsEventMustCreate(epicsEventEmpty);
     pvtData.listenerLock = epicsMutexMustCreate();
-    pvtData.msgQueueLock = epicsMutexMustCreate();
     pvtData.waitForFlush = epicsEventMustCreate(epicsEventEmpty);
     pvtData.flush = epicsEventMustCreate(epicsEventEmpty);
     pvtData.flushLock = epicsMutexMustCreate();
     pvtData.waitForExit = epicsEventMustCreate(epicsEventEmpty);
+    pvtData.stageId = epicsThreadPrivateCreate();
     pvtData.pbuffer = callocMustSucceed(1, pvtData.buffersize,
         "errlogInitPvt");
 
@@ -529,17 +548,13 @@ int errlogInit(int bufsize)
 
 void errlogFlush(void)
 {
-    int count;
-
     errlogInit(0);
     if (pvtData.atExit)
         return;
 
    /*If nothing in queue dont wake up errlogThread*/
-    epicsMutexMustLock(pvtData.msgQueueLock);
-    count = ellCount(&pvtData.msgQueue);
-    epicsMutexUnlock(pvtData.msgQueueLock);
-    if (count <= 0)
+    if (epicsAtomicGetSizeT(&pvtData.head) ==
+        epicsAtomicGetSizeT(&pvtData.tail))
         return;
 
     /*must let errlogThread empty queue*/
@@ -550,32 +565,50 @@ void errlogFlush(void)
     epicsMutexUnlock(pvtData.flushLock);
 }
 
-static void errlogThread(void)
+static void errlogDispatch(const char *pmessage, int noConsoleMessage,
+    FILE *console)
 {
     listenerNode *plistenerNode;
-    int noConsoleMessage;
-    char *pmessage;
+
+    if (pvtData.toConsole && !noConsoleMessage)
+        fprintf(console, "%s", pmessage);
+
+    plistenerNode = (listenerNode *)ellFirst(&pvtData.listenerList);
+    while (plistenerNode) {
+        (*plistenerNode->listener)(plistenerNode->pPrivate, pmessage);
+        plistenerNode = (listenerNode *)ellNext(&plistenerNode->node);
+    }
+}
+
+static void errlogThread(void)
+{
+    msgNode *pnode;
 
     epicsAtExit(errlogExitHandler,0);
     while (TRUE) {
         epicsEventMustWait(pvtData.waitForWork);
-        while ((pmessage = msgbufGetSend(&noConsoleMessage))) {
-            epicsMutexMustLock(pvtData.listenerLock);
-            if (pvtData.toConsole && !noConsoleMessage) {
-                FILE *console = pvtData.console ? pvtData.console : stderr;
+        pnode = msgbufGetSend();
+        if (pnode) {
+            FILE *console = pvtData.console ? pvtData.console : stderr;
 
-                fprintf(console, "%s", pmessage);
+            /* Send everything that is ready as one batch */
+            epicsMutexMustLock(pvtData.listenerLock);
+            do {
+                if (pvtData.discarded) {
+                    char notice[64];
+
+                    sprintf(notice, "errlog: %d messages were discarded\n",
+                        pvtData.discarded);
+                    pvtData.discarded = 0;
+                    errlogDispatch(notice, 0, console);
+                }
+                errlogDispatch((char *)(pnode + 1), pnode->noConsoleMessage,
+                    console);
+                msgbufFreeSend(pnode);
+            } while ((pnode = msgbufGetSend()));
+            if (pvtData.toConsole)
                 fflush(console);
-            }
-
-            plistenerNode = (listenerNode *)ellFirst(&pvtData.listenerList);
-            while (plistenerNode) {
-                (*plistenerNode->listener)(plistenerNode->pPrivate, pmessage);
-                plistenerNode = (listenerNode *)ellNext(&plistenerNode->node);
-            }
-
             epicsMutexUnlock(pvtData.listenerLock);
-            msgbufFreeSend();
         }
 
         if (pvtData.atExit)
@@ -590,106 +623,123 @@ static void errlogThread(void)
 }
 
 
-static msgNode * msgbufGetNode(void)
+static void msgbufFreeStage(void *pstage)
 {
-    char *pbuffer = pvtData.pbuffer;
-    char *pnextFree;
-    msgNode *pnextSend;
-
-    if (ellCount(&pvtData.msgQueue) == 0 ) {
-        pnextFree = pbuffer;        /* Reset if empty */
-    }
-    else {
-        msgNode *pfirst = (msgNode *)ellFirst(&pvtData.msgQueue);
-        msgNode *plast = (msgNode *)ellLast(&pvtData.msgQueue);
-        char *plimit = pbuffer + pvtData.buffersize;
-
-        pnextFree = plast->message + adjustToWorstCaseAlignment(plast->length);
-        if (pfirst > plast) {
-            plimit = (char *)pfirst;
-        }
-        else if (pnextFree + pvtData.msgNeeded > plimit) {
-            pnextFree = pbuffer;    /* Hit end, wrap to start */
-            plimit = (char *)pfirst;
-        }
-        if (pnextFree + pvtData.msgNeeded > plimit) {
-            return 0;               /* No room */
-        }
-    }
-
-    pnextSend = (msgNode *)pnextFree;
-    pnextSend->message = pnextFree + sizeof(msgNode);
-    pnextSend->length = 0;
-    return pnextSend;
+    epicsThreadPrivateSet(pvtData.stageId, NULL);
+    free(pstage);
 }
 
 static char * msgbufGetFree(int noConsoleMessage)
 {
-    msgNode *pnextSend;
+    msgStage *pstage = epicsThreadPrivateGet(pvtData.stageId);
 
-    if (epicsMutexLock(pvtData.msgQueueLock) != epicsMutexLockOK)
-        return 0;
+    if (!pstage) {
+        pstage = malloc(offsetof(msgStage, message) + pvtData.maxMsgSize);
+        if (!pstage) {
+            epicsAtomicIncrIntT(&pvtData.missedMessages);
+            return 0;
+        }
+        epicsThreadPrivateSet(pvtData.stageId, pstage);
+        epicsAtThreadExit(msgbufFreeStage, pstage);
+    }
+    pstage->noConsoleMessage = noConsoleMessage;
+    return pstage->message;
+}
 
-    if ((ellCount(&pvtData.msgQueue) == 0) && pvtData.missedMessages) {
-        int nchar;
+/* Reserve size bytes of the ring, or return 0 if it's full */
+static msgNode * msgbufReserve(size_t size)
+{
+    size_t mask = pvtData.buffersize - 1;
+    size_t head, tail, pos, needed;
 
-        pnextSend = msgbufGetNode();
-        nchar = sprintf(pnextSend->message,
-            "errlog: %d messages were discarded\n", pvtData.missedMessages);
-        pnextSend->length = nchar + 1;
-        pvtData.missedMessages = 0;
-        ellAdd(&pvtData.msgQueue, &pnextSend->node);
+    while (TRUE) {
+        head = epicsAtomicGetSizeT(&pvtData.head);
+        tail = epicsAtomicGetSizeT(&pvtData.tail);
+        pos = head & mask;
+        needed = size;
+        if (pos + size > pvtData.buffersize ||
+            (head == tail && pos && size <= pos))
+            needed += pvtData.buffersize - pos; /* Pad to the start */
+
+        if (head - tail + needed > pvtData.buffersize) {
+            if (epicsAtomicGetSizeT(&pvtData.head) != head)
+                continue;           /* Stale, try again */
+            return 0;               /* No room */
+        }
+        if (epicsAtomicCmpAndSwapSizeT(&pvtData.head, head,
+                head + needed) == head)
+            break;
     }
 
-    pvtData.pnextSend = pnextSend = msgbufGetNode();
-    if (pnextSend) {
-        pnextSend->noConsoleMessage = noConsoleMessage;
-        pnextSend->length = 0;
-        return pnextSend->message;  /* NB: msgQueueLock is still locked */
-    }
+    if (needed != size) {
+        msgNode *ppad = (msgNode *)(pvtData.pbuffer + pos);
 
-    ++pvtData.missedMessages;
-    epicsMutexUnlock(pvtData.msgQueueLock);
-    return 0;
+        epicsAtomicSetIntT(&ppad->committed, -(int)(needed - size));
+        return (msgNode *)pvtData.pbuffer;
+    }
+    return (msgNode *)(pvtData.pbuffer + pos);
 }
 
 static void msgbufSetSize(int size)
 {
-    msgNode *pnextSend = pvtData.pnextSend;
+    msgStage *pstage = epicsThreadPrivateGet(pvtData.stageId);
+    size_t needed = adjustToWorstCaseAlignment(sizeof(msgNode) + size + 1);
+    msgNode *pnode = msgbufReserve(needed);
+    char *pmessage;
+
+    if (!pnode) {
+        epicsAtomicIncrIntT(&pvtData.missedMessages);
+        return;
+    }
 
-    pnextSend->length = size+1;
-    ellAdd(&pvtData.msgQueue, &pnextSend->node);
-    epicsMutexUnlock(pvtData.msgQueueLock);
+    pnode->noConsoleMessage = pstage->noConsoleMessage;
+    pmessage = (char *)(pnode + 1);
+    memcpy(pmessage, pstage->message, size);
+    pmessage[size] = '\0';
+    epicsAtomicWriteMemoryBarrier();
+    epicsAtomicSetIntT(&pnode->committed, (int) needed);
     epicsEventSignal(pvtData.waitForWork);
 }
 
 
-static char * msgbufGetSend(int *noConsoleMessage)
+static msgNode * msgbufGetSend(void)
 {
-    msgNode *pnextSend;
+    while (TRUE) {
+        size_t tail = pvtData.tail;
+        msgNode *pnode;
+        int committed;
 
-    epicsMutexMustLock(pvtData.msgQueueLock);
-    pnextSend = (msgNode *)ellFirst(&pvtData.msgQueue);
-    epicsMutexUnlock(pvtData.msgQueueLock);
-    if (!pnextSend)
-        return 0;
+        if (tail == epicsAtomicGetSizeT(&pvtData.head)) {
+            /* Empty, count any messages discarded so far */
+            int missed = epicsAtomicGetIntT(&pvtData.missedMessages);
+
+            if (missed) {
+                epicsAtomicAddIntT(&pvtData.missedMessages, -missed);
+                pvtData.discarded += missed;
+            }
+            return 0;
+        }
 
-    *noConsoleMessage = pnextSend->noConsoleMessage;
-    return pnextSend->message;
+        pnode = (msgNode *)(pvtData.pbuffer +
+            (tail & (pvtData.buffersize - 1)));
+        committed = epicsAtomicGetIntT(&pnode->committed);
+        if (committed == 0)
+            return 0;               /* Still being copied */
+        epicsAtomicReadMemoryBarrier();
+        if (committed > 0)
+            return pnode;
+
+        msgbufFreeSend(pnode);      /* Skip padding */
+    }
 }
 
-static void msgbufFreeSend(void)
+static void msgbufFreeSend(msgNode *pnode)
 {
-    msgNode *pnextSend;
+    int committed = pnode->committed;
+    size_t size = committed > 0 ? committed : -committed;
 
-    epicsMutexMustLock(pvtData.msgQueueLock);
-    pnextSend = (msgNode *)ellFirst(&pvtData.msgQueue);
-    if (!pnextSend) {
-        FILE *console = pvtData.console ? pvtData.console : stderr;
-
-        fprintf(console, "errlog: msgbufFreeSend logic error\n");
-        epicsThreadSuspendSelf();
-    }
-    ellDelete(&pvtData.msgQueue, &pnextSend->node);
-    epicsMutexUnlock(pvtData.msgQueueLock);
+    /* Clear the space so its next user starts uncommitted */
+    memset(pnode, 0, size);
+    epicsAtomicWriteMemoryBarrier();
+    epicsAtomicSetSizeT(&pvtData.tail, pvtData.tail + size);
 }
@@ -394,7 +394,7 @@ static void installLastResortEventProviderCallFunc(const iocshArgBuf *args)
     installLastResortEventProvider();
 }
 
-static iocshVarDef asCheckClientIPDef[] = { { "asCheckClientIP", iocshArgInt, 0 }, { NULL, iocshArgInt, NULL } };
+static iocshVarDef asCheckClientIPDef[] = { { "asCheckClientIP", iocshArgInt, 0 }, { "asCacheSize", iocshArgInt, 0 }, { NULL, iocshArgInt, NULL } };
 
 void epicsStdCall libComRegister(void)
 {
@@ -430,5 +430,6 @@ void epicsStdCall libComRegister(void)
     iocshRegister(&installLastResortEventProviderFuncDef, installLastResortEventProviderCallFunc);
 
     asCheckClientIPDef[0].pval = &asCheckClientIP;
+    asCheckClientIPDef[1].pval = &asCacheSize;
     iocshRegisterVariable(asCheckClientIPDef);
 }
@@ -27,14 +27,18 @@
 #include "epicsEvent.h"
 #include "epicsGuard.h"
 #include "epicsExit.h"
+#include "epicsTime.h"
+#include "epicsStdio.h"
+#include "envDefs.h"
 #include "tsDLList.h"
 #include "tsFreeList.h"
+#include "resourceLib.h"
 #include "errlog.h"
 
 // - this class implements the asynchronous DNS query
 // - it completes early with the host name in dotted IP address form
 //   if the ipAddrToAsciiEngine is destroyed before IO completion
-//   or if there are too many items already in the engine's queue.
+//   or if there are too many lookups already waiting in the engine.
 class ipAddrToAsciiTransactionPrivate :
     public ipAddrToAsciiTransaction,
     public tsDLNode < ipAddrToAsciiTransactionPrivate > {
@@ -51,6 +55,7 @@ public:
     ipAddrToAsciiEnginePrivate & engine;
     ipAddrToAsciiCallBack * pCB;
     bool pending;
+    bool waiting; // on the waiting list, otherwise on labor
     void ipAddrToAscii ( const osiSockAddr &, ipAddrToAsciiCallBack & );
     void release ();
     void operator delete ( void * );
@@ -75,22 +80,73 @@ extern "C" {
 static void ipAddrToAsciiEngineGlobalMutexConstruct ( void * );
 }
 
+static unsigned defaultHostNameLookup ( const struct in_addr * pAddr,
+    char * pBuf, unsigned bufSize )
+{
+    return ipAddrToHostName ( pAddr, pBuf, bufSize );
+}
+
 namespace {
+typedef intId < unsigned, 8u > ipAddrToAsciiNameID;
+
+// - the host name found for one IP address, or that none was found
+// - while a lookup is in progress it is also on the lookups list
+//   and every transaction for the address waits for it
+struct ipAddrToAsciiName :
+    public tsSLNode < ipAddrToAsciiName >,
+    public tsDLNode < ipAddrToAsciiName >,
+    public ipAddrToAsciiNameID {
+    ipAddrToAsciiName ( const struct in_addr & addrIn ) :
+        ipAddrToAsciiNameID ( addrIn.s_addr ), resolving ( true ) {}
+    std::string name; // empty if the lookup failed
+    epicsTime expires;
+    bool resolving;
+};
+
+struct ipAddrToAsciiGlobal;
+
+// - each of these threads makes one host name lookup at a time
+struct ipAddrToAsciiResolver : public epicsThreadRunable {
+    ipAddrToAsciiResolver ( ipAddrToAsciiGlobal & globalIn );
+    virtual ~ipAddrToAsciiResolver () {}
+    virtual void run ();
+    ipAddrToAsciiGlobal & global;
+    epicsThread thread;
+};
+
 struct ipAddrToAsciiGlobal : public epicsThreadRunable {
     ipAddrToAsciiGlobal();
-    virtual ~ipAddrToAsciiGlobal() {}
+    virtual ~ipAddrToAsciiGlobal();
 
     virtual void run ();
 
+    bool findName ( const osiSockAddr & addr, bool & resolved );
+    void formatName ( const osiSockAddr & addr );
+    void purgeNames ( bool all );
+
     char nameTmp [1024];
     tsFreeList
         < ipAddrToAsciiTransactionPrivate, 0x80 >
             transactionFreeList;
+    // transactions whose name is known, ready for their callback
     tsDLList < ipAddrToAsciiTransactionPrivate > labor;
+    // transactions waiting for a lookup of their address
+    tsDLList < ipAddrToAsciiTransactionPrivate > waiting;
+    resTable < ipAddrToAsciiName, ipAddrToAsciiNameID > names;
+    tsDLList < ipAddrToAsciiName > lookups;
     mutable epicsMutex mutex;
     epicsEvent laborEvent;
+    epicsEvent lookupEvent;
     epicsEvent destructorBlockEvent;
     epicsThread thread;
+    ipAddrToAsciiResolver ** pResolvers;
+    unsigned nResolvers;
+    unsigned busyResolvers;
+    double positiveTTL;
+    double negativeTTL;
+    unsigned long cacheHits;
+    unsigned long cacheMisses;
+    ipAddrToAsciiEngine::hostNameLookup pLookup;
     // pCurrent may be changed by any thread (worker or other)
     ipAddrToAsciiTransactionPrivate * pCurrent;
     // pActive may only be changed by the worker
@@ -123,6 +179,13 @@ private:
 };
 
 ipAddrToAsciiGlobal * ipAddrToAsciiEnginePrivate :: pEngine = 0;
+static ipAddrToAsciiEngine::hostNameLookup ipAddrToAsciiLookup =
+    defaultHostNameLookup;
+
+// at most this many names are remembered
+static const unsigned maxNames = 1024u;
+// put some reasonable limit on queue expansion
+static const unsigned maxWaiting = 64u;
 static epicsThreadOnceId ipAddrToAsciiEngineGlobalMutexOnceFlag = EPICS_THREAD_ONCE_INIT;
 
 // the users are not required to supply a show routine
@@ -150,6 +213,7 @@ void ipAddrToAsciiEngine::cleanup()
         ipAddrToAsciiEnginePrivate::pEngine->exitFlag = true;
     }
     ipAddrToAsciiEnginePrivate::pEngine->laborEvent.signal();
+    ipAddrToAsciiEnginePrivate::pEngine->lookupEvent.signal();
     ipAddrToAsciiEnginePrivate::pEngine->thread.exitWait();
     delete ipAddrToAsciiEnginePrivate::pEngine;
     ipAddrToAsciiEnginePrivate::pEngine = 0;
@@ -169,17 +233,206 @@ ipAddrToAsciiEngine & ipAddrToAsciiEngine::allocate ()
     return * new ipAddrToAsciiEnginePrivate();
 }
 
+void ipAddrToAsciiEngine::setHostNameLookup ( hostNameLookup pLookup )
+{
+    epicsThreadOnce (
+        & ipAddrToAsciiEngineGlobalMutexOnceFlag,
+        ipAddrToAsciiEngineGlobalMutexConstruct, 0 );
+    if ( ! pLookup ) {
+        pLookup = defaultHostNameLookup;
+    }
+    if ( ipAddrToAsciiEnginePrivate::pEngine ) {
+        epicsGuard < epicsMutex > G ( ipAddrToAsciiEnginePrivate::pEngine->mutex );
+        ipAddrToAsciiEnginePrivate::pEngine->pLookup = pLookup;
+        // names found by the old lookup no longer apply
+        ipAddrToAsciiEnginePrivate::pEngine->purgeNames ( false );
+    }
+    ipAddrToAsciiLookup = pLookup;
+}
+
 ipAddrToAsciiGlobal::ipAddrToAsciiGlobal () :
     mutex(__FILE__, __LINE__),
     thread ( *this, "ipToAsciiProxy",
         epicsThreadGetStackSize(epicsThreadStackBig),
         epicsThreadPriorityLow ),
+    pResolvers ( 0 ), nResolvers ( 4u ), busyResolvers ( 0u ),
+    positiveTTL ( 300.0 ), negativeTTL ( 30.0 ),
+    cacheHits ( 0u ), cacheMisses ( 0u ), pLookup ( ipAddrToAsciiLookup ),
     pCurrent ( 0 ), pActive ( 0 ), cancelPendingCount ( 0u ), exitFlag ( false ),
     callbackInProgress ( false )
 {
+    long nLookups;
+    if ( ! envGetLongConfigParam ( & EPICS_HOST_NAME_LOOKUPS, & nLookups ) ) {
+        if ( nLookups < 1 ) {
+            nLookups = 1;
+        }
+        else if ( nLookups > 64 ) {
+            nLookups = 64;
+        }
+        this->nResolvers = static_cast < unsigned > ( nLookups );
+    }
+    envGetDoubleConfigParam ( & EPICS_HOST_NAME_TTL, & this->positiveTTL );
+    envGetDoubleConfigParam ( & EPICS_HOST_NAME_NEG_TTL, & this->negativeTTL );
+
+    this->pResolvers = new ipAddrToAsciiResolver * [this->nResolvers];
+    for ( unsigned i = 0u; i < this->nResolvers; i++ ) {
+        this->pResolvers[i] = new ipAddrToAsciiResolver ( *this );
+    }
     this->thread.start (); // start the thread
 }
 
+ipAddrToAsciiGlobal::~ipAddrToAsciiGlobal ()
+{
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        this->exitFlag = true;
+    }
+    this->lookupEvent.signal ();
+    for ( unsigned i = 0u; i < this->nResolvers; i++ ) {
+        this->pResolvers[i]->thread.exitWait ();
+        delete this->pResolvers[i];
+    }
+    delete [] this->pResolvers;
+    this->purgeNames ( true );
+}
+
+ipAddrToAsciiResolver::ipAddrToAsciiResolver ( ipAddrToAsciiGlobal & globalIn ) :
+    global ( globalIn ),
+    thread ( *this, "ipToAsciiLookup",
+        epicsThreadGetStackSize(epicsThreadStackBig),
+        epicsThreadPriorityLow )
+{
+    this->thread.start ();
+}
+
+void ipAddrToAsciiResolver::run ()
+{
+    ipAddrToAsciiGlobal & g = this->global;
+    epicsGuard < epicsMutex > guard ( g.mutex );
+    while ( ! g.exitFlag ) {
+        ipAddrToAsciiName * pName = g.lookups.get ();
+        if ( ! pName ) {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            g.lookupEvent.wait ();
+            continue;
+        }
+        if ( g.lookups.count () ) {
+            // wake another resolver for the rest
+            g.lookupEvent.signal ();
+        }
+
+        struct in_addr addr;
+        addr.s_addr = pName->getId ();
+        ipAddrToAsciiEngine::hostNameLookup pLookup = g.pLookup;
+        char name[1024];
+        unsigned len;
+        g.busyResolvers++;
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            // depending on DNS configuration, this could take a very long time
+            // so we release the lock
+            len = ( *pLookup ) ( & addr, name, sizeof ( name ) );
+        }
+        g.busyResolvers--;
+
+        pName->name.assign ( name, len < sizeof ( name ) ? len : 0u );
+        pName->expires = epicsTime::getCurrent () +
+            ( len ? g.positiveTTL : g.negativeTTL );
+        pName->resolving = false;
+
+        // every transaction for this address can now complete
+        bool ready = false;
+        tsDLIter < ipAddrToAsciiTransactionPrivate > it ( g.waiting.firstIter () );
+        while ( it.valid () ) {
+            ipAddrToAsciiTransactionPrivate * pTrn = it.pointer ();
+            ++it;
+            if ( pTrn->addr.ia.sin_addr.s_addr == addr.s_addr ) {
+                g.waiting.remove ( *pTrn );
+                pTrn->waiting = false;
+                g.labor.add ( *pTrn );
+                ready = true;
+            }
+        }
+        if ( ready ) {
+            g.laborEvent.signal ();
+        }
+    }
+    // pass the exit on to the other resolvers
+    g.lookupEvent.signal ();
+}
+
+// - true if a name for the address is, or soon will be, known
+// - otherwise the caller must queue a lookup
+bool ipAddrToAsciiGlobal::findName ( const osiSockAddr & addr, bool & resolved )
+{
+    ipAddrToAsciiNameID id ( addr.ia.sin_addr.s_addr );
+    ipAddrToAsciiName * pName = this->names.lookup ( id );
+    if ( pName ) {
+        if ( pName->resolving ) {
+            resolved = false;
+            return true;
+        }
+        if ( epicsTime::getCurrent () < pName->expires ) {
+            this->cacheHits++;
+            resolved = true;
+            return true;
+        }
+    }
+    this->cacheMisses++;
+    if ( this->waiting.count () >= maxWaiting ) {
+        return false;
+    }
+    if ( ! pName ) {
+        if ( this->names.numEntriesInstalled () >= maxNames ) {
+            this->purgeNames ( false );
+        }
+        pName = new ipAddrToAsciiName ( addr.ia.sin_addr );
+        this->names.add ( *pName );
+    }
+    pName->resolving = true;
+    this->lookups.add ( *pName );
+    resolved = false;
+    return true;
+}
+
+// - remove names that are not being looked up, or all names once
+//   the resolver threads have stopped
+void ipAddrToAsciiGlobal::purgeNames ( bool all )
+{
+    tsSLList < ipAddrToAsciiName > list;
+    this->names.removeAll ( list );
+    while ( ipAddrToAsciiName * pName = list.get () ) {
+        if ( pName->resolving && ! all ) {
+            this->names.add ( *pName );
+        }
+        else {
+            if ( pName->resolving ) {
+                this->lookups.remove ( *pName );
+            }
+            delete pName;
+        }
+    }
+}
+
+// - put the name for the address in nameTmp, in the form
+//   produced by sockAddrToA()
+void ipAddrToAsciiGlobal::formatName ( const osiSockAddr & addr )
+{
+    if ( addr.sa.sa_family != AF_INET ) {
+        sockAddrToA ( & addr.sa, this->nameTmp, sizeof ( this->nameTmp ) );
+        return;
+    }
+    ipAddrToAsciiName * pName = this->exitFlag ? 0 :
+        this->names.lookup ( ipAddrToAsciiNameID ( addr.ia.sin_addr.s_addr ) );
+    if ( pName && ! pName->resolving && pName->name.size () ) {
+        epicsSnprintf ( this->nameTmp, sizeof ( this->nameTmp ), "%s:%hu",
+            pName->name.c_str (), ntohs ( addr.ia.sin_port ) );
+    }
+    else {
+        ipAddrToDottedIP ( & addr.ia, this->nameTmp, sizeof ( this->nameTmp ) );
+    }
+}
+
 
 void ipAddrToAsciiEnginePrivate::release ()
 {
@@ -204,6 +457,17 @@ void ipAddrToAsciiEnginePrivate::release ()
                     pEngine->labor.remove(*trn);
                 }
             }
+            tsDLIter < ipAddrToAsciiTransactionPrivate > wit(pEngine->waiting.firstIter());
+            while(wit.valid()) {
+                ipAddrToAsciiTransactionPrivate *trn = wit.pointer();
+                ++wit;
+
+                if(this==&trn->engine) {
+                    trn->pending = false;
+                    trn->waiting = false;
+                    pEngine->waiting.remove(*trn);
+                }
+            }
 
             // cancel transaction in lookup or callback
             if (pEngine->pCurrent && this==&pEngine->pCurrent->engine) {
@@ -235,7 +499,14 @@ void ipAddrToAsciiEnginePrivate::show ( unsigned level ) const
 {
     epicsGuard < epicsMutex > guard ( this->pEngine->mutex );
     printf ( "ipAddrToAsciiEngine at %p with %u requests pending\n",
-        static_cast <const void *> (this), this->pEngine->labor.count () );
+        static_cast <const void *> (this),
+        this->pEngine->labor.count () + this->pEngine->waiting.count () );
+    printf ( "\t%u names known, %u lookups queued, %u of %u resolvers busy\n",
+        this->pEngine->names.numEntriesInstalled (),
+        this->pEngine->lookups.count (), this->pEngine->busyResolvers,
+        this->pEngine->nResolvers );
+    printf ( "\t%lu cache hits, %lu misses\n",
+        this->pEngine->cacheHits, this->pEngine->cacheMisses );
     if ( level > 0u ) {
         tsDLIter < ipAddrToAsciiTransactionPrivate >
             pItem = this->pEngine->labor.firstIter ();
@@ -243,6 +514,11 @@ void ipAddrToAsciiEnginePrivate::show ( unsigned level ) const
             pItem->show ( level - 1u );
             pItem++;
         }
+        pItem = this->pEngine->waiting.firstIter ();
+        while ( pItem.valid () ) {
+            pItem->show ( level - 1u );
+            pItem++;
+        }
     }
     if ( level > 1u ) {
         printf ( "mutex:\n" );
@@ -308,27 +584,10 @@ void ipAddrToAsciiGlobal::run ()
             if ( ! pItem ) {
                 break;
             }
-            osiSockAddr addr = pItem->addr;
+            // the name was found by a resolver thread, so this
+            // doesn't block
             this->pCurrent = pItem;
-
-            if ( this->exitFlag )
-            {
-                sockAddrToDottedIP ( & addr.sa, this->nameTmp,
-                    sizeof ( this->nameTmp ) );
-            }
-            else {
-                epicsGuardRelease < epicsMutex > unguard ( guard );
-                // depending on DNS configuration, this could take a very long time
-                // so we release the lock
-                sockAddrToA ( &addr.sa, this->nameTmp, sizeof ( this->nameTmp ) );
-            }
-
-            // the ipAddrToAsciiTransactionPrivate destructor is allowed to
-            // set pCurrent to nill and avoid blocking on a slow DNS
-            // operation
-            if ( ! this->pCurrent ) {
-                continue;
-            }
+            this->formatName ( pItem->addr );
 
             // fix for lp:1580623
             // a destructing cac sets pCurrent to NULL, so
@@ -358,7 +617,7 @@ void ipAddrToAsciiGlobal::run ()
 
 ipAddrToAsciiTransactionPrivate::ipAddrToAsciiTransactionPrivate
     ( ipAddrToAsciiEnginePrivate & engineIn ) :
-    engine ( engineIn ), pCB ( 0 ), pending ( false )
+    engine ( engineIn ), pCB ( 0 ), pending ( false ), waiting ( false )
 {
     memset ( & this->addr, '\0', sizeof ( this->addr ) );
     this->addr.sa.sa_family = AF_UNSPEC;
@@ -402,8 +661,13 @@ ipAddrToAsciiTransactionPrivate::~ipAddrToAsciiTransactionPrivate ()
                     // cancel from callback, or while lookup in progress
                     pGlobal->pCurrent = 0;
                 }
+                else if ( this->waiting ) {
+                    // cancel while waiting for the lookup
+                    pGlobal->waiting.remove ( *this );
+                    this->waiting = false;
+                }
                 else {
-                    // cancel before lookup starts
+                    // cancel before callback starts
                     pGlobal->labor.remove ( *this );
                 }
                 this->pending = false;
@@ -421,6 +685,7 @@ void ipAddrToAsciiTransactionPrivate::ipAddrToAscii (
     const osiSockAddr & addrIn, ipAddrToAsciiCallBack & cbIn )
 {
     bool success;
+    bool resolved = true;
     ipAddrToAsciiGlobal *pGlobal = this->engine.pEngine;
 
     {
@@ -430,12 +695,19 @@ void ipAddrToAsciiTransactionPrivate::ipAddrToAscii (
             errlogPrintf("Warning: ipAddrToAscii on transaction with release()'d ipAddrToAsciiEngine");
             success = false;
 
-        } else if ( !this->pending && pGlobal->labor.count () < 16u ) {
-            // put some reasonable limit on queue expansion
+        } else if ( !this->pending &&
+                ( addrIn.sa.sa_family != AF_INET ||
+                  pGlobal->findName ( addrIn, resolved ) ) ) {
             this->addr = addrIn;
             this->pCB = & cbIn;
             this->pending = true;
-            pGlobal->labor.add ( *this );
+            this->waiting = ! resolved;
+            if ( resolved ) {
+                pGlobal->labor.add ( *this );
+            }
+            else {
+                pGlobal->waiting.add ( *this );
+            }
             success = true;
         }
         else {
@@ -444,7 +716,12 @@ void ipAddrToAsciiTransactionPrivate::ipAddrToAscii (
     }
 
     if ( success ) {
-        pGlobal->laborEvent.signal ();
+        if ( resolved ) {
+            pGlobal->laborEvent.signal ();
+        }
+        else {
+            pGlobal->lookupEvent.signal ();
+        }
     }
     else {
         char autoNameTmp[256];
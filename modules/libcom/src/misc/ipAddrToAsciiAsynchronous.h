@@ -47,6 +47,12 @@ protected:
 public:
 #ifdef EPICS_PRIVATE_API
     static void cleanup();
+    // Replace the host name lookup, eg. with a stand-in for testing.
+    // Returns the length of the name, or 0 if no name was found.
+    // A null pointer restores ipAddrToHostName().
+    typedef unsigned ( * hostNameLookup ) ( const struct in_addr *,
+        char * pBuf, unsigned bufSize );
+    static void setHostNameLookup ( hostNameLookup );
 #endif
 };
 
@@ -73,6 +73,14 @@ LIBCOM_API void epicsThreadPoolReleaseShared(epicsThreadPool *pool);
  */
 LIBCOM_API epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts);
 
+/* As epicsThreadPoolCreate() but the pool uses the work-stealing scheduler.
+ * Each worker keeps its own queue of the jobs queued from that
+ * worker, which other workers steal from when they run out.
+ * Suits many short jobs which queue further jobs.
+ * Such pools are never shared.
+ */
+LIBCOM_API epicsThreadPool* epicsThreadPoolCreateStealing(epicsThreadPoolConfig *opts);
+
 /* Blocks until all worker threads have stopped.
  * Any jobs still attached to this pool receive a callback with EPICSJOB_CLEANUP
  * and are then orphaned.
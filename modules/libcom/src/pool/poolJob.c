@@ -119,6 +119,9 @@ int createPoolThread(epicsThreadPool *pool)
 {
     epicsThreadId tid;
 
+    if (pool->workStealing)
+        return stealCreateWorker(pool);
+
     tid = epicsThreadCreate("PoolWorker",
                             pool->conf.workerPriority,
                             pool->conf.workerStack,
@@ -162,6 +165,11 @@ void epicsJobDestroy(epicsJob *job)
     }
     pool = job->pool;
 
+    if (pool->workStealing) {
+        stealJobDestroy(job);
+        return;
+    }
+
     epicsMutexMustLock(pool->guard);
 
     assert(!job->dead);
@@ -188,7 +196,7 @@ int epicsJobMove(epicsJob *job, epicsThreadPool *newpool)
     if (pool) {
         epicsMutexMustLock(pool->guard);
 
-        if (job->queued || job->running) {
+        if (job->queued || job->running || job->state) {
             epicsMutexUnlock(pool->guard);
             return S_pool_jobBusy;
         }
@@ -220,6 +228,11 @@ int epicsJobQueue(epicsJob *job)
     if (!pool)
         return S_pool_noPool;
 
+    if (pool->workStealing) {
+        assert(!job->dead);
+        return stealJobQueue(job);
+    }
+
     epicsMutexMustLock(pool->guard);
 
     assert(!job->dead);
@@ -307,6 +320,11 @@ int epicsJobUnqueue(epicsJob *job)
     if (!pool)
         return S_pool_noPool;
 
+    if (pool->workStealing) {
+        assert(!job->dead);
+        return stealJobUnqueue(job);
+    }
+
     epicsMutexMustLock(pool->guard);
 
     assert(!job->dead);
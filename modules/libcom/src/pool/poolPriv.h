@@ -14,6 +14,21 @@
 #include "epicsThread.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
+#include "epicsAtomic.h"
+
+/* Capacity of each worker's deque in a work-stealing pool, a power of 2 */
+#define POOL_DEQUE_SIZE 256
+
+/* A worker of a work-stealing pool.  Jobs queued from the worker thread
+ * go on the bottom of its deque, and are popped from there by the same
+ * worker.  Other workers steal from the top.  Chase-Lev, no locking.
+ */
+typedef struct poolWorker {
+    epicsThreadPool *pool;
+    size_t top;
+    size_t bottom;
+    EpicsAtomicPtrT ring[POOL_DEQUE_SIZE];
+} poolWorker;
 
 struct epicsThreadPool {
     ELLNODE sharedNode;
@@ -46,18 +61,36 @@ struct epicsThreadPool {
     epicsEventId observerWakeup;
 
     /* Disallow epicsJobQueue */
-    unsigned int pauseadd:1;
+    int pauseadd;
     /* Prevent workers from running new jobs */
-    unsigned int pauserun:1;
+    int pauserun;
     /* Prevent further changes to pool options */
     unsigned int freezeopt:1;
     /* tell workers to exit */
-    unsigned int shutdown:1;
+    int shutdown;
+
+    /* Work-stealing pools only, see poolSteal.c.
+     * The ints are accessed with epicsAtomic, not under guard.
+     */
+    poolWorker *workers; /* conf.maxThreads of them */
+    int nWorkers; /* # of workers started */
+    int stealBusy; /* # of jobs queued or running */
+    int stealSleepers; /* # of workers waiting on the workerWakeup event */
+    int stealObservers; /* # of threads in epicsThreadPoolWait() */
+
+    /* Jobs queued by threads which aren't workers of this pool */
+    epicsMutexId injectGuard;
+    epicsJob **inject; /* ring buffer */
+    size_t injectSize;
+    size_t injectHead;
+    size_t injectCount;
 
     epicsMutexId guard;
 
     /* copy of config passed when created */
     epicsThreadPoolConfig conf;
+    /* created by epicsThreadPoolCreateStealing() */
+    unsigned int workStealing;
 };
 
 /* Called after manipulating counters to check that invariants are preserved */
@@ -93,14 +126,38 @@ struct epicsJob {
     unsigned int running:1;
     unsigned int freewhendone:1; /* lazy delete of running job */
     unsigned int dead:1; /* flag to catch use of freed objects */
+
+    int state; /* in a work-stealing pool, replaces the flags above */
 };
 
+/* Job states in a work-stealing pool.
+ * A job has at most one entry in the deques and the injection queue.
+ * epicsJobUnqueue() cancels the entry, which the worker that finds it
+ * then drops.
+ */
+#define STEAL_IDLE      0 /* no entry, not running */
+#define STEAL_QUEUED    1 /* live entry */
+#define STEAL_CANCELLED 2 /* dead entry */
+#define STEAL_RUNNING   3 /* no entry, running */
+#define STEAL_REQUEUE   4 /* running, to be queued again when done */
+#define STEAL_FREE      8 /* flag, free once any entry or run is done */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 int createPoolThread(epicsThreadPool *pool);
 
+int stealPoolInit(epicsThreadPool *pool);
+void stealPoolCleanup(epicsThreadPool *pool);
+int stealCreateWorker(epicsThreadPool *pool);
+void stealWakeup(epicsThreadPool *pool);
+int stealPoolWait(epicsThreadPool *pool, double timeout);
+void stealPoolReport(epicsThreadPool *pool, FILE *fd);
+int stealJobQueue(epicsJob *job);
+int stealJobUnqueue(epicsJob *job);
+void stealJobDestroy(epicsJob *job);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,603 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* Work-stealing scheduler for epicsThreadPool
+ *
+ * Jobs queued by a worker, usually from inside a running job, go on the
+ * bottom of that worker's deque and are popped from there by the same
+ * worker without taking any lock.  Jobs queued by other threads go to
+ * the injection queue.  A worker with an empty deque first takes a share
+ * of the injection queue, then steals from the top of other deques.
+ *
+ * Each job has at most one entry in these queues.  The job state tells
+ * whether the entry is live, so epicsJobUnqueue() only has to mark it
+ * cancelled, and the worker which finds a cancelled entry drops it.
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "dbDefs.h"
+#include "errlog.h"
+#include "ellLib.h"
+#include "epicsThread.h"
+#include "epicsMutex.h"
+#include "epicsEvent.h"
+#include "epicsAtomic.h"
+#include "epicsAssert.h"
+#include "cantProceed.h"
+
+#include "epicsThreadPool.h"
+#include "poolPriv.h"
+
+#define DEQUE_MASK (POOL_DEQUE_SIZE-1)
+
+/* Jobs queued before the injection queue has to grow */
+#define INJECT_INITIAL 64
+
+static epicsThreadOnceId stealOnce = EPICS_THREAD_ONCE_INIT;
+static epicsThreadPrivateId stealWorkerId;
+
+static
+void stealOnceInit(void *unused)
+{
+    stealWorkerId = epicsThreadPrivateCreate();
+}
+
+/* The worker of this pool which is the current thread, if any */
+static
+poolWorker* stealSelf(epicsThreadPool *pool)
+{
+    poolWorker *worker = epicsThreadPrivateGet(stealWorkerId);
+
+    return worker && worker->pool == pool ? worker : NULL;
+}
+
+/* Deque operations.
+ * Only the owning worker pushes and pops, and so writes bottom.
+ * Anyone may steal, which advances top with a compare and swap.
+ */
+
+static
+int dequePush(poolWorker *worker, epicsJob *job)
+{
+    size_t b = worker->bottom;
+    size_t t = epicsAtomicGetSizeT(&worker->top);
+
+    if (b - t >= POOL_DEQUE_SIZE)
+        return 0;
+    epicsAtomicSetPtrT(&worker->ring[b & DEQUE_MASK], job);
+    epicsAtomicSetSizeT(&worker->bottom, b + 1);
+    return 1;
+}
+
+static
+epicsJob* dequePop(poolWorker *worker)
+{
+    size_t b = worker->bottom - 1;
+    size_t t;
+    epicsJob *job;
+
+    /* Set then Get is a full barrier, thieves see the new bottom
+     * before we read top.
+     */
+    epicsAtomicSetSizeT(&worker->bottom, b);
+    t = epicsAtomicGetSizeT(&worker->top);
+
+    if ((ptrdiff_t)(b - t) < 0) {
+        /* was empty */
+        epicsAtomicSetSizeT(&worker->bottom, t);
+        return NULL;
+    }
+    job = epicsAtomicGetPtrT(&worker->ring[b & DEQUE_MASK]);
+    if (b != t)
+        return job;
+
+    /* the last entry, which a thief may be taking */
+    if (epicsAtomicCmpAndSwapSizeT(&worker->top, t, t + 1) != t)
+        job = NULL;
+    epicsAtomicSetSizeT(&worker->bottom, t + 1);
+    return job;
+}
+
+static
+epicsJob* dequeSteal(poolWorker *worker)
+{
+    size_t t = epicsAtomicGetSizeT(&worker->top);
+    size_t b = epicsAtomicGetSizeT(&worker->bottom);
+    epicsJob *job;
+
+    if ((ptrdiff_t)(b - t) <= 0)
+        return NULL;
+    job = epicsAtomicGetPtrT(&worker->ring[t & DEQUE_MASK]);
+    if (epicsAtomicCmpAndSwapSizeT(&worker->top, t, t + 1) != t)
+        return NULL; /* lost a race, the caller looks elsewhere */
+    return job;
+}
+
+static
+int dequeDepth(poolWorker *worker)
+{
+    ptrdiff_t n = (ptrdiff_t)(epicsAtomicGetSizeT(&worker->bottom) -
+        epicsAtomicGetSizeT(&worker->top));
+
+    return n > 0 ? (int)n : 0;
+}
+
+/* Injection queue operations */
+
+static
+void injectPut(epicsThreadPool *pool, epicsJob *job)
+{
+    size_t count;
+
+    epicsMutexMustLock(pool->injectGuard);
+    count = pool->injectCount;
+    if (count == pool->injectSize) {
+        size_t size = pool->injectSize ? 2 * pool->injectSize : INJECT_INITIAL;
+        epicsJob **ring = mallocMustSucceed(size * sizeof(*ring), "injectPut");
+        size_t i;
+
+        for (i = 0; i < count; i++)
+            ring[i] = pool->inject[(pool->injectHead + i) % pool->injectSize];
+        free(pool->inject);
+        pool->inject = ring;
+        pool->injectSize = size;
+        pool->injectHead = 0;
+    }
+    pool->inject[(pool->injectHead + count) % pool->injectSize] = job;
+    epicsAtomicSetSizeT(&pool->injectCount, count + 1);
+    epicsMutexUnlock(pool->injectGuard);
+}
+
+/* Take a share of the injection queue.  One job is returned, the rest go
+ * on our own (empty) deque where other workers can steal them.
+ */
+static
+epicsJob* injectTake(epicsThreadPool *pool, poolWorker *self)
+{
+    epicsJob *job;
+    size_t n, i;
+
+    if (!epicsAtomicGetSizeT(&pool->injectCount))
+        return NULL;
+
+    epicsMutexMustLock(pool->injectGuard);
+    n = pool->injectCount;
+    if (!n) {
+        epicsMutexUnlock(pool->injectGuard);
+        return NULL;
+    }
+    n = n / epicsAtomicGetIntT(&pool->nWorkers) + 1;
+    if (n > pool->injectCount)
+        n = pool->injectCount;
+    if (n > POOL_DEQUE_SIZE / 2)
+        n = POOL_DEQUE_SIZE / 2;
+
+    job = pool->inject[pool->injectHead];
+    for (i = 1; i < n; i++) {
+        int ok = dequePush(self,
+            pool->inject[(pool->injectHead + i) % pool->injectSize]);
+
+        assert(ok);
+    }
+    pool->injectHead = (pool->injectHead + n) % pool->injectSize;
+    epicsAtomicSetSizeT(&pool->injectCount, pool->injectCount - n);
+    epicsMutexUnlock(pool->injectGuard);
+    return job;
+}
+
+/* Wake a sleeping worker, if there is one.
+ * The caller's atomic store of new work comes before the (fenced) read
+ * of stealSleepers, and workers increment that before looking for work,
+ * so a wakeup can't be lost.
+ */
+static
+void stealNotify(epicsThreadPool *pool)
+{
+    if (epicsAtomicGetIntT(&pool->stealSleepers) > 0)
+        epicsEventSignal(pool->workerWakeup);
+}
+
+void stealWakeup(epicsThreadPool *pool)
+{
+    stealNotify(pool);
+}
+
+static
+int stealHasWork(epicsThreadPool *pool)
+{
+    int i, n = epicsAtomicGetIntT(&pool->nWorkers);
+
+    if (epicsAtomicGetSizeT(&pool->injectCount))
+        return 1;
+    for (i = 0; i < n; i++) {
+        if (dequeDepth(&pool->workers[i]))
+            return 1;
+    }
+    return 0;
+}
+
+static
+epicsJob* stealFind(epicsThreadPool *pool, poolWorker *self)
+{
+    int i, n, me = (int)(self - pool->workers);
+    epicsJob *job;
+
+    if ((job = dequePop(self)) != NULL)
+        return job;
+
+    if ((job = injectTake(pool, self)) != NULL) {
+        if (dequeDepth(self))
+            stealNotify(pool); /* some for the others */
+        return job;
+    }
+
+    n = epicsAtomicGetIntT(&pool->nWorkers);
+    for (i = 1; i < n; i++) {
+        if ((job = dequeSteal(&pool->workers[(me + i) % n])) != NULL)
+            return job;
+    }
+    return NULL;
+}
+
+/* One less job queued or running */
+static
+void stealDone(epicsThreadPool *pool)
+{
+    if (epicsAtomicDecrIntT(&pool->stealBusy) == 0 &&
+            epicsAtomicGetIntT(&pool->stealObservers) > 0)
+        epicsEventSignal(pool->observerWakeup);
+}
+
+static
+void stealFree(epicsThreadPool *pool, epicsJob *job)
+{
+    epicsMutexMustLock(pool->guard);
+    ellDelete(&pool->owned, &job->jobnode);
+    epicsMutexUnlock(pool->guard);
+    job->dead = 1;
+    free(job);
+}
+
+/* Compare and swap the job state.  On failure *pstate is updated to the
+ * actual state, so callers can start from a guess instead of a read.
+ */
+static
+int stateSwap(epicsJob *job, int *pstate, int next)
+{
+    int prev = epicsAtomicCmpAndSwapIntT(&job->state, *pstate, next);
+
+    if (prev == *pstate)
+        return 1;
+    *pstate = prev;
+    return 0;
+}
+
+static
+void stealRun(epicsThreadPool *pool, poolWorker *self, epicsJob *job)
+{
+    int state = STEAL_QUEUED;
+
+    /* claim the entry, or drop it if cancelled */
+    for (;;) {
+        if (state == STEAL_QUEUED) {
+            if (stateSwap(job, &state, STEAL_RUNNING))
+                break;
+        }
+        else if (state == STEAL_CANCELLED) {
+            if (stateSwap(job, &state, STEAL_IDLE))
+                return;
+        }
+        else {
+            /* nothing else may change a cancelled job being freed */
+            assert(state == (STEAL_CANCELLED | STEAL_FREE));
+            stealFree(pool, job);
+            return;
+        }
+    }
+
+    (*job->func)(job->arg, epicsJobModeRun);
+
+    state = STEAL_RUNNING;
+    for (;;) {
+        if (state == STEAL_RUNNING) {
+            if (stateSwap(job, &state, STEAL_IDLE)) {
+                stealDone(pool);
+                return;
+            }
+        }
+        else if (state == STEAL_REQUEUE) {
+            /* queued again from within the callback */
+            if (stateSwap(job, &state, STEAL_QUEUED)) {
+                if (!dequePush(self, job))
+                    injectPut(pool, job);
+                stealNotify(pool);
+                return;
+            }
+        }
+        else {
+            /* destroyed from within the callback */
+            assert(state == (STEAL_RUNNING | STEAL_FREE));
+            stealFree(pool, job);
+            stealDone(pool);
+            return;
+        }
+    }
+}
+
+static
+void stealWorkerMain(void *arg)
+{
+    poolWorker *self = arg;
+    epicsThreadPool *pool = self->pool;
+    unsigned int nrun;
+
+    epicsThreadPrivateSet(stealWorkerId, self);
+
+    for (;;) {
+        epicsJob *job = NULL;
+
+        if (!epicsAtomicGetIntT(&pool->pauserun))
+            job = stealFind(pool, self);
+        if (job) {
+            stealRun(pool, self, job);
+            continue;
+        }
+        /* Exit once no entries are left, so cancelled jobs are dropped
+         * before epicsThreadPoolDestroy() notifies them.
+         */
+        if (epicsAtomicGetIntT(&pool->shutdown) && !stealHasWork(pool))
+            break;
+
+        epicsAtomicIncrIntT(&pool->stealSleepers);
+        if (!epicsAtomicGetIntT(&pool->shutdown) &&
+                (epicsAtomicGetIntT(&pool->pauserun) || !stealHasWork(pool)))
+            epicsEventMustWait(pool->workerWakeup);
+        epicsAtomicDecrIntT(&pool->stealSleepers);
+
+        /* pass the wakeup along if there is more than one worker's worth */
+        if (epicsAtomicGetIntT(&pool->shutdown) ||
+                (!epicsAtomicGetIntT(&pool->pauserun) && stealHasWork(pool)))
+            stealNotify(pool);
+    }
+
+    epicsThreadPrivateSet(stealWorkerId, NULL);
+
+    epicsMutexMustLock(pool->guard);
+    pool->threadsRunning--;
+    nrun = pool->threadsRunning;
+    epicsMutexUnlock(pool->guard);
+
+    if (nrun)
+        epicsEventSignal(pool->workerWakeup); /* pass along */
+    else
+        epicsEventSignal(pool->shutdownEvent);
+}
+
+/* Call with guard locked */
+int stealCreateWorker(epicsThreadPool *pool)
+{
+    int n = pool->nWorkers;
+    poolWorker *worker = &pool->workers[n];
+    epicsThreadId tid;
+
+    if ((unsigned int)n >= pool->conf.maxThreads)
+        return S_pool_noThreads;
+
+    worker->pool = pool;
+    /* visible to thieves before it can hold any jobs */
+    epicsAtomicSetIntT(&pool->nWorkers, n + 1);
+
+    tid = epicsThreadCreate("PoolWorker",
+                            pool->conf.workerPriority,
+                            pool->conf.workerStack,
+                            &stealWorkerMain,
+                            worker);
+    if (!tid) {
+        epicsAtomicSetIntT(&pool->nWorkers, n);
+        return S_pool_noThreads;
+    }
+
+    pool->threadsRunning++;
+    return 0;
+}
+
+int stealPoolInit(epicsThreadPool *pool)
+{
+    epicsThreadOnce(&stealOnce, &stealOnceInit, NULL);
+
+    pool->workers = calloc(pool->conf.maxThreads, sizeof(*pool->workers));
+    pool->injectGuard = epicsMutexCreate();
+    if (!pool->workers || !pool->injectGuard || !stealWorkerId) {
+        stealPoolCleanup(pool);
+        return S_pool_noThreads;
+    }
+    return 0;
+}
+
+void stealPoolCleanup(epicsThreadPool *pool)
+{
+    free(pool->workers);
+    pool->workers = NULL;
+    free(pool->inject);
+    pool->inject = NULL;
+    if (pool->injectGuard)
+        epicsMutexDestroy(pool->injectGuard);
+    pool->injectGuard = NULL;
+}
+
+int stealPoolWait(epicsThreadPool *pool, double timeout)
+{
+    int ret = 0;
+
+    epicsAtomicIncrIntT(&pool->stealObservers);
+
+    while (epicsAtomicGetIntT(&pool->stealBusy) > 0) {
+        if (timeout < 0.0) {
+            epicsEventMustWait(pool->observerWakeup);
+        }
+        else {
+            switch (epicsEventWaitWithTimeout(pool->observerWakeup, timeout)) {
+            case epicsEventWaitError:
+                cantProceed("epicsThreadPoolWait: failed to wait for Event");
+                break;
+            case epicsEventWaitTimeout:
+                if (epicsAtomicGetIntT(&pool->stealBusy) > 0)
+                    ret = S_pool_timeout;
+                break;
+            case epicsEventWaitOK:
+                ret = 0;
+                break;
+            }
+        }
+        if (ret != 0)
+            break;
+    }
+
+    if (epicsAtomicDecrIntT(&pool->stealObservers) > 0)
+        epicsEventSignal(pool->observerWakeup);
+
+    return ret;
+}
+
+void stealPoolReport(epicsThreadPool *pool, FILE *fd)
+{
+    int i, n = epicsAtomicGetIntT(&pool->nWorkers);
+
+    fprintf(fd, "  Work-stealing, %d jobs queued or running, %u injected\n",
+            epicsAtomicGetIntT(&pool->stealBusy),
+            (unsigned)epicsAtomicGetSizeT(&pool->injectCount));
+    for (i = 0; i < n; i++)
+        fprintf(fd, "  worker %d has %d queued\n", i,
+                dequeDepth(&pool->workers[i]));
+}
+
+int stealJobQueue(epicsJob *job)
+{
+    epicsThreadPool *pool = job->pool;
+    poolWorker *self;
+    int state = STEAL_IDLE;
+
+    if (epicsAtomicGetIntT(&pool->pauseadd))
+        return S_pool_paused;
+
+    for (;;) {
+        if (state & STEAL_FREE)
+            return S_pool_jobBusy;
+
+        switch (state) {
+        case STEAL_QUEUED:
+        case STEAL_REQUEUE:
+            return 0;
+
+        case STEAL_CANCELLED:
+            /* revive the existing entry */
+            if (stateSwap(job, &state, STEAL_QUEUED)) {
+                epicsAtomicIncrIntT(&pool->stealBusy);
+                return 0;
+            }
+            break;
+
+        case STEAL_RUNNING:
+            /* the worker will queue it again when done */
+            if (stateSwap(job, &state, STEAL_REQUEUE))
+                return 0;
+            break;
+
+        case STEAL_IDLE:
+            if (stateSwap(job, &state, STEAL_QUEUED))
+                goto add;
+            break;
+        }
+    }
+
+add:
+    /* Start another worker while there is more work than workers */
+    if (epicsAtomicIncrIntT(&pool->stealBusy) > epicsAtomicGetIntT(&pool->nWorkers)) {
+        epicsMutexMustLock(pool->guard);
+        if (pool->nWorkers < (int)pool->conf.maxThreads && !pool->shutdown &&
+                stealCreateWorker(pool) && pool->nWorkers == 0) {
+            /* oops, we couldn't lazy create our first worker
+             * so this job would never run!
+             */
+            epicsMutexUnlock(pool->guard);
+            epicsAtomicSetIntT(&job->state, STEAL_IDLE);
+            stealDone(pool);
+            return S_pool_noThreads;
+        }
+        epicsMutexUnlock(pool->guard);
+    }
+
+    self = stealSelf(pool);
+    if (!self || !dequePush(self, job))
+        injectPut(pool, job);
+    stealNotify(pool);
+    return 0;
+}
+
+int stealJobUnqueue(epicsJob *job)
+{
+    epicsThreadPool *pool = job->pool;
+    int state = STEAL_QUEUED;
+
+    for (;;) {
+        if (state == STEAL_QUEUED) {
+            if (stateSwap(job, &state, STEAL_CANCELLED)) {
+                stealDone(pool);
+                return 0;
+            }
+        }
+        else if (state == STEAL_REQUEUE) {
+            if (stateSwap(job, &state, STEAL_RUNNING))
+                return 0;
+        }
+        else
+            return S_pool_jobIdle;
+    }
+}
+
+void stealJobDestroy(epicsJob *job)
+{
+    epicsThreadPool *pool = job->pool;
+    int state = STEAL_IDLE;
+
+    assert(!job->dead);
+
+    for (;;) {
+        assert(!(state & STEAL_FREE));
+
+        switch (state) {
+        case STEAL_IDLE:
+            if (stateSwap(job, &state, STEAL_FREE)) {
+                stealFree(pool, job);
+                return;
+            }
+            break;
+
+        case STEAL_QUEUED:
+            /* the worker which finds the entry frees the job */
+            if (stateSwap(job, &state, STEAL_CANCELLED | STEAL_FREE)) {
+                stealDone(pool);
+                return;
+            }
+            break;
+
+        case STEAL_CANCELLED:
+            if (stateSwap(job, &state, STEAL_CANCELLED | STEAL_FREE))
+                return;
+            break;
+
+        case STEAL_RUNNING:
+        case STEAL_REQUEUE:
+            /* freed when the callback returns */
+            if (stateSwap(job, &state, STEAL_RUNNING | STEAL_FREE))
+                return;
+            break;
+        }
+    }
+}
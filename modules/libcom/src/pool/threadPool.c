@@ -35,7 +35,8 @@ void epicsThreadPoolConfigDefaults(epicsThreadPoolConfig *opts)
         opts->workerPriority = epicsThreadPriorityMedium;
 }
 
-epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts)
+static epicsThreadPool* poolCreate(epicsThreadPoolConfig *opts,
+                                   unsigned int workStealing)
 {
     size_t i;
     epicsThreadPool *pool;
@@ -54,6 +55,7 @@ epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts)
         memcpy(&pool->conf, opts, sizeof(*opts));
     else
         epicsThreadPoolConfigDefaults(&pool->conf);
+    pool->workStealing = workStealing;
 
     if (pool->conf.initialThreads > pool->conf.maxThreads)
         pool->conf.initialThreads = pool->conf.maxThreads;
@@ -70,6 +72,9 @@ epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts)
     ellInit(&pool->jobs);
     ellInit(&pool->owned);
 
+    if (pool->workStealing && stealPoolInit(pool))
+        goto cleanup;
+
     epicsMutexMustLock(pool->guard);
 
     for (i = 0; i < pool->conf.initialThreads; i++) {
@@ -79,6 +84,8 @@ epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts)
     if (pool->threadsRunning == 0 && pool->conf.initialThreads != 0) {
         epicsMutexUnlock(pool->guard);
         errlogPrintf("Error: Unable to create any threads for thread pool\n");
+        if (pool->workStealing)
+            stealPoolCleanup(pool);
         goto cleanup;
 
     }
@@ -105,6 +112,16 @@ cleanup:
     return NULL;
 }
 
+epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts)
+{
+    return poolCreate(opts, 0);
+}
+
+epicsThreadPool* epicsThreadPoolCreateStealing(epicsThreadPoolConfig *opts)
+{
+    return poolCreate(opts, 1);
+}
+
 static
 void epicsThreadPoolControlImpl(epicsThreadPool *pool, epicsThreadPoolOption opt, unsigned int val)
 {
@@ -122,6 +139,11 @@ void epicsThreadPoolControlImpl(epicsThreadPool *pool, epicsThreadPoolOption opt
             int jobs = ellCount(&pool->jobs);
             pool->pauserun = 0;
 
+            if (pool->workStealing) {
+                stealWakeup(pool);
+                return;
+            }
+
             if (jobs) {
                 int wakeable = pool->threadsSleeping - pool->threadsWaking;
 
@@ -160,6 +182,10 @@ void epicsThreadPoolControl(epicsThreadPool *pool, epicsThreadPoolOption opt, un
 int epicsThreadPoolWait(epicsThreadPool *pool, double timeout)
 {
     int ret = 0;
+
+    if (pool->workStealing)
+        return stealPoolWait(pool, timeout);
+
     epicsMutexMustLock(pool->guard);
 
     while (ellCount(&pool->jobs) > 0 || pool->threadsAreAwake > 0) {
@@ -213,7 +239,6 @@ void epicsThreadPoolDestroy(epicsThreadPool *pool)
     /* run remaining queued jobs */
     epicsThreadPoolControlImpl(pool, epicsThreadPoolQueueAdd, 0);
     epicsThreadPoolControlImpl(pool, epicsThreadPoolQueueRun, 1);
-    nThr = pool->threadsRunning;
     pool->freezeopt = 1;
 
     epicsMutexUnlock(pool->guard);
@@ -223,9 +248,14 @@ void epicsThreadPoolDestroy(epicsThreadPool *pool)
 
     epicsMutexMustLock(pool->guard);
 
-    pool->shutdown = 1;
+    /* jobs may have started more workers while we waited */
+    nThr = pool->threadsRunning;
+    epicsAtomicSetIntT(&pool->shutdown, 1);
     /* wakeup all */
-    if (pool->threadsWaking < pool->threadsSleeping) {
+    if (pool->workStealing) {
+        stealWakeup(pool);
+    }
+    else if (pool->threadsWaking < pool->threadsSleeping) {
         pool->threadsWaking = pool->threadsSleeping;
         epicsEventSignal(pool->workerWakeup);
     }
@@ -247,14 +277,21 @@ void epicsThreadPoolDestroy(epicsThreadPool *pool)
         epicsJob *job = CONTAINER(cur, epicsJob, jobnode);
 
         job->running = 1;
+        job->state = STEAL_RUNNING;
         job->func(job->arg, epicsJobModeCleanup);
         job->running = 0;
-        if (job->freewhendone)
+        if (job->freewhendone || (job->state & STEAL_FREE)) {
             free(job);
-        else
+        }
+        else {
+            job->state = STEAL_IDLE;
             job->pool = NULL; /* orphan */
+        }
     }
 
+    if (pool->workStealing)
+        stealPoolCleanup(pool);
+
     epicsEventDestroy(pool->workerWakeup);
     epicsEventDestroy(pool->shutdownEvent);
     epicsEventDestroy(pool->observerWakeup);
@@ -281,6 +318,8 @@ void epicsThreadPoolReport(epicsThreadPool *pool, FILE *fd)
         fprintf(fd, "  Pause workers\n");
     if (pool->shutdown)
         fprintf(fd, "  Shutdown in progress\n");
+    if (pool->workStealing)
+        stealPoolReport(pool, fd);
 
     for (cur = ellFirst(&pool->jobs); cur; cur = ellNext(cur)) {
         epicsJob *job = CONTAINER(cur, epicsJob, jobnode);
@@ -360,6 +399,9 @@ LIBCOM_API epicsThreadPool* epicsThreadPoolGetShared(epicsThreadPoolConfig *opts
             continue;
         if (cur->conf.workerStack < opts->workerStack)
             continue;
+        /* and the default scheduler */
+        if (cur->workStealing)
+            continue;
 
         cur->sharedCount++;
         assert(cur->sharedCount > 0);
@@ -54,6 +54,7 @@ void epicsTimerForC::destroy ()
     timerQueue & queueTmp = this->queue;
     this->~epicsTimerForC ();
     queueTmp.timerForCFreeList.release ( this );
+    queueTmp.timerDestroyed ();
 }
 
 epicsTimerNotify::expireStatus epicsTimerForC::expire ( const epicsTime & )
@@ -32,7 +32,7 @@
 
 template < class T > class epicsGuard;
 
-class timer : public epicsTimer, public tsDLNode < timer > {
+class timer : public epicsTimer {
 public:
     void destroy ();
     void start ( class epicsTimerNotify &, const epicsTime & );
@@ -51,6 +51,9 @@ private:
     epicsTime exp; // experation time
     state curState; // current state
     epicsTimerNotify * pNotify; // callback
+    unsigned heapIndex; // position in the queue's heap while pending
+    unsigned startSeq; // start order, breaks ties in expiration time
+    bool expiresBefore ( const timer & ) const;
     void privateStart ( epicsTimerNotify & notify, const epicsTime & );
     timer & operator = ( const timer & );
     // Visual C++ .net appears to require operator delete if
@@ -99,7 +102,11 @@ private:
     tsFreeList < epicsTimerForC, 0x20 > timerForCFreeList;
     mutable epicsMutex mutex;
     epicsEvent cancelBlockingEvent;
-    tsDLList < timer > timerList;
+    timer ** heap; // pending timers, earliest expiration first
+    unsigned heapCount;
+    unsigned heapSize;
+    unsigned timerCount;
+    unsigned startCount;
     epicsTimerQueueNotify & notify;
     timer * pExpireTmr;
     epicsThreadId processThread;
@@ -108,6 +115,13 @@ private:
     static const double exceptMsgMinPeriod;
     void printExceptMsg ( const char * pName,
                 const type_info & type );
+    void heapReserve ();
+    void heapInsert ( timer & );
+    void heapRemove ( timer & );
+    void heapSiftUp ( unsigned index );
+    void heapSiftDown ( unsigned index );
+    timer * heapFirst () const;
+    void timerDestroyed ();
     timerQueue ( const timerQueue & );
     timerQueue & operator = ( const timerQueue & );
     friend class timer;
@@ -236,6 +250,19 @@ inline unsigned timerQueueActive::threadPriority () const
     return thread.getPriority ();
 }
 
+inline bool timer::expiresBefore ( const timer & other ) const
+{
+    if ( this->exp != other.exp ) {
+        return this->exp < other.exp;
+    }
+    return static_cast < int > ( this->startSeq - other.startSeq ) < 0;
+}
+
+inline timer * timerQueue::heapFirst () const
+{
+    return this->heapCount ? this->heap[0] : 0;
+}
+
 inline void * timer::operator new ( size_t size,
                      tsFreeList < timer, 0x20 > & freeList )
 {
@@ -26,6 +26,11 @@ epicsTimerQueue::~epicsTimerQueue () {}
 
 timerQueue::timerQueue ( epicsTimerQueueNotify & notifyIn ) :
     mutex(__FILE__, __LINE__),
+    heap ( 0 ),
+    heapCount ( 0u ),
+    heapSize ( 0u ),
+    timerCount ( 0u ),
+    startCount ( 0u ),
     notify ( notifyIn ),
     pExpireTmr ( 0 ),
     processThread ( 0 ),
@@ -37,10 +42,105 @@ timerQueue::timerQueue ( epicsTimerQueueNotify & notifyIn ) :
 
 timerQueue::~timerQueue ()
 {
-    timer *pTmr;
-    while ( ( pTmr = this->timerList.get () ) ) {
-        pTmr->curState = timer::stateLimbo;
+    for ( unsigned i = 0u; i < this->heapCount; i++ ) {
+        this->heap[i]->curState = timer::stateLimbo;
     }
+    delete [] this->heap;
+}
+
+//
+// The pending timers are kept in a binary min-heap ordered by
+// expiration time, so that start and cancel are O(log n). Each
+// timer records its heap index so that it can be removed without
+// a search. Timers with equal expiration times expire in the order
+// that they were started.
+//
+// Every timer created by this queue might be pending at once, so the
+// heap is grown when timers are created and insertion never allocates.
+//
+void timerQueue::heapReserve ()
+{
+    if ( this->timerCount < this->heapSize ) {
+        return;
+    }
+    unsigned newSize = this->heapSize ? 2u * this->heapSize : 16u;
+    timer ** pNewHeap = new timer * [newSize];
+    for ( unsigned i = 0u; i < this->heapCount; i++ ) {
+        pNewHeap[i] = this->heap[i];
+    }
+    delete [] this->heap;
+    this->heap = pNewHeap;
+    this->heapSize = newSize;
+}
+
+void timerQueue::heapInsert ( timer & tmr )
+{
+    tmr.startSeq = this->startCount++;
+    tmr.heapIndex = this->heapCount++;
+    this->heap[tmr.heapIndex] = & tmr;
+    this->heapSiftUp ( tmr.heapIndex );
+}
+
+void timerQueue::heapRemove ( timer & tmr )
+{
+    unsigned index = tmr.heapIndex;
+    timer * pLast = this->heap[--this->heapCount];
+    if ( pLast != & tmr ) {
+        this->heap[index] = pLast;
+        pLast->heapIndex = index;
+        if ( index > 0u &&
+                pLast->expiresBefore ( *this->heap[( index - 1u ) / 2u] ) ) {
+            this->heapSiftUp ( index );
+        }
+        else {
+            this->heapSiftDown ( index );
+        }
+    }
+}
+
+void timerQueue::heapSiftUp ( unsigned index )
+{
+    timer * pTmr = this->heap[index];
+    while ( index > 0u ) {
+        unsigned parent = ( index - 1u ) / 2u;
+        if ( ! pTmr->expiresBefore ( *this->heap[parent] ) ) {
+            break;
+        }
+        this->heap[index] = this->heap[parent];
+        this->heap[index]->heapIndex = index;
+        index = parent;
+    }
+    this->heap[index] = pTmr;
+    pTmr->heapIndex = index;
+}
+
+void timerQueue::heapSiftDown ( unsigned index )
+{
+    timer * pTmr = this->heap[index];
+    while ( true ) {
+        unsigned child = 2u * index + 1u;
+        if ( child >= this->heapCount ) {
+            break;
+        }
+        if ( child + 1u < this->heapCount &&
+                this->heap[child + 1u]->expiresBefore ( *this->heap[child] ) ) {
+            child++;
+        }
+        if ( ! this->heap[child]->expiresBefore ( *pTmr ) ) {
+            break;
+        }
+        this->heap[index] = this->heap[child];
+        this->heap[index]->heapIndex = index;
+        index = child;
+    }
+    this->heap[index] = pTmr;
+    pTmr->heapIndex = index;
+}
+
+void timerQueue::timerDestroyed ()
+{
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    this->timerCount--;
 }
 
 void timerQueue ::
@@ -83,7 +183,7 @@ double timerQueue::process ( const epicsTime & currentTime )
     if ( this->pExpireTmr ) {
         // if some other thread is processing the queue
         // (or if this is a recursive call)
-        timer * pTmr = this->timerList.first ();
+        timer * pTmr = this->heapFirst ();
         if ( pTmr ) {
             double delay = pTmr->exp - currentTime;
             if ( delay < 0.0 ) {
@@ -100,10 +200,10 @@ double timerQueue::process ( const epicsTime & currentTime )
     // Tag current epired tmr so that we can detect if call back
     // is in progress when canceling the timer.
     //
-    if ( this->timerList.first () ) {
-        if ( currentTime >= this->timerList.first ()->exp ) {
-            this->pExpireTmr = this->timerList.first ();
-            this->timerList.remove ( *this->pExpireTmr );
+    if ( this->heapCount ) {
+        if ( currentTime >= this->heap[0]->exp ) {
+            this->pExpireTmr = this->heap[0];
+            this->heapRemove ( *this->pExpireTmr );
             this->pExpireTmr->curState = timer::stateActive;
             this->processThread = epicsThreadGetIdSelf ();
 #           ifdef DEBUG
@@ -111,7 +211,7 @@ double timerQueue::process ( const epicsTime & currentTime )
 #           endif
         }
         else {
-            double delay = this->timerList.first ()->exp - currentTime;
+            double delay = this->heap[0]->exp - currentTime;
             debugPrintf ( ( "no activity process %f to next\n", delay ) );
             return delay;
         }
@@ -178,17 +278,17 @@ double timerQueue::process ( const epicsTime & currentTime )
         }
         this->pExpireTmr = 0;
 
-        if ( this->timerList.first () ) {
-            if ( currentTime >= this->timerList.first ()->exp ) {
-                this->pExpireTmr = this->timerList.first ();
-                this->timerList.remove ( *this->pExpireTmr );
+        if ( this->heapCount ) {
+            if ( currentTime >= this->heap[0]->exp ) {
+                this->pExpireTmr = this->heap[0];
+                this->heapRemove ( *this->pExpireTmr );
                 this->pExpireTmr->curState = timer::stateActive;
 #               ifdef DEBUG
                     this->pExpireTmr->show ( 0u );
 #               endif
             }
             else {
-                delay = this->timerList.first ()->exp - currentTime;
+                delay = this->heap[0]->exp - currentTime;
                 this->processThread = 0;
                 break;
             }
@@ -204,23 +304,30 @@ double timerQueue::process ( const epicsTime & currentTime )
 
 epicsTimer & timerQueue::createTimer ()
 {
-    return * new ( this->timerFreeList ) timer ( * this );
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    this->heapReserve ();
+    timer & tmr = * new ( this->timerFreeList ) timer ( * this );
+    this->timerCount++;
+    return tmr;
 }
 
 epicsTimerForC & timerQueue::createTimerForC ( epicsTimerCallback pCallback, void *pArg )
 {
-    return * new ( this->timerForCFreeList ) epicsTimerForC ( *this, pCallback, pArg );
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    this->heapReserve ();
+    epicsTimerForC & tmr = * new ( this->timerForCFreeList )
+        epicsTimerForC ( *this, pCallback, pArg );
+    this->timerCount++;
+    return tmr;
 }
 
 void timerQueue::show ( unsigned level ) const
 {
     epicsGuard < epicsMutex > locker ( this->mutex );
-    printf ( "epicsTimerQueue with %u items pending\n", this->timerList.count () );
+    printf ( "epicsTimerQueue with %u items pending\n", this->heapCount );
     if ( level >= 1u ) {
-        tsDLIterConst < timer > iter = this->timerList.firstIter ();
-        while ( iter.valid () ) {
-            iter->show ( level - 1u );
-            ++iter;
+        for ( unsigned i = 0u; i < this->heapCount; i++ ) {
+            this->heap[i]->show ( level - 1u );
         }
     }
 }
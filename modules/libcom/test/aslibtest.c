@@ -13,6 +13,7 @@
 
 #include <errSymTbl.h>
 #include <epicsString.h>
+#include <epicsStdio.h>
 #include <osiFileName.h>
 #include <errlog.h>
 
@@ -144,12 +145,133 @@ static void testUseIP(void)
     testAccess("rw", 0);
 }
 
+static const char cache_config[] = ""
+        "UAG(ops) {alice}\n"
+        "ASG(DEFAULT) {RULE(0, NONE)}\n"
+        "ASG(calc) {INPA(\"x\") RULE(1, READ) RULE(1, WRITE) {UAG(ops) CALC(\"A>1\")}}\n"
+        ;
+
+#define NCLIENTS 100
+
+static unsigned clientAccess(ASCLIENTPVT *clients, int n)
+{
+    unsigned mask = 0;
+    int i;
+
+    /* all clients must agree */
+    for(i=0; i<n; i++) {
+        unsigned actual = 0;
+        actual |= asCheckGet(clients[i]) ? 1 : 0;
+        actual |= asCheckPut(clients[i]) ? 2 : 0;
+        if(i && actual!=mask)
+            return 0xff;
+        mask = actual;
+    }
+    return mask;
+}
+
+/* Number of decisions in the cache, from the asDumpFP() report */
+static int cacheEntries(void)
+{
+    FILE *fp = epicsTempFile();
+    char line[128];
+    int n = -1;
+
+    if(!fp)
+        return -1;
+    asDumpFP(fp, NULL, NULL, 1);
+    rewind(fp);
+    while(fgets(line, sizeof(line), fp)) {
+        if(sscanf(line, "Decision cache: %d entries", &n) == 1)
+            break;
+    }
+    fclose(fp);
+    return n;
+}
+
+static void testCache(void)
+{
+    ASMEMBERPVT asp = 0;
+    ASCLIENTPVT alice[NCLIENTS], bob;
+    unsigned long hits, misses;
+    ASG *pasg;
+    int i;
+
+    testDiag("testCache()");
+    asCheckClientIP = 0;
+
+    testOk1(asInitMem(cache_config, NULL)==0);
+    testOk1(asAddMember(&asp, "calc")==0);
+    pasg = asp->pasg;
+
+    setUser("alice");
+    setHost("localhost");
+    hits = asCacheHits;
+    misses = asCacheMisses;
+    for(i=0; i<NCLIENTS; i++)
+        asAddClient(&alice[i], asp, 0, asUser, asHost);
+    asAddClient(&bob, asp, 0, "bob", asHost);
+    testOk(asCacheMisses - misses == 2 && asCacheHits - hits == NCLIENTS - 1,
+           "%lu misses, %lu hits", asCacheMisses - misses, asCacheHits - hits);
+    testOk(clientAccess(alice, NCLIENTS)==1, "alice can read");
+
+    testDiag("INPA changes to 2");
+    pasg->pavalue[0] = 2.0;
+    pasg->inpChanged = 1;
+    hits = asCacheHits;
+    misses = asCacheMisses;
+    asComputeAsg(pasg);
+    testOk(asCacheMisses - misses == 2 && asCacheHits - hits == NCLIENTS - 1,
+           "%lu misses, %lu hits", asCacheMisses - misses, asCacheHits - hits);
+    testOk(clientAccess(alice, NCLIENTS)==3, "alice can write");
+    testOk(clientAccess(&bob, 1)==1, "bob can read");
+
+    testDiag("INPA goes bad");
+    pasg->inpBad = 1;
+    asComputeAsg(pasg);
+    testOk(clientAccess(alice, NCLIENTS)==1, "alice can read");
+
+    testDiag("INPA comes back, decisions are remembered");
+    pasg->inpBad = 0;
+    hits = asCacheHits;
+    misses = asCacheMisses;
+    asComputeAsg(pasg);
+    testOk(asCacheMisses - misses == 0 && asCacheHits - hits == NCLIENTS + 1,
+           "%lu misses, %lu hits", asCacheMisses - misses, asCacheHits - hits);
+    testOk(clientAccess(alice, NCLIENTS)==3, "alice can write");
+
+    testDiag("Cache disabled");
+    asCacheSize = 0;
+    pasg->pavalue[0] = 0.0;
+    pasg->inpChanged = 1;
+    hits = asCacheHits;
+    misses = asCacheMisses;
+    asComputeAsg(pasg);
+    testOk(asCacheMisses == misses && asCacheHits == hits, "No lookups");
+    testOk(clientAccess(alice, NCLIENTS)==1, "alice can read");
+    asCacheSize = 4096;
+
+    for(i=0; i<NCLIENTS; i++)
+        asRemoveClient(&alice[i]);
+    asRemoveClient(&bob);
+    asRemoveMember(&asp);
+
+    testDiag("Freeing the configuration empties the cache");
+    testOk(cacheEntries() > 0, "%d decisions cached", cacheEntries());
+    asFreeAll((ASBASE*)pasbase);
+    pasbase = NULL;
+    /* Installing the new configuration doesn't touch the cache */
+    testOk1(asInitMem(cache_config, NULL)==0);
+    testOk(cacheEntries() == 0, "%d decisions cached", cacheEntries());
+}
+
 MAIN(aslibtest)
 {
-    testPlan(27);
+    testPlan(42);
     testSyntaxErrors();
     testHostNames();
     testUseIP();
+    testCache();
     errlogFlush();
     return testDone();
 }
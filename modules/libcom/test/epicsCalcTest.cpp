@@ -14,6 +14,8 @@
 #include "epicsTypes.h"
 #include "epicsMath.h"
 #include "epicsAlgorithm.h"
+#include "epicsTime.h"
+#include "dbDefs.h"
 #include "postfix.h"
 #include "testMain.h"
 
@@ -44,6 +46,21 @@ double doCalc(const char *expr) {
     return result;
 }
 
+double doUnoptimized(const char *expr) {
+    /* Evaluate expression as parsed, without the optimizer */
+    int optimize = postfixOptimize;
+    double result;
+
+    postfixOptimize = 0;
+    result = doCalc(expr);
+    postfixOptimize = optimize;
+    return result;
+}
+
+bool sameResult(double x, double y) {
+    return x == y || (isnan(x) && isnan(y));
+}
+
 void testCalc(const char *expr, double expected) {
     /* Evaluate expression, test against expected result */
     bool pass = false;
@@ -52,7 +69,7 @@ void testCalc(const char *expr, double expected) {
     };
     char *rpn = (char*)malloc(INFIX_TO_POSTFIX_SIZE(strlen(expr)+1));
     short err;
-    double result = 0.0;
+    double result = 0.0, unoptimized;
     result /= result;  /* Start as NaN */
 
     if(!rpn) {
@@ -74,8 +91,12 @@ void testCalc(const char *expr, double expected) {
     } else {
         pass = (result == expected);
     }
+    /* The optimizer must not change the result */
+    unoptimized = doUnoptimized(expr);
+    pass = pass && sameResult(result, unoptimized);
     if (!testOk(pass, "%s", expr)) {
-        testDiag("Expected result is %g, actually got %g", expected, result);
+        testDiag("Expected result is %g, actually got %g (%g unoptimized)",
+                 expected, result, unoptimized);
         calcExprDump(rpn);
     }
     free(rpn);
@@ -158,6 +179,200 @@ void testBadExpr(const char *expr, short expected_err) {
     free(rpn);
 }
 
+/* Compare the rate of evaluating some typical record expressions with
+ * and without the optimizer.
+ */
+double benchRate(const char *expr, int optimize, double *presult) {
+    double args[CALCPERFORM_NARGS] = {
+        1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0
+    };
+    char *rpn = (char*)malloc(INFIX_TO_POSTFIX_SIZE(strlen(expr)+1));
+    const int nIter = 200000;
+    int saved = postfixOptimize;
+    epicsTimeStamp start, stop;
+    short err;
+    int n;
+
+    if (!rpn)
+        testAbort("postfix: %s no memory", expr);
+    postfixOptimize = optimize;
+    if (postfix(expr, rpn, &err))
+        testAbort("postfix: %s in expression '%s'", calcErrorStr(err), expr);
+    postfixOptimize = saved;
+
+    *presult = 0;
+    epicsTimeGetCurrent(&start);
+    for (n = 0; n < nIter; n++) {
+        calcPerform(args, presult, rpn);
+    }
+    epicsTimeGetCurrent(&stop);
+    free(rpn);
+    return nIter / epicsTimeDiffInSeconds(&stop, &start);
+}
+
+void benchmark(void) {
+    static const char *exprs[] = {
+        "A+B*C",
+        "(A-B)/C*D+E",
+        "A>B?C:D",
+        "A*D2R*2+SIN(PI/4)*B",
+        "C?(A<5?A+1:0):B*1000/60",
+        "0?A:B+(1?C*(R2D/60):D)",
+        "VAL>=4096?0:VAL+1",
+    };
+    const int nExprs = NELEMENTS(exprs);
+
+    testDiag("Expressions evaluated per second, as parsed -> optimized");
+    for (int n = 0; n < nExprs; n++) {
+        double plain, optimized;
+        double before = benchRate(exprs[n], 0, &plain);
+        double after = benchRate(exprs[n], 1, &optimized);
+
+        testOk(sameResult(plain, optimized), "%-24s %6.2f -> %6.2f M/s",
+            exprs[n], before / 1e6, after / 1e6);
+    }
+}
+
+/* Infrastructure for testing calcPerformArray() */
+
+#define ARRAY_NELM 200
+
+static double arrayCols[CALCPERFORM_NARGS][ARRAY_NELM];
+static const double *arrayArgs[CALCPERFORM_NARGS];
+static unsigned long arrayCounts[CALCPERFORM_NARGS];
+
+void arraySetup(void) {
+    for (int i = 0; i < ARRAY_NELM; i++) {
+        arrayCols[0][i] = i * 0.5 - 20;
+        arrayCols[2][i] = i % 5 - 2;
+        arrayCols[3][i] = i * 37 % 256;
+        arrayCols[4][i] = i % 13 ? i : epicsNAN;
+        for (int k = 5; k < CALCPERFORM_NARGS - 1; k++)
+            arrayCols[k][i] = i + k;
+    }
+    arrayCols[1][0] = 3.0;      /* B is the same for every element */
+    for (int k = 0; k < CALCPERFORM_NARGS; k++) {
+        arrayArgs[k] = arrayCols[k];
+        arrayCounts[k] = k == 1 ? 1 : ARRAY_NELM;
+    }
+    arrayArgs[CALCPERFORM_NARGS - 1] = NULL;   /* L is always zero */
+}
+
+char * arrayPostfix(const char *expr, int optimize) {
+    char *rpn = (char*)malloc(INFIX_TO_POSTFIX_SIZE(strlen(expr)+1));
+    int saved = postfixOptimize;
+    short err;
+
+    if (!rpn)
+        testAbort("postfix: %s no memory", expr);
+    postfixOptimize = optimize;
+    if (postfix(expr, rpn, &err))
+        testAbort("postfix: %s in expression '%s'", calcErrorStr(err), expr);
+    postfixOptimize = saved;
+    return rpn;
+}
+
+/* Evaluate each element with calcPerform() */
+long arrayLoop(const char *rpn, double *presults, unsigned long n) {
+    double args[CALCPERFORM_NARGS];
+
+    for (unsigned long i = 0; i < n; i++) {
+        for (int k = 0; k < CALCPERFORM_NARGS; k++)
+            args[k] = !arrayArgs[k] ? 0 :
+                arrayCounts[k] == 1 ? arrayArgs[k][0] : arrayArgs[k][i];
+        if (calcPerform(args, &presults[i], rpn))
+            return -1;
+    }
+    return 0;
+}
+
+void testArray(const char *expr, int optimize) {
+    char *rpn = arrayPostfix(expr, optimize);
+    double expected[ARRAY_NELM], results[ARRAY_NELM];
+    long status;
+    bool pass = true;
+    int i;
+
+    for (i = 0; i < ARRAY_NELM; i++)
+        expected[i] = results[i] = i;   /* VAL */
+    status = arrayLoop(rpn, expected, ARRAY_NELM);
+    status |= calcPerformArray(arrayArgs, arrayCounts, results, ARRAY_NELM,
+        rpn);
+
+    for (i = 0; i < ARRAY_NELM && pass; i++)
+        pass = sameResult(results[i], expected[i]);
+    if (!testOk(!status && pass, "Array %s%s", expr,
+            optimize ? "" : " (unoptimized)")) {
+        if (status)
+            testDiag("Evaluation failed");
+        else
+            testDiag("Element %d expected %g, got %g",
+                     i - 1, expected[i - 1], results[i - 1]);
+        calcExprDump(rpn);
+    }
+    free(rpn);
+}
+
+/* Compare the rate of evaluating an expression over a large array with
+ * calcPerformArray() and with a calcPerform() loop.
+ */
+void arrayBenchmark(void) {
+    static const char *exprs[] = {
+        "A*B+C",
+        "A>B?C*2:D",
+        "SIN(A)*B+C",
+        "MAX(A,C)+ABS(D-F)/G",
+    };
+    const int nExprs = NELEMENTS(exprs);
+    const unsigned long nElem = 10000;
+    const int nIter = 20;
+    double *cols = (double*)calloc(4 * nElem, sizeof(double));
+    double *loop = (double*)calloc(nElem, sizeof(double));
+    double *batch = (double*)calloc(nElem, sizeof(double));
+
+    if (!cols || !loop || !batch)
+        testAbort("arrayBenchmark: no memory");
+    for (unsigned long i = 0; i < nElem; i++) {
+        cols[i] = i * 0.001;
+        cols[nElem + i] = (i % 100) * 0.01;
+        cols[2 * nElem + i] = i % 7;
+        cols[3 * nElem + i] = i % 11 + 1;
+    }
+    for (int k = 0; k < CALCPERFORM_NARGS; k++) {
+        arrayArgs[k] = NULL;
+        arrayCounts[k] = nElem;
+    }
+    arrayArgs[0] = cols;
+    arrayArgs[1] = cols + nElem;
+    arrayArgs[2] = cols + 2 * nElem;
+    arrayArgs[3] = arrayArgs[5] = arrayArgs[6] = cols + 3 * nElem;
+
+    testDiag("Array elements evaluated per second, loop -> calcPerformArray");
+    for (int n = 0; n < nExprs; n++) {
+        char *rpn = arrayPostfix(exprs[n], 1);
+        epicsTimeStamp start, mid, stop;
+        bool pass = true;
+
+        epicsTimeGetCurrent(&start);
+        for (int i = 0; i < nIter; i++)
+            arrayLoop(rpn, loop, nElem);
+        epicsTimeGetCurrent(&mid);
+        for (int i = 0; i < nIter; i++)
+            calcPerformArray(arrayArgs, arrayCounts, batch, nElem, rpn);
+        epicsTimeGetCurrent(&stop);
+
+        for (unsigned long i = 0; i < nElem && pass; i++)
+            pass = sameResult(loop[i], batch[i]);
+        testOk(pass, "%-20s %6.1f -> %6.1f M/s", exprs[n],
+            nIter * nElem / epicsTimeDiffInSeconds(&mid, &start) / 1e6,
+            nIter * nElem / epicsTimeDiffInSeconds(&stop, &mid) / 1e6);
+        free(rpn);
+    }
+    free(cols);
+    free(loop);
+    free(batch);
+}
+
 /* Test an expression that is also valid C code */
 #define testExpr(expr) testCalc(#expr, expr);
 
@@ -298,7 +513,7 @@ MAIN(epicsCalcTest)
     const double a=1.0, b=2.0, c=3.0, d=4.0, e=5.0, f=6.0,
                  g=7.0, h=8.0, i=9.0, j=10.0, k=11.0, l=12.0;
 
-    testPlan(630);
+    testPlan(682);
 
     /* LITERAL_OPERAND elements */
     testExpr(0);
@@ -903,6 +1118,24 @@ MAIN(epicsCalcTest)
     testCalc("1+(1|2)**3", 1+pow((double) (1 | 2), 3.));// 8 6
     testExpr(1+(1?(1<2):(1>2))*2);
 
+    // Conditionals that are decided at run-time
+    testExpr(a < b ? c : d);
+    testExpr(a > b ? c : d);
+    testExpr(a ? b ? c : d : e);
+    testExpr(a ? b - 2 ? c : d : e);
+    testExpr(a - 1 ? b : c ? d : e);
+    testExpr(a ? 0 ? c : d : e);
+    testExpr(0 ? a : b ? c : d);
+    testExpr((a > b ? c : d) + (b > a ? e : f) * 2);
+    testExpr(-(a < b ? 1 ? c : d : 0 ? e : f));
+    testExpr((a ? b ? c : d : e) + 1);
+    testExpr(1 ? a : b ? c : d);
+    testExpr(b - 2 ? a : (c ? d ? 0 : f : g) * 2);
+    testExpr(a - 1 ? 1 ? c : d : 0 ? e : f);
+    testCalc("MAX(a, 1 ? b : c, 0 ? d : e, f > g ? h : i)", 9);
+    testCalc("a < b ? PI / 2 : sin(0.5) * 4", PI / 2);
+    testCalc("g:=a ? c : d; g", 3);
+
     testArgs("a", A_A, 0);
     testArgs("A", A_A, 0);
     testArgs("B", A_B, 0);
@@ -932,6 +1165,10 @@ MAIN(epicsCalcTest)
     testArgs("11.1;L:=0", 0, A_L);
     testArgs("12.1;A:=0;B:=A;C:=B;D:=C", 0, A_A|A_B|A_C|A_D);
     testArgs("13.1;B:=A;A:=B;C:=D;D:=C", A_A|A_D, A_A|A_B|A_C|A_D);
+    testArgs("0?A:B", A_B, 0);
+    testArgs("1?A:B", A_A, 0);
+    testArgs("C?A:B", A_A|A_B|A_C, 0);
+    testArgs("1+1?A:B;C:=D", A_A|A_D, A_C);
 
     // Malformed expressions
     testBadExpr("0x0.1", CALC_ERR_SYNTAX);
@@ -1005,5 +1242,41 @@ MAIN(epicsCalcTest)
     testUInt32Calc("-1431655766.1 << 0.1", 0xaaaaaaaau);
     testUInt32Calc("2863311530.1 << 0.1", 0xaaaaaaaau);
 
+    benchmark();
+
+    // Evaluating expressions over arrays
+    arraySetup();
+    testArray("A+B*C", 1);
+    testArray("(A-B)/C*D+E", 1);
+    testArray("A>B?C:D", 1);
+    testArray("A>B?C:D", 0);
+    testArray("C?A<0?A+1:0:B*1000/60", 1);
+    testArray("A?B?C:D:E", 1);
+    testArray("A?B?C:D:E", 0);
+    testArray("-(C<0?1?D:E:0?F:G)", 1);
+    testArray("(C?D?E:F:G)+(A>0?H:I)", 1);
+    testArray("MAX(A,C,E)+MIN(D,E,F)", 1);
+    testArray("FINITE(A,E)+ISNAN(E,C)*2+ISINF(A/C)+!C", 1);
+    testArray("D>>2 | D<<3 XOR 0xaaaaaaaa", 1);
+    testArray("D>>>1 AND ~C", 1);
+    testArray("A%C+A**2-ABS(A)", 1);
+    testArray("ATAN2(A,C)+SQRT(D)+FLOOR(A)+CEIL(A)+NINT(A)", 1);
+    testArray("EXP(C)+LN(D)+LOG(D)+SIN(A)*COS(A)+TANH(C)", 1);
+    testArray("G:=A*2;H:=G+1;G+H+VAL", 1);
+    testArray("VAL>=100?0:VAL+1", 1);
+    testArray("L+K", 1);
+    testArray("A+RNDM*0", 1);
+    {
+        char *rpn = arrayPostfix("A+C", 1);
+        double results[ARRAY_NELM];
+
+        arrayCounts[2] = ARRAY_NELM / 2;
+        testOk(calcPerformArray(arrayArgs, arrayCounts, results, ARRAY_NELM,
+            rpn) != 0, "Array input that is too short");
+        arrayCounts[2] = ARRAY_NELM;
+        free(rpn);
+    }
+    arrayBenchmark();
+
     return testDone();
 }
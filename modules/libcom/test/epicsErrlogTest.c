@@ -19,6 +19,7 @@
 #include "epicsAssert.h"
 #include "epicsThread.h"
 #include "epicsEvent.h"
+#include "epicsTime.h"
 #include "dbDefs.h"
 #include "errlog.h"
 #include "epicsUnitTest.h"
@@ -30,6 +31,7 @@
 #include "fdmgr.h"
 
 #define LOGBUFSIZE 2048
+#define NPRODUCED 20000
 
 static
 const char longmsg[]="A0123456789abcdef"
@@ -83,6 +85,7 @@ typedef struct {
 } clientPvt;
 
 static void testLogPrefix(void);
+static void testProducers(unsigned nthreads);
 static void acceptNewClient( void *pParam );
 static void readFromClient( void *pParam );
 static void testPrefixLogandCompare( const char* logmessage);
@@ -173,7 +176,7 @@ MAIN(epicsErrlogTest)
     char msg[256];
     clientPvt pvt, pvt2;
 
-    testPlan(40);
+    testPlan(44);
 
     strcpy(msg, truncmsg);
 
@@ -355,8 +358,11 @@ MAIN(epicsErrlogTest)
     epicsEventMustWait(pvt.done);
     testEqInt(pvt.count, 2);
 
-    /* The buffer has space for 1 more message: sizeof(msgNode) + 256 bytes */
+    /* Messages only take the space they need, so the buffer has room
+     * for 2 more of the same size.
+     */
     errlogPrintfNoConsole("%s", msg); /* Use up that space */
+    errlogPrintfNoConsole("%s", msg);
 
     testDiag("Overflow the buffer");
     errlogPrintfNoConsole("%s", msg);
@@ -370,16 +376,99 @@ MAIN(epicsErrlogTest)
 
     testDiag("Logged %u messages", pvt.count);
     epicsEventMustWait(pvt.done);
-    testEqInt(pvt.count, N+1);
+    testEqInt(pvt.count, N+2);
 
     /* Clean up */
     testOk(1 == errlogRemoveListeners(&logClient, &pvt),
         "Removed 1 listener");
 
+    testDiag("Concurrent producers");
+    testProducers(1);
+    testProducers(2);
+    testProducers(4);
+    testProducers(8);
+
     testLogPrefix();
 
     return testDone();
 }
+
+typedef struct {
+    unsigned received;
+    unsigned discarded;
+} countPvt;
+
+static
+void countClient(void* raw, const char* msg)
+{
+    countPvt *pvt = raw;
+    unsigned n;
+
+    if (sscanf(msg, "errlog: %u messages were discarded", &n) == 1)
+        pvt->discarded += n;
+    else
+        pvt->received++;
+}
+
+static
+void producer(void* raw)
+{
+    epicsEventId done = raw;
+    int i;
+
+    for (i = 0; i < NPRODUCED; i++)
+        errlogPrintfNoConsole("producer %p message %d\n", raw, i);
+    epicsEventSignal(done);
+}
+
+/*
+ * Several threads log as fast as they can, as during an alarm storm.
+ * Every message must be either delivered or counted as discarded.
+ */
+static void testProducers(unsigned nthreads)
+{
+    epicsEventId done[8];
+    epicsTimeStamp start, stop;
+    countPvt pvt;
+    unsigned i, sent = nthreads * NPRODUCED + 1;
+    double elapsed;
+
+    assert(nthreads <= NELEMENTS(done));
+
+    /* Clear "errlog: <n> messages were discarded" status */
+    errlogPrintfNoConsole(".");
+    errlogFlush();
+
+    pvt.received = 0;
+    pvt.discarded = 0;
+    errlogAddListener(&countClient, &pvt);
+
+    epicsTimeGetCurrent(&start);
+    for (i = 0; i < nthreads; i++) {
+        done[i] = epicsEventMustCreate(epicsEventEmpty);
+        epicsThreadMustCreate("producer", epicsThreadPriorityMedium,
+            epicsThreadGetStackSize(epicsThreadStackSmall),
+            producer, done[i]);
+    }
+    for (i = 0; i < nthreads; i++)
+        epicsEventMustWait(done[i]);
+    epicsTimeGetCurrent(&stop);
+    elapsed = epicsTimeDiffInSeconds(&stop, &start);
+
+    /* Report the discards before the last message */
+    errlogFlush();
+    errlogPrintfNoConsole(".");
+    errlogFlush();
+
+    testOk(pvt.received + pvt.discarded == sent,
+        "%u threads: %.0f messages/s, %u delivered + %u discarded == %u",
+        nthreads, (sent - 1) / elapsed, pvt.received, pvt.discarded, sent);
+
+    errlogRemoveListeners(&countClient, &pvt);
+    for (i = 0; i < nthreads; i++)
+        epicsEventDestroy(done[i]);
+}
+
 /*
  * Tests the log prefix code
  * The prefix is only applied to log messages as they go out to the socket,
@@ -15,9 +15,27 @@
 #include "epicsUnitTest.h"
 
 #include "cantProceed.h"
+#include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsThread.h"
+#include "epicsTime.h"
+
+/* Scheduler of the pools created by the tests below */
+static unsigned int workStealing;
+
+static epicsThreadPool* createPool(epicsThreadPoolConfig *conf)
+{
+    epicsThreadPoolConfig defconf;
+
+    if(!conf) {
+        epicsThreadPoolConfigDefaults(&defconf);
+        conf = &defconf;
+    }
+    if(workStealing)
+        return epicsThreadPoolCreateStealing(conf);
+    return epicsThreadPoolCreate(conf);
+}
 
 /* Do nothing */
 static void nullop(void)
@@ -104,7 +122,8 @@ static void postjobs(size_t icnt, size_t mcnt, int cork)
     priv->count=mcnt;
     priv->job=callocMustSucceed(mcnt, sizeof(*priv->job), "postjobs job array");
 
-    testDiag("postjobs(%lu,%lu)", (unsigned long)icnt, (unsigned long)mcnt);
+    testDiag("postjobs(%lu,%lu)%s", (unsigned long)icnt, (unsigned long)mcnt,
+             workStealing ? " work-stealing" : "");
 
     {
         epicsThreadPoolConfig conf;
@@ -112,7 +131,7 @@ static void postjobs(size_t icnt, size_t mcnt, int cork)
         conf.initialThreads=icnt;
         conf.maxThreads=mcnt;
 
-        testOk1((pool=epicsThreadPoolCreate(&conf))!=NULL);
+        testOk1((pool=createPool(&conf))!=NULL);
         if(!pool)
             return;
     }
@@ -208,8 +227,9 @@ static void testcleanup(void)
     epicsJob *job[3];
 
     testDiag("testcleanup()");
+    flag0 = 0;
 
-    testOk1((pool=epicsThreadPoolCreate(NULL))!=NULL);
+    testOk1((pool=createPool(NULL))!=NULL);
     if(!pool)
         return;
 
@@ -272,7 +292,7 @@ static void testreadd(void) {
 
     epicsThreadPoolConfigDefaults(&conf);
     conf.maxThreads = 2;
-    testOk1((pool=epicsThreadPoolCreate(&conf))!=NULL);
+    testOk1((pool=createPool(&conf))!=NULL);
     if(!pool)
         return;
 
@@ -329,7 +349,8 @@ void testcancel(void)
 {
     epicsJob *job[2];
     epicsThreadPool *pool;
-    testOk1((pool=epicsThreadPoolCreate(NULL))!=NULL);
+    shouldneverrun = numtoolate = 0;
+    testOk1((pool=createPool(NULL))!=NULL);
     if(!pool)
         return;
 
@@ -417,13 +438,106 @@ void testshared(void)
 
     testOk1(poolA->sharedCount==1);
 
+    testDiag("Work-stealing pools aren't shared with others");
+    testOk1((poolB=epicsThreadPoolCreateStealing(&conf))!=NULL);
+    testOk1(poolB!=poolA && poolB->workStealing && !poolA->workStealing);
+    epicsThreadPoolDestroy(poolB);
+
     epicsThreadPoolReleaseShared(poolA);
 
 }
 
+/* Throughput of many short jobs, queued either by another thread
+ * or by the jobs themselves.
+ */
+#define BENCH_JOBS 1000
+#define BENCH_ROUNDS 200
+
+typedef struct {
+    epicsJob *job;
+    unsigned int requeue; /* times left to queue itself again */
+} benchPriv;
+
+static int benchRuns;
+
+static void benchjob(void *arg, epicsJobMode mode)
+{
+    benchPriv *priv=arg;
+    if(mode!=epicsJobModeRun)
+        return;
+    epicsAtomicIncrIntT(&benchRuns);
+    if(priv->requeue) {
+        priv->requeue--;
+        epicsJobQueue(priv->job);
+    }
+}
+
+static double benchrate(unsigned int stealing, int fromJobs)
+{
+    epicsThreadPoolConfig conf;
+    epicsThreadPool *pool;
+    benchPriv *priv=callocMustSucceed(BENCH_JOBS, sizeof(*priv), "benchrate");
+    epicsTimeStamp start, stop;
+    double rate;
+    int i, r;
+
+    epicsThreadPoolConfigDefaults(&conf);
+    if(stealing)
+        pool = epicsThreadPoolCreateStealing(&conf);
+    else
+        pool = epicsThreadPoolCreate(&conf);
+    if(!pool)
+        testAbort("Can't create pool");
+    for(i=0; i<BENCH_JOBS; i++)
+        priv[i].job = epicsJobCreate(pool, &benchjob, &priv[i]);
+    benchRuns = 0;
+
+    epicsTimeGetCurrent(&start);
+    if(fromJobs) {
+        for(i=0; i<BENCH_JOBS; i++) {
+            priv[i].requeue = BENCH_ROUNDS-1;
+            epicsJobQueue(priv[i].job);
+        }
+        epicsThreadPoolWait(pool, -1);
+    }
+    else {
+        for(r=0; r<BENCH_ROUNDS; r++) {
+            for(i=0; i<BENCH_JOBS; i++)
+                epicsJobQueue(priv[i].job);
+            epicsThreadPoolWait(pool, -1);
+        }
+    }
+    epicsTimeGetCurrent(&stop);
+    rate = BENCH_JOBS*BENCH_ROUNDS/epicsTimeDiffInSeconds(&stop, &start);
+
+    testOk(epicsAtomicGetIntT(&benchRuns)==BENCH_JOBS*BENCH_ROUNDS,
+           "%-13s queued by %-6s %10.0f jobs/s",
+           stealing ? "work-stealing" : "shared queue",
+           fromJobs ? "jobs" : "thread", rate);
+
+    for(i=0; i<BENCH_JOBS; i++)
+        epicsJobDestroy(priv[i].job);
+    epicsThreadPoolDestroy(pool);
+    free(priv);
+    return rate;
+}
+
+static void benchmark(void)
+{
+    double base, steal;
+
+    testDiag("Throughput with %u CPUs", (unsigned)epicsThreadGetCPUs());
+    base = benchrate(0, 0);
+    steal = benchrate(1, 0);
+    testDiag("Work-stealing is %.2f times as fast", steal/base);
+    base = benchrate(0, 1);
+    steal = benchrate(1, 1);
+    testDiag("Work-stealing is %.2f times as fast", steal/base);
+}
+
 MAIN(epicsThreadPoolTest)
 {
-    testPlan(171);
+    testPlan(294);
 
     nullop();
     oneop();
@@ -444,5 +558,18 @@ MAIN(epicsThreadPoolTest)
     testcancel();
     testshared();
 
+    testDiag("Work-stealing scheduler");
+    workStealing = 1;
+    postjobs(0,1,1);
+    postjobs(0,4,1);
+    postjobs(2,4,1);
+    postjobs(0,4,0);
+    postjobs(4,4,0);
+    testcleanup();
+    testreadd();
+    testcancel();
+
+    benchmark();
+
     return testDone();
 }
@@ -0,0 +1,197 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Measure the cost of starting, restarting, canceling and expiring
+ * a large number of concurrent timers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "epicsTimer.h"
+#include "epicsEvent.h"
+#include "epicsAtomic.h"
+#include "epicsThread.h"
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+static const unsigned nTimers = 100000u;
+static const double maxDelay = 10.0; // sec
+
+class passiveNotify : public epicsTimerQueueNotify {
+public:
+    void reschedule () {}
+    double quantum () { return 0.0; }
+};
+
+class perfTimer : public epicsTimerNotify {
+public:
+    perfTimer () : pTimer ( 0 ), pCheck ( 0 ) {}
+    expireStatus expire ( const epicsTime & )
+    {
+        epicsTimer::expireInfo info = this->pTimer->getExpireInfo ();
+        if ( info.expireTime < this->pCheck->last ) {
+            this->pCheck->outOfOrder++;
+        }
+        this->pCheck->last = info.expireTime;
+        this->pCheck->expireCount++;
+        return expireStatus ( noRestart );
+    }
+    struct check {
+        check () : expireCount ( 0u ), outOfOrder ( 0u ) {}
+        epicsTime last;
+        unsigned expireCount;
+        unsigned outOfOrder;
+    };
+    epicsTimer * pTimer;
+    check * pCheck;
+};
+
+class activeTimer : public epicsTimerNotify {
+public:
+    expireStatus expire ( const epicsTime & currentTime )
+    {
+        double late = currentTime - this->expected;
+        if ( late > this->pStats->maxLate ) {
+            this->pStats->maxLate = late;
+        }
+        if ( epicsAtomicDecrIntT ( & this->pStats->remaining ) == 0 ) {
+            this->pStats->done.signal ();
+        }
+        return expireStatus ( noRestart );
+    }
+    struct stats {
+        stats () : remaining ( 0 ), maxLate ( 0.0 ) {}
+        int remaining;
+        double maxLate;
+        epicsEvent done;
+    };
+    epicsTime expected;
+    stats * pStats;
+};
+
+static double randomDelay ()
+{
+    return maxDelay * rand () / ( RAND_MAX + 1.0 );
+}
+
+static void report ( const char * pWhat, const epicsTime & begin,
+    unsigned count )
+{
+    double elapsed = epicsTime::getCurrent () - begin;
+    testDiag ( "%-28s %8.3f ms, %7.3f us each", pWhat,
+        elapsed * 1e3, elapsed * 1e6 / count );
+}
+
+static void passiveQueuePerformance ()
+{
+    passiveNotify notify;
+    epicsTimerQueuePassive & queue = epicsTimerQueuePassive::create ( notify );
+    perfTimer * pNotify = new perfTimer [nTimers];
+    perfTimer::check check;
+    epicsTime begin;
+    unsigned i;
+
+    testDiag ( "%u timers in a passive queue", nTimers );
+
+    begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i++ ) {
+        pNotify[i].pTimer = & queue.createTimer ();
+        pNotify[i].pCheck = & check;
+    }
+    report ( "create", begin, nTimers );
+
+    epicsTime now = epicsTime::getCurrent ();
+    begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i++ ) {
+        pNotify[i].pTimer->start ( pNotify[i], now + randomDelay () );
+    }
+    report ( "start, random delay", begin, nTimers );
+
+    begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i++ ) {
+        pNotify[i].pTimer->start ( pNotify[i], now + randomDelay () );
+    }
+    report ( "restart, random delay", begin, nTimers );
+
+    begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i += 2u ) {
+        pNotify[i].pTimer->cancel ();
+    }
+    report ( "cancel every other timer", begin, nTimers / 2u );
+
+    begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i += 2u ) {
+        pNotify[i].pTimer->start ( pNotify[i], now + maxDelay );
+    }
+    report ( "start, same expiration", begin, nTimers / 2u );
+
+    begin = epicsTime::getCurrent ();
+    queue.process ( now + 2.0 * maxDelay );
+    report ( "expire", begin, nTimers );
+
+    testOk ( check.expireCount == nTimers,
+        "%u of %u timers expired", check.expireCount, nTimers );
+    testOk ( check.outOfOrder == 0u,
+        "%u timers expired out of order", check.outOfOrder );
+
+    begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i++ ) {
+        pNotify[i].pTimer->destroy ();
+    }
+    report ( "destroy", begin, nTimers );
+
+    delete [] pNotify;
+    delete & queue;
+}
+
+static void activeQueuePerformance ()
+{
+    epicsTimerQueueActive & queue =
+        epicsTimerQueueActive::allocate ( false, epicsThreadPriorityMax );
+    activeTimer * pNotify = new activeTimer [nTimers];
+    epicsTimer ** pTimers = new epicsTimer * [nTimers];
+    activeTimer::stats stats;
+    const double window = 1.0; // sec
+    unsigned i;
+
+    testDiag ( "%u timers in an active queue expiring within %.1f sec",
+        nTimers, window );
+
+    for ( i = 0u; i < nTimers; i++ ) {
+        pTimers[i] = & queue.createTimer ();
+        pNotify[i].pStats = & stats;
+    }
+    stats.remaining = nTimers;
+
+    epicsTime begin = epicsTime::getCurrent ();
+    for ( i = 0u; i < nTimers; i++ ) {
+        pNotify[i].expected = begin + 0.5 + window * rand () / RAND_MAX;
+        pTimers[i]->start ( pNotify[i], pNotify[i].expected );
+    }
+    report ( "start", begin, nTimers );
+
+    bool done = stats.done.wait ( 0.5 + window + 10.0 );
+    testOk ( done, "%d timers remaining", stats.remaining );
+    testDiag ( "%-28s %8.3f ms", "latest expiration",
+        stats.maxLate * 1e3 );
+
+    for ( i = 0u; i < nTimers; i++ ) {
+        pTimers[i]->destroy ();
+    }
+    delete [] pTimers;
+    delete [] pNotify;
+    queue.release ();
+}
+
+MAIN ( epicsTimerPerform )
+{
+    testPlan ( 3 );
+    passiveQueuePerformance ();
+    activeQueuePerformance ();
+    return testDone ();
+}
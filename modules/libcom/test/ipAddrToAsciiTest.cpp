@@ -7,6 +7,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <string>
 
 #define EPICS_PRIVATE_API
 
@@ -14,6 +17,9 @@
 #include "epicsGuard.h"
 #include "epicsThread.h"
 #include "epicsEvent.h"
+#include "epicsTime.h"
+#include "epicsStdio.h"
+#include "envDefs.h"
 #include "ipAddrToAsciiAsynchronous.h"
 
 #include "epicsUnitTest.h"
@@ -143,17 +149,141 @@ void doCancel()
     trn2.release();
 }
 
+// Stand-in resolver: slow, names 10.0.0.N "hostN" for N < 100
+epicsMutex standInMutex;
+unsigned standInCalls;
+double standInDelay = 0.5;
+
+unsigned standInLookup(const struct in_addr *pAddr, char *pBuf, unsigned bufSize)
+{
+    unsigned ip = ntohl(pAddr->s_addr);
+    {
+        Guard G(standInMutex);
+        standInCalls++;
+    }
+    epicsThreadSleep(standInDelay);
+    if((ip >> 8) != 0x0a0000 || (ip & 0xff) >= 100)
+        return 0;
+    int len = epicsSnprintf(pBuf, bufSize, "host%u", ip & 0xff);
+    return len > 0 ? unsigned(len) : 0;
+}
+
+unsigned calls()
+{
+    Guard G(standInMutex);
+    unsigned ret = standInCalls;
+    standInCalls = 0;
+    return ret;
+}
+
+struct NameCB : public ipAddrToAsciiCallBack
+{
+    epicsEvent done;
+    std::string name;
+    virtual ~NameCB() {}
+    virtual void transactionComplete ( const char * pHostName )
+    {
+        name = pHostName;
+        done.signal();
+    }
+};
+
+// Look up all the addresses at once, returns seconds taken
+double lookupAll(ipAddrToAsciiEngine& engine, const unsigned *hosts,
+                 unsigned n, std::string *names)
+{
+    ipAddrToAsciiTransaction **trn = new ipAddrToAsciiTransaction* [n];
+    NameCB *cb = new NameCB [n];
+    epicsTime start = epicsTime::getCurrent();
+
+    for(unsigned i=0; i<n; i++) {
+        osiSockAddr addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.ia.sin_family = AF_INET;
+        addr.ia.sin_addr.s_addr = htonl(0x0a000000 | hosts[i]);
+        addr.ia.sin_port = htons(42);
+        trn[i] = &engine.createTransaction();
+        trn[i]->ipAddrToAscii(addr, cb[i]);
+    }
+    for(unsigned i=0; i<n; i++) {
+        if(!cb[i].done.wait(10.0))
+            testDiag("Lookup %u timed out", i);
+        names[i] = cb[i].name;
+    }
+    double elapsed = epicsTime::getCurrent() - start;
+    for(unsigned i=0; i<n; i++)
+        trn[i]->release();
+    delete [] cb;
+    delete [] trn;
+    return elapsed;
+}
+
+// Parallel lookups, deduplication and caching with the stand-in resolver
+void doStandIn()
+{
+    testDiag("In doStandIn");
+
+    ipAddrToAsciiEngine::setHostNameLookup(standInLookup);
+    ipAddrToAsciiEngine& engine(ipAddrToAsciiEngine::allocate());
+    std::string names[8];
+    double elapsed;
+    calls();
+
+    {
+        static const unsigned hosts[] = {1, 2, 3, 4, 5, 6, 7, 8};
+        elapsed = lookupAll(engine, hosts, 8, names);
+        testOk(calls()==8u, "8 addresses looked up");
+        testOk(names[0]=="host1:42" && names[7]=="host8:42",
+               "names %s ... %s", names[0].c_str(), names[7].c_str());
+        testOk(elapsed < 8 * standInDelay / 2,
+               "Lookups overlap, %.2f sec for 8 of %.2f sec", elapsed, standInDelay);
+    }
+
+    {
+        static const unsigned hosts[] = {50, 50, 50, 50, 50, 50};
+        lookupAll(engine, hosts, 6, names);
+        testOk(calls()==1u, "6 requests for one address share a lookup");
+        testOk(names[0]=="host50:42" && names[5]=="host50:42",
+               "names %s ... %s", names[0].c_str(), names[5].c_str());
+    }
+
+    {
+        static const unsigned hosts[] = {1, 50};
+        elapsed = lookupAll(engine, hosts, 2, names);
+        testOk(calls()==0u && elapsed < standInDelay,
+               "Known names are remembered (%.2f sec)", elapsed);
+    }
+
+    {
+        static const unsigned hosts[] = {200};
+        lookupAll(engine, hosts, 1, names);
+        testOk(calls()==1u && names[0]=="10.0.0.200:42",
+               "Address with no name gives %s", names[0].c_str());
+        lookupAll(engine, hosts, 1, names);
+        testOk(calls()==0u, "Missing name is remembered");
+        epicsThreadSleep(1.0);
+        lookupAll(engine, hosts, 1, names);
+        testOk(calls()==1u, "Missing name is looked up again after its TTL");
+    }
+
+    engine.release();
+    ipAddrToAsciiEngine::setHostNameLookup(0);
+}
+
 } // namespace
 
 MAIN(ipAddrToAsciiTest)
 {
-    testPlan(5);
+    testPlan(14);
+    // must be set before the first engine is allocated
+    epicsEnvSet("EPICS_HOST_NAME_NEG_TTL", "0.5");
     {
         ipAddrToAsciiEngine& engine(ipAddrToAsciiEngine::allocate());
         doLookup(engine);
         engine.release();
     }
     doCancel();
+    doStandIn();
     // TODO: somehow test cancel of in-progress callback
     // allow time for any un-canceled transcations to crash us...
     epicsThreadSleep(1.0);